@@ -524,4 +524,69 @@
     explain = coll.explain().aggregate(pipeline, {collation: caseInsensitiveCollation});
     assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
     assert.eq({str: 1, d: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
+
+    //
+    // Verify that a $sort-$group pipeline with only $last accumulators can use a DISTINCT_SCAN that
+    // walks the index in the reverse of the sort order.
+    //
+    pipeline = [{$sort: {a: 1, b: 1}}, {$group: {_id: "$a", accum: {$last: "$b"}}}];
+    result = coll.aggregate(pipeline).toArray().sort(bsonWoCompare);
+    assert.eq(result, [{_id: null, accum: 1}, {_id: 1, accum: 3}, {_id: 2, accum: 2}]);
+    explain = coll.explain().aggregate(pipeline);
+    assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+    assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
+    assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+
+    //
+    // Verify that a $sort-$group pipeline that mixes $first and $last accumulators _does not_ use
+    // a DISTINCT_SCAN.
+    //
+    pipeline = [
+        {$sort: {a: 1, b: 1}},
+        {$group: {_id: "$a", first: {$first: "$b"}, last: {$last: "$b"}}}
+    ];
+    result = coll.aggregate(pipeline).toArray().sort(bsonWoCompare);
+    assert.eq(result, [
+        {_id: null, first: null, last: 1},
+        {_id: 1, first: 1, last: 3},
+        {_id: 2, first: 2, last: 2}
+    ]);
+    explain = coll.explain().aggregate(pipeline);
+    assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+
+    //
+    // Verify that a $group pipeline with a $max accumulator can use a DISTINCT_SCAN that reads the
+    // greatest value of each group first.
+    //
+    pipeline = [{$group: {_id: "$a", accum: {$max: "$b"}}}];
+    result = coll.aggregate(pipeline).toArray().sort(bsonWoCompare);
+    assert.eq(result, [{_id: null, accum: 1}, {_id: 1, accum: 3}, {_id: 2, accum: 2}]);
+    explain = coll.explain().aggregate(pipeline);
+    assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+    assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
+
+    //
+    // Verify that $min accumulators, which ignore missing and null values that sort first in the
+    // index, _do not_ use a DISTINCT_SCAN.
+    //
+    pipeline = [{$group: {_id: "$a", accum: {$min: "$b"}}}];
+    result = coll.aggregate(pipeline).toArray().sort(bsonWoCompare);
+    assert.eq(result, [{_id: null, accum: 1}, {_id: 1, accum: 1}, {_id: 2, accum: 2}]);
+    explain = coll.explain().aggregate(pipeline);
+    assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+
+    //
+    // Verify that a $max accumulator over a multikey field _does not_ use a DISTINCT_SCAN. The
+    // index orders an array by its elements, but $max compares whole arrays, which sort above
+    // numbers.
+    //
+    const mkMaxColl = db.group_conversion_to_distinct_scan_multikey_max;
+    mkMaxColl.drop();
+    assert.commandWorked(mkMaxColl.createIndex({a: 1, ts: -1}));
+    assert.commandWorked(mkMaxColl.insert([{a: 1, ts: [1, 2]}, {a: 1, ts: 50}, {a: 2, ts: 3}]));
+    pipeline = [{$group: {_id: "$a", accum: {$max: "$ts"}}}];
+    result = mkMaxColl.aggregate(pipeline).toArray().sort(bsonWoCompare);
+    assert.eq(result, [{_id: 1, accum: [1, 2]}, {_id: 2, accum: 3}]);
+    explain = mkMaxColl.explain().aggregate(pipeline);
+    assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
 }());
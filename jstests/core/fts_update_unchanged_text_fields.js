@@ -0,0 +1,48 @@
+// Test that updates which leave the indexed text fields untouched, but still touch other indexes,
+// keep the text index consistent with the documents.
+(function() {
+    "use strict";
+
+    load("jstests/libs/fts.js");  // For queryIDS.
+
+    const coll = db.fts_update_unchanged_text_fields;
+    coll.drop();
+
+    assert.commandWorked(coll.createIndex({tag: 1}));
+    assert.commandWorked(coll.createIndex({prefix: 1, title: "text", "body.text": "text"},
+                                          {language_override: "lang"}));
+
+    assert.writeOK(
+        coll.insert({_id: 1, prefix: 1, tag: 1, title: "running", body: {text: "dogs"}}));
+    assert.writeOK(coll.insert(
+        {_id: 2, prefix: 1, tag: 2, title: "walking", body: {text: "cats"}, lang: "english"}));
+
+    // Changes only a field covered by another index.
+    assert.writeOK(coll.update({_id: 1}, {$set: {tag: 3}}));
+    assert.eq([1], queryIDS(coll, "run", {prefix: 1}));
+    assert.eq([1], queryIDS(coll, "dog", {prefix: 1}));
+
+    // Replaces the whole document without changing the indexed text fields.
+    assert.writeOK(coll.update(
+        {_id: 2}, {prefix: 1, tag: 4, title: "walking", body: {text: "cats"}, lang: "english"}));
+    assert.eq([2], queryIDS(coll, "walk", {prefix: 1}));
+
+    // Changes a text field alongside the other index.
+    assert.writeOK(coll.update({_id: 1}, {$set: {tag: 5, title: "jumping"}}));
+    assert.eq([], queryIDS(coll, "run", {prefix: 1}));
+    assert.eq([1], queryIDS(coll, "jump", {prefix: 1}));
+
+    // Changes a nested text field alongside the other index.
+    assert.writeOK(coll.update({_id: 1}, {$set: {tag: 6, "body.text": "birds"}}));
+    assert.eq([], queryIDS(coll, "dog", {prefix: 1}));
+    assert.eq([1], queryIDS(coll, "bird", {prefix: 1}));
+
+    // Changes the non-text prefix of the text index.
+    assert.writeOK(coll.update({_id: 1}, {$set: {tag: 7, prefix: 2}}));
+    assert.eq([], queryIDS(coll, "jump", {prefix: 1}));
+    assert.eq([1], queryIDS(coll, "jump", {prefix: 2}));
+
+    // Changes the language override, so that stop words are no longer removed.
+    assert.writeOK(coll.update({_id: 2}, {$set: {tag: 8, title: "the", lang: "none"}}));
+    assert.eq([2], queryIDS(coll, "the", {prefix: 1}, {$language: "none"}));
+}());
@@ -0,0 +1,55 @@
+// Tests that a query which constrains only the trailing fields of a compound index can be answered
+// by a skip scan that seeks past each distinct value of the leading field.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("jstests_skip_scan");
+    const coll = testDB.skip_scan;
+
+    const tenants = ["a", "b", "c"];
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let tenant of tenants) {
+        for (let ts = 0; ts < 1000; ++ts) {
+            bulk.insert({tenant: tenant, ts: ts});
+        }
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({tenant: 1, ts: 1}));
+
+    const query = {ts: {$gte: 500, $lt: 510}};
+    const expected =
+        coll.find(query, {_id: 0}).hint({$natural: 1}).sort({tenant: 1, ts: 1}).toArray();
+
+    // Skip scans are off by default, so the query has to scan the collection.
+    let explain = coll.find(query).explain("executionStats");
+    assert(isCollscan(testDB, explain.queryPlanner.winningPlan), explain);
+
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryPlannerGenerateSkipScans: true}));
+
+    assert.eq(expected, coll.find(query, {_id: 0}).sort({tenant: 1, ts: 1}).toArray());
+
+    // The skip scan beats the collection scan it races, and reads only the matching keys plus one
+    // key past the end of each tenant's range.
+    coll.getPlanCache().clear();
+    explain = coll.find(query).explain("executionStats");
+    const ixscan = getPlanStage(explain.executionStats.executionStages, "IXSCAN");
+    assert.neq(null, ixscan, explain);
+    assert.eq(true, ixscan.isSkipScan, ixscan);
+    assert.eq({tenant: 1, ts: 1}, ixscan.keyPattern, ixscan);
+    assert.eq(30, explain.executionStats.nReturned, explain);
+    assert.eq(30, explain.executionStats.totalDocsExamined, explain);
+    assert.lte(ixscan.keysExamined, 30 + 2 * tenants.length, ixscan);
+
+    // A predicate on the leading field produces ordinary bounds instead.
+    explain = coll.find({tenant: "a", ts: {$gte: 500}}).explain();
+    const plainIxscan = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+    assert.neq(null, plainIxscan, explain);
+    assert(!plainIxscan.hasOwnProperty("isSkipScan"), plainIxscan);
+
+    MongoRunner.stopMongod(conn);
+}());
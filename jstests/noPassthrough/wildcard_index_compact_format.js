@@ -0,0 +1,119 @@
+/**
+ * Tests that a version 2 $** index, which stores path ids from its path dictionary in place of the
+ * full paths, answers queries with the same results as a version 1 $** index and a collection
+ * scan, including after the server restarts and the dictionary is loaded back from the index.
+ * @tags: [requires_persistence]
+ */
+(function() {
+    "use strict";
+
+    const dbpath = MongoRunner.dataPath + "wildcard_index_compact_format/";
+    let conn = MongoRunner.runMongod({dbpath: dbpath});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    function insertDocs(testDB, start, count) {
+        for (let collName of["v1", "v2"]) {
+            const bulk = testDB[collName].initializeUnorderedBulkOp();
+            for (let i = start; i < start + count; ++i) {
+                let doc = {_id: i, a: i % 10, b: {c: i % 3, d: [i % 4, {e: i % 5}]}};
+                if (i % 7 === 0) {
+                    doc["f" + (i % 4)] = {g: i};
+                }
+                bulk.insert(doc);
+            }
+            assert.writeOK(bulk.execute());
+        }
+    }
+
+    function createIndexes(testDB) {
+        testDB.v1.drop();
+        testDB.v2.drop();
+        assert.commandWorked(testDB.v1.createIndex({"$**": 1}));
+        assert.commandWorked(testDB.v2.createIndex({"$**": 1}, {wildcardIndexVersion: 2}));
+    }
+
+    const queries = [
+        {a: 3},
+        {a: {$gte: 2, $lt: 5}},
+        {"b.c": {$in: [0, 2]}},
+        {"b.d": 1},
+        {"b.d.e": {$gt: 2}},
+        {"b.d.1.e": 4},
+        {b: {$exists: true}},
+        {"b.d": {$exists: true}},
+        {f1: {$exists: true}},
+        {"f2.g": {$lt: 100}},
+        {a: 1, "f3.g": {$exists: true}},
+        {neverIndexed: 1},
+    ];
+
+    function checkQueries(testDB) {
+        for (let query of queries) {
+            const expected = testDB.v1.find(query).hint({$natural: 1}).sort({_id: 1}).toArray();
+            for (let collName of["v1", "v2"]) {
+                const actual = testDB[collName].find(query).hint({"$**": 1}).toArray();
+                actual.sort((x, y) => x._id - y._id);
+                assert.eq(expected, actual, tojson({coll: collName, query: query}));
+                assert.eq(expected.length,
+                          testDB[collName].find(query).hint({"$**": 1}).itcount(),
+                          tojson({coll: collName, query: query}));
+            }
+        }
+
+        // A sort on the indexed path can be provided by either index.
+        assert.eq(testDB.v1.find({a: {$gt: 5}}, {_id: 0, a: 1}).sort({a: 1}).toArray(),
+                  testDB.v2.find({a: {$gt: 5}}, {_id: 0, a: 1}).sort({a: 1}).toArray());
+        assert.eq(testDB.v1.distinct("b.c", {"b.c": {$gte: 0}}).sort(),
+                  testDB.v2.distinct("b.c", {"b.c": {$gte: 0}}).sort());
+
+        for (let collName of["v1", "v2"]) {
+            const res = assert.commandWorked(testDB[collName].validate({full: true}));
+            assert(res.valid, tojson(res));
+        }
+    }
+
+    let testDB = conn.getDB("test");
+    createIndexes(testDB);
+    insertDocs(testDB, 0, 500);
+
+    // Updates and deletes must remove the keys written under each path's id.
+    for (let collName of["v1", "v2"]) {
+        assert.writeOK(testDB[collName].update({a: 4}, {$set: {"b.c": 7, h: 1}}, {multi: true}));
+        assert.writeOK(testDB[collName].remove({a: 9}));
+    }
+    checkQueries(testDB);
+
+    // The keys of the version 2 index lead with a path id rather than the path.
+    const returnedKeys = testDB.v2.find({a: 3}).hint({"$**": 1}).returnKey().toArray();
+    assert.gt(returnedKeys.length, 0);
+    assert(returnedKeys.every(key => typeof key["$_path"] !== "string"), tojson(returnedKeys));
+
+    // Paths first seen after a restart must be assigned fresh ids, without disturbing the paths
+    // already in the reloaded dictionary.
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod({dbpath: dbpath, noCleanData: true});
+    assert.neq(null, conn, "mongod was unable to restart");
+    testDB = conn.getDB("test");
+
+    checkQueries(testDB);
+    insertDocs(testDB, 500, 500);
+    for (let collName of["v1", "v2"]) {
+        assert.writeOK(testDB[collName].insert({_id: 1000, newPath: {x: 1}, a: 3}));
+    }
+    queries.push({"newPath.x": 1}, {newPath: {$exists: true}});
+    checkQueries(testDB);
+
+    // Building the version 2 index over existing data produces the same results.
+    assert.commandWorked(testDB.v2.dropIndexes());
+    assert.commandWorked(testDB.v2.createIndex({"$**": 1}, {wildcardIndexVersion: 2}));
+    checkQueries(testDB);
+
+    // The version option is only accepted for $** indexes, and only with a known version.
+    assert.commandFailedWithCode(testDB.v2.createIndex({x: 1}, {wildcardIndexVersion: 2}),
+                                 ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        testDB.v2.createIndex({"x.$**": 1}, {wildcardIndexVersion: 3}),
+        ErrorCodes.CannotCreateIndex);
+
+    MongoRunner.stopMongod(conn);
+}());
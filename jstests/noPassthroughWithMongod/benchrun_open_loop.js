@@ -0,0 +1,47 @@
+// Tests the "opsPerSecond" and "throughputIntervalSeconds" options to benchRun(), and the latency
+// percentiles it reports.
+(function() {
+    "use strict";
+
+    const coll = db.benchrun_open_loop;
+    coll.drop();
+    assert.commandWorked(coll.insert({_id: 1, x: 1}));
+
+    const benchArgs = {
+        ops: [{op: "findOne", ns: coll.getFullName(), query: {_id: 1}, readCmd: true}],
+        parallel: 2,
+        seconds: 4,
+        opsPerSecond: 100,
+        throughputIntervalSeconds: 1,
+        host: db.getMongo().host
+    };
+    if (jsTest.options().auth) {
+        benchArgs['db'] = 'admin';
+        benchArgs['username'] = jsTest.options().authUser;
+        benchArgs['password'] = jsTest.options().authPassword;
+    }
+
+    const res = benchRun(benchArgs);
+    jsTestLog("benchRun result: " + tojson(res));
+
+    // The arrival rate caps the throughput. Allow generous slack for slow test machines.
+    assert.gt(res.findOnes, 0, tojson(res));
+    assert.lte(res.findOnes, benchArgs.opsPerSecond * benchArgs.seconds * 1.5, tojson(res));
+
+    const percentiles = res.findOneLatencyPercentilesMicros;
+    assert(percentiles, tojson(res));
+    assert.lte(percentiles.p50, percentiles.p99, tojson(res));
+    assert.lte(percentiles.p99, percentiles.p999, tojson(res));
+    assert.lte(percentiles.p999, percentiles.max, tojson(res));
+
+    assert(Array.isArray(res.throughput), tojson(res));
+    assert.gt(res.throughput.length, 0, tojson(res));
+    let totalOps = 0;
+    res.throughput.forEach(function(interval, i) {
+        assert.eq(i * benchArgs.throughputIntervalSeconds, interval.time, tojson(res));
+        totalOps += interval.totalOps;
+    });
+    assert.eq(res.findOnes, totalOps, tojson(res));
+
+    assert.throws(() => benchRun(Object.merge(benchArgs, {opsPerSecond: -1})));
+})();
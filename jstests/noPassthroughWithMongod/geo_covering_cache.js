@@ -0,0 +1,72 @@
+/**
+ * Tests that repeated 2dsphere queries return the same results whether or not coverings of query
+ * geometries and geoNear annuli are cached.
+ */
+(function() {
+    "use strict";
+
+    const coll = db.geo_covering_cache;
+    coll.drop();
+
+    Random.setRandomSeed();
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 2000; ++i) {
+        // Cluster most points around a hot spot, with the rest spread more thinly.
+        const spread = (i % 4 === 0) ? 1 : 0.01;
+        bulk.insert({
+            _id: i,
+            loc: {
+                type: "Point",
+                coordinates:
+                    [-73.98 + (Random.rand() - 0.5) * spread, 40.75 + (Random.rand() - 0.5) * spread]
+            }
+        });
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+    function setCacheCoverings(enabled) {
+        assert.commandWorked(
+            db.adminCommand({setParameter: 1, internalQueryS2GeoCacheCoverings: enabled}));
+    }
+
+    const polygon = {
+        type: "Polygon",
+        coordinates:
+            [[[-73.99, 40.74], [-73.97, 40.74], [-73.97, 40.76], [-73.99, 40.76], [-73.99, 40.74]]]
+    };
+
+    function runQueries() {
+        return {
+            within: coll.find({loc: {$geoWithin: {$geometry: polygon}}})
+                        .sort({_id: 1})
+                        .toArray()
+                        .map(doc => doc._id),
+            near: coll.find({
+                          loc: {
+                              $nearSphere:
+                                  {$geometry: {type: "Point", coordinates: [-73.98, 40.75]}}
+                          }
+                      })
+                      .limit(500)
+                      .toArray()
+                      .map(doc => doc._id),
+        };
+    }
+
+    try {
+        setCacheCoverings(false);
+        const expected = runQueries();
+        assert.gt(expected.within.length, 0);
+        assert.eq(500, expected.near.length);
+
+        setCacheCoverings(true);
+        for (let i = 0; i < 3; ++i) {
+            const actual = runQueries();
+            assert.eq(expected.within, actual.within);
+            assert.eq(expected.near, actual.near);
+        }
+    } finally {
+        setCacheCoverings(true);
+    }
+}());
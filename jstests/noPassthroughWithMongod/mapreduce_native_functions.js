@@ -0,0 +1,116 @@
+/**
+ * Tests that mapReduce jobs whose map and reduce functions are applied in C++ produce the same
+ * results as when they are applied in the JS engine, including for documents and values that fall
+ * back to the JS functions.
+ */
+(function() {
+    "use strict";
+
+    const coll = db.mapreduce_native_functions;
+    coll.drop();
+    const outColl = db.mapreduce_native_functions_out;
+    outColl.drop();
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 2000; ++i) {
+        let doc = {_id: i, k: i % 17, v: i % 5};
+        if (i % 7 === 0) {
+            doc.k = "key" + (i % 3);
+        }
+        if (i % 11 === 0) {
+            doc.v = NumberInt(i % 9);
+        }
+        if (i % 13 === 0) {
+            doc.v = NumberLong(i);
+        }
+        if (i % 97 === 0) {
+            // Not a number, so lists holding it are reduced by the JS function.
+            doc.v = "str" + i;
+        }
+        if (i % 101 === 0) {
+            // Missing fields are handled by the JS map function.
+            delete doc.k;
+        }
+        if (i % 103 === 0) {
+            doc.k = {nested: i % 2};
+        }
+        bulk.insert(doc);
+    }
+    assert.writeOK(bulk.execute());
+
+    function setNativeFunctions(enabled) {
+        assert.commandWorked(db.adminCommand(
+            {setParameter: 1, internalQueryMapReduceEnableNativeFunctions: enabled}));
+    }
+
+    const maps = [
+        function() {
+            emit(this.k, this.v);
+        },
+        function() {
+            emit(this.k, 1);
+        },
+        function() {
+            emit(this.v, -2.5);
+        },
+        // Not of a recognized shape, so only the batching of JS map calls applies.
+        function() {
+            emit(this.k, this.v);
+            emit(this._id % 3, 1);
+        },
+        // Literals that overflow or underflow a double, and an octal literal, are left to the JS
+        // engine. They are given as strings since octal literals are not allowed in strict mode.
+        "function() { emit(this.k, " + "1".repeat(400) + "); }",
+        "function() { emit(this.k, -" + "9".repeat(400) + ".5); }",
+        "function() { emit(this.k, 0." + "0".repeat(400) + "1); }",
+        "function() { emit(this.k, 010); }",
+    ];
+    const reduces = [
+        function(key, values) {
+            return Array.sum(values);
+        },
+        function(key, values) {
+            return Math.min.apply(null, values);
+        },
+        function(key, values) {
+            return Math.max.apply(Math, values);
+        },
+        // Not of a recognized shape, so only the batching of JS reduce calls applies.
+        function(key, values) {
+            return values.length;
+        },
+    ];
+
+    function runMapReduce(map, reduce, out) {
+        const res = assert.commandWorked(db.runCommand({
+            mapReduce: coll.getName(),
+            map: map,
+            reduce: reduce,
+            query: {_id: {$ne: 5}},
+            sort: {_id: 1},
+            out: out,
+        }));
+        const results = out.inline ? res.results : outColl.find().toArray();
+        return results.sort((a, b) => bsonWoCompare({_id: a._id}, {_id: b._id}));
+    }
+
+    try {
+        for (let map of maps) {
+            for (let reduce of reduces) {
+                for (let out of[{inline: 1}, outColl.getName()]) {
+                    const msg = tojson({map: map, reduce: reduce, out: out});
+                    setNativeFunctions(false);
+                    const expected = runMapReduce(map, reduce, out);
+                    setNativeFunctions(true);
+                    const actual = runMapReduce(map, reduce, out);
+                    assert.eq(expected.length, actual.length, msg);
+                    for (let i = 0; i < expected.length; ++i) {
+                        assert.eq(0, bsonWoCompare(expected[i], actual[i]), msg);
+                    }
+                }
+            }
+        }
+    } finally {
+        setNativeFunctions(true);
+    }
+}());
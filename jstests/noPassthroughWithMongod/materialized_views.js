@@ -0,0 +1,138 @@
+/**
+ * Tests that materialized views return the same documents as the equivalent aggregation over the
+ * underlying collection as it is written to, and that their backing collections follow the views.
+ */
+(function() {
+    "use strict";
+
+    const coll = db.materialized_views;
+    const groupView = db.materialized_views_by_category;
+    const matchView = db.materialized_views_expensive;
+    coll.drop();
+    groupView.drop();
+    matchView.drop();
+
+    const groupPipeline = [
+        {$match: {status: "active"}},
+        {$addFields: {revenue: {$multiply: ["$price", "$qty"]}}},
+        {$group: {_id: "$category", revenue: {$sum: "$revenue"}, items: {$sum: 1}}},
+    ];
+    const matchPipeline = [{$match: {price: {$gte: 10}}}, {$project: {category: 1, price: 1}}];
+
+    const categories = ["a", "b", "c", "d"];
+    const statuses = ["active", "inactive"];
+
+    Random.setRandomSeed();
+    function randomDoc(id) {
+        return {
+            _id: id,
+            category: categories[Random.randInt(categories.length)],
+            status: statuses[Random.randInt(statuses.length)],
+            price: Random.randInt(20),
+            qty: Random.randInt(5),
+        };
+    }
+
+    let nextId = 0;
+    for (; nextId < 200; ++nextId) {
+        assert.writeOK(coll.insert(randomDoc(nextId)));
+    }
+
+    assert.commandWorked(db.createView(groupView.getName(), coll.getName(), groupPipeline));
+    assert.commandWorked(db.runCommand({
+        create: groupView.getName() + "_materialized",
+        viewOn: coll.getName(),
+        pipeline: groupPipeline,
+        materialized: true
+    }));
+    assert.commandWorked(db.runCommand({
+        create: matchView.getName(),
+        viewOn: coll.getName(),
+        pipeline: matchPipeline,
+        materialized: true
+    }));
+    const materializedGroupView = db[groupView.getName() + "_materialized"];
+
+    // A materialized view is built in the write unit of work that creates it, so it cannot be
+    // built from a collection larger than materializedViewMaxBuildSourceBytes.
+    const maxBuildSourceBytes = assert
+                                    .commandWorked(db.adminCommand(
+                                        {getParameter: 1, materializedViewMaxBuildSourceBytes: 1}))
+                                    .materializedViewMaxBuildSourceBytes;
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, materializedViewMaxBuildSourceBytes: 1}));
+    assert.commandFailedWithCode(db.runCommand({
+        create: "materialized_views_too_large",
+        viewOn: coll.getName(),
+        pipeline: matchPipeline,
+        materialized: true
+    }),
+                                 50984);
+    assert.eq(0, db.getCollectionInfos({name: "materialized_views_too_large"}).length);
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, materializedViewMaxBuildSourceBytes: maxBuildSourceBytes}));
+
+    function assertViewsMatch() {
+        const byId = {_id: 1};
+        assert.eq(groupView.find().sort(byId).toArray(),
+                  materializedGroupView.find().sort(byId).toArray());
+        assert.eq(coll.aggregate(matchPipeline.concat([{$sort: byId}])).toArray(),
+                  matchView.find().sort(byId).toArray());
+    }
+
+    assertViewsMatch();
+
+    // The hidden count of each group is not visible through the view.
+    materializedGroupView.find().forEach(doc => assert(!doc.hasOwnProperty("__mvCount"), doc));
+
+    for (let round = 0; round < 5; ++round) {
+        for (let i = 0; i < 20; ++i) {
+            assert.writeOK(coll.insert(randomDoc(nextId++)));
+        }
+        for (let i = 0; i < 20; ++i) {
+            const id = Random.randInt(nextId);
+            assert.writeOK(coll.update({_id: id}, {$set: {price: Random.randInt(20)}}));
+            assert.writeOK(coll.update({_id: id + 1}, randomDoc(id + 1)));
+        }
+        assert.writeOK(coll.remove({_id: {$in: [Random.randInt(nextId), Random.randInt(nextId)]}}));
+        assert.writeOK(coll.remove({category: categories[round % categories.length], qty: 0}));
+        assertViewsMatch();
+    }
+
+    // Groups whose last document goes away disappear from the view.
+    assert.writeOK(coll.remove({category: "a"}));
+    assertViewsMatch();
+    assert.eq(0, materializedGroupView.find({_id: "a"}).itcount());
+
+    // Only pipelines which can be maintained incrementally may define a materialized view.
+    for (let pipeline of[[{$sort: {price: 1}}],
+                          [{$group: {_id: "$category", avg: {$avg: "$price"}}}],
+                          [{$group: {_id: "$category", n: {$sum: 1}}}, {$match: {n: 1}}],
+                          [{$project: {_id: 0, price: 1}}]]) {
+        assert.commandFailedWithCode(db.runCommand({
+            create: "materialized_views_invalid",
+            viewOn: coll.getName(),
+            pipeline: pipeline,
+            materialized: true
+        }),
+                                     ErrorCodes.OptionNotSupportedOnView,
+                                     tojson(pipeline));
+    }
+    assert.commandFailedWithCode(
+        db.runCommand({collMod: matchView.getName(), viewOn: coll.getName(), pipeline: []}),
+        ErrorCodes.OptionNotSupportedOnView);
+
+    // Dropping the collection empties the views on it.
+    assert(coll.drop());
+    assertViewsMatch();
+    assert.eq(0, materializedGroupView.find().itcount());
+
+    // Dropping a materialized view drops its backing collection.
+    const backingName = "system.materialized." + matchView.getName();
+    assert.eq(1, db.getCollectionInfos({name: backingName}).length);
+    assert(matchView.drop());
+    assert.eq(0, db.getCollectionInfos({name: backingName}).length);
+
+    assert(groupView.drop());
+    assert(materializedGroupView.drop());
+}());
@@ -0,0 +1,79 @@
+/**
+ * Tests that a $text search sorted by text score with a limit returns the same scores whether or
+ * not the TEXT_OR stage is allowed to stop reading the text index early, and that explain reports
+ * when it did.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+    const coll = db.text_search_top_k;
+    coll.drop();
+
+    const words = ["apple", "banana", "cherry", "grape", "lemon", "mango", "orange", "peach"];
+
+    Random.setRandomSeed();
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; ++i) {
+        const numWords = 1 + Random.randInt(12);
+        let text = [];
+        for (let j = 0; j < numWords; ++j) {
+            text.push(words[Random.randInt(words.length)]);
+        }
+        bulk.insert({_id: i, title: words[i % words.length], body: text.join(" ")});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({title: "text", body: "text"}, {weights: {title: 5}}));
+
+    function setTextTopK(enabled) {
+        assert.commandWorked(
+            db.adminCommand({setParameter: 1, internalQueryPlannerEnableTextTopK: enabled}));
+    }
+
+    function topScores(search, limit) {
+        return coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+            .sort({score: {$meta: "textScore"}})
+            .limit(limit)
+            .toArray()
+            .map(doc => doc.score);
+    }
+
+    const searches = [
+        "apple",
+        "apple banana",
+        "cherry grape lemon mango",
+        "peach -orange",
+        "\"apple banana\" cherry",
+        "kiwi",
+        "kiwi apple",
+    ];
+
+    try {
+        for (let search of searches) {
+            for (let limit of[1, 5, 20, 2000]) {
+                setTextTopK(false);
+                const expected = topScores(search, limit);
+                setTextTopK(true);
+                const actual = topScores(search, limit);
+                assert.eq(expected, actual, `search: ${search}, limit: ${limit}`);
+            }
+        }
+
+        // With a single term, the first posting read is the highest scoring document, so the
+        // stage can stop straight after it.
+        const explain = coll.find({$text: {$search: "apple"}}, {score: {$meta: "textScore"}})
+                            .sort({score: {$meta: "textScore"}})
+                            .limit(1)
+                            .explain("executionStats");
+        const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+        assert.neq(null, textOr, tojson(explain));
+        assert.eq(1, textOr.limit, tojson(textOr));
+        assert.eq(true, textOr.stoppedEarly, tojson(textOr));
+        assert.eq(1, textOr.termScansCutShort, tojson(textOr));
+        assert.lt(textOr.docsExamined, coll.find({$text: {$search: "apple"}}).itcount(),
+                  tojson(textOr));
+    } finally {
+        setTextTopK(true);
+    }
+}());
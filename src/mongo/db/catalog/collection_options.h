@@ -149,5 +149,7 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+    // Whether the results of this view are stored and kept up to date by the server.
+    bool materialized = false;
 };
 }
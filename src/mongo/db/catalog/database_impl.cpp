@@ -69,6 +69,8 @@
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/system_index.h"
+#include "mongo/db/views/materialized_view.h"
+#include "mongo/db/views/materialized_view_maintenance.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/cannot_implicitly_create_collection_info.h"
@@ -437,8 +439,14 @@ void DatabaseImpl::getStats(OperationContext* opCtx, BSONObjBuilder* output, dou
 }
 
 Status DatabaseImpl::dropView(OperationContext* opCtx, StringData fullns) {
+    auto view = _views.lookup(opCtx, fullns);
     Status status = _views.dropView(opCtx, NamespaceString(fullns));
     Top::get(opCtx->getServiceContext()).collectionDropped(fullns);
+
+    // Secondaries drop the backing collection of a materialized view through replication.
+    if (status.isOK() && view && view->isMaterialized() && opCtx->writesAreReplicated()) {
+        status = dropCollectionEvenIfSystem(opCtx, view->backingNss(), {});
+    }
     return status;
 }
 
@@ -468,6 +476,14 @@ Status DatabaseImpl::dropCollection(OperationContext* opCtx,
         }
     }
 
+    // Materialized views on the collection become empty, like any view on a missing collection.
+    // This cannot be left to the OpObserver, which must not write while the drop is logged.
+    if (ViewDefinition::anyMaterialized() && opCtx->writesAreReplicated() && !nss.isSystem()) {
+        for (auto&& view : _views.lookupMaterializedViewsOn(opCtx, nss)) {
+            emptyMaterializedView(opCtx, _this, *view);
+        }
+    }
+
     return dropCollectionEvenIfSystem(opCtx, nss, dropOpTime);
 }
 
@@ -764,7 +780,33 @@ Status DatabaseImpl::createView(OperationContext* opCtx,
         return Status(ErrorCodes::InvalidNamespace,
                       str::stream() << "invalid namespace name for a view: " + nss.toString());
 
-    return _views.createView(opCtx, nss, viewOnNss, BSONArray(options.pipeline), options.collation);
+    // Fill the backing collection of a materialized view before the view becomes visible, so that
+    // it is never read half built. Secondaries receive the backing collection through replication.
+    if (options.materialized && opCtx->writesAreReplicated()) {
+        std::unique_ptr<CollatorInterface> collator;
+        if (!options.collation.isEmpty()) {
+            auto collatorWithStatus = CollatorFactoryInterface::get(opCtx->getServiceContext())
+                                          ->makeFromBSON(options.collation);
+            if (!collatorWithStatus.isOK())
+                return collatorWithStatus.getStatus();
+            collator = std::move(collatorWithStatus.getValue());
+        }
+
+        ViewDefinition view(
+            nss.db(), nss.coll(), options.viewOn, options.pipeline, std::move(collator), true);
+        Status status = validateMaterializedViewPipeline(view.pipeline());
+        if (!status.isOK())
+            return status;
+
+        createMaterializedViewBackingCollection(opCtx, _this, view);
+    }
+
+    return _views.createView(opCtx,
+                             nss,
+                             viewOnNss,
+                             BSONArray(options.pipeline),
+                             options.collation,
+                             options.materialized);
 }
 
 Collection* DatabaseImpl::createCollection(OperationContext* opCtx,
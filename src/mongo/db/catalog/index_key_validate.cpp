@@ -92,6 +92,7 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kTextVersionFieldName,
     IndexDescriptor::kUniqueFieldName,
     IndexDescriptor::kWeightsFieldName,
+    IndexDescriptor::kWildcardVersionFieldName,
     // Index creation under legacy writeMode can result in an index spec with an _id field.
     "_id"};
 
@@ -434,6 +435,35 @@ StatusWith<BSONObj> validateIndexSpec(
                 return ex.toStatus(str::stream() << "Failed to parse: "
                                                  << IndexDescriptor::kPathProjectionFieldName);
             }
+        } else if (IndexDescriptor::kWildcardVersionFieldName == indexSpecElemFieldName) {
+            const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+            if (IndexNames::findPluginName(key) != IndexNames::WILDCARD) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "The field '" << IndexDescriptor::kWildcardVersionFieldName
+                                      << "' is only allowed in an '"
+                                      << IndexNames::WILDCARD
+                                      << "' index"};
+            }
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '" << IndexDescriptor::kWildcardVersionFieldName
+                                      << "' must be a number, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+            const auto requestedVersion = representAs<int>(indexSpecElem.number());
+            if (!requestedVersion || (*requestedVersion != WILDCARD_INDEX_VERSION_1 &&
+                                      *requestedVersion != WILDCARD_INDEX_VERSION_2)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "unsupported wildcard index version { "
+                                      << IndexDescriptor::kWildcardVersionFieldName
+                                      << " : "
+                                      << indexSpecElem
+                                      << " }, only versions: ["
+                                      << WILDCARD_INDEX_VERSION_1
+                                      << ","
+                                      << WILDCARD_INDEX_VERSION_2
+                                      << "] are supported"};
+            }
         } else {
             // We can assume field name is valid at this point. Validation of fieldname is handled
             // prior to this in validateIndexSpecFieldNames().
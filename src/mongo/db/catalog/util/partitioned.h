@@ -277,6 +277,15 @@ public:
         }
         void operator*() && = delete;
 
+        /**
+         * Returns the lock held on this partition, so that a condition variable whose state is
+         * protected by the partition's mutex can wait on it.
+         */
+        stdx::unique_lock<stdx::mutex>& lock() & {
+            return _partitionLock;
+        }
+        void lock() && = delete;
+
     private:
         friend class Partitioned;
 
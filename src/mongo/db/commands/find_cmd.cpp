@@ -44,6 +44,8 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/point_read.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/server_parameters.h"
@@ -263,6 +265,14 @@ public:
             const int ntoskip = -1;
             beginQueryOp(opCtx, nss, _request.body, ntoreturn, ntoskip);
 
+            // A find for a single key of a unique index does not need a query plan.
+            if (!ctx->getView() && ctx->getCollection()) {
+                if (auto pointRead = PointRead::make(opCtx, ctx->getCollection(), *qr)) {
+                    runPointRead(opCtx, ctx->getCollection(), nss, &*pointRead, result);
+                    return;
+                }
+            }
+
             // Finish the parsing step by using the QueryRequest to create a CanonicalQuery.
             const ExtensionsCallbackReal extensionsCallback(opCtx, &nss);
             const boost::intrusive_ptr<ExpressionContext> expCtx;
@@ -398,6 +408,48 @@ public:
         }
 
     private:
+        /**
+         * Runs 'pointRead' and generates the response, which never has an open cursor, without
+         * building a PlanExecutor.
+         */
+        void runPointRead(OperationContext* opCtx,
+                          Collection* collection,
+                          const NamespaceString& nss,
+                          PointRead* pointRead,
+                          rpc::ReplyBuilderInterface* result) {
+            auto curOp = CurOp::get(opCtx);
+            {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                curOp->setPlanSummary_inlock(pointRead->getPlanSummary());
+            }
+
+            CurOpFailpointHelpers::waitWhileFailPointEnabled(
+                &waitInFindBeforeMakingBatch, opCtx, "waitInFindBeforeMakingBatch");
+
+            CursorResponseBuilder::Options options;
+            options.isInitialResponse = true;
+            CursorResponseBuilder firstBatch(result, options);
+            const long long numResults = pointRead->execute(opCtx, collection, &firstBatch);
+
+            CollectionShardingState::get(opCtx, nss)->checkShardVersionOrThrow(opCtx);
+
+            // Fill out curop the same way endQueryOp() does for an exhausted PlanExecutor.
+            curOp->debug().nreturned = numResults;
+            curOp->debug().cursorid = -1;
+            curOp->debug().cursorExhausted = true;
+            PlanSummaryStats summaryStats;
+            summaryStats.totalKeysExamined = pointRead->getKeysExamined();
+            summaryStats.totalDocsExamined = pointRead->getDocsExamined();
+            summaryStats.indexesUsed.insert(pointRead->getIndex()->indexName());
+            curOp->debug().setPlanSummaryMetrics(summaryStats);
+            collection->infoCache()->notifyOfQuery(opCtx, summaryStats.indexesUsed);
+            if (curOp->shouldDBProfile()) {
+                curOp->debug().execStats = pointRead->getStats();
+            }
+
+            firstBatch.done(0, nss.ns());
+        }
+
         const OpMsgRequest& _request;
         const StringData _dbName;
     };
@@ -32,6 +32,12 @@
 
 #include "mongo/db/commands/mr.h"
 
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/client/connpool.h"
@@ -58,6 +64,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -76,6 +83,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/text.h"
 
 namespace mongo {
 
@@ -161,6 +169,172 @@ void assertCollectionNotNull(const NamespaceString& nss, AutoT& autoT) {
     uassert(18698, "Collection unexpectedly disappeared: " + nss.ns(), autoT.getCollection());
 }
 
+// Lists of tuples reduced together in one JS invocation are kept under this many bytes, so that
+// both the arguments and the array of results stay well inside the maximum BSON size.
+const int kMaxReduceBatchBytes = BSONObjMaxUserSize / 4;
+
+// Map and reduce functions with longer sources are always applied in the JS engine.
+const size_t kMaxNativeFunctionSourceLength = 1024;
+
+/**
+ * Matches the source of a JS function against the few simple forms that are applied natively, one
+ * token at a time. Whitespace before each token is skipped.
+ */
+class JSSourceMatcher {
+public:
+    explicit JSSourceMatcher(StringData source) : _source(source) {}
+
+    /**
+     * Consumes 'token' if it comes next.
+     */
+    bool consume(StringData token) {
+        _skipSpace();
+        if (!_source.substr(_pos).startsWith(token))
+            return false;
+        _pos += token.size();
+        return true;
+    }
+
+    /**
+     * Consumes a JS identifier, such as a field or argument name, into 'out'.
+     */
+    bool consumeIdentifier(std::string* out) {
+        _skipSpace();
+        if (_pos == _source.size())
+            return false;
+        if (!std::isalpha(_peek()) && _peek() != '_' && _peek() != '$')
+            return false;
+        *out = _consumeWordChars().toString();
+        return true;
+    }
+
+    /**
+     * Consumes the optional name of a function.
+     */
+    void consumeFunctionName() {
+        _skipSpace();
+        _consumeWordChars();
+    }
+
+    /**
+     * Consumes a number of the form -?\d+(\.\d+)? into 'out'. Returns false without consuming
+     * anything if the integer part has a leading zero, which makes it an octal literal in JS, or
+     * if the number is too large or too small to be represented exactly as in JS.
+     */
+    bool consumeNumber(double* out) {
+        _skipSpace();
+        const size_t begin = _pos;
+        if (_pos < _source.size() && _peek() == '-')
+            ++_pos;
+        const size_t integerBegin = _pos;
+        if (!_consumeDigits() || (_source[integerBegin] == '0' && _pos - integerBegin > 1)) {
+            _pos = begin;
+            return false;
+        }
+        if (_pos < _source.size() && _peek() == '.') {
+            // The fraction must have digits, or the '.' is not part of the number.
+            ++_pos;
+            if (!_consumeDigits())
+                --_pos;
+        }
+
+        const std::string number = _source.substr(begin, _pos - begin).toString();
+        errno = 0;
+        const double value = std::strtod(number.c_str(), nullptr);
+        if (errno == ERANGE || !std::isfinite(value)) {
+            _pos = begin;
+            return false;
+        }
+        *out = value;
+        return true;
+    }
+
+    /**
+     * Consumes the spaces and tabs separating 'return' from its expression. A line break there
+     * would make the function return undefined, so it is not allowed.
+     */
+    bool consumeReturnSeparator() {
+        const size_t begin = _pos;
+        while (_pos < _source.size() && (_peek() == ' ' || _peek() == '\t'))
+            ++_pos;
+        return _pos > begin && _pos < _source.size() && !_isSpace(_peek());
+    }
+
+    bool atEnd() {
+        _skipSpace();
+        return _pos == _source.size();
+    }
+
+private:
+    static bool _isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    static bool _isWordChar(char c) {
+        return std::isalnum(c) || c == '_' || c == '$';
+    }
+
+    unsigned char _peek() const {
+        return _source[_pos];
+    }
+
+    void _skipSpace() {
+        while (_pos < _source.size() && _isSpace(_peek()))
+            ++_pos;
+    }
+
+    StringData _consumeWordChars() {
+        const size_t begin = _pos;
+        while (_pos < _source.size() && _isWordChar(_peek()))
+            ++_pos;
+        return _source.substr(begin, _pos - begin);
+    }
+
+    bool _consumeDigits() {
+        const size_t begin = _pos;
+        while (_pos < _source.size() && std::isdigit(_peek()))
+            ++_pos;
+        return _pos > begin;
+    }
+
+    const StringData _source;
+    size_t _pos = 0;
+};
+
+/**
+ * Returns true if 'elem' is present and would be emitted unchanged, apart from a NumberInt
+ * becoming a double, had the map function read it from 'this' in the JS engine.
+ */
+bool isNativeMapValue(const BSONElement& elem) {
+    switch (elem.type()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case Bool:
+        case jstNULL:
+        case jstOID:
+            return true;
+        case String:
+            return isValidUTF8(elem.str());
+        case Date: {
+            // Dates beyond the range of a JS Date do not survive the round trip.
+            const long long millis = elem.date().toMillisSinceEpoch();
+            return millis >= -8640000000000000LL && millis <= 8640000000000000LL;
+        }
+        default:
+            return false;
+    }
+}
+
+void appendNativeMapValue(BSONObjBuilder* b, StringData fieldName, const BSONElement& elem) {
+    if (elem.type() == NumberInt) {
+        b->append(fieldName, static_cast<double>(elem._numberInt()));
+    } else {
+        b->appendAs(elem, fieldName);
+    }
+}
+
 }  // namespace
 
 AtomicUInt32 Config::JOB_NUMBER;
@@ -185,18 +359,64 @@ void JSFunction::init(State* state) {
     _scope->setFunction(_type.c_str(), _code.c_str());
 }
 
+std::vector<BSONObj> Reducer::reduceBatch(const std::vector<const BSONList*>& batch) {
+    std::vector<BSONObj> results;
+    results.reserve(batch.size());
+    for (auto&& tuples : batch) {
+        results.push_back(reduce(*tuples));
+    }
+    return results;
+}
+
 void JSMapper::init(State* state) {
     _func.init(state);
     _params = state->config().mapParams;
+
+    // Calls the map function, installed as _map by JSFunction::init(), on each of the documents.
+    _mapBatch = _func.scope()->createFunction(
+        "function(docs, params) {"
+        "  for (var i = 0; i < docs.length; i++) {"
+        "    _map.apply(docs[i], params);"
+        "  }"
+        "}");
+    massert(50977, "error initializing JavaScript map batch function", _mapBatch != 0);
 }
 
 /**
- * Applies the map function to an object, which should internally call emit()
+ * Buffers an owned object for the map function, which should internally call emit() once the
+ * batch is flushed
  */
 void JSMapper::map(const BSONObj& o) {
+    if (!_batch.empty() && _batchBytes + o.objsize() > BSONObjMaxUserSize / 2)
+        flush();
+
+    _batch.push_back(o);
+    _batchBytes += o.objsize();
+}
+
+/**
+ * Applies the map function to the buffered objects with a single invocation
+ */
+void JSMapper::flush() {
+    if (_batch.empty())
+        return;
+
+    BSONObjBuilder argsBuilder(_batchBytes + _params.objsize() + 64);
+    {
+        BSONArrayBuilder docs(argsBuilder.subarrayStart("docs"));
+        for (auto&& doc : _batch) {
+            docs.append(doc);
+        }
+    }
+    argsBuilder.appendArray("params", _params);
+    BSONObj args = argsBuilder.obj();
+
+    _batch.clear();
+    _batchBytes = 0;
+
     Scope* s = _func.scope();
     verify(s);
-    if (s->invoke(_func.func(), &_params, &o, 0, true))
+    if (s->invoke(_mapBatch, &args, 0, 0, true))
         uasserted(9014, str::stream() << "map invoke failed: " << s->getError());
 }
 
@@ -220,6 +440,18 @@ BSONObj JSFinalizer::finalize(const BSONObj& o) {
 
 void JSReducer::init(State* state) {
     _func.init(state);
+
+    // Calls the reduce function, installed as _reduce by JSFunction::init(), on each [key, values]
+    // pair and returns the array of results.
+    _reduceBatchFunc = _func.scope()->createFunction(
+        "function(groups) {"
+        "  var results = [];"
+        "  for (var i = 0; i < groups.length; i++) {"
+        "    results.push(_reduce(groups[i][0], groups[i][1]));"
+        "  }"
+        "  return results;"
+        "}");
+    massert(50978, "error initializing JavaScript reduce batch function", _reduceBatchFunc != 0);
 }
 
 /**
@@ -339,6 +571,285 @@ void JSReducer::_reduce(const BSONList& tuples, BSONObj& key, int& endSizeEstima
     _reduce(x, key, endSizeEstimate);
 }
 
+std::vector<BSONObj> JSReducer::reduceBatch(const std::vector<const BSONList*>& batch) {
+    std::vector<BSONObj> results;
+    results.reserve(batch.size());
+
+    size_t begin = 0;
+    int batchBytes = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        int bytes = 0;
+        for (auto&& tuple : *batch[i]) {
+            bytes += tuple.objsize();
+        }
+
+        if (batchBytes + bytes > kMaxReduceBatchBytes) {
+            _reduceBatch(batch, begin, i, &results);
+            begin = i;
+            batchBytes = 0;
+        }
+
+        if (bytes > kMaxReduceBatchBytes) {
+            // Too large to share an invocation, and possibly too large for a single one, which
+            // _reduce() takes care of.
+            results.push_back(reduce(*batch[i]));
+            begin = i + 1;
+            continue;
+        }
+
+        batchBytes += bytes;
+    }
+    _reduceBatch(batch, begin, batch.size(), &results);
+
+    return results;
+}
+
+void JSReducer::_reduceBatch(const std::vector<const BSONList*>& batch,
+                             size_t begin,
+                             size_t end,
+                             std::vector<BSONObj>* out) {
+    if (begin == end)
+        return;
+
+    if (end - begin == 1) {
+        out->push_back(reduce(*batch[begin]));
+        return;
+    }
+
+    // need to build the reduce args: ( [[key, [values]], ...] )
+    BSONObjBuilder argsBuilder;
+    {
+        BSONArrayBuilder groups(argsBuilder.subarrayStart("groups"));
+        for (size_t i = begin; i < end; ++i) {
+            BSONArrayBuilder group(groups.subarrayStart());
+            group.append(batch[i]->front().firstElement());
+            BSONArrayBuilder values(group.subarrayStart());
+            for (auto&& tuple : *batch[i]) {
+                BSONObjIterator j(tuple);
+                j.next();
+                values.append(j.next());
+            }
+        }
+    }
+    BSONObj args = argsBuilder.obj();
+
+    Scope* s = _func.scope();
+    s->invokeSafe(_reduceBatchFunc, &args, 0);
+    numReduces += end - begin;
+
+    BSONObj results = s->getObject("__returnValue");
+    BSONObjIterator it(results);
+    for (size_t i = begin; i < end; ++i) {
+        BSONElement result = it.next();
+        uassert(50979, "reduce -> multiple not supported yet", result.type() != Array);
+
+        BSONObjBuilder b(batch[i]->front().firstElement().size() + result.size() + 16);
+        b.appendAs(batch[i]->front().firstElement(), "0");
+        b.appendAs(result, "1");
+        out->push_back(b.obj());
+    }
+}
+
+std::unique_ptr<NativeMapper> NativeMapper::parse(const BSONElement& code) {
+    if (code.type() != Code && code.type() != String)
+        return nullptr;
+
+    const StringData source = code.valueStringData();
+    if (source.size() > kMaxNativeFunctionSourceLength)
+        return nullptr;
+
+    // function() { emit(this.<field>, <this.<field> | number>); }
+    std::unique_ptr<NativeMapper> mapper(new NativeMapper(code));
+    JSSourceMatcher matcher(source);
+    if (!matcher.consume("function"))
+        return nullptr;
+    matcher.consumeFunctionName();
+    if (!matcher.consume("(") || !matcher.consume(")") || !matcher.consume("{") ||
+        !matcher.consume("emit") || !matcher.consume("(") || !matcher.consume("this") ||
+        !matcher.consume(".") || !matcher.consumeIdentifier(&mapper->_keyField) ||
+        !matcher.consume(","))
+        return nullptr;
+    if (matcher.consume("this")) {
+        if (!matcher.consume(".") || !matcher.consumeIdentifier(&mapper->_valueField))
+            return nullptr;
+    } else {
+        double value;
+        if (!matcher.consumeNumber(&value))
+            return nullptr;
+        mapper->_value = BSON("" << value);
+    }
+    if (!matcher.consume(")"))
+        return nullptr;
+    matcher.consume(";");
+    if (!matcher.consume("}") || !matcher.atEnd())
+        return nullptr;
+
+    // Names such as __proto__ resolve to something other than a field of the document in JS.
+    if (str::startsWith(mapper->_keyField, "__") || str::startsWith(mapper->_valueField, "__"))
+        return nullptr;
+
+    return mapper;
+}
+
+void NativeMapper::init(State* state) {
+    // The JS map function is still needed for documents the native one cannot handle.
+    _js.init(state);
+    _state = state;
+}
+
+void NativeMapper::map(const BSONObj& o) {
+    BSONElement key = o.getField(_keyField);
+    BSONElement value = _valueField.empty() ? _value.firstElement() : o.getField(_valueField);
+    if (!isNativeMapValue(key) || !isNativeMapValue(value)) {
+        _js.map(o);
+        return;
+    }
+
+    // Emit in document order, after any documents handed to the JS map function so far.
+    _js.flush();
+
+    BSONObjBuilder b(key.size() + value.size() + 16);
+    appendNativeMapValue(&b, "0", key);
+    appendNativeMapValue(&b, "1", value);
+    fastEmit(b.obj(), _state);
+}
+
+void NativeMapper::flush() {
+    _js.flush();
+}
+
+std::unique_ptr<NativeReducer> NativeReducer::parse(const BSONElement& code) {
+    if (code.type() != Code && code.type() != String)
+        return nullptr;
+
+    const StringData source = code.valueStringData();
+    if (source.size() > kMaxNativeFunctionSourceLength)
+        return nullptr;
+
+    // function(key, values) { return <Array.sum(values) | Math.<min|max>.apply(null, values)>; }
+    JSSourceMatcher matcher(source);
+    std::string key;
+    std::string values;
+    if (!matcher.consume("function"))
+        return nullptr;
+    matcher.consumeFunctionName();
+    if (!matcher.consume("(") || !matcher.consumeIdentifier(&key) || !matcher.consume(",") ||
+        !matcher.consumeIdentifier(&values) || !matcher.consume(")") || !matcher.consume("{") ||
+        !matcher.consume("return") || !matcher.consumeReturnSeparator())
+        return nullptr;
+
+    Op op = Op::kSum;
+    if (matcher.consume("Array")) {
+        if (!matcher.consume(".") || !matcher.consume("sum") || !matcher.consume("("))
+            return nullptr;
+    } else {
+        if (!matcher.consume("Math") || !matcher.consume("."))
+            return nullptr;
+        if (matcher.consume("min")) {
+            op = Op::kMin;
+        } else if (matcher.consume("max")) {
+            op = Op::kMax;
+        } else {
+            return nullptr;
+        }
+        if (!matcher.consume(".") || !matcher.consume("apply") || !matcher.consume("(") ||
+            !(matcher.consume("null") || matcher.consume("Math")) || !matcher.consume(","))
+            return nullptr;
+    }
+
+    std::string argument;
+    if (!matcher.consumeIdentifier(&argument) || argument != values || !matcher.consume(")"))
+        return nullptr;
+    matcher.consume(";");
+    if (!matcher.consume("}") || !matcher.atEnd())
+        return nullptr;
+    return std::unique_ptr<NativeReducer>(new NativeReducer(op, code));
+}
+
+void NativeReducer::init(State* state) {
+    // The JS reduce function is still needed for values that are not numbers, and is the one
+    // applied in JS mode.
+    _js.init(state);
+}
+
+bool NativeReducer::_reduceNumbers(const BSONList& tuples, double* result) const {
+    bool first = true;
+    for (auto&& tuple : tuples) {
+        BSONObjIterator it(tuple);
+        it.next();
+        BSONElement elem = it.next();
+        if (elem.type() != NumberInt && elem.type() != NumberLong && elem.type() != NumberDouble)
+            return false;
+
+        // Mirror Array.sum(), which adds the values in order starting from the first, and
+        // Math.min() and Math.max(), which propagate NaN and order -0 before +0.
+        const double value = elem.numberDouble();
+        if (first) {
+            *result = value;
+            first = false;
+        } else if (_op == Op::kSum) {
+            *result += value;
+        } else if (std::isnan(*result) || std::isnan(value)) {
+            *result = std::numeric_limits<double>::quiet_NaN();
+        } else if (_op == Op::kMin) {
+            if (value < *result || (value == *result && std::signbit(value)))
+                *result = value;
+        } else {
+            if (value > *result || (value == *result && !std::signbit(value)))
+                *result = value;
+        }
+    }
+    return true;
+}
+
+/**
+ * Reduces a list of tuple objects (key, value) to a single tuple {"0": key, "1": value}
+ */
+BSONObj NativeReducer::reduce(const BSONList& tuples) {
+    if (tuples.size() <= 1)
+        return tuples[0];
+
+    double result;
+    if (!_reduceNumbers(tuples, &result)) {
+        const long long jsReduces = _js.numReduces;
+        BSONObj res = _js.reduce(tuples);
+        numReduces += _js.numReduces - jsReduces;
+        return res;
+    }
+    ++numReduces;
+
+    BSONObjBuilder b;
+    b.appendAs(tuples[0].firstElement(), "0");
+    b.append("1", result);
+    return b.obj();
+}
+
+/**
+ * Reduces a list of tuple objects (key, value) to a single tuple {_id: key, value: val}
+ * Also applies a finalizer method if present.
+ */
+BSONObj NativeReducer::finalReduce(const BSONList& tuples, Finalizer* finalizer) {
+    double result;
+    if (tuples.size() == 1 || !_reduceNumbers(tuples, &result)) {
+        const long long jsReduces = _js.numReduces;
+        BSONObj res = _js.finalReduce(tuples, finalizer);
+        numReduces += _js.numReduces - jsReduces;
+        return res;
+    }
+    ++numReduces;
+
+    BSONObjBuilder b;
+    b.appendAs(tuples[0].firstElement(), "_id");
+    b.append("value", result);
+    BSONObj res = b.obj();
+
+    if (finalizer) {
+        res = finalizer->finalize(res);
+    }
+
+    return res;
+}
+
 Config::Config(const string& _dbname, const BSONObj& cmdObj) {
     dbname = _dbname;
     uassert(ErrorCodes::TypeMismatch,
@@ -395,8 +906,18 @@ Config::Config(const string& _dbname, const BSONObj& cmdObj) {
         if (cmdObj["scope"].type() == Object)
             scopeSetup = cmdObj["scope"].embeddedObjectUserCheck().getOwned();
 
-        mapper.reset(new JSMapper(cmdObj["map"]));
-        reducer.reset(new JSReducer(cmdObj["reduce"]));
+        // Map and reduce functions of a few common shapes are applied in C++ rather than in the
+        // JS engine. In JS mode the emitted values are kept in the JS engine, so it is used
+        // throughout.
+        if (internalQueryMapReduceEnableNativeFunctions.load() && !jsMode &&
+            scopeSetup.isEmpty()) {
+            mapper = NativeMapper::parse(cmdObj["map"]);
+            reducer = NativeReducer::parse(cmdObj["reduce"]);
+        }
+        if (!mapper)
+            mapper.reset(new JSMapper(cmdObj["map"]));
+        if (!reducer)
+            reducer.reset(new JSReducer(cmdObj["reduce"]));
         if (cmdObj["finalize"].type() && cmdObj["finalize"].trueValue())
             finalizer.reset(new JSFinalizer(cmdObj["finalize"]));
 
@@ -1238,6 +1759,7 @@ void State::reduceInMemory() {
     long nSize = 0;
     _dupCount = 0;
 
+    std::vector<const BSONList*> toReduce;
     for (InMemory::iterator i = _temp->begin(); i != _temp->end(); ++i) {
         BSONList& all = i->second;
 
@@ -1251,12 +1773,15 @@ void State::reduceInMemory() {
                 nSize += _add(n.get(), all[0]);
             }
         } else if (all.size() > 1) {
-            // several values, reduce and add to map
-            BSONObj res = _config.reducer->reduce(all);
-            nSize += _add(n.get(), res);
+            // several values, reduce together with the other keys below and add to map
+            toReduce.push_back(&all);
         }
     }
 
+    for (auto&& res : _config.reducer->reduceBatch(toReduce)) {
+        nSize += _add(n.get(), res);
+    }
+
     // swap maps
     _temp.reset(n.release());
     _size = nSize;
@@ -1539,6 +2064,14 @@ public:
                     //
                     numInputs++;
                     if (numInputs % 100 == 0) {
+                        // The mapper may buffer documents, which must be mapped before the
+                        // emitted values are reduced.
+                        if (config.verbose)
+                            mt.reset();
+                        config.mapper->flush();
+                        if (config.verbose)
+                            mapTime += mt.micros();
+
                         Timer t;
 
                         // TODO: As an optimization, we might want to do the save/restore
@@ -1571,6 +2104,13 @@ public:
                                             << WorkingSetCommon::toStatusString(o));
                 }
 
+                // map the documents still buffered by the mapper
+                if (config.verbose)
+                    mt.reset();
+                config.mapper->flush();
+                if (config.verbose)
+                    mapTime += mt.micros();
+
                 // Record the indexes used by the PlanExecutor.
                 PlanSummaryStats stats;
                 Explain::getSummaryStats(*exec, &stats);
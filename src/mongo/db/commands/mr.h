@@ -60,6 +60,12 @@ public:
 
     virtual void map(const BSONObj& o) = 0;
 
+    /**
+     * Applies the map function to any documents that map() has buffered rather than mapped
+     * straight away. Must be called before the emitted values are reduced or counted.
+     */
+    virtual void flush() {}
+
 protected:
     Mapper() = default;
 };
@@ -92,6 +98,12 @@ public:
     /** this means its a final reduce, even if there is no finalizer */
     virtual BSONObj finalReduce(const BSONList& tuples, Finalizer* finalizer) = 0;
 
+    /**
+     * Reduces each list of tuples in 'batch' to a single tuple {"0": key, "1": value}, returned
+     * in the same order. The default implementation calls reduce() on each list in turn.
+     */
+    virtual std::vector<BSONObj> reduceBatch(const std::vector<const BSONList*>& batch);
+
     long long numReduces;
 };
 
@@ -129,15 +141,24 @@ private:
     ScriptingFunction _func;
 };
 
+/**
+ * Buffers the documents passed to map() and applies the map function to a whole batch of them in
+ * a single JS invocation, to save the cost of crossing into the JS engine once per document.
+ */
 class JSMapper : public Mapper {
 public:
     JSMapper(const BSONElement& code) : _func("_map", code) {}
     virtual void map(const BSONObj& o);
+    virtual void flush();
     virtual void init(State* state);
 
 private:
     JSFunction _func;
     BSONObj _params;
+
+    ScriptingFunction _mapBatch = 0;
+    std::vector<BSONObj> _batch;
+    int _batchBytes = 0;
 };
 
 class JSReducer : public Reducer {
@@ -148,6 +169,12 @@ public:
     virtual BSONObj reduce(const BSONList& tuples);
     virtual BSONObj finalReduce(const BSONList& tuples, Finalizer* finalizer);
 
+    /**
+     * Reduces the lists of tuples in 'batch' with a single JS invocation, except for lists too
+     * large to share an invocation, which are reduced on their own.
+     */
+    virtual std::vector<BSONObj> reduceBatch(const std::vector<const BSONList*>& batch);
+
 private:
     /**
      * result in "__returnValue"
@@ -156,7 +183,17 @@ private:
     */
     void _reduce(const BSONList& values, BSONObj& key, int& endSizeEstimate);
 
+    /**
+     * Reduces the lists batch[begin, end) in one JS invocation, appending a tuple per list to
+     * 'out'.
+     */
+    void _reduceBatch(const std::vector<const BSONList*>& batch,
+                      size_t begin,
+                      size_t end,
+                      std::vector<BSONObj>* out);
+
     JSFunction _func;
+    ScriptingFunction _reduceBatchFunc = 0;
 };
 
 class JSFinalizer : public Finalizer {
@@ -171,6 +208,68 @@ private:
     JSFunction _func;
 };
 
+// ------------  native function implementations -----------
+
+/**
+ * Map function of the form 'function() { emit(this.<field>, <this.<field> | number>); }', applied
+ * in C++. Documents where either field is missing or holds a type that would not come back out of
+ * the JS engine unchanged are handed to the JS map function instead.
+ */
+class NativeMapper : public Mapper {
+public:
+    /**
+     * Returns a NativeMapper if 'code' is a map function of the recognized form, or nullptr.
+     */
+    static std::unique_ptr<NativeMapper> parse(const BSONElement& code);
+
+    virtual void init(State* state);
+    virtual void map(const BSONObj& o);
+    virtual void flush();
+
+private:
+    NativeMapper(const BSONElement& code) : _js(code) {}
+
+    JSMapper _js;
+    State* _state = nullptr;
+
+    std::string _keyField;
+    // Either '_valueField' is set or the emitted value is the constant '_value'.
+    std::string _valueField;
+    BSONObj _value;
+};
+
+/**
+ * Reduce function returning 'Array.sum(values)', 'Math.min.apply(null, values)' or
+ * 'Math.max.apply(null, values)', applied in C++. Lists of tuples holding a value that is not a
+ * number are handed to the JS reduce function instead.
+ */
+class NativeReducer : public Reducer {
+public:
+    enum class Op { kSum, kMin, kMax };
+
+    /**
+     * Returns a NativeReducer if 'code' is a reduce function of one of the recognized forms, or
+     * nullptr.
+     */
+    static std::unique_ptr<NativeReducer> parse(const BSONElement& code);
+
+    virtual void init(State* state);
+    virtual BSONObj reduce(const BSONList& tuples);
+    virtual BSONObj finalReduce(const BSONList& tuples, Finalizer* finalizer);
+
+private:
+    NativeReducer(Op op, const BSONElement& code) : _op(op), _js(code) {}
+
+    /**
+     * Sets 'result' to the value the JS reduce function would return for 'tuples', or returns
+     * false if any value is not a number.
+     */
+    bool _reduceNumbers(const BSONList& tuples, double* result) const;
+
+    Op _op;
+    JSReducer _js;
+};
+
 // -----------------
 
 class TupleKeyCmp {
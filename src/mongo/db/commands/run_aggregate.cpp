@@ -483,6 +483,7 @@ Status runAggregate(OperationContext* opCtx,
 
         invariant(collatorToUse);
         expCtx = makeExpressionContext(opCtx, request, std::move(*collatorToUse), uuid);
+        const auto memoryTracker = expCtx->memoryTracker;
 
         auto pipeline = uassertStatusOK(Pipeline::parse(request.getPipeline(), expCtx));
 
@@ -531,6 +532,10 @@ Status runAggregate(OperationContext* opCtx,
                     expCtx->getCollator() ? expCtx->getCollator()->clone() : nullptr,
                     uuid);
 
+                // Memory used by the pipeline feeding the exchange is charged to the tracker of
+                // the original ExpressionContext, so the consumers report that tracker as well.
+                expCtx->memoryTracker = memoryTracker;
+
                 // Create a new pipeline for the consumer consisting of a single
                 // DocumentSourceExchange.
                 boost::intrusive_ptr<DocumentSource> consumer =
@@ -563,6 +568,7 @@ Status runAggregate(OperationContext* opCtx,
             auto planSummary = Explain::getPlanSummary(execs[0].get());
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             curOp->setPlanSummary_inlock(std::move(planSummary));
+            curOp->setMemoryTracker_inlock(memoryTracker);
         }
     }
 
@@ -34,8 +34,10 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_internal.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/logger/async_log_writer.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/ramlog.h"
@@ -283,6 +285,13 @@ public:
     }
 } memBase;
 
+ServerStatusMetricField<Counter64> displayAsyncLogWritten("log.async.written",
+                                                          &logger::asyncLogMessagesWritten);
+ServerStatusMetricField<Counter64> displayAsyncLogDropped("log.async.dropped",
+                                                          &logger::asyncLogMessagesDropped);
+ServerStatusMetricField<Counter64> displayAsyncLogBlocked("log.async.blocked",
+                                                          &logger::asyncLogMessagesBlocked);
+
 }  // namespace
 
 }  // namespace mongo
@@ -74,6 +74,34 @@ TEST(Deadlock, Simple) {
     locker2.unlock(resIdA);
 }
 
+TEST(Deadlock, IntentLockGrantedThroughFastPath) {
+    const ResourceId resIdA(RESOURCE_DATABASE, std::string("A"));
+    const ResourceId resIdB(RESOURCE_DATABASE, std::string("B"));
+
+    LockerForTests locker1(MODE_IX);
+    LockerForTests locker2(MODE_IX);
+
+    // Uncontended, so granted without being put on the granted list
+    ASSERT_EQUALS(LOCK_OK, locker1.lockBegin(nullptr, resIdA, MODE_IX));
+    ASSERT_EQUALS(LOCK_OK, locker2.lockBegin(nullptr, resIdB, MODE_X));
+
+    // 1 -> 2
+    ASSERT_EQUALS(LOCK_WAITING, locker1.lockBegin(nullptr, resIdB, MODE_X));
+
+    // 2 -> 1
+    ASSERT_EQUALS(LOCK_WAITING, locker2.lockBegin(nullptr, resIdA, MODE_X));
+
+    DeadlockDetector wfg1(*getGlobalLockManager(), &locker1);
+    ASSERT(wfg1.check().hasCycle());
+
+    DeadlockDetector wfg2(*getGlobalLockManager(), &locker2);
+    ASSERT(wfg2.check().hasCycle());
+
+    // Cleanup, so that LockerImpl doesn't complain about leaked locks
+    locker1.unlock(resIdB);
+    locker2.unlock(resIdA);
+}
+
 TEST(Deadlock, SimpleUpgrade) {
     const ResourceId resId(RESOURCE_DATABASE, std::string("A"));
 
@@ -41,6 +41,7 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
@@ -168,6 +169,56 @@ struct PartitionedLockHead {
     LockRequestList grantedList;
 };
 
+/**
+ * The FastPathLockSlot allows granting and releasing requests in the intent modes MODE_IS and
+ * MODE_IX on an uncontended resource without taking a partition or bucket mutex and without any
+ * hash table lookups.
+ *
+ * Each LockBucket has one slot, which is attached to at most one LockHead of that bucket at a
+ * time. While the slot is enabled for a resource, its LockHead has no granted or pending requests
+ * in a non-intent mode, so any intent mode request is granted by putting it on the list of its
+ * stripe. The stripes are selected by locker and are on separate cache lines, so that lockers
+ * running on different cores do not contend with each other.
+ *
+ * The first request in a non-intent mode disables the slot under the bucket mutex and migrates
+ * the requests from all stripes to the granted list of the LockHead, in the same way as requests
+ * are migrated from PartitionedLockHeads. Diagnostics, such as the lockInfo command, and the
+ * DeadlockDetector therefore see every request which conflicts with another one.
+ *
+ * May not lock a LockManager bucket while holding a stripe mutex.
+ */
+struct FastPathLockSlot {
+    FastPathLockSlot() {
+        for (auto& stripe : stripes) {
+            stripe.requests.reset();
+        }
+    }
+
+    struct alignas(stdx::hardware_destructive_interference_size) Stripe {
+        SimpleMutex mutex;
+
+        // Requests granted through this slot. Protected by 'mutex'.
+        LockRequestList requests;
+    };
+
+    Stripe& stripeFor(const Locker* locker) {
+        return stripes[locker->getId() % kNumStripes];
+    }
+
+    // Enough stripes that only a few lockers share each one, even with a hundred or more threads.
+    static const unsigned kNumStripes = 32;
+
+    // The resource for which requests are granted through this slot, or zero if it is disabled.
+    // Written under the bucket mutex. Checked again under the stripe mutex before a request is
+    // put on a stripe, so that a request which disables the slot always finds it.
+    alignas(stdx::hardware_destructive_interference_size) AtomicWord<uint64_t> enabledFor;
+
+    // The LockHead to which this slot is attached, or null. Protected by the bucket mutex.
+    LockHead* lock = nullptr;
+
+    Stripe stripes[kNumStripes];
+};
+
 //
 // LockHead
 //
@@ -184,6 +235,8 @@ void LockHead::initNew(ResourceId resId) {
 
     conversionsCount = 0;
     compatibleFirstCount = 0;
+
+    fastPathSlot = nullptr;
 }
 
 bool LockHead::partitioned() const {
@@ -326,6 +379,7 @@ const unsigned LockManager::_numPartitions = 32;
 LockManager::LockManager() {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
+    _fastPathSlots = new FastPathLockSlot[_numLockBuckets];
 }
 
 LockManager::~LockManager() {
@@ -338,6 +392,7 @@ LockManager::~LockManager() {
 
     delete[] _lockBuckets;
     delete[] _partitions;
+    delete[] _fastPathSlots;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -348,8 +403,16 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
     request->partitioned = (mode == MODE_IX || mode == MODE_IS);
     request->mode = mode;
 
-    // For intent modes, try the PartitionedLockHead
+    // Requests held through the fast path are not on the granted list until they are migrated,
+    // so they cannot switch the lock's policy to compatible-first
+    const bool fastPath = request->partitioned && !request->compatibleFirst;
+
+    // For intent modes, try the fast path and then the PartitionedLockHead
     if (request->partitioned) {
+        if (fastPath && _tryLockFastPath(resId, request)) {
+            return LOCK_OK;
+        }
+
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
 
@@ -371,8 +434,15 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     LockHead* lock = bucket->findOrInsert(resId);
 
-    // Start a partitioned lock if possible
+    // Start a fast path or partitioned lock if possible
     if (request->partitioned && !(lock->grantedModes & (~intentModes)) && !lock->conflictModes) {
+        if (fastPath && _enableFastPath(lock)) {
+            // Holding the bucket mutex, so the slot cannot be disabled in between
+            const bool granted = _tryLockFastPath(resId, request);
+            invariant(granted);
+            return LOCK_OK;
+        }
+
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
         PartitionedLockHead* partitionedLock = partition->findOrInsert(resId);
@@ -382,10 +452,14 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
         return LOCK_OK;
     }
 
-    // For the first lock with a non-intent mode, migrate requests from partitioned lock heads
+    // For the first lock with a non-intent mode, migrate requests from partitioned lock heads and
+    // stop granting requests through the fast path
     if (lock->partitioned()) {
         lock->migratePartitionedLockHeads();
     }
+    if (lock->fastPathSlot) {
+        _disableFastPath(lock);
+    }
 
     request->partitioned = false;
     return lock->newRequest(request);
@@ -414,6 +488,19 @@ LockResult LockManager::convert(ResourceId resId, LockRequest* request, LockMode
     invariant((LockConflictsTable[request->mode] | LockConflictsTable[newMode]) ==
               LockConflictsTable[newMode]);
 
+    // A MODE_IS request held through the fast path can be converted to MODE_IX without leaving
+    // it, as long as the slot stays enabled. The stripe mutex keeps the request from being
+    // migrated while its mode changes.
+    if (request->fastPathSlot && newMode == MODE_IX) {
+        FastPathLockSlot* slot = request->fastPathSlot;
+        FastPathLockSlot::Stripe& stripe = slot->stripeFor(request->locker);
+        stdx::lock_guard<SimpleMutex> scopedLock(stripe.mutex);
+        if (!request->lock && slot->enabledFor.load() == resId) {
+            request->mode = newMode;
+            return LOCK_OK;
+        }
+    }
+
     LockBucket* bucket = _getBucket(resId);
     stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
 
@@ -426,6 +513,26 @@ LockResult LockManager::convert(ResourceId resId, LockRequest* request, LockMode
         lock->migratePartitionedLockHeads();
     }
 
+    // Move a request still held through the fast path onto the granted list, where it can wait
+    // for the conversion. It stays granted in its current mode throughout. If the slot has been
+    // disabled, the request has already been migrated.
+    if (request->fastPathSlot) {
+        FastPathLockSlot::Stripe& stripe = request->fastPathSlot->stripeFor(request->locker);
+        stdx::lock_guard<SimpleMutex> scopedLock(stripe.mutex);
+        if (!request->lock) {
+            invariant(request->fastPathSlot == lock->fastPathSlot);
+            stripe.requests.remove(request);
+            request->lock = lock;
+            lock->grantedList.push_back(request);
+            lock->incGrantedModeCount(request->mode);
+        }
+        request->fastPathSlot = nullptr;
+    }
+
+    if (lock->fastPathSlot && !(modeMask(newMode) & intentModes)) {
+        _disableFastPath(lock);
+    }
+
     // Construct granted mask without our current mode, so that it is not counted as
     // conflicting
     uint32_t grantedModesWithoutCurrentRequest = 0;
@@ -476,6 +583,23 @@ bool LockManager::unlock(LockRequest* request) {
         return false;
     }
 
+    if (request->fastPathSlot) {
+        // Unlocking a lock that was granted through the fast path. As with partitioned requests,
+        // the request may since have been migrated to the lock head, which can only be found out
+        // under the stripe mutex.
+        invariant(request->status == LockRequest::STATUS_GRANTED);
+        FastPathLockSlot::Stripe& stripe = request->fastPathSlot->stripeFor(request->locker);
+        request->fastPathSlot = nullptr;
+        stdx::lock_guard<SimpleMutex> scopedLock(stripe.mutex);
+        // Fast path: still held through the slot.
+        if (!request->lock) {
+            stripe.requests.remove(request);
+            return true;
+        }
+
+        // migrated, fall through to regular case
+    }
+
     if (request->partitioned) {
         // Unlocking a lock that was acquired as partitioned. The lock request may since have
         // moved to the lock head, but there is no safe way to find out without synchronizing
@@ -584,6 +708,9 @@ void LockManager::_cleanupUnusedLocksInBucket(LockBucket* bucket) {
         if (lock->partitioned()) {
             lock->migratePartitionedLockHeads();
         }
+        if (lock->fastPathSlot) {
+            _disableFastPath(lock);
+        }
 
         if (lock->grantedModes == 0) {
             invariant(lock->grantedModes == 0);
@@ -722,6 +849,68 @@ LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
     return &_partitions[request->locker->getId() % _numPartitions];
 }
 
+FastPathLockSlot* LockManager::_getFastPathSlot(ResourceId resId) const {
+    return &_fastPathSlots[resId % _numLockBuckets];
+}
+
+bool LockManager::_tryLockFastPath(ResourceId resId, LockRequest* request) {
+    FastPathLockSlot* slot = _getFastPathSlot(resId);
+    if (slot->enabledFor.load() != resId) {
+        return false;
+    }
+
+    // A request, which disables the slot concurrently, migrates every stripe after clearing
+    // 'enabledFor', so either this check fails or the request is migrated.
+    FastPathLockSlot::Stripe& stripe = slot->stripeFor(request->locker);
+    stdx::lock_guard<SimpleMutex> scopedLock(stripe.mutex);
+    if (slot->enabledFor.load() != resId) {
+        return false;
+    }
+
+    request->partitioned = false;
+    request->fastPathSlot = slot;
+    request->status = LockRequest::STATUS_GRANTED;
+    stripe.requests.push_back(request);
+    return true;
+}
+
+bool LockManager::_enableFastPath(LockHead* lock) {
+    FastPathLockSlot* slot = _getFastPathSlot(lock->resourceId);
+    if (slot->lock && slot->lock != lock) {
+        return false;
+    }
+
+    slot->lock = lock;
+    lock->fastPathSlot = slot;
+    slot->enabledFor.store(lock->resourceId);
+    return true;
+}
+
+void LockManager::_disableFastPath(LockHead* lock) {
+    FastPathLockSlot* slot = lock->fastPathSlot;
+    invariant(slot->lock == lock);
+
+    // There can't be non-intent modes or conflicts while the fast path is enabled
+    invariant(!(lock->grantedModes & ~intentModes) && !lock->conflictModes);
+
+    slot->enabledFor.store(0);
+
+    // Lock each stripe in turn and transfer its requests, if any
+    for (auto& stripe : slot->stripes) {
+        stdx::lock_guard<SimpleMutex> scopedLock(stripe.mutex);
+        while (!stripe.requests.empty()) {
+            LockRequest* request = stripe.requests._front;
+            stripe.requests.remove(request);
+            request->lock = lock;
+            lock->grantedList.push_back(request);
+            lock->incGrantedModeCount(request->mode);
+        }
+    }
+
+    slot->lock = nullptr;
+    lock->fastPathSlot = nullptr;
+}
+
 void LockManager::dump() const {
     log() << "Dumping LockManager @ " << static_cast<const void*>(this) << '\n';
 
@@ -1079,6 +1268,7 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
 
     lock = nullptr;
     partitionedLock = nullptr;
+    fastPathSlot = nullptr;
     prev = nullptr;
     next = nullptr;
     status = STATUS_NEW;
@@ -176,6 +176,36 @@ private:
      */
     Partition* _getPartition(LockRequest* request) const;
 
+    /**
+     * Retrieves the fast path slot of the bucket in which the particular resource must reside.
+     * There is no need to hold a lock when calling this function.
+     */
+    FastPathLockSlot* _getFastPathSlot(ResourceId resId) const;
+
+    /**
+     * Grants the intent mode request through the resource's fast path slot, taking only the mutex
+     * of the locker's stripe, if the slot is enabled for that resource. Returns false if it is not.
+     */
+    bool _tryLockFastPath(ResourceId resId, LockRequest* request);
+
+    /**
+     * Attaches the fast path slot of its bucket to 'lock' and enables it, unless the slot is
+     * attached to another resource. Returns whether intent mode requests on 'lock' can now be
+     * granted through the slot. The lock must not have any granted or pending requests in a
+     * non-intent mode.
+     *
+     * MUST be called under the lock bucket's mutex.
+     */
+    bool _enableFastPath(LockHead* lock);
+
+    /**
+     * Stops granting requests on 'lock' through its fast path slot, migrates the requests held
+     * through the slot to the granted list of 'lock' and detaches the slot.
+     *
+     * MUST be called under the lock bucket's mutex.
+     */
+    void _disableFastPath(LockHead* lock);
+
     /**
      * Prints the contents of a bucket to the log.
      */
@@ -222,6 +252,10 @@ private:
 
     static const unsigned _numPartitions;
     Partition* _partitions;
+
+    // One fast path slot for each lock bucket, so that a slot is only ever attached to the
+    // LockHeads of a single bucket and is protected by that bucket's mutex.
+    FastPathLockSlot* _fastPathSlots;
 };
 
 
@@ -423,6 +457,11 @@ private:
     // TODO: Remove this vector and make LockHead a POD
     std::vector<LockManager::Partition*> partitions;
 
+    // The fast path slot attached to this lock, if any. While the slot is attached, the lock has
+    // no granted or pending requests in a non-intent mode and any number of intent mode requests
+    // may be granted through the slot, without being put on the granted list.
+    FastPathLockSlot* fastPathSlot;
+
     //
     // Conversion
     //
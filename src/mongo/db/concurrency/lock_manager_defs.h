@@ -43,6 +43,7 @@ class Locker;
 
 struct LockHead;
 struct PartitionedLockHead;
+struct FastPathLockSlot;
 
 /**
  * LockMode compatibility matrix.
@@ -307,8 +308,8 @@ public:
 
 /**
  * There is one of those entries per each request for a lock. They hang on a linked list off
- * the LockHead or off a PartitionedLockHead and also are in a map for each Locker. This
- * structure is not thread-safe.
+ * the LockHead, a PartitionedLockHead or a FastPathLockSlot, and also are in a map for each
+ * Locker. This structure is not thread-safe.
  *
  * LockRequest are owned by the Locker class and it controls their lifetime. They should not
  * be deleted while on the LockManager though (see the contract for the lock/unlock methods).
@@ -402,6 +403,18 @@ struct LockRequest {
     // Protected by LockHead bucket's mutex
     PartitionedLockHead* partitionedLock;
 
+    // Pointer to the fast path slot through which this request was granted in an intent mode, or
+    // null. While the request is held through the slot, it hangs off one of the slot's stripes
+    // and 'lock' is null. Disabling the slot migrates the request to the LockHead and sets 'lock',
+    // which is only known for sure under the stripe mutex, so this pointer is kept until the
+    // Locker thread next converts or unlocks the request. A request can only transition from
+    // 'fastPathSlot' to 'lock', never the other way around.
+    //
+    // Written by LockManager on Locker thread
+    // Read by LockManager on Locker thread
+    // No synchronization
+    FastPathLockSlot* fastPathSlot;
+
     // The linked list chain on which this request hangs off the owning lock head. The reason
     // intrusive linked list is used instead of the std::list class is to allow for entries to be
     // removed from the middle of the list in O(1) time, if they are known instead of having to
@@ -26,6 +26,7 @@
  *    it in the license file.
  */
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
 #include "mongo/unittest/unittest.h"
@@ -912,6 +913,84 @@ TEST(LockManager, CompatibleFirstCancelWaiting) {
     ASSERT(lockMgr.unlock(&requestX));
 }
 
+TEST(LockManager, IntentLocksUseFastPathWhileUncontended) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    LockerImpl lockerIS;
+    LockRequestCombo requestIS(&lockerIS);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIS, MODE_IS));
+    ASSERT(requestIS.fastPathSlot);
+
+    LockerImpl lockerIX;
+    LockRequestCombo requestIX(&lockerIX);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIX, MODE_IX));
+    ASSERT(requestIX.fastPathSlot);
+
+    // A conflicting request must wait for all requests held through the fast path
+    LockerImpl lockerX;
+    LockRequestCombo requestX(&lockerX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestX, MODE_X));
+
+    ASSERT(lockMgr.unlock(&requestIS));
+    ASSERT_EQ(0, requestX.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestIX));
+    ASSERT_EQ(LOCK_OK, requestX.lastResult);
+    ASSERT_EQ(1, requestX.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestX));
+
+    // Without conflicts, intent requests are granted through the fast path again, and can be
+    // converted between the intent modes without leaving it
+    LockRequestCombo request(&lockerIS);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request, MODE_IS));
+    ASSERT(request.fastPathSlot);
+
+    ASSERT(LOCK_OK == lockMgr.convert(resId, &request, MODE_IX));
+    ASSERT(request.fastPathSlot);
+    ASSERT(request.mode == MODE_IX);
+
+    // Converting to a non-intent mode moves the request off the fast path
+    ASSERT(LOCK_OK == lockMgr.convert(resId, &request, MODE_X));
+    ASSERT(!request.fastPathSlot);
+    ASSERT(request.mode == MODE_X);
+
+    ASSERT(!lockMgr.unlock(&request));
+    ASSERT(!lockMgr.unlock(&request));
+    ASSERT(lockMgr.unlock(&request));
+}
+
+TEST(LockManager, FastPathRequestsAreReportedInLockInfo) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    LockerImpl locker;
+    LockRequestCombo request(&locker);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request, MODE_IX));
+    ASSERT(request.fastPathSlot);
+
+    // Reporting migrates the request held through the fast path onto the granted list
+    BSONObjBuilder builder;
+    lockMgr.getLockInfoBSON({}, &builder);
+    const BSONObj lockInfo = builder.obj();
+
+    const auto buckets = lockInfo["lockInfo"].Array();
+    ASSERT_EQ(1U, buckets.size());
+    ASSERT_EQ(resId.toString(), buckets[0]["resourceId"].String());
+    const auto granted = buckets[0]["granted"].Array();
+    ASSERT_EQ(1U, granted.size());
+    ASSERT_EQ("IX", granted[0]["mode"].String());
+
+    ASSERT(lockMgr.unlock(&request));
+
+    // New requests are granted through the fast path again
+    LockRequestCombo requestIS(&locker);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIS, MODE_IS));
+    ASSERT(requestIS.fastPathSlot);
+    ASSERT(lockMgr.unlock(&requestIS));
+}
+
 TEST(LockManager, Fairness) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_GLOBAL, 0);
@@ -493,6 +493,11 @@ void CurOp::reportState(BSONObjBuilder* builder, bool truncateOps) {
         builder->append("planSummary", _planSummary);
     }
 
+    if (_memoryTracker) {
+        builder->append("memoryUsageBytes", _memoryTracker->currentMemoryBytes());
+        builder->append("peakMemoryUsageBytes", _memoryTracker->peakMemoryBytes());
+    }
+
     if (_genericCursor) {
         // This creates a new builder to truncate the object that will go into the curOp output. In
         // order to make sure the object is not too large but not truncate the comment, we only
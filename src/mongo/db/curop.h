@@ -38,6 +38,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/memory_usage_tracker.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/time_support.h"
 
@@ -565,6 +566,14 @@ public:
 
     void setGenericCursor_inlock(GenericCursor gc);
 
+    /**
+     * Sets the tracker whose current and peak memory usage is reported for this operation, e.g.
+     * the memory tracker of an aggregation pipeline.
+     */
+    void setMemoryTracker_inlock(std::shared_ptr<const MemoryUsageTracker> tracker) {
+        _memoryTracker = std::move(tracker);
+    }
+
     const boost::optional<SingleThreadedLockStats> getLockStatsBase() {
         return _lockStatsBase;
     }
@@ -613,6 +622,7 @@ private:
     boost::optional<GenericCursor> _genericCursor;
 
     std::string _planSummary;
+    std::shared_ptr<const MemoryUsageTracker> _memoryTracker;
     boost::optional<SingleThreadedLockStats>
         _lockStatsBase;  // This is the snapshot of lock stats taken when curOp is constructed.
 };
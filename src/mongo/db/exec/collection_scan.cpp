@@ -38,8 +38,13 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 
@@ -51,6 +56,87 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+// Batches are split into chunks of at least this many documents, so that small batches aren't
+// handed to threads that would spend longer waking up than filtering.
+const size_t kMinDocsPerFilterChunk = 64;
+
+/**
+ * Returns the pool shared by all collection scans that evaluate their filter on several threads.
+ * It is never destroyed, since a task may still be queued on it at shutdown.
+ */
+ThreadPool* getFilterThreadPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "CollectionScanFilter";
+        options.minThreads = 0;
+        options.maxThreads = 64;
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+/**
+ * The state shared between a collection scan and the threads helping it filter a batch. Each
+ * thread, including the scan's own, claims chunks of the batch until none are left, so the scan
+ * never waits for a task that the pool hasn't started; it only waits for chunks that are being
+ * filtered. A task that starts after every chunk has been claimed returns without touching the
+ * batch or its filter, which may no longer exist by then.
+ */
+struct FilterBatchJob {
+    using Batch = std::vector<std::pair<RecordId, Snapshotted<BSONObj>>>;
+
+    FilterBatchJob(const Batch* batch, size_t numChunks)
+        : batch(batch),
+          batchSize(batch->size()),
+          matched(batchSize, 0),
+          numChunks(numChunks),
+          chunkSize((batchSize + numChunks - 1) / numChunks) {}
+
+    void filterChunks(const MatchExpression* filter) {
+        for (size_t chunk = nextChunk.fetchAndAdd(1); chunk < numChunks;
+             chunk = nextChunk.fetchAndAdd(1)) {
+            Status chunkStatus = Status::OK();
+            try {
+                const size_t end = std::min(batchSize, (chunk + 1) * chunkSize);
+                for (size_t i = chunk * chunkSize; i < end; ++i) {
+                    matched[i] = filter->matchesBSON((*batch)[i].second.value());
+                }
+            } catch (const DBException& ex) {
+                chunkStatus = ex.toStatus();
+            }
+
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (status.isOK()) {
+                status = chunkStatus;
+            }
+            if (++chunksDone == numChunks) {
+                allChunksDone.notify_all();
+            }
+        }
+    }
+
+    // Only read once a chunk has been claimed, since the scan refills or destroys the batch once
+    // every chunk has been filtered.
+    const Batch* const batch;
+    const size_t batchSize;
+    std::vector<char> matched;
+
+    const size_t numChunks;
+    const size_t chunkSize;
+    AtomicWord<size_t> nextChunk{0};
+
+    stdx::mutex mutex;
+    stdx::condition_variable allChunksDone;
+    size_t chunksDone = 0;
+    Status status = Status::OK();
+};
+
+}  // namespace
+
 // static
 const char* CollectionScan::kStageType = "COLLSCAN";
 
@@ -73,6 +159,25 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
         _endCondition = stdx::make_unique<GTEMatchExpression>(repl::OpTime::kTimestampFieldName,
                                                               _endConditionBSON.firstElement());
     }
+
+    // $where and $expr evaluate through state shared by every copy of the filter, as do geo
+    // predicates, whose geometries may build their indexes lazily on first use. The oplog options
+    // all depend on seeing each record as it is read.
+    const size_t filterThreads = internalQueryExecCollScanFilterThreads.load();
+    if (filterThreads > 0 && _filter && !_params.tailable && !_params.maxTs &&
+        !_params.shouldTrackLatestOplogTimestamp && !_params.stopApplyingFilterAfterFirstMatch &&
+        !QueryPlannerCommon::hasNode(_filter, MatchExpression::WHERE) &&
+        !QueryPlannerCommon::hasNode(_filter, MatchExpression::EXPRESSION) &&
+        !QueryPlannerCommon::hasNode(_filter, MatchExpression::GEO) &&
+        !QueryPlannerCommon::hasNode(_filter, MatchExpression::GEO_NEAR)) {
+        _filterThreads = filterThreads;
+        _batchSize = internalQueryExecCollScanFilterBatchSize.load();
+        _batchBytes = internalQueryExecCollScanFilterBatchBytes.load();
+        for (size_t i = 0; i < _filterThreads; ++i) {
+            _filterClones.push_back(_filter->shallowClone());
+        }
+        _specificStats.filterThreads = _filterThreads;
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -87,10 +192,20 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::DEAD;
     }
 
+    if (!_batchResults.empty()) {
+        *out = _batchResults.front();
+        _batchResults.pop();
+        return PlanStage::ADVANCED;
+    }
+
     if (_commonStats.isEOF) {
         return PlanStage::IS_EOF;
     }
 
+    if (_filterThreads > 0 && _cursor) {
+        return doWorkBatched(out);
+    }
+
     boost::optional<Record> record;
     const bool needToMakeCursor = !_cursor;
     try {
@@ -184,6 +299,89 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+PlanStage::StageState CollectionScan::doWorkBatched(WorkingSetID* out) {
+    // Read one record per call, as the unbatched scan does, so that plan ranking and yielding see
+    // the same amount of work for each record.
+    boost::optional<Record> record;
+    try {
+        if (_lastSeenId.isNull() && !_params.start.isNull()) {
+            record = _cursor->seekExact(_params.start);
+        } else {
+            record = _cursor->next();
+        }
+    } catch (const WriteConflictException&) {
+        // The records read so far are owned, so we can keep them and carry on after the yield.
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    if (record) {
+        // The cursor may reuse its buffer on the next call, so keep a copy of the record.
+        _lastSeenId = record->id;
+        _batch.emplace_back(record->id,
+                            Snapshotted<BSONObj>(getOpCtx()->recoveryUnit()->getSnapshotId(),
+                                                 record->data.releaseToBson().getOwned()));
+        _batchBytesBuffered += _batch.back().second.value().objsize();
+        if (_batch.size() < _batchSize && _batchBytesBuffered < _batchBytes) {
+            return PlanStage::NEED_TIME;
+        }
+    } else {
+        _commonStats.isEOF = true;
+    }
+
+    filterBatch();
+
+    if (!_batchResults.empty()) {
+        *out = _batchResults.front();
+        _batchResults.pop();
+        return PlanStage::ADVANCED;
+    }
+
+    return _commonStats.isEOF ? PlanStage::IS_EOF : PlanStage::NEED_TIME;
+}
+
+void CollectionScan::filterBatch() {
+    if (_batch.empty()) {
+        return;
+    }
+
+    const size_t numChunks =
+        std::max<size_t>(1, std::min(_filterThreads + 1, _batch.size() / kMinDocsPerFilterChunk));
+    auto job = std::make_shared<FilterBatchJob>(&_batch, numChunks);
+    for (size_t i = 0; i + 1 < numChunks; ++i) {
+        const MatchExpression* clone = _filterClones[i].get();
+        // If the pool can't take the task, the chunks are filtered on this thread instead.
+        getFilterThreadPool()
+            ->schedule([job, clone] { job->filterChunks(clone); })
+            .transitional_ignore();
+    }
+    job->filterChunks(_filter);
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(job->mutex);
+        job->allChunksDone.wait(lk, [&] { return job->chunksDone == job->numChunks; });
+        uassertStatusOK(job->status);
+    }
+
+    for (size_t i = 0; i < _batch.size(); ++i) {
+        if (!job->matched[i]) {
+            continue;
+        }
+
+        WorkingSetID id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = _batch[i].first;
+        member->obj = std::move(_batch[i].second);
+        _workingSet->transitionToRecordIdAndObj(id);
+        _batchResults.push(id);
+    }
+
+    _specificStats.docsTested += _batch.size();
+    ++_specificStats.filterBatches;
+    _batch.clear();
+    _batchBytesBuffered = 0;
+}
+
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     if (tsElem.type() != BSONType::bsonTimestamp) {
@@ -219,7 +417,7 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
 }
 
 bool CollectionScan::isEOF() {
-    return _commonStats.isEOF || _isDead;
+    return (_commonStats.isEOF && _batchResults.empty()) || _isDead;
 }
 
 void CollectionScan::doSaveState() {
@@ -29,11 +29,14 @@
 #pragma once
 
 #include <memory>
+#include <queue>
+#include <vector>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/snapshot.h"
 
 namespace mongo {
 
@@ -46,6 +49,11 @@ class OperationContext;
  * Scans over a collection, starting at the RecordId provided in params and continuing until
  * there are no more records in the collection.
  *
+ * If internalQueryExecCollScanFilterThreads is set, records are read in batches and the filter is
+ * evaluated over each batch by that many threads in addition to the operation's own, each using
+ * its own copy of the filter. Records are still read through one cursor on the operation's thread
+ * and results are returned in record order.
+ *
  * Preconditions: Valid RecordId.
  */
 class CollectionScan final : public PlanStage {
@@ -91,6 +99,18 @@ private:
      */
     Status setLatestOplogEntryTimestamp(const Record& record);
 
+    /**
+     * Adds the next record to '_batch' and, once it is full, queues the records that pass the
+     * filter, which is evaluated by several threads. Used when '_filterThreads' is non-zero.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
+    /**
+     * Evaluates the filter against every document in '_batch', queues the ids of new working set
+     * members for those that pass it, and clears '_batch'.
+     */
+    void filterBatch();
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -114,6 +134,21 @@ private:
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
 
+    // The number of threads, besides the operation's own, that evaluate the filter. Zero unless
+    // the filter is safe to evaluate concurrently and the scan is not over the oplog.
+    size_t _filterThreads = 0;
+    size_t _batchSize = 0;
+    size_t _batchBytes = 0;
+
+    // One copy of '_filter' for each of the '_filterThreads' threads.
+    std::vector<std::unique_ptr<MatchExpression>> _filterClones;
+
+    // Owned copies of the records read for the current batch, and the members for those that
+    // passed the filter but have not been returned yet.
+    std::vector<std::pair<RecordId, Snapshotted<BSONObj>>> _batch;
+    size_t _batchBytesBuffered = 0;
+    std::queue<WorkingSetID> _batchResults;
+
     // Stats
     CollectionScanStats _specificStats;
 };
@@ -30,6 +30,8 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/filter.h"
@@ -52,13 +54,18 @@ FetchStage::FetchStage(OperationContext* opCtx,
                        WorkingSet* ws,
                        PlanStage* child,
                        const MatchExpression* filter,
-                       const Collection* collection)
+                       const Collection* collection,
+                       size_t batchSize,
+                       bool preserveOrder)
     : PlanStage(kStageType, opCtx),
       _collection(collection),
       _ws(ws),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _batchSize(batchSize),
+      _preserveOrder(preserveOrder) {
     _children.emplace_back(child);
+    _specificStats.batchSize = batchSize > 1 ? batchSize : 0;
 }
 
 FetchStage::~FetchStage() {}
@@ -69,6 +76,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_batch.empty()) {
+        // We have buffered results left to fetch or return.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -77,6 +89,10 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batchSize > 1) {
+        return doWorkBatched(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -131,6 +147,138 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatched(WorkingSetID* out) {
+    if (!_batchReady) {
+        if (_batch.size() < _batchSize && !child()->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState status = child()->work(&id);
+            if (PlanStage::ADVANCED == status) {
+                _batch.push_back(id);
+                if (_batch.size() < _batchSize) {
+                    return NEED_TIME;
+                }
+            } else if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
+                // The stage which produces a failure is responsible for allocating a working set
+                // member with error details.
+                invariant(WorkingSet::INVALID_ID != id);
+                *out = id;
+                return status;
+            } else if (PlanStage::NEED_YIELD == status) {
+                *out = id;
+                return status;
+            } else if (PlanStage::NEED_TIME == status) {
+                return status;
+            }
+        }
+
+        if (_batch.empty()) {
+            return IS_EOF;
+        }
+
+        prepareBatch();
+        return NEED_TIME;
+    }
+
+    if (_fetchPos < _fetchOrder.size()) {
+        const size_t pos = _fetchOrder[_fetchPos];
+        const WorkingSetID id = _batch[pos];
+        try {
+            if (!_cursor)
+                _cursor = _collection->getCursor(getOpCtx());
+
+            if (WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
+                // The cursor may reuse the memory of this record when it reads the next one.
+                _ws->get(id)->makeObjOwnedIfNeeded();
+            } else {
+                _ws->free(id);
+                _batch[pos] = WorkingSet::INVALID_ID;
+            }
+        } catch (const WriteConflictException&) {
+            // Retry fetching this record after the yield.
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+
+        ++_fetchPos;
+        return NEED_TIME;
+    }
+
+    while (_returnPos < _batch.size()) {
+        const WorkingSetID id = _batch[_returnPos++];
+        if (_returnPos == _batch.size()) {
+            resetBatch();
+        }
+
+        if (WorkingSet::INVALID_ID != id) {
+            return returnIfMatches(_ws->get(id), id, out);
+        }
+    }
+
+    return NEED_TIME;
+}
+
+void FetchStage::prepareBatch() {
+    // Count how often reading the records in the order of the child would have had to seek
+    // backwards, a measure of how much random I/O the batch saves.
+    const RecordId* prevRecordId = nullptr;
+    for (auto id : _batch) {
+        const WorkingSetMember* member = _ws->get(id);
+        if (member->hasObj()) {
+            continue;
+        }
+        if (prevRecordId && member->recordId < *prevRecordId) {
+            ++_specificStats.backwardSeeksAvoided;
+        }
+        prevRecordId = &member->recordId;
+    }
+
+    const auto byRecordId = [this](WorkingSetID lhs, WorkingSetID rhs) {
+        return _ws->get(lhs)->recordId < _ws->get(rhs)->recordId;
+    };
+
+    if (!_preserveOrder) {
+        // Return the results in the order in which they are fetched. Results which already have
+        // an object need no fetching, and go first.
+        auto firstToFetch = std::stable_partition(_batch.begin(),
+                                                  _batch.end(),
+                                                  [this](WorkingSetID id) {
+                                                      return _ws->get(id)->hasObj();
+                                                  });
+        std::sort(firstToFetch, _batch.end(), byRecordId);
+    }
+
+    for (size_t pos = 0; pos < _batch.size(); ++pos) {
+        const WorkingSetMember* member = _ws->get(_batch[pos]);
+        if (member->hasObj()) {
+            ++_specificStats.alreadyHasObj;
+            continue;
+        }
+
+        // We need a valid RecordId to fetch from and this is the only state that has one.
+        verify(WorkingSetMember::RID_AND_IDX == member->getState());
+        verify(member->hasRecordId());
+        _fetchOrder.push_back(pos);
+    }
+
+    if (_preserveOrder) {
+        std::sort(_fetchOrder.begin(), _fetchOrder.end(), [&](size_t lhs, size_t rhs) {
+            return byRecordId(_batch[lhs], _batch[rhs]);
+        });
+    }
+
+    ++_specificStats.batches;
+    _specificStats.docsFetchedInBatches += _fetchOrder.size();
+    _batchReady = true;
+}
+
+void FetchStage::resetBatch() {
+    _batch.clear();
+    _fetchOrder.clear();
+    _fetchPos = 0;
+    _returnPos = 0;
+    _batchReady = false;
+}
+
 void FetchStage::doSaveState() {
     if (_cursor)
         _cursor->saveUnpositioned();
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
@@ -46,6 +47,11 @@ class SeekableRecordCursor;
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
  * Preconditions: Valid RecordId.
+ *
+ * If 'batchSize' is greater than 1, the stage buffers that many results of its child and reads
+ * their records in RecordId order, which turns the random reads of a poorly correlated index into
+ * mostly sequential ones. The buffered results are then returned in the order in which the child
+ * returned them if 'preserveOrder' is true, and in RecordId order otherwise.
  */
 class FetchStage : public PlanStage {
 public:
@@ -53,7 +59,9 @@ public:
                WorkingSet* ws,
                PlanStage* child,
                const MatchExpression* filter,
-               const Collection* collection);
+               const Collection* collection,
+               size_t batchSize = 0,
+               bool preserveOrder = true);
 
     ~FetchStage();
 
@@ -82,6 +90,21 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * doWork() for a stage which fetches in batches. Each call does one unit of work: buffers one
+     * result of the child, fetches one buffered record or returns one buffered result.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
+    /**
+     * Called once '_batch' is full or the child is exhausted. Works out the order in which to
+     * fetch the buffered records and, if the order of the results does not matter, reorders
+     * '_batch' accordingly.
+     */
+    void prepareBatch();
+
+    void resetBatch();
+
     // Collection which is used by this stage. Used to resolve record ids retrieved by child
     // stages. The lifetime of the collection must supersede that of the stage.
     const Collection* _collection;
@@ -97,6 +120,24 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // Batched fetching is used if '_batchSize' is greater than 1.
+    const size_t _batchSize;
+    const bool _preserveOrder;
+
+    // The results of the child buffered for the current batch, in the order in which they are to
+    // be returned. Members which did not survive fetching are replaced by WorkingSet::INVALID_ID.
+    std::vector<WorkingSetID> _batch;
+
+    // Whether '_batch' is complete and its records are being fetched or returned.
+    bool _batchReady = false;
+
+    // Positions in '_batch' of the members which need fetching, in RecordId order.
+    std::vector<size_t> _fetchOrder;
+
+    // The next position in '_fetchOrder' to fetch, and in '_batch' to return.
+    size_t _fetchPos = 0;
+    size_t _returnPos = 0;
+
     // Stats
     FetchStats _specificStats;
 };
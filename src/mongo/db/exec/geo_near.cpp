@@ -832,8 +832,69 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+/**
+ * Returns a key which identifies the region built by buildS2Region() for 'sphereBounds', for use
+ * with the shared covering cache.
+ */
+std::string buildS2RegionCacheKey(const R2Annulus& sphereBounds) {
+    const double values[] = {sphereBounds.center().x,
+                             sphereBounds.center().y,
+                             sphereBounds.getInner(),
+                             sphereBounds.getOuter()};
+    return std::string("annulus") +
+        std::string(reinterpret_cast<const char*>(values), sizeof(values));
+}
+
+/**
+ * Returns the area in square meters of a spherical cap on the earth with the given radius in
+ * meters.
+ */
+double capAreaInSquareMeters(double radius) {
+    const double angle = std::min(std::max(radius, 0.0) / kRadiusOfEarthInMeters, M_PI);
+    return 2 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters * (1 - std::cos(angle));
 }
 
+// The number of documents we aim for each search annulus to contain. This is the middle of the
+// range that the annulus sizing used to steer towards by doubling and halving.
+const double kTargetResultsPerInterval = 450;
+
+// Bounds on how quickly the annulus width can change between intervals, so that a single sparse
+// or crowded interval does not throw off the next one too badly.
+const double kMaxBoundsIncrementGrowth = 8;
+const double kMaxBoundsIncrementShrink = 8;
+
+/**
+ * Returns the width of the next search annulus, which starts at 'nextInner', given the stats of
+ * the previous annulus and its width 'lastIncrement'.
+ *
+ * Assuming that documents are spread evenly around the previous annulus, the number of documents
+ * found there gives a density, and the next annulus is sized to cover the area that should hold
+ * kTargetResultsPerInterval documents at that density.
+ */
+double nextS2BoundsIncrement(const IntervalStats& lastInterval,
+                             double lastIncrement,
+                             double nextInner) {
+    const double lastArea = capAreaInSquareMeters(lastInterval.maxDistanceAllowed) -
+        capAreaInSquareMeters(lastInterval.minDistanceAllowed);
+    if (lastInterval.numResultsBuffered == 0 || lastArea <= 0) {
+        // With nothing to go on, widen the search quickly.
+        return lastIncrement * 2;
+    }
+
+    const double density = lastInterval.numResultsBuffered / lastArea;
+    const double nextOuterArea =
+        capAreaInSquareMeters(nextInner) + kTargetResultsPerInterval / density;
+    const double cosAngle = 1 -
+        nextOuterArea / (2 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters);
+    const double nextOuter = std::acos(std::max(-1.0, cosAngle)) * kRadiusOfEarthInMeters;
+
+    return std::min(std::max(nextOuter - nextInner, lastIncrement / kMaxBoundsIncrementShrink),
+                    lastIncrement * kMaxBoundsIncrementGrowth);
+}
+
+}  // namespace
+
 // Estimate the density of data by search the nearest cells level by level around center.
 class GeoNear2DSphereStage::DensityEstimator {
 public:
@@ -1028,13 +1089,8 @@ StatusWith<NearStage::CoveredInterval*>  //
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = nextS2BoundsIncrement(
+            _specificStats.intervalStats.back(), _boundsIncrement, _currBounds.getOuter());
     }
 
     invariant(_boundsIncrement > 0.0);
@@ -1062,7 +1118,9 @@ StatusWith<NearStage::CoveredInterval*>  //
     scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    // Repeated searches around the same point tend to pick the same annuli.
+    std::vector<S2CellId> cover =
+        ExpressionMapping::get2dsphereCoveringCached(*region, buildS2RegionCacheKey(_currBounds));
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
@@ -1079,8 +1137,11 @@ StatusWith<NearStage::CoveredInterval*>  //
     // Add the cells in this covering to the _scannedCells union
     _scannedCells.Add(cover);
 
+    // Documents indexed under a parent cell that an earlier annulus already scanned were buffered
+    // then, so there is no need to scan that cell again.
     OrderedIntervalList* coveredIntervals = &scanParams.bounds.fields[s2FieldPosition];
-    ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, _indexParams, coveredIntervals);
+    ExpressionMapping::S2CellIdsToIntervalsWithParents(
+        cover, _indexParams, coveredIntervals, &_scannedParentCells);
 
     IndexScan* scan = new IndexScan(opCtx, scanParams, workingSet, nullptr);
 
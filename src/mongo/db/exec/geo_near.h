@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "mongo/db/exec/near.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/working_set.h"
@@ -152,6 +154,9 @@ private:
     // Keeps track of the region that has already been scanned
     S2CellUnion _scannedCells;
 
+    // The parent cells whose exact index keys have already been scanned
+    std::unordered_set<S2CellId> _scannedParentCells;  // NOLINT
+
     class DensityEstimator;
     std::unique_ptr<DensityEstimator> _densityEstimator;
 };
@@ -80,6 +80,7 @@ IndexScan::IndexScan(OperationContext* opCtx,
     _specificStats.isUnique = _params.isUnique;
     _specificStats.isSparse = _params.isSparse;
     _specificStats.isPartial = _params.isPartial;
+    _specificStats.isSkipScan = _params.isSkipScan;
     _specificStats.indexVersion = static_cast<int>(_params.version);
     _specificStats.collation = _params.collation.getOwned();
 }
@@ -93,6 +93,10 @@ struct IndexScanParams {
 
     // Do we want to add the key as metadata?
     bool addKeyMetadata{false};
+
+    // Is this a skip scan over unconstrained leading fields? Only reported in explain output; the
+    // bounds checker does the seeking either way.
+    bool isSkipScan{false};
 };
 
 /**
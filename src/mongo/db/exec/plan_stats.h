@@ -181,7 +181,7 @@ struct CachedPlanStats : public SpecificStats {
 };
 
 struct CollectionScanStats : public SpecificStats {
-    CollectionScanStats() : docsTested(0), direction(1) {}
+    CollectionScanStats() : docsTested(0), direction(1), filterThreads(0), filterBatches(0) {}
 
     SpecificStats* clone() const final {
         CollectionScanStats* specific = new CollectionScanStats(*this);
@@ -199,6 +199,11 @@ struct CollectionScanStats : public SpecificStats {
     // sees a document that does not pass the filter and has a "ts" Timestamp field greater than
     // 'maxTs'.
     boost::optional<Timestamp> maxTs;
+
+    // The number of threads, besides the operation's own, that evaluated the filter, and the
+    // number of batches of records they evaluated it over.
+    size_t filterThreads;
+    size_t filterBatches;
 };
 
 struct CountStats : public SpecificStats {
@@ -341,6 +346,17 @@ struct FetchStats : public SpecificStats {
 
     // The total number of full documents touched by the fetch stage.
     size_t docsExamined = 0u;
+
+    // The number of child results buffered per batch, or 0 if the stage does not fetch in batches.
+    size_t batchSize = 0u;
+
+    // The number of batches, and the number of records read in RecordId order within them.
+    size_t batches = 0u;
+    size_t docsFetchedInBatches = 0u;
+
+    // The number of times reading the records of a batch in the order returned by the child would
+    // have sought backwards in the collection.
+    size_t backwardSeeksAvoided = 0u;
 };
 
 struct GroupStats : public SpecificStats {
@@ -380,6 +396,7 @@ struct IndexScanStats : public SpecificStats {
           isPartial(false),
           isSparse(false),
           isUnique(false),
+          isSkipScan(false),
           dupsTested(0),
           dupsDropped(0),
           keysExamined(0),
@@ -425,6 +442,9 @@ struct IndexScanStats : public SpecificStats {
     bool isSparse;
     bool isUnique;
 
+    // Whether the scan seeks past each distinct value of unconstrained leading index fields.
+    bool isSkipScan;
+
     size_t dupsTested;
     size_t dupsDropped;
 
@@ -644,6 +664,20 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // The number of documents requested from the stage, or 0 if all of the matching documents
+    // were.
+    size_t limit = 0;
+
+    // Whether the stage stopped reading postings before all of its index scans were exhausted,
+    // because no document it had not seen could score high enough to be returned.
+    bool stoppedEarly = false;
+
+    // When the stage stopped early, the highest score a document not yet seen could have had.
+    double scoreThreshold = 0;
+
+    // When the stage stopped early, the number of term index scans left with unread postings.
+    size_t termScansCutShort = 0;
 };
 
 }  // namespace mongo
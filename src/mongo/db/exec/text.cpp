@@ -119,8 +119,12 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     std::unique_ptr<PlanStage> textMatchStage;
     if (wantTextScore) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
-        // compute their text scores. This is a blocking operation.
-        auto textScorer = make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, _params.index);
+        // compute their text scores. This is a blocking operation, but if only the highest scoring
+        // documents are needed it can stop reading the index scans early.
+        auto textScorer = _params.limit > 0
+            ? make_unique<TextOrStage>(
+                  opCtx, _params.spec, ws, filter, _params.index, _params.query, _params.limit)
+            : make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, _params.index);
 
         textScorer->addChildren(std::move(indexScanList));
 
@@ -28,6 +28,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -38,6 +39,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/exec/working_set_computed_data.h"
+#include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
 #include "mongo/stdx/memory.h"
@@ -53,6 +55,13 @@ using fts::FTSSpec;
 
 const char* TextOrStage::kStageType = "TEXT_OR";
 
+namespace {
+
+// The score bound of a child which has no postings left.
+const double kChildExhausted = -1;
+
+}  // namespace
+
 TextOrStage::TextOrStage(OperationContext* opCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
@@ -66,6 +75,27 @@ TextOrStage::TextOrStage(OperationContext* opCtx,
       _idRetrying(WorkingSet::INVALID_ID),
       _index(index) {}
 
+TextOrStage::TextOrStage(OperationContext* opCtx,
+                         const FTSSpec& ftsSpec,
+                         WorkingSet* ws,
+                         const MatchExpression* filter,
+                         IndexDescriptor* index,
+                         const fts::FTSQueryImpl& query,
+                         size_t limit)
+    : PlanStage(kStageType, opCtx),
+      _ftsSpec(ftsSpec),
+      _ws(ws),
+      _scoreIterator(_scores.end()),
+      _limit(limit),
+      _terms(query.getTermsForBounds().begin(), query.getTermsForBounds().end()),
+      _ftsMatcher(stdx::make_unique<fts::FTSMatcher>(query, ftsSpec)),
+      _filter(filter),
+      _idRetrying(WorkingSet::INVALID_ID),
+      _index(index) {
+    invariant(_limit > 0);
+    _specificStats.limit = _limit;
+}
+
 TextOrStage::~TextOrStage() {}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
@@ -185,8 +215,19 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         _idRetrying = WorkingSet::INVALID_ID;
     }
 
+    if (_limit > 0 && _childScoreBounds.empty()) {
+        _childScoreBounds.resize(_children.size(), std::numeric_limits<double>::infinity());
+    }
+
     if (PlanStage::ADVANCED == childState) {
+        if (_limit > 0) {
+            return addTermTopK(id, out);
+        }
         return addTerm(id, out);
+    } else if (PlanStage::IS_EOF == childState && _limit > 0) {
+        _childScoreBounds[_currentChild] = kChildExhausted;
+        advanceToNextChild();
+        return PlanStage::NEED_TIME;
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
         ++_currentChild;
@@ -221,7 +262,51 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 }
 
+void TextOrStage::advanceToNextChild() {
+    double scoreBound = 0;
+    size_t numChildrenLeft = 0;
+    for (auto childScoreBound : _childScoreBounds) {
+        if (childScoreBound != kChildExhausted) {
+            scoreBound += childScoreBound;
+            ++numChildrenLeft;
+        }
+    }
+
+    if (numChildrenLeft == 0) {
+        _internalState = State::kReturningResults;
+        return;
+    }
+
+    if (_topK.size() == _limit && _topK.top().first >= scoreBound) {
+        _specificStats.stoppedEarly = true;
+        _specificStats.scoreThreshold = scoreBound;
+        _specificStats.termScansCutShort = numChildrenLeft;
+        _internalState = State::kReturningResults;
+        return;
+    }
+
+    // Read the next posting from the next child which still has some, so that the bounds of all of
+    // the children fall together.
+    do {
+        _currentChild = (_currentChild + 1) % _children.size();
+    } while (_childScoreBounds[_currentChild] == kChildExhausted);
+}
+
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
+    if (_limit > 0) {
+        if (_topK.empty()) {
+            _internalState = State::kDone;
+            return PlanStage::IS_EOF;
+        }
+
+        const auto scoredMember = _topK.top();
+        _topK.pop();
+
+        _ws->get(scoredMember.second)->addComputed(new TextScoreComputedData(scoredMember.first));
+        *out = scoredMember.second;
+        return PlanStage::ADVANCED;
+    }
+
     if (_scoreIterator == _scores.end()) {
         _internalState = State::kDone;
         return PlanStage::IS_EOF;
@@ -299,19 +384,86 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
+    double documentTermScore = fts::FTSIndexFormat::getScoreFromKey(_ftsSpec, newKeyData.keyData);
+
+    // Aggregate relevance score, term keys.
+    textRecordData->score += documentTermScore;
+    return NEED_TIME;
+}
+
+PlanStage::StageState TextOrStage::addTermTopK(WorkingSetID wsid, WorkingSetID* out) {
+    WorkingSetMember* wsm = _ws->get(wsid);
+    invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
+    invariant(1 == wsm->keyData.size());
+    const IndexKeyDatum keyData = wsm->keyData.back();  // copy to keep it around.
+
+    // The postings of each child come in descending order of score, so this posting's score bounds
+    // the scores of all of the postings which this child has yet to return.
+    _childScoreBounds[_currentChild] =
+        fts::FTSIndexFormat::getScoreFromKey(_ftsSpec, keyData.keyData);
+
+    // Every document is scored in full the first time that it is seen, so later postings for it
+    // from the other children can be ignored.
+    const bool firstPosting = _scores.emplace(wsm->recordId, TextRecordData()).second;
+    if (!firstPosting) {
+        _ws->free(wsid);
+        advanceToNextChild();
+        return NEED_TIME;
+    }
+
+    if (!Filter::passes(keyData.keyData, keyData.indexKeyPattern, _filter)) {
+        _ws->free(wsid);
+        advanceToNextChild();
+        return NEED_TIME;
+    }
+
+    try {
+        if (!WorkingSetCommon::fetch(getOpCtx(), _ws, wsid, _recordCursor)) {
+            _ws->free(wsid);
+            advanceToNextChild();
+            return NEED_TIME;
+        }
+        ++_specificStats.fetches;
+    } catch (const WriteConflictException&) {
+        // Forget the document so that it is treated as new again when the posting is retried.
+        _scores.erase(wsm->recordId);
+        wsm->makeObjOwnedIfNeeded();
+        _idRetrying = wsid;
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    if (!_ftsMatcher->matches(wsm->obj.value())) {
+        _ws->free(wsid);
+        advanceToNextChild();
+        return NEED_TIME;
     }
 
-    keyIt.next();  // Skip past 'term'.
+    // Compute the score that the document has across all of the terms, which is the sum of the
+    // scores in its postings.
+    fts::TermFrequencyMap termFrequencies;
+    _ftsSpec.scoreDocument(wsm->obj.value(), &termFrequencies);
+    double score = 0;
+    for (const auto& term : _terms) {
+        auto it = termFrequencies.find(term);
+        if (it != termFrequencies.end()) {
+            score += it->second;
+        }
+    }
 
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
+    if (_topK.size() < _limit) {
+        wsm->makeObjOwnedIfNeeded();
+        _topK.emplace(score, wsid);
+    } else if (score > _topK.top().first) {
+        wsm->makeObjOwnedIfNeeded();
+        _ws->free(_topK.top().second);
+        _topK.pop();
+        _topK.emplace(score, wsid);
+    } else {
+        _ws->free(wsid);
+    }
 
-    // Aggregate relevance score, term keys.
-    textRecordData->score += documentTermScore;
+    advanceToNextChild();
     return NEED_TIME;
 }
 
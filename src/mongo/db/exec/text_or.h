@@ -28,10 +28,16 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <queue>
+#include <string>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/fts/fts_matcher.h"
+#include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/expression.h"
@@ -47,6 +53,13 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
+ * When constructed with a limit, only the documents with the 'limit' highest scores are returned.
+ * The children are then read in turn, and since each of them scans the postings for one term in
+ * descending order of score, the score of the last posting read from each child bounds the score of
+ * the postings it has yet to return. Every new document is fetched and scored exactly against all
+ * of the terms, and reading stops as soon as the best 'limit' documents found so far all score at
+ * least the sum of these bounds, which no document that has not been seen yet can exceed.
+ *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
  */
 class TextOrStage final : public PlanStage {
@@ -73,6 +86,19 @@ public:
                 WorkingSet* ws,
                 const MatchExpression* filter,
                 IndexDescriptor* index);
+
+    /**
+     * Constructs a stage which returns only the 'limit' highest scoring documents which match
+     * 'query', reading the children as described above. 'limit' must be positive.
+     */
+    TextOrStage(OperationContext* opCtx,
+                const FTSSpec& ftsSpec,
+                WorkingSet* ws,
+                const MatchExpression* filter,
+                IndexDescriptor* index,
+                const fts::FTSQueryImpl& query,
+                size_t limit);
+
     ~TextOrStage();
 
     void addChild(std::unique_ptr<PlanStage> child);
@@ -117,6 +143,18 @@ private:
      */
     StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
 
+    /**
+     * Called instead of addTerm() when only the top '_limit' documents are wanted. Scores a
+     * document the first time that it is seen and keeps it if it is among the best found so far.
+     */
+    StageState addTermTopK(WorkingSetID wsid, WorkingSetID* out);
+
+    /**
+     * Moves on to the next child which has not been exhausted yet, or to kReturningResults if the
+     * best '_limit' documents found so far can no longer be beaten by a document not yet seen.
+     */
+    void advanceToNextChild();
+
     /**
      * Worker for kReturningResults. Returns a wsm with RecordID and Score.
      */
@@ -149,6 +187,27 @@ private:
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // Only the '_limit' highest scoring documents are returned if this is non-zero. The members
+    // below are only used in that case.
+    const size_t _limit = 0;
+
+    // The distinct terms which the children scan for, in the form produced by FTSSpec when
+    // scoring a document.
+    std::vector<std::string> _terms;
+
+    // Checks the fetched documents against the whole text query, so that documents which are
+    // later rejected for a phrase or a negated term do not take up one of the '_limit' places.
+    std::unique_ptr<fts::FTSMatcher> _ftsMatcher;
+
+    // The score of the last posting read from each child. This is infinite before the child's
+    // first posting, and negative once the child is exhausted.
+    std::vector<double> _childScoreBounds;
+
+    // The best documents found so far, as (score, wsid) pairs with the lowest score on top.
+    using ScoredMember = std::pair<double, WorkingSetID>;
+    std::priority_queue<ScoredMember, std::vector<ScoredMember>, std::greater<ScoredMember>>
+        _topK;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
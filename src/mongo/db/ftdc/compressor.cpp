@@ -68,20 +68,61 @@ FTDCCompressor::addSample(const BSONObj& sample, Date_t date) {
 
     // We need to flush the current set of samples since the BSON schema has changed.
     if (!swMatches.getValue()) {
-        auto swCompressedSamples = getCompressedSamples();
+        return _changeSchema(sample, date, 0);
+    }
 
-        if (!swCompressedSamples.isOK()) {
-            return swCompressedSamples.getStatus();
-        }
+    return _addDeltas();
+}
 
-        // Set the new sample as the current reference document as we have to start all over
-        _reset(sample, date);
-        return {std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>(
-            std::get<0>(swCompressedSamples.getValue()),
-            CompressorState::kSchemaChanged,
-            std::get<1>(swCompressedSamples.getValue()))};
+StatusWith<boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>
+FTDCCompressor::addSample(const BSONObj& schema,
+                          std::uint64_t schemaVersion,
+                          const std::vector<std::uint64_t>& metrics,
+                          Date_t date) {
+    dassert(schemaVersion != 0);
+
+    _metrics.assign(metrics.begin(), metrics.end());
+
+    if (!_referenceDoc.isEmpty() && schemaVersion == _schemaVersion) {
+        return _addDeltas();
+    }
+
+    // The decompressor reads the first sample of a chunk from its reference document, so it must
+    // hold this sample's values.
+    auto swReferenceDoc = FTDCBSONUtil::constructDocumentFromMetrics(schema, metrics);
+    if (!swReferenceDoc.isOK()) {
+        return swReferenceDoc.getStatus();
+    }
+
+    if (_referenceDoc.isEmpty()) {
+        _reset(swReferenceDoc.getValue(), date, schemaVersion);
+        return {boost::none};
+    }
+
+    return _changeSchema(swReferenceDoc.getValue(), date, schemaVersion);
+}
+
+StatusWith<boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>
+FTDCCompressor::_changeSchema(const BSONObj& referenceDoc,
+                              Date_t date,
+                              std::uint64_t schemaVersion) {
+    auto swCompressedSamples = getCompressedSamples();
+
+    if (!swCompressedSamples.isOK()) {
+        return swCompressedSamples.getStatus();
     }
 
+    // Set the new sample as the current reference document as we have to start all over
+    _reset(referenceDoc, date, schemaVersion);
+    return {std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>(
+        std::get<0>(swCompressedSamples.getValue()),
+        CompressorState::kSchemaChanged,
+        std::get<1>(swCompressedSamples.getValue()))};
+}
+
+StatusWith<boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>
+FTDCCompressor::_addDeltas() {
+    dassert(_metricsCount == _metrics.size());
 
     // Add another sample
     for (std::size_t i = 0; i < _metrics.size(); ++i) {
@@ -222,9 +263,10 @@ void FTDCCompressor::reset() {
     _reset(BSONObj(), Date_t());
 }
 
-void FTDCCompressor::_reset(const BSONObj& referenceDoc, Date_t date) {
+void FTDCCompressor::_reset(const BSONObj& referenceDoc, Date_t date, std::uint64_t schemaVersion) {
     _referenceDoc = referenceDoc;
     _referenceDocDate = date;
+    _schemaVersion = schemaVersion;
 
     _metricsCount = _metrics.size();
     _deltaCount = 0;
@@ -95,6 +95,22 @@ public:
     StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>> addSample(
         const BSONObj& sample, Date_t date);
 
+    /**
+     * Add a sample whose metrics have already been extracted, such as a sample of an
+     * FTDCMetricRegistry. 'metrics' must be laid out in the order in which
+     * FTDCBSONUtil::extractMetricsFromDocument() finds them in 'schema', and all samples with the
+     * same non-zero 'schemaVersion' must share the same schema.
+     *
+     * Unlike the BSON overload, this does not extract or compare documents. A document is only
+     * built from 'schema' and 'metrics' when the sample becomes the reference document of a new
+     * chunk. Returns the same values as the BSON overload.
+     */
+    StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>> addSample(
+        const BSONObj& schema,
+        std::uint64_t schemaVersion,
+        const std::vector<std::uint64_t>& metrics,
+        Date_t date);
+
     /**
      * Returns the number of enqueued samples.
      *
@@ -147,7 +163,19 @@ private:
     /**
      * Reset the state
      */
-    void _reset(const BSONObj& referenceDoc, Date_t date);
+    void _reset(const BSONObj& referenceDoc, Date_t date, std::uint64_t schemaVersion = 0);
+
+    /**
+     * Compress the current chunk, and start a new one with 'referenceDoc', whose metrics are in
+     * '_metrics', as the reference document.
+     */
+    StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>>
+    _changeSchema(const BSONObj& referenceDoc, Date_t date, std::uint64_t schemaVersion);
+
+    /**
+     * Record the deltas between '_metrics' and the previous sample.
+     */
+    StatusWith<boost::optional<std::tuple<ConstDataRange, CompressorState, Date_t>>> _addDeltas();
 
 private:
     // Block Compressor
@@ -159,6 +187,10 @@ private:
     // Reference schema document
     BSONObj _referenceDoc;
 
+    // Version of the schema of the reference document when samples were added with pre-extracted
+    // metrics, 0 otherwise.
+    std::uint64_t _schemaVersion{0};
+
     // Time at which reference schema document was collected.
     // Passed in via addSample and returned with each chunk.
     Date_t _referenceDocDate;
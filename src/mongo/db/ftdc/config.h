@@ -45,6 +45,7 @@ struct FTDCConfig {
           maxDirectorySizeBytes(kMaxDirectorySizeBytesDefault),
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
+          registryPeriod(kRegistryPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
           maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
 
@@ -72,6 +73,16 @@ struct FTDCConfig {
      */
     Milliseconds period;
 
+    /**
+     * Period at which to sample the FTDCMetricRegistry, if any. Zero, the default, disables
+     * sampling it.
+     *
+     * Registry samples are cheap enough to be taken more often than the BSON collectors run. They
+     * are written to a subdirectory of their own, which is bounded by the same size limits as the
+     * main one, so enabling them can double the disk space FTDC uses.
+     */
+    Milliseconds registryPeriod;
+
     /**
      * Maximum number of samples to collect in an archive metric chunk for long term storage.
      */
@@ -86,6 +97,7 @@ struct FTDCConfig {
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
+    static const std::int64_t kRegistryPeriodMillisDefault;
     static const std::uint64_t kMaxDirectorySizeBytesDefault = 200 * 1024 * 1024;
     static const std::uint64_t kMaxFileSizeBytesDefault = 10 * 1024 * 1024;
 
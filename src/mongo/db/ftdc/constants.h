@@ -35,6 +35,9 @@ namespace mongo {
 extern const char kFTDCInterimFile[];
 extern const char kFTDCArchiveFile[];
 
+// Subdirectory of the FTDC directory that holds the files of FTDCMetricRegistry samples
+extern const char kFTDCRegistryDirectory[];
+
 extern const char kFTDCIdField[];
 extern const char kFTDCTypeField[];
 
@@ -46,6 +49,8 @@ extern const char kFTDCDocsField[];
 extern const char kFTDCCollectStartField[];
 extern const char kFTDCCollectEndField[];
 
+extern const char kFTDCRegistryField[];
+
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
 }  // namespace mongo
@@ -32,8 +32,11 @@
 
 #include "mongo/db/ftdc/controller.h"
 
+#include <algorithm>
+
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/stdx/condition_variable.h"
@@ -68,6 +71,12 @@ void FTDCController::setPeriod(Milliseconds millis) {
     _condvar.notify_one();
 }
 
+void FTDCController::setRegistryPeriod(Milliseconds millis) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.registryPeriod = millis;
+    _condvar.notify_one();
+}
+
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
@@ -127,6 +136,13 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::setMetricRegistry(FTDCMetricRegistry* registry) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    invariant(_state == State::kNotStarted);
+
+    _registry = registry;
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
@@ -181,6 +197,14 @@ void FTDCController::stop() {
             log() << "Failed to close full-time diagnostic data capture file manager: " << s;
         }
     }
+
+    if (_registryMgr) {
+        auto s = _registryMgr->close();
+        if (!s.isOK()) {
+            log() << "Failed to close full-time diagnostic data capture registry file manager: "
+                  << s;
+        }
+    }
 }
 
 void FTDCController::doLoop() {
@@ -200,7 +224,17 @@ void FTDCController::doLoop() {
             auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
 
             // Get next time to run at
-            auto next_time = FTDCUtil::roundTime(now, _config.period);
+            auto next_periodic_time = FTDCUtil::roundTime(now, _config.period);
+            auto next_time = next_periodic_time;
+
+            // The registry is sampled on its own, usually shorter, period. The two periods are
+            // rounded the same way, so when one divides the other both run together.
+            const bool sampleRegistry = _registry && _config.registryPeriod > Milliseconds(0);
+            auto next_registry_time = Date_t::max();
+            if (sampleRegistry) {
+                next_registry_time = FTDCUtil::roundTime(now, _config.registryPeriod);
+                next_time = std::min(next_time, next_registry_time);
+            }
 
             // Wait for the next run or signal to shutdown
             {
@@ -241,17 +275,46 @@ void FTDCController::doLoop() {
                     _mgr = uassertStatusOK(std::move(swMgr));
                 }
 
-                auto collectSample = _periodicCollectors.collect(client);
+                if (next_time == next_registry_time && !_registry->empty()) {
+                    if (!_registryMgr) {
+                        auto swMgr = FTDCFileManager::create(
+                            &_config, _path / kFTDCRegistryDirectory, &_rotateCollectors, client);
+
+                        _registryMgr = uassertStatusOK(std::move(swMgr));
+                    }
+
+                    // Snapshot the typed metrics straight into an array of numbers, without
+                    // building a BSON document.
+                    auto sampleTime = getGlobalServiceContext()->getPreciseClockSource()->now();
+                    _registrySchemaVersion =
+                        _registry->sample(sampleTime,
+                                          _registrySchemaVersion,
+                                          &_registrySchema,
+                                          &_registryMetrics);
+
+                    Status s =
+                        _registryMgr->writeRegistrySampleAndRotateIfNeeded(client,
+                                                                           _registrySchema,
+                                                                           _registrySchemaVersion,
+                                                                           _registryMetrics,
+                                                                           sampleTime);
+
+                    uassertStatusOK(s);
+                }
+
+                if (next_time == next_periodic_time) {
+                    auto collectSample = _periodicCollectors.collect(client);
 
-                Status s = _mgr->writeSampleAndRotateIfNeeded(
-                    client, std::get<0>(collectSample), std::get<1>(collectSample));
+                    Status s = _mgr->writeSampleAndRotateIfNeeded(
+                        client, std::get<0>(collectSample), std::get<1>(collectSample));
 
-                uassertStatusOK(s);
+                    uassertStatusOK(s);
 
-                // Store a reference to the most recent document from the periodic collectors
-                {
-                    stdx::lock_guard<stdx::mutex> lock(_mutex);
-                    _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                    // Store a reference to the most recent document from the periodic collectors
+                    {
+                        stdx::lock_guard<stdx::mutex> lock(_mutex);
+                        _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                    }
                 }
             }
         }
@@ -31,11 +31,13 @@
 #include <boost/filesystem/path.hpp>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/file_manager.h"
+#include "mongo/db/ftdc/metric_registry.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
@@ -74,6 +76,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the period for sampling the FTDCMetricRegistry. Zero disables sampling it.
+     */
+    void setRegistryPeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -117,6 +124,11 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Set the registry of typed metrics to sample every registry period. Not owned.
+     */
+    void setMetricRegistry(FTDCMetricRegistry* registry);
+
     /**
      * Start the controller.
      *
@@ -203,12 +215,27 @@ private:
     // Owned
     BSONObj _mostRecentPeriodicDocument;
 
+    // Registry of typed metrics, sampled every registry period
+    // Not owned
+    FTDCMetricRegistry* _registry{nullptr};
+
+    // Schema of the most recent registry sample, and its version
+    BSONObj _registrySchema;
+    std::uint64_t _registrySchemaVersion{0};
+
+    // Buffer for the metrics of registry samples
+    std::vector<std::uint64_t> _registryMetrics;
+
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
+    // File manager for the FTDCMetricRegistry samples. They are written to their own files, in
+    // a subdirectory of _path, so every file holds a single stream of samples.
+    std::unique_ptr<FTDCFileManager> _registryMgr;
+
     // Background collection and writing thread
     stdx::thread _thread;
 };
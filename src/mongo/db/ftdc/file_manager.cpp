@@ -306,6 +306,25 @@ Status FTDCFileManager::writeSampleAndRotateIfNeeded(Client* client,
     return Status::OK();
 }
 
+Status FTDCFileManager::writeRegistrySampleAndRotateIfNeeded(
+    Client* client,
+    const BSONObj& schema,
+    std::uint64_t schemaVersion,
+    const std::vector<std::uint64_t>& metrics,
+    Date_t date) {
+    Status s = _writer.writeRegistrySample(schema, schemaVersion, metrics, date);
+
+    if (!s.isOK()) {
+        return s;
+    }
+
+    if (_writer.getSize() > _config->maxFileSizeBytes) {
+        return rotate(client);
+    }
+
+    return Status::OK();
+}
+
 Status FTDCFileManager::close() {
     return _writer.close();
 }
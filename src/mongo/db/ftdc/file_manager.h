@@ -84,6 +84,17 @@ public:
      */
     Status writeSampleAndRotateIfNeeded(Client* client, const BSONObj& sample, Date_t date);
 
+    /**
+     * Writes a sample of an FTDCMetricRegistry to disk via FTDCFileWriter.
+     *
+     * Rotates files as needed.
+     */
+    Status writeRegistrySampleAndRotateIfNeeded(Client* client,
+                                                const BSONObj& schema,
+                                                std::uint64_t schemaVersion,
+                                                const std::vector<std::uint64_t>& metrics,
+                                                Date_t date);
+
     /**
      * Closes the current file manager down.
      */
@@ -152,8 +152,20 @@ Status FTDCFileWriter::writeMetadata(const BSONObj& metadata, Date_t date) {
 }
 
 Status FTDCFileWriter::writeSample(const BSONObj& sample, Date_t date) {
-    auto ret = _compressor.addSample(sample, date);
+    return handleAddSampleResult(_compressor.addSample(sample, date));
+}
+
+Status FTDCFileWriter::writeRegistrySample(const BSONObj& schema,
+                                           std::uint64_t schemaVersion,
+                                           const std::vector<std::uint64_t>& metrics,
+                                           Date_t date) {
+    return handleAddSampleResult(_compressor.addSample(schema, schemaVersion, metrics, date));
+}
 
+Status FTDCFileWriter::handleAddSampleResult(
+    StatusWith<boost::optional<std::tuple<ConstDataRange,
+                                          FTDCCompressor::CompressorState,
+                                          Date_t>>> ret) {
     if (!ret.isOK()) {
         return ret.getStatus();
     }
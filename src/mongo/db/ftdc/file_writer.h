@@ -79,6 +79,18 @@ public:
      */
     Status writeSample(const BSONObj& sample, Date_t date);
 
+    /**
+     * Write a sample of an FTDCMetricRegistry to interim and/or archive log as needed. See
+     * FTDCCompressor::addSample() for the meaning of the arguments.
+     *
+     * A file should hold either registry samples or BSON samples, not both: the compressor starts a
+     * new chunk every time it switches between them.
+     */
+    Status writeRegistrySample(const BSONObj& schema,
+                               std::uint64_t schemaVersion,
+                               const std::vector<std::uint64_t>& metrics,
+                               Date_t date);
+
     /**
      * Close all the files and shutdown cleanly by zeroing the beginning of the interim file.
      */
@@ -100,6 +112,15 @@ public:
     void closeWithoutFlushForTest();
 
 private:
+    /**
+     * Flushes a full chunk returned by the compressor, or writes the current chunk to the interim
+     * file if it is time to.
+     */
+    Status handleAddSampleResult(
+        StatusWith<boost::optional<std::tuple<ConstDataRange,
+                                              FTDCCompressor::CompressorState,
+                                              Date_t>>> ret);
+
     /**
      * Flush all changes to disk.
      */
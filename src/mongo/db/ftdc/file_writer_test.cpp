@@ -151,6 +151,33 @@ TEST_F(FTDCFileTest, TestFileBasicCompress) {
     ASSERT_EQUALS(sw.getValue(), false);
 }
 
+// Registry samples are read back by the same reader as BSON samples
+TEST_F(FTDCFileTest, TestFileRegistrySamples) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path p(tempdir.path());
+    p /= kTestFile;
+
+    deleteFileIfNeeded(p);
+
+    BSONObj schema = BSON("start" << Date_t() << "registry" << BSON("ops" << 0LL));
+
+    FTDCConfig config;
+    FTDCFileWriter writer(&config);
+
+    ASSERT_OK(writer.open(p));
+
+    ASSERT_OK(writer.writeRegistrySample(schema, 1, {100, 7}, Date_t()));
+    ASSERT_OK(writer.writeRegistrySample(schema, 1, {200, 9}, Date_t()));
+
+    writer.close().transitional_ignore();
+
+    ValidateDocumentList(
+        p,
+        {BSON("start" << Date_t::fromMillisSinceEpoch(100) << "registry" << BSON("ops" << 7LL)),
+         BSON("start" << Date_t::fromMillisSinceEpoch(200) << "registry" << BSON("ops" << 9LL))},
+        FTDCValidationMode::kStrict);
+}
+
 /**
  * Validates all the data that gets written to file is returned as is
  */
@@ -41,10 +41,13 @@
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_system_stats.h"
+#include "mongo/db/ftdc/metric_registry.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/transport/service_entry_point.h"
 
 namespace mongo {
 
@@ -110,6 +113,34 @@ public:
 
 } exportedFTDCPeriodParameter;
 
+AtomicInt32 localRegistryPeriodMillis(FTDCConfig::kRegistryPeriodMillisDefault);
+
+class ExportedFTDCRegistryPeriodParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCRegistryPeriodParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionRegistryPeriodMillis",
+              &localRegistryPeriodMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue != 0 && potentialNewValue < 10) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionRegistryPeriodMillis must be 0, to disable "
+                          "sampling the metric registry, or greater than or equal to 10ms");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setRegistryPeriod(Milliseconds(potentialNewValue));
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCRegistryPeriodParameter;
+
 // Scale the values down since are defaults are in bytes, but the user interface is MB
 AtomicInt32 localMaxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024));
 
@@ -261,6 +292,45 @@ std::string FTDCSimpleInternalCommandCollector::name() const {
     return _name;
 }
 
+namespace {
+
+void registerOpCounters(FTDCMetricRegistry* registry,
+                        StringData prefix,
+                        const OpCounters& counters) {
+    auto registerCounter = [&](StringData name, const AtomicUInt32* counter) {
+        registry->registerCallbackGauge(prefix.toString() + "." + name,
+                                        [counter] { return counter->load(); });
+    };
+    registerCounter("insert", counters.getInsert());
+    registerCounter("query", counters.getQuery());
+    registerCounter("update", counters.getUpdate());
+    registerCounter("delete", counters.getDelete());
+    registerCounter("getmore", counters.getGetMore());
+    registerCounter("command", counters.getCommand());
+}
+
+void registerNetworkCounters(FTDCMetricRegistry* registry) {
+    auto registerCounter = [&](StringData name, const AtomicInt64* counter) {
+        registry->registerCallbackGauge("network." + name.toString(),
+                                        [counter] { return counter->loadRelaxed(); });
+    };
+    registerCounter("bytesIn", networkCounter.getLogicalBytesIn());
+    registerCounter("bytesOut", networkCounter.getLogicalBytesOut());
+    registerCounter("physicalBytesIn", networkCounter.getPhysicalBytesIn());
+    registerCounter("physicalBytesOut", networkCounter.getPhysicalBytesOut());
+    registerCounter("numRequests", networkCounter.getRequests());
+}
+
+void registerConnections(FTDCMetricRegistry* registry) {
+    registry->registerCallbackGauge("connections.current", []() -> long long {
+        // The service entry point is set up after FTDC starts.
+        auto sep = getGlobalServiceContext()->getServiceEntryPoint();
+        return sep ? sep->numOpenSessions() : 0;
+    });
+}
+
+}  // namespace
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -270,6 +340,7 @@ void startFTDC(boost::filesystem::path& path,
                RegisterCollectorsFunction registerCollectors) {
     FTDCConfig config;
     config.period = Milliseconds(localPeriodMillis.load());
+    config.registryPeriod = Milliseconds(localRegistryPeriodMillis.load());
     // Only enable FTDC if our caller says to enable FTDC, MongoS may not have a valid path to write
     // files to so update the diagnosticDataCollectionEnabled set parameter to reflect that.
     localEnabledFlag.store(startupMode == FTDCStartMode::kStart && localEnabledFlag.load());
@@ -305,6 +376,15 @@ void startFTDC(boost::filesystem::path& path,
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    // Sample the typed metrics of the process on the registry period. These are also in
+    // serverStatus, but change too quickly for its period to show bursts.
+    auto registry = FTDCMetricRegistry::getGlobal();
+    registerOpCounters(registry, "opcounters", globalOpCounters);
+    registerOpCounters(registry, "opcountersRepl", replOpCounters);
+    registerNetworkCounters(registry);
+    registerConnections(registry);
+    controller->setMetricRegistry(registry);
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
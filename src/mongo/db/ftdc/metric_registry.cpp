@@ -0,0 +1,206 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/metric_registry.h"
+
+#include <algorithm>
+
+#include "mongo/db/ftdc/constants.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+std::vector<StringData> splitPath(StringData path) {
+    std::vector<StringData> parts;
+    size_t start = 0;
+    while (true) {
+        const size_t dot = path.find('.', start);
+        parts.push_back(path.substr(start, dot == std::string::npos ? dot : dot - start));
+        if (dot == std::string::npos) {
+            return parts;
+        }
+        start = dot + 1;
+    }
+}
+
+/**
+ * Returns true if 'prefix' names a parent document of 'path'.
+ */
+bool isParentPath(StringData prefix, StringData path) {
+    return path.size() > prefix.size() && path.startsWith(prefix) && path[prefix.size()] == '.';
+}
+
+}  // namespace
+
+FTDCMetricRegistry::FTDCMetricRegistry() {
+    _rebuildSchema();
+}
+
+FTDCMetricRegistry* FTDCMetricRegistry::getGlobal() {
+    static auto* const globalRegistry = new FTDCMetricRegistry();
+    return globalRegistry;
+}
+
+FTDCCounter* FTDCMetricRegistry::registerCounter(StringData path) {
+    return static_cast<FTDCCounter*>(_register(
+        path, FTDCMetric::Type::kCounter, [] { return stdx::make_unique<FTDCCounter>(); }));
+}
+
+FTDCGauge* FTDCMetricRegistry::registerGauge(StringData path) {
+    return static_cast<FTDCGauge*>(_register(
+        path, FTDCMetric::Type::kGauge, [] { return stdx::make_unique<FTDCGauge>(); }));
+}
+
+void FTDCMetricRegistry::registerCallbackGauge(StringData path,
+                                               stdx::function<long long()> callback) {
+    _register(path, FTDCMetric::Type::kCallbackGauge, [&] {
+        return stdx::make_unique<FTDCCallbackGauge>(std::move(callback));
+    });
+}
+
+bool FTDCMetricRegistry::empty() const {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    return _metrics.empty();
+}
+
+FTDCMetric* FTDCMetricRegistry::_register(
+    StringData path,
+    FTDCMetric::Type type,
+    const stdx::function<std::unique_ptr<FTDCMetric>()>& makeMetric) {
+    for (auto part : splitPath(path)) {
+        uassert(50974,
+                str::stream() << "Invalid FTDC metric path '" << path << "'",
+                !part.empty() && part[0] != '$');
+    }
+
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+
+    auto it = _metrics.lower_bound(path.toString());
+    if (it != _metrics.end() && it->first == path) {
+        uassert(50973,
+                str::stream() << "FTDC callback gauge '" << path << "' is already registered",
+                type != FTDCMetric::Type::kCallbackGauge);
+        uassert(50975,
+                str::stream() << "FTDC metric '" << path
+                              << "' is already registered with a different type",
+                it->second->getType() == type);
+        return it->second.get();
+    }
+
+    // A path cannot be both a metric and a document of metrics. Paths which 'path' is a prefix of
+    // sort right after it, and its parents sort before it.
+    bool hasChild = false;
+    for (auto next = it; next != _metrics.end() && StringData(next->first).startsWith(path);
+         ++next) {
+        hasChild = hasChild || isParentPath(path, next->first);
+    }
+    const bool hasParent = std::any_of(_metrics.begin(), it, [&](const auto& entry) {
+        return isParentPath(entry.first, path);
+    });
+    uassert(50976,
+            str::stream() << "FTDC metric '" << path
+                          << "' conflicts with the path of another registered metric",
+            !hasChild && !hasParent);
+
+    auto metric = _metrics.emplace_hint(it, path.toString(), makeMetric())->second.get();
+    _rebuildSchema();
+    return metric;
+}
+
+void FTDCMetricRegistry::_rebuildSchema() {
+    BSONObjBuilder builder;
+    builder.appendDate(kFTDCCollectStartField, Date_t());
+
+    BSONObjBuilder registryBuilder(builder.subobjStart(kFTDCRegistryField));
+
+    // Builders of the documents enclosing the current metric, outermost first, along with their
+    // field names.
+    std::vector<std::unique_ptr<BSONObjBuilder>> open;
+    std::vector<StringData> openNames;
+
+    _ordered.clear();
+    for (const auto& entry : _metrics) {
+        auto parts = splitPath(entry.first);
+
+        // Close the documents which do not enclose this metric, then open the missing ones.
+        size_t common = 0;
+        while (common < openNames.size() && common + 1 < parts.size() &&
+               openNames[common] == parts[common]) {
+            ++common;
+        }
+        while (open.size() > common) {
+            open.back()->done();
+            open.pop_back();
+            openNames.pop_back();
+        }
+        for (size_t i = common; i + 1 < parts.size(); ++i) {
+            auto& parent = open.empty() ? registryBuilder : *open.back();
+            open.push_back(stdx::make_unique<BSONObjBuilder>(parent.subobjStart(parts[i])));
+            openNames.push_back(parts[i]);
+        }
+
+        auto& parent = open.empty() ? registryBuilder : *open.back();
+        parent.append(parts.back(), 0LL);
+        _ordered.push_back(entry.second.get());
+    }
+    while (!open.empty()) {
+        open.back()->done();
+        open.pop_back();
+    }
+    registryBuilder.done();
+
+    _schema = builder.obj();
+    ++_schemaVersion;
+}
+
+std::uint64_t FTDCMetricRegistry::sample(Date_t date,
+                                         std::uint64_t knownSchemaVersion,
+                                         BSONObj* schema,
+                                         std::vector<std::uint64_t>* metrics) const {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+
+    if (knownSchemaVersion != _schemaVersion) {
+        *schema = _schema;
+    }
+
+    metrics->resize(_ordered.size() + 1);
+    (*metrics)[0] = date.toMillisSinceEpoch();
+    for (size_t i = 0; i < _ordered.size(); ++i) {
+        (*metrics)[i + 1] = _ordered[i]->get();
+    }
+
+    return _schemaVersion;
+}
+
+}  // namespace mongo
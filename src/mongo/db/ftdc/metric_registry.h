@@ -0,0 +1,225 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+/**
+ * A single metric in an FTDCMetricRegistry.
+ */
+class FTDCMetric {
+    MONGO_DISALLOW_COPYING(FTDCMetric);
+
+public:
+    enum class Type { kCounter, kGauge, kCallbackGauge };
+
+    virtual ~FTDCMetric() = default;
+
+    virtual Type getType() const = 0;
+
+    /**
+     * Returns the current value of the metric. Called by the FTDC thread on every sample.
+     */
+    virtual long long get() const = 0;
+
+protected:
+    FTDCMetric() = default;
+};
+
+/**
+ * A monotonically increasing count, such as the number of operations of some kind.
+ */
+class FTDCCounter final : public FTDCMetric {
+public:
+    Type getType() const final {
+        return Type::kCounter;
+    }
+
+    long long get() const final {
+        return _value.load();
+    }
+
+    void increment(long long n = 1) {
+        _value.fetchAndAdd(n);
+    }
+
+private:
+    AtomicWord<long long> _value;
+};
+
+/**
+ * A value which can go up and down, such as the number of operations in progress.
+ */
+class FTDCGauge final : public FTDCMetric {
+public:
+    Type getType() const final {
+        return Type::kGauge;
+    }
+
+    long long get() const final {
+        return _value.load();
+    }
+
+    void set(long long value) {
+        _value.store(value);
+    }
+
+    void add(long long n) {
+        _value.fetchAndAdd(n);
+    }
+
+private:
+    AtomicWord<long long> _value;
+};
+
+/**
+ * A gauge whose value is computed by a function when FTDC takes a sample. Used to expose values
+ * which are already tracked elsewhere, such as opcounters. The function must be cheap and must
+ * not block, since it runs on every sample.
+ */
+class FTDCCallbackGauge final : public FTDCMetric {
+public:
+    explicit FTDCCallbackGauge(stdx::function<long long()> callback)
+        : _callback(std::move(callback)) {}
+
+    Type getType() const final {
+        return Type::kCallbackGauge;
+    }
+
+    long long get() const final {
+        return _callback();
+    }
+
+private:
+    const stdx::function<long long()> _callback;
+};
+
+/**
+ * A set of typed metrics which FTDC samples without building a BSON document per sample.
+ *
+ * Metrics are identified by dotted paths, such as "opcounters.insert", and are never removed once
+ * registered, so the returned pointers stay valid for the lifetime of the registry. Registering
+ * and sampling are thread-safe. Updating a metric never takes a lock.
+ *
+ * The metrics of a sample are laid out in the order in which
+ * FTDCBSONUtil::extractMetricsFromDocument() finds them in the schema document:
+ * {
+ *    "start" : Date_t,    <- Time at which the sample was taken
+ *    "registry" : {
+ *       "opcounters" : {
+ *          "insert" : NumberLong,
+ *          ...
+ *       },
+ *       ...
+ *    }
+ * }
+ * so FTDC can compress samples as arrays of numbers, and only turn them into BSON documents once
+ * per metric chunk.
+ */
+class FTDCMetricRegistry {
+    MONGO_DISALLOW_COPYING(FTDCMetricRegistry);
+
+public:
+    FTDCMetricRegistry();
+
+    /**
+     * Returns the registry of the process, which the FTDC controller samples.
+     */
+    static FTDCMetricRegistry* getGlobal();
+
+    /**
+     * Register a metric, or return the existing one if a metric of the same type is already
+     * registered with the same path.
+     *
+     * Throws if 'path' is invalid, is registered with a different type, or is a prefix of another
+     * metric's path or vice versa.
+     */
+    FTDCCounter* registerCounter(StringData path);
+    FTDCGauge* registerGauge(StringData path);
+
+    /**
+     * Register a callback gauge. Throws if 'path' is already registered.
+     */
+    void registerCallbackGauge(StringData path, stdx::function<long long()> callback);
+
+    /**
+     * Returns true if no metrics have been registered.
+     */
+    bool empty() const;
+
+    /**
+     * Reads the current value of every metric into 'metrics', preceded by 'date', replacing its
+     * contents. Returns the version of the schema the values are laid out in. The version changes
+     * whenever a metric is registered, and is never 0.
+     *
+     * If the version differs from 'knownSchemaVersion', also sets 'schema' to the current schema
+     * document.
+     */
+    std::uint64_t sample(Date_t date,
+                         std::uint64_t knownSchemaVersion,
+                         BSONObj* schema,
+                         std::vector<std::uint64_t>* metrics) const;
+
+private:
+    FTDCMetric* _register(StringData path,
+                          FTDCMetric::Type type,
+                          const stdx::function<std::unique_ptr<FTDCMetric>()>& makeMetric);
+
+    /**
+     * Rebuilds '_schema' and '_ordered' from '_metrics'.
+     */
+    void _rebuildSchema();
+
+    mutable stdx::mutex _mutex;
+
+    // All metrics, by path. Ordered so that metrics which share a path prefix are adjacent, which
+    // is the order in which they appear in the schema document.
+    std::map<std::string, std::unique_ptr<FTDCMetric>> _metrics;
+
+    // The metrics of '_metrics' in the same order, to avoid walking the map on every sample.
+    std::vector<const FTDCMetric*> _ordered;
+
+    BSONObj _schema;
+    std::uint64_t _schemaVersion{0};
+};
+
+}  // namespace mongo
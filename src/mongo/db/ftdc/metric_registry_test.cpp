@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/compressor.h"
+#include "mongo/db/ftdc/config.h"
+#include "mongo/db/ftdc/decompressor.h"
+#include "mongo/db/ftdc/ftdc_test.h"
+#include "mongo/db/ftdc/metric_registry.h"
+#include "mongo/db/ftdc/util.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj sampleToBSON(const FTDCMetricRegistry& registry, Date_t date) {
+    BSONObj schema;
+    std::vector<std::uint64_t> metrics;
+    registry.sample(date, 0, &schema, &metrics);
+    return uassertStatusOK(FTDCBSONUtil::constructDocumentFromMetrics(schema, metrics));
+}
+
+TEST(FTDCMetricRegistryTest, SchemaNestsMetricsByPath) {
+    FTDCMetricRegistry registry;
+    registry.registerCounter("b.y")->increment(3);
+    registry.registerGauge("a")->set(-1);
+    registry.registerCounter("b.x.z")->increment();
+    registry.registerCallbackGauge("b-c", [] { return 7LL; });
+    registry.registerGauge("b.w")->add(5);
+
+    ASSERT_BSONOBJ_EQ(
+        sampleToBSON(registry, Date_t::fromMillisSinceEpoch(42)),
+        BSON("start" << Date_t::fromMillisSinceEpoch(42) << "registry"
+                     << BSON("a" << -1LL << "b-c" << 7LL << "b"
+                                 << BSON("w" << 5LL << "x" << BSON("z" << 1LL) << "y" << 3LL))));
+}
+
+TEST(FTDCMetricRegistryTest, RegisteringSamePathReturnsSameMetric) {
+    FTDCMetricRegistry registry;
+    auto counter = registry.registerCounter("a.b");
+    ASSERT_EQUALS(counter, registry.registerCounter("a.b"));
+    ASSERT_THROWS_CODE(registry.registerGauge("a.b"), AssertionException, 50975);
+
+    registry.registerCallbackGauge("a.c", [] { return 0LL; });
+    ASSERT_THROWS_CODE(
+        registry.registerCallbackGauge("a.c", [] { return 0LL; }), AssertionException, 50973);
+}
+
+TEST(FTDCMetricRegistryTest, RejectsConflictingAndInvalidPaths) {
+    FTDCMetricRegistry registry;
+    registry.registerCounter("a.b");
+    registry.registerCounter("a-b");
+
+    ASSERT_THROWS_CODE(registry.registerCounter("a"), AssertionException, 50976);
+    ASSERT_THROWS_CODE(registry.registerCounter("a.b.c"), AssertionException, 50976);
+    ASSERT_THROWS_CODE(registry.registerCounter(""), AssertionException, 50974);
+    ASSERT_THROWS_CODE(registry.registerCounter("a..b"), AssertionException, 50974);
+    ASSERT_THROWS_CODE(registry.registerCounter("a.$b"), AssertionException, 50974);
+}
+
+TEST(FTDCMetricRegistryTest, SchemaVersionChangesOnRegistration) {
+    FTDCMetricRegistry registry;
+    registry.registerCounter("a");
+
+    BSONObj schema;
+    std::vector<std::uint64_t> metrics;
+    auto version = registry.sample(Date_t(), 0, &schema, &metrics);
+    ASSERT_NOT_EQUALS(version, 0U);
+    ASSERT_EQUALS(metrics.size(), 2U);
+
+    // The schema is only returned when it changed.
+    BSONObj unchanged;
+    ASSERT_EQUALS(registry.sample(Date_t(), version, &unchanged, &metrics), version);
+    ASSERT_TRUE(unchanged.isEmpty());
+
+    registry.registerCounter("a");
+    ASSERT_EQUALS(registry.sample(Date_t(), version, &unchanged, &metrics), version);
+
+    registry.registerCounter("b");
+    ASSERT_NOT_EQUALS(registry.sample(Date_t(), version, &schema, &metrics), version);
+    ASSERT_EQUALS(metrics.size(), 3U);
+}
+
+// Registry samples compressed without building BSON must decompress to the same documents as if
+// each sample had been built as BSON.
+TEST(FTDCMetricRegistryTest, CompressedSamplesRoundTrip) {
+    FTDCConfig config;
+    config.maxSamplesPerArchiveMetricChunk = 10;
+    FTDCCompressor compressor(&config);
+    FTDCDecompressor decompressor;
+
+    FTDCMetricRegistry registry;
+    auto counter = registry.registerCounter("ops.total");
+    auto gauge = registry.registerGauge("ops.active");
+
+    BSONObj schema;
+    std::uint64_t version = 0;
+    std::vector<std::uint64_t> metrics;
+    std::vector<BSONObj> expected;
+    std::vector<BSONObj> actual;
+
+    auto addSample = [&](int i) {
+        const auto date = Date_t::fromMillisSinceEpoch(i * 100);
+        version = registry.sample(date, version, &schema, &metrics);
+        expected.push_back(sampleToBSON(registry, date));
+
+        auto st = compressor.addSample(schema, version, metrics, date);
+        ASSERT_OK(st.getStatus());
+        if (st.getValue()) {
+            auto docs = decompressor.uncompress(std::get<0>(st.getValue().get()));
+            ASSERT_OK(docs.getStatus());
+            actual.insert(actual.end(), docs.getValue().begin(), docs.getValue().end());
+        }
+    };
+
+    for (int i = 0; i < 25; ++i) {
+        counter->increment(i);
+        gauge->set(i % 3);
+        addSample(i);
+    }
+
+    // A new metric changes the schema, which starts a new chunk.
+    auto late = registry.registerCounter("ops.late");
+    for (int i = 25; i < 30; ++i) {
+        late->increment();
+        addSample(i);
+    }
+
+    auto swBuf = compressor.getCompressedSamples();
+    ASSERT_OK(swBuf.getStatus());
+    auto docs = decompressor.uncompress(std::get<0>(swBuf.getValue()));
+    ASSERT_OK(docs.getStatus());
+    actual.insert(actual.end(), docs.getValue().begin(), docs.getValue().end());
+
+    ValidateDocumentList(actual, expected, FTDCValidationMode::kStrict);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -51,6 +51,7 @@ namespace mongo {
 const char kFTDCInterimFile[] = "metrics.interim";
 const char kFTDCInterimTempFile[] = "metrics.interim.temp";
 const char kFTDCArchiveFile[] = "metrics";
+const char kFTDCRegistryDirectory[] = "registry";
 
 const char kFTDCIdField[] = "_id";
 const char kFTDCTypeField[] = "type";
@@ -63,7 +64,10 @@ const char kFTDCDocsField[] = "docs";
 const char kFTDCCollectStartField[] = "start";
 const char kFTDCCollectEndField[] = "end";
 
+const char kFTDCRegistryField[] = "registry";
+
 const std::int64_t FTDCConfig::kPeriodMillisDefault = 1000;
+const std::int64_t FTDCConfig::kRegistryPeriodMillisDefault = 0;
 
 const std::size_t kMaxRecursion = 10;
 
@@ -230,6 +230,18 @@ BSONObj FTSIndexFormat::getIndexKey(double weight,
     return b.obj();
 }
 
+double FTSIndexFormat::getScoreFromKey(const FTSSpec& spec, const BSONObj& indexKey) {
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(indexKey);
+    for (unsigned i = 0; i < spec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    return keyIt.next().number();
+}
+
 void FTSIndexFormat::_appendIndexKey(BSONObjBuilder& b,
                                      double weight,
                                      const string& term,
@@ -58,6 +58,13 @@ public:
                                const BSONObj& indexPrefix,
                                TextIndexVersion textIndexVersion);
 
+    /**
+     * Returns the term score stored in 'indexKey', a key generated by getKeys() for 'spec'. Keys
+     * for the same term are ordered by this score, so the score of the last key read by a
+     * descending scan over a term bounds the score of every key that the scan has yet to return.
+     */
+    static double getScoreFromKey(const FTSSpec& spec, const BSONObj& indexKey);
+
 private:
     /**
      * Helper method to get return entry from the FTSIndex as a BSONObj
@@ -108,6 +108,33 @@ TEST(FTSIndexFormat, ExtraFront1) {
     ASSERT(i.next().numberDouble() > 0);
 }
 
+TEST(FTSIndexFormat, GetScoreFromKeyMatchesDocumentScore) {
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("x" << 1 << "data"
+                                                                   << "text"
+                                                                   << "y"
+                                                                   << 1)))));
+    BSONObj document = BSON("data"
+                            << "cat cat dog"
+                            << "x"
+                            << 5
+                            << "y"
+                            << 7);
+    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    FTSIndexFormat::getKeys(spec, document, &keys);
+
+    TermFrequencyMap termFrequencies;
+    spec.scoreDocument(document, &termFrequencies);
+
+    ASSERT_EQUALS(2U, keys.size());
+    for (const auto& key : keys) {
+        BSONObjIterator i(key);
+        i.next();  // Skip past the prefix field.
+        const auto term = i.next().String();
+        ASSERT_EQUALS(termFrequencies[term], FTSIndexFormat::getScoreFromKey(spec, key));
+    }
+    ASSERT_GREATER_THAN(termFrequencies["cat"], termFrequencies["dog"]);
+}
+
 TEST(FTSIndexFormat, StopWords1) {
     FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("data"
                                                                << "text")))));
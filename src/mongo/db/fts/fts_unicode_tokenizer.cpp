@@ -35,6 +35,8 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/stop_words.h"
 #include "mongo/db/fts/tokenizer.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
+#include "mongo/db/fts/unicode/codepoints.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
@@ -44,6 +46,65 @@ namespace fts {
 
 using std::string;
 
+namespace {
+
+/**
+ * Per-byte answers to the codepoint queries the tokenizer makes, for the ASCII range.
+ */
+struct AsciiTables {
+    AsciiTables() {
+        for (char32_t c = 0; c < 128; ++c) {
+            englishDelimiter[c] =
+                unicode::codepointIsDelimiter(c, unicode::DelimiterListLanguage::kEnglish);
+            otherDelimiter[c] =
+                unicode::codepointIsDelimiter(c, unicode::DelimiterListLanguage::kNotEnglish);
+            diacritic[c] = unicode::codepointIsDiacritic(c);
+        }
+    }
+
+    bool englishDelimiter[128];
+    bool otherDelimiter[128];
+    bool diacritic[128];
+};
+
+const AsciiTables& asciiTables() {
+    static const AsciiTables tables;
+    return tables;
+}
+
+bool isAscii(StringData str) {
+    const char* it = str.rawData();
+    const char* const end = it + str.size();
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    using unicode::ByteVector;
+    for (; end - it >= ByteVector::size; it += ByteVector::size) {
+        if (ByteVector::load(it).maskHigh())
+            return false;
+    }
+#endif
+    for (; it != end; ++it) {
+        if (static_cast<unsigned char>(*it) >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Returns true if caseFoldAndStripDiacritics() could change 'word' when folding case sensitively.
+ * This is the case if it has any non-ASCII bytes or any ASCII diacritics.
+ */
+bool mayHaveDiacritics(StringData word) {
+    const auto& tables = asciiTables();
+    for (char c : word) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (byte >= 0x80 || tables.diacritic[byte])
+            return true;
+    }
+    return false;
+}
+
+}  // namespace
+
 UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
     : _language(language),
       _stemmer(language),
@@ -57,6 +118,16 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
+
+    // Turkish lowercases the ASCII 'I' to a non-ASCII codepoint, so it always takes the general
+    // path.
+    _isAscii = _caseFoldMode == unicode::CaseFoldMode::kNormal && isAscii(document);
+    if (_isAscii) {
+        _asciiDocument.assign(document.rawData(), document.size());
+        _skipAsciiDelimiters();
+        return;
+    }
+
     _document.resetData(document);  // Validates that document is valid UTF8.
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
@@ -64,6 +135,10 @@ void UnicodeFTSTokenizer::reset(StringData document, Options options) {
 }
 
 bool UnicodeFTSTokenizer::moveNext() {
+    if (_isAscii) {
+        return _moveNextAscii();
+    }
+
     while (true) {
         if (_pos >= _document.size()) {
             _word = "";
@@ -117,5 +192,61 @@ void UnicodeFTSTokenizer::_skipDelimiters() {
     }
 }
 
+bool UnicodeFTSTokenizer::_moveNextAscii() {
+    const bool* const isDelimiter = _delimListLanguage == unicode::DelimiterListLanguage::kEnglish
+        ? asciiTables().englishDelimiter
+        : asciiTables().otherDelimiter;
+
+    while (true) {
+        if (_pos >= _asciiDocument.size()) {
+            _word = "";
+            return false;
+        }
+
+        size_t start = _pos++;
+        while (_pos < _asciiDocument.size() && !isDelimiter[uint8_t(_asciiDocument[_pos])]) {
+            ++_pos;
+        }
+        const size_t len = _pos - start;
+
+        _skipAsciiDelimiters();
+
+        // ASCII lowercasing matches unicode::String::toLowerToBuf() outside of Turkish.
+        _wordBuf.reset();
+        char* lower = _wordBuf.skip(len);
+        for (size_t i = 0; i < len; ++i) {
+            const char c = _asciiDocument[start + i];
+            lower[i] = (c >= 'A' && c <= 'Z') ? (c | 0x20) : c;
+        }
+        _word = StringData(lower, len);
+
+        if ((_options & kFilterStopWords) && _stopWords->isStopWord(_word)) {
+            continue;
+        }
+
+        if (_options & kGenerateCaseSensitiveTokens) {
+            _word = StringData(_asciiDocument.data() + start, len);
+        }
+
+        _word = _stemmer.stem(_word);
+
+        if (!(_options & kGenerateDiacriticSensitiveTokens) && mayHaveDiacritics(_word)) {
+            _word = unicode::String::caseFoldAndStripDiacritics(
+                &_finalBuf, _word, unicode::String::kCaseSensitive, _caseFoldMode);
+        }
+
+        return true;
+    }
+}
+
+void UnicodeFTSTokenizer::_skipAsciiDelimiters() {
+    const bool* const isDelimiter = _delimListLanguage == unicode::DelimiterListLanguage::kEnglish
+        ? asciiTables().englishDelimiter
+        : asciiTables().otherDelimiter;
+    while (_pos < _asciiDocument.size() && isDelimiter[uint8_t(_asciiDocument[_pos])]) {
+        ++_pos;
+    }
+}
+
 }  // namespace fts
 }  // namespace mongo
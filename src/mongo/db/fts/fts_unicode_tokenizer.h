@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_tokenizer.h"
@@ -53,6 +55,10 @@ class StopWords;
  *
  * For each word returns a stem version of a word optimized for full text indexing.
  * Optionally supports returning case sensitive search terms.
+ *
+ * Documents made up entirely of ASCII, which are the common case, are tokenized directly on their
+ * bytes rather than being decoded into codepoints first. This produces the same tokens as the
+ * general path.
  */
 class UnicodeFTSTokenizer final : public FTSTokenizer {
     MONGO_DISALLOW_COPYING(UnicodeFTSTokenizer);
@@ -73,6 +79,12 @@ private:
      */
     void _skipDelimiters();
 
+    /**
+     * Equivalents of moveNext() and _skipDelimiters() for documents that are entirely ASCII.
+     */
+    bool _moveNextAscii();
+    void _skipAsciiDelimiters();
+
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
@@ -80,6 +92,11 @@ private:
     const unicode::CaseFoldMode _caseFoldMode;
 
     unicode::String _document;
+
+    // When '_isAscii' is true, the document is held in '_asciiDocument' and '_document' is unused.
+    bool _isAscii = false;
+    std::string _asciiDocument;
+
     size_t _pos;
     StringData _word;
     Options _options;
@@ -241,5 +241,66 @@ TEST(FtsUnicodeTokenizer, FrenchStopWordsAndDiacriticSensitive) {
     ASSERT_EQUALS("excit", terms[4]);
 }
 
+// Ensure that documents made up entirely of ASCII produce the same tokens as documents that also
+// contain non-ASCII characters, for every combination of options.
+TEST(FtsUnicodeTokenizer, AsciiDocumentsMatchNonAsciiDocuments) {
+    const std::string ascii =
+        "  The QUICK brown foxes, who were Running-and-Jumping; over the lazy dog's "
+        "backs^ and `ticks`... 12 3.5  ";
+    // Appending a separate non-ASCII word forces the general path, and adds exactly one token.
+    const std::string nonAscii = ascii + " zx\xc3\xa9zx";
+
+    for (const char* language : {"english", "french", "none"}) {
+        for (FTSTokenizer::Options options = 0; options < (1 << 3); ++options) {
+            const auto asciiTerms = tokenizeString(ascii.c_str(), language, options);
+            auto nonAsciiTerms = tokenizeString(nonAscii.c_str(), language, options);
+
+            ASSERT_FALSE(nonAsciiTerms.empty());
+            nonAsciiTerms.pop_back();
+            ASSERT(asciiTerms == nonAsciiTerms) << "language: " << language
+                                                << ", options: " << static_cast<int>(options);
+        }
+    }
+}
+
+// Ensure that a tokenizer can be reused across ASCII and non-ASCII documents.
+TEST(FtsUnicodeTokenizer, ResetBetweenAsciiAndNonAsciiDocuments) {
+    StatusWithFTSLanguage swl = FTSLanguage::make("french", TEXT_INDEX_VERSION_3);
+    ASSERT_OK(swl);
+    UnicodeFTSTokenizer tokenizer(swl.getValue());
+
+    for (int i = 0; i < 2; ++i) {
+        tokenizer.reset("Je vais être excité", FTSTokenizer::kNone);
+        std::vector<std::string> terms;
+        while (tokenizer.moveNext()) {
+            terms.push_back(tokenizer.get().toString());
+        }
+        ASSERT_EQUALS(4U, terms.size());
+        ASSERT_EQUALS("etre", terms[2]);
+        ASSERT_EQUALS("excit", terms[3]);
+
+        tokenizer.reset("Je vais etre excite", FTSTokenizer::kNone);
+        terms.clear();
+        while (tokenizer.moveNext()) {
+            terms.push_back(tokenizer.get().toString());
+        }
+        ASSERT_EQUALS(4U, terms.size());
+        ASSERT_EQUALS("etre", terms[2]);
+        ASSERT_EQUALS("excit", terms[3]);
+    }
+}
+
+// Ensure that Turkish documents made up entirely of ASCII are still folded with Turkish rules,
+// which lowercase 'I' to a dotless 'i'.
+TEST(FtsUnicodeTokenizer, TurkishAsciiDocument) {
+    std::vector<std::string> terms =
+        tokenizeString("SEN NEREDEN VARDIR?", "turkish", FTSTokenizer::kNone);
+
+    ASSERT_EQUALS(3U, terms.size());
+    ASSERT_EQUALS("sen", terms[0]);
+    ASSERT_EQUALS("nere", terms[1]);
+    ASSERT_EQUALS("var", terms[2]);
+}
+
 }  // namespace fts
 }  // namespace mongo
@@ -28,21 +28,103 @@
 *    it in the license file.
 */
 
+#include <array>
 #include <cstdlib>
+#include <functional>
 
 #include "mongo/db/fts/stemmer.h"
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
 namespace fts {
 
-Stemmer::Stemmer(const FTSLanguage* language) {
-    _stemmer = NULL;
-    if (language->str() != "none")
-        _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
+/**
+ * A bounded cache of word -> stem for a single language. Most text is made of a small vocabulary
+ * of common words, so a modest cache absorbs the bulk of the stemming work done by index
+ * maintenance. The cache is split into partitions, each with its own mutex, so that concurrent
+ * writers tokenizing different words rarely contend. A partition that fills up is simply cleared.
+ */
+class StemCache {
+    MONGO_DISALLOW_COPYING(StemCache);
+
+public:
+    // Longer words are rare enough that caching them would only evict useful entries.
+    static constexpr size_t kMaxWordSize = 64;
+
+    StemCache() = default;
+
+    /**
+     * Copies the cached stem of 'word' into 'out' and returns true, or returns false if 'word' is
+     * not in the cache.
+     */
+    bool lookup(const std::string& word, std::string* out) {
+        auto& partition = _getPartition(word);
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        auto it = partition.stems.find(word);
+        if (it == partition.stems.end()) {
+            return false;
+        }
+        *out = it->second;
+        return true;
+    }
+
+    void insert(const std::string& word, StringData stem) {
+        auto& partition = _getPartition(word);
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        if (partition.stems.size() >= kMaxEntriesPerPartition) {
+            partition.stems.clear();
+        }
+        partition.stems.emplace(word, stem.toString());
+    }
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+    static constexpr size_t kMaxEntriesPerPartition = 1024;
+
+    struct Partition {
+        stdx::mutex mutex;
+        stdx::unordered_map<std::string, std::string> stems;
+    };
+
+    Partition& _getPartition(const std::string& word) {
+        return _partitions[std::hash<std::string>()(word) % kNumPartitions];
+    }
+
+    std::array<Partition, kNumPartitions> _partitions;
+};
+
+namespace {
+
+stdx::mutex stemCachesMutex;
+
+// Never destroyed, since Stemmers may still be in use during static destruction.
+auto* const stemCaches = new stdx::unordered_map<const FTSLanguage*, std::unique_ptr<StemCache>>();
+
+StemCache* getStemCache(const FTSLanguage* language) {
+    if (language->str() == "none") {
+        return nullptr;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(stemCachesMutex);
+    auto& cache = (*stemCaches)[language];
+    if (!cache) {
+        cache = stdx::make_unique<StemCache>();
+    }
+    return cache.get();
 }
 
+}  // namespace
+
+Stemmer::Stemmer(const FTSLanguage* language)
+    : _language(language), _cache(getStemCache(language)) {}
+
 Stemmer::~Stemmer() {
     if (_stemmer) {
         sb_stemmer_delete(_stemmer);
@@ -51,6 +133,20 @@ Stemmer::~Stemmer() {
 }
 
 StringData Stemmer::stem(StringData word) const {
+    if (!_cache)
+        return word;
+
+    const bool cacheable = word.size() <= StemCache::kMaxWordSize;
+    if (cacheable) {
+        _word.assign(word.rawData(), word.size());
+        if (_cache->lookup(_word, &_stem))
+            return _stem;
+    }
+
+    if (!_stemmerCreated) {
+        _stemmer = sb_stemmer_new(_language->str().c_str(), "UTF_8");
+        _stemmerCreated = true;
+    }
     if (!_stemmer)
         return word;
 
@@ -62,7 +158,10 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    StringData stemmed((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    if (cacheable)
+        _cache->insert(_word, stemmed);
+    return stemmed;
 }
 }
 }
@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -39,10 +41,15 @@ namespace mongo {
 
 namespace fts {
 
+class StemCache;
+
 /**
  * maintains case
  * but works
  * running/Running -> run/Run
+ *
+ * Stems are shared between all Stemmers for the same language through a bounded, process-wide
+ * cache, so the underlying snowball stemmer is only created once a word misses that cache.
  */
 class Stemmer {
     MONGO_DISALLOW_COPYING(Stemmer);
@@ -61,7 +68,18 @@ public:
     StringData stem(StringData word) const;
 
 private:
-    struct sb_stemmer* _stemmer;
+    const FTSLanguage* const _language;
+
+    // Shared cache of stems for '_language', or nullptr if the language does no stemming.
+    StemCache* const _cache;
+
+    // Created on the first cache miss.
+    mutable struct sb_stemmer* _stemmer = nullptr;
+    mutable bool _stemmerCreated = false;
+
+    // Scratch space for the cache key and the last stem returned from the cache.
+    mutable std::string _word;
+    mutable std::string _stem;
 };
 }
 }
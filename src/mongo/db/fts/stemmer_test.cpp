@@ -48,5 +48,34 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, RepeatedStemsAgreeAcrossStemmers) {
+    Stemmer first(&languageEnglishV2);
+    Stemmer second(&languageEnglishV2);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQUALS("run", first.stem("running"));
+        ASSERT_EQUALS("run", second.stem("running"));
+        ASSERT_EQUALS("Run", second.stem("Running"));
+        ASSERT_EQUALS("Run", first.stem("Running"));
+    }
+}
+
+TEST(English, CachedStemsAreNotSharedAcrossLanguages) {
+    Stemmer english(&languageEnglishV2);
+    StatusWithFTSLanguage swl = FTSLanguage::make("none", TEXT_INDEX_VERSION_2);
+    ASSERT_OK(swl.getStatus());
+    Stemmer none(swl.getValue());
+    ASSERT_EQUALS("run", english.stem("running"));
+    ASSERT_EQUALS("running", none.stem("running"));
+    ASSERT_EQUALS("run", english.stem("running"));
+}
+
+TEST(English, LongWordsAreStemmed) {
+    Stemmer s(&languageEnglishV2);
+    const std::string longWord = std::string(100, 'x') + "running";
+    const std::string expected = std::string(100, 'x') + "run";
+    ASSERT_EQUALS(expected, s.stem(longWord));
+    ASSERT_EQUALS(expected, s.stem(longWord));
+}
 }
 }
@@ -27,6 +27,9 @@
 */
 
 #include "mongo/db/index/fts_access_method.h"
+
+#include <algorithm>
+
 #include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/index/expression_keys_private.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -34,7 +37,29 @@
 namespace mongo {
 
 FTSAccessMethod::FTSAccessMethod(IndexCatalogEntry* btreeState, SortedDataInterface* btree)
-    : AbstractIndexAccessMethod(btreeState, btree), _ftsSpec(btreeState->descriptor()->infoObj()) {}
+    : AbstractIndexAccessMethod(btreeState, btree), _ftsSpec(btreeState->descriptor()->infoObj()) {
+    if (_ftsSpec.wildcard()) {
+        return;
+    }
+
+    auto addKeyField = [this](StringData path) {
+        auto fieldName = path.substr(0, path.find('.')).toString();
+        if (!_isKeyField(fieldName)) {
+            _keyFields.push_back(std::move(fieldName));
+        }
+    };
+
+    for (const auto& weight : _ftsSpec.weights()) {
+        addKeyField(weight.first);
+    }
+    for (size_t i = 0; i < _ftsSpec.numExtraBefore(); ++i) {
+        addKeyField(_ftsSpec.extraBefore(i));
+    }
+    for (size_t i = 0; i < _ftsSpec.numExtraAfter(); ++i) {
+        addKeyField(_ftsSpec.extraAfter(i));
+    }
+    addKeyField(_ftsSpec.languageOverrideField());
+}
 
 void FTSAccessMethod::doGetKeys(const BSONObj& obj,
                                 BSONObjSet* keys,
@@ -43,4 +68,36 @@ void FTSAccessMethod::doGetKeys(const BSONObj& obj,
     ExpressionKeysPrivate::getFTSKeys(obj, _ftsSpec, keys);
 }
 
+bool FTSAccessMethod::updateLeavesKeysUnchanged(const BSONObj& from, const BSONObj& to) const {
+    if (_keyFields.empty()) {
+        return false;
+    }
+
+    // Compares the key fields of 'from' and 'to' in document order, so that a document with
+    // repeated or reordered key fields conservatively counts as changed.
+    BSONObjIterator fromIt(from);
+    BSONObjIterator toIt(to);
+    while (true) {
+        BSONElement fromElem;
+        while (fromIt.more() && !_isKeyField((fromElem = fromIt.next()).fieldNameStringData())) {
+            fromElem = BSONElement();
+        }
+        BSONElement toElem;
+        while (toIt.more() && !_isKeyField((toElem = toIt.next()).fieldNameStringData())) {
+            toElem = BSONElement();
+        }
+
+        if (fromElem.eoo() || toElem.eoo()) {
+            return fromElem.eoo() && toElem.eoo();
+        }
+        if (!fromElem.binaryEqual(toElem)) {
+            return false;
+        }
+    }
+}
+
+bool FTSAccessMethod::_isKeyField(StringData fieldName) const {
+    return std::find(_keyFields.begin(), _keyFields.end(), fieldName) != _keyFields.end();
+}
+
 }  // namespace mongo
@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "mongo/base/status.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_access_method.h"
@@ -56,7 +59,23 @@ private:
                    BSONObjSet* multikeyMetadataKeys,
                    MultikeyPaths* multikeyPaths) const final;
 
+    /**
+     * Text keys are costly to generate, since every indexed string must be tokenized and stemmed.
+     * Returns true if no top-level field that text key generation reads differs between 'from'
+     * and 'to'.
+     */
+    bool updateLeavesKeysUnchanged(const BSONObj& from, const BSONObj& to) const final;
+
+    /**
+     * Returns true if key generation reads the top-level field 'fieldName'.
+     */
+    bool _isKeyField(StringData fieldName) const;
+
     fts::FTSSpec _ftsSpec;
+
+    // The top-level fields read when generating keys, or empty if the index has a wildcard text
+    // field and so depends on every field.
+    std::vector<std::string> _keyFields;
 };
 
 }  // namespace mongo
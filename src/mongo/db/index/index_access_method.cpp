@@ -194,6 +194,7 @@ Status AbstractIndexAccessMethod::insert(OperationContext* opCtx,
     // Add all new data keys, and all new multikey metadata keys, into the index. When iterating
     // over the data keys, each of them should point to the doc's RecordId. When iterating over
     // the multikey metadata keys, they should point to the reserved 'kMultikeyMetadataKeyId'.
+    BSONObjSet insertedMultikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     for (const auto keySet : {&keys, &multikeyMetadataKeys}) {
         const auto& recordId = (keySet == &keys ? loc : kMultikeyMetadataKeyId);
         for (const auto& key : *keySet) {
@@ -208,11 +209,18 @@ Status AbstractIndexAccessMethod::insert(OperationContext* opCtx,
             if (isFatalError(opCtx, status, key)) {
                 return status;
             }
+            if (status.isOK() && keySet == &multikeyMetadataKeys) {
+                insertedMultikeyMetadataKeys.insert(key);
+            }
         }
     }
 
     *numInserted = keys.size() + multikeyMetadataKeys.size();
 
+    if (!insertedMultikeyMetadataKeys.empty()) {
+        onMultikeyMetadataKeysInserted(opCtx, insertedMultikeyMetadataKeys);
+    }
+
     if (shouldMarkIndexAsMultikey(keys, multikeyMetadataKeys, multikeyPaths)) {
         _btreeState->setMultikey(opCtx, multikeyPaths);
     }
@@ -395,6 +403,14 @@ Status AbstractIndexAccessMethod::validateUpdate(OperationContext* opCtx,
                                                  const InsertDeleteOptions& options,
                                                  UpdateTicket* ticket,
                                                  const MatchExpression* indexFilter) {
+    // With a partial index, 'from' and 'to' may still differ in whether they belong in the index.
+    if (!indexFilter && updateLeavesKeysUnchanged(from, to)) {
+        ticket->loc = record;
+        ticket->dupsAllowed = options.dupsAllowed;
+        ticket->_isValid = true;
+        return Status::OK();
+    }
+
     if (!indexFilter || indexFilter->matchesBSON(from)) {
         // There's no need to compute the prefixes of the indexed fields that possibly caused the
         // index to be multikey when the old version of the document was written since the index
@@ -448,6 +464,7 @@ Status AbstractIndexAccessMethod::update(OperationContext* opCtx,
     // over the data keys, each of them should point to the doc's RecordId. When iterating over
     // the multikey metadata keys, they should point to the reserved 'kMultikeyMetadataKeyId'.
     const auto newMultikeyMetadataKeys = asVector(ticket.newMultikeyMetadataKeys);
+    BSONObjSet insertedMultikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     for (const auto keySet : {&ticket.added, &newMultikeyMetadataKeys}) {
         const auto& recordId = (keySet == &ticket.added ? ticket.loc : kMultikeyMetadataKeyId);
         for (const auto& key : *keySet) {
@@ -462,9 +479,16 @@ Status AbstractIndexAccessMethod::update(OperationContext* opCtx,
             if (isFatalError(opCtx, status, key)) {
                 return status;
             }
+            if (status.isOK() && keySet == &newMultikeyMetadataKeys) {
+                insertedMultikeyMetadataKeys.insert(key);
+            }
         }
     }
 
+    if (!insertedMultikeyMetadataKeys.empty()) {
+        onMultikeyMetadataKeysInserted(opCtx, insertedMultikeyMetadataKeys);
+    }
+
     if (shouldMarkIndexAsMultikey(
             ticket.newKeys, ticket.newMultikeyMetadataKeys, ticket.newMultikeyPaths)) {
         _btreeState->setMultikey(opCtx, ticket.newMultikeyPaths);
@@ -557,6 +581,10 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
 
     bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
 
+    // The multikey metadata keys which were added to the builder. They are only written once the
+    // builder commits.
+    BSONObjSet insertedMultikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+
     while (it->more()) {
         if (mayInterrupt) {
             opCtx->checkForInterrupt();
@@ -595,6 +623,10 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
             return status;
         }
 
+        if (data.second == kMultikeyMetadataKeyId) {
+            insertedMultikeyMetadataKeys.insert(data.first.getOwned());
+        }
+
         // If we're here either it's a dup and we're cool with it or the addKey went just fine.
         pm.hit();
         wunit.commit();
@@ -617,6 +649,9 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
     // start up.
     if (specialFormatInserted == SpecialFormatInserted::LongTypeBitsInserted)
         _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
+    if (!insertedMultikeyMetadataKeys.empty()) {
+        onMultikeyMetadataKeysInserted(opCtx, insertedMultikeyMetadataKeys);
+    }
     wunit.commit();
     return Status::OK();
 }
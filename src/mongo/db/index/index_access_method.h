@@ -502,6 +502,24 @@ protected:
                            BSONObjSet* multikeyMetadataKeys,
                            MultikeyPaths* multikeyPaths) const = 0;
 
+    /**
+     * Returns true if the keys generated for 'to' are known to be the same as those generated for
+     * 'from' without generating them, in which case validateUpdate() skips key generation. Index
+     * types whose key generation is expensive may override this to cheaply detect updates that
+     * leave every indexed field untouched. Returning false is always correct.
+     */
+    virtual bool updateLeavesKeysUnchanged(const BSONObj& from, const BSONObj& to) const {
+        return false;
+    }
+
+    /**
+     * Called by insert(), update() and commitBulk() with the multikey metadata keys they have
+     * written to the index as part of the current WriteUnitOfWork. Keys which were skipped, for
+     * example for being too long, are not passed. Does nothing by default.
+     */
+    virtual void onMultikeyMetadataKeysInserted(OperationContext* opCtx,
+                                                const BSONObjSet& multikeyMetadataKeys) {}
+
     IndexCatalogEntry* const _btreeState;  // owned by IndexCatalogEntry
     const IndexDescriptor* const _descriptor;
 
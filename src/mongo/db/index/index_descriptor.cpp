@@ -59,6 +59,7 @@ void populateOptionsMap(std::map<StringData, BSONElement>& theMap, const BSONObj
                 IndexDescriptor::kIndexVersionFieldName ||  // not considered for equivalence
             fieldName == IndexDescriptor::kTextVersionFieldName ||      // same as index version
             fieldName == IndexDescriptor::k2dsphereVersionFieldName ||  // same as index version
+            fieldName == IndexDescriptor::kWildcardVersionFieldName ||  // same as index version
             fieldName ==
                 IndexDescriptor::kBackgroundFieldName ||  // this is a creation time option only
             fieldName == IndexDescriptor::kDropDuplicatesFieldName ||  // this is now ignored
@@ -96,6 +97,7 @@ constexpr StringData IndexDescriptor::kStorageEngineFieldName;
 constexpr StringData IndexDescriptor::kTextVersionFieldName;
 constexpr StringData IndexDescriptor::kUniqueFieldName;
 constexpr StringData IndexDescriptor::kWeightsFieldName;
+constexpr StringData IndexDescriptor::kWildcardVersionFieldName;
 
 bool IndexDescriptor::isIndexVersionSupported(IndexVersion indexVersion) {
     switch (indexVersion) {
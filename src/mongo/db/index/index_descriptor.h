@@ -84,6 +84,7 @@ public:
     static constexpr StringData kTextVersionFieldName = "textIndexVersion"_sd;
     static constexpr StringData kUniqueFieldName = "unique"_sd;
     static constexpr StringData kWeightsFieldName = "weights"_sd;
+    static constexpr StringData kWildcardVersionFieldName = "wildcardIndexVersion"_sd;
 
     /**
      * OnDiskIndexData is a pointer to the memory mapped per-index data.
@@ -30,20 +30,77 @@
 
 #include "mongo/db/index/wildcard_access_method.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/operation_context.h"
 
 namespace mongo {
+namespace {
 
-WildcardAccessMethod::WildcardAccessMethod(IndexCatalogEntry* wildcardState,
+std::shared_ptr<WildcardPathDictionary> makePathDictionary(const IndexDescriptor* descriptor) {
+    const auto versionElem = descriptor->infoObj()[IndexDescriptor::kWildcardVersionFieldName];
+    if (versionElem.numberInt() != WILDCARD_INDEX_VERSION_2) {
+        return nullptr;
+    }
+    return std::make_shared<WildcardPathDictionary>();
+}
+}  // namespace
+
+WildcardAccessMethod::WildcardAccessMethod(OperationContext* opCtx,
+                                           IndexCatalogEntry* wildcardState,
                                            SortedDataInterface* btree)
     : AbstractIndexAccessMethod(wildcardState, btree),
-      _keyGen(
-          _descriptor->keyPattern(), _descriptor->pathProjection(), _btreeState->getCollator()) {}
+      _pathDictionary(makePathDictionary(_descriptor)),
+      _keyGen(_descriptor->keyPattern(),
+              _descriptor->pathProjection(),
+              _btreeState->getCollator(),
+              _pathDictionary.get()) {
+    if (_pathDictionary) {
+        _loadPathDictionary(opCtx);
+    }
+}
 
 bool WildcardAccessMethod::shouldMarkIndexAsMultikey(const BSONObjSet& keys,
                                                      const BSONObjSet& multikeyMetadataKeys,
                                                      const MultikeyPaths& multikeyPaths) const {
-    return !multikeyMetadataKeys.empty();
+    // Path dictionary entry keys are stored alongside the multikey metadata keys, but do not
+    // indicate that any path is multikey.
+    return std::any_of(multikeyMetadataKeys.begin(),
+                       multikeyMetadataKeys.end(),
+                       [](const auto& key) { return !WildcardPathDictionary::isEntryKey(key); });
+}
+
+void WildcardAccessMethod::onMultikeyMetadataKeysInserted(OperationContext* opCtx,
+                                                          const BSONObjSet& multikeyMetadataKeys) {
+    // Once the entry keys written for new paths have committed, documents which use those paths
+    // no longer need to write them again.
+    for (const auto& key : multikeyMetadataKeys) {
+        if (!WildcardPathDictionary::isEntryKey(key)) {
+            continue;
+        }
+        opCtx->recoveryUnit()->onCommit(
+            [ pathDictionary = _pathDictionary, key ](boost::optional<Timestamp>) {
+                pathDictionary->markDurable(std::next(key.begin())->valueStringData());
+            });
+    }
+}
+
+void WildcardAccessMethod::_loadPathDictionary(OperationContext* opCtx) {
+    auto cursor = newCursor(opCtx);
+    // All of the dictionary entry keys are prefixed by the same value, and store their path and id
+    // in the following two fields. Establish an index cursor which will scan this range.
+    const auto prefix = WildcardPathDictionary::kEntryKeyPrefix;
+    const BSONObj entryKeyRangeBegin = BSON("" << prefix << "" << MINKEY);
+    const BSONObj entryKeyRangeEnd = BSON("" << prefix << "" << MAXKEY);
+
+    constexpr bool inclusive = true;
+    cursor->setEndPosition(entryKeyRangeEnd, inclusive);
+    for (auto entry = cursor->seek(entryKeyRangeBegin, inclusive); entry; entry = cursor->next()) {
+        invariant(entry->loc.repr() ==
+                  static_cast<int64_t>(RecordId::ReservedId::kWildcardMultikeyMetadataId));
+        _pathDictionary->loadEntryKey(entry->key);
+    }
 }
 
 void WildcardAccessMethod::doGetKeys(const BSONObj& obj,
@@ -28,8 +28,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/wildcard_key_generator.h"
+#include "mongo/db/index/wildcard_path_dictionary.h"
 #include "mongo/db/jsobj.h"
 
 namespace mongo {
@@ -40,10 +43,16 @@ namespace mongo {
  *
  * $** indexes store a special metadata key for each path in the index that is multikey. This class
  * provides an interface to access the multikey metadata: see getMultikeyPathSet().
+ *
+ * Version 2 $** indexes store an integer id in place of the path in each key. The ids are assigned
+ * by a WildcardPathDictionary whose entries are stored alongside the multikey metadata keys, and
+ * which is loaded from the index when this class is constructed: see getPathDictionary().
  */
 class WildcardAccessMethod final : public AbstractIndexAccessMethod {
 public:
-    WildcardAccessMethod(IndexCatalogEntry* wildcardState, SortedDataInterface* btree);
+    WildcardAccessMethod(OperationContext* opCtx,
+                         IndexCatalogEntry* wildcardState,
+                         SortedDataInterface* btree);
 
     /**
      * Returns 'true' if the index should become multikey on the basis of the passed arguments.
@@ -61,12 +70,28 @@ public:
      */
     std::set<FieldRef> getMultikeyPathSet(OperationContext*) const final;
 
+    /**
+     * Returns the dictionary which maps this index's paths to the ids stored in its keys, or
+     * nullptr if this is a version 1 index which stores the paths themselves.
+     */
+    std::shared_ptr<const WildcardPathDictionary> getPathDictionary() const {
+        return _pathDictionary;
+    }
+
 private:
     void doGetKeys(const BSONObj& obj,
                    BSONObjSet* keys,
                    BSONObjSet* multikeyMetadataKeys,
                    MultikeyPaths* multikeyPaths) const final;
 
+    void onMultikeyMetadataKeysInserted(OperationContext* opCtx,
+                                        const BSONObjSet& multikeyMetadataKeys) final;
+
+    // Populates '_pathDictionary' from the dictionary entry keys already present in the index.
+    void _loadPathDictionary(OperationContext* opCtx);
+
+    // Shared with the planner's IndexEntry objects, which may outlive this access method.
+    const std::shared_ptr<WildcardPathDictionary> _pathDictionary;
     const WildcardKeyGenerator _keyGen;
 };
 }  // namespace mongo
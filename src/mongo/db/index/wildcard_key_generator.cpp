@@ -92,8 +92,9 @@ std::unique_ptr<ProjectionExecAgg> WildcardKeyGenerator::createProjectionExec(
 
 WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
                                            BSONObj pathProjection,
-                                           const CollatorInterface* collator)
-    : _collator(collator), _keyPattern(keyPattern) {
+                                           const CollatorInterface* collator,
+                                           WildcardPathDictionary* pathDictionary)
+    : _collator(collator), _keyPattern(keyPattern), _pathDictionary(pathDictionary) {
     _projExec = createProjectionExec(keyPattern, pathProjection);
 }
 
@@ -120,14 +121,14 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(elem, *path, objIsArray, keys))
+                if (_addKeyForNestedArray(elem, *path, objIsArray, keys, multikeyPaths))
                     break;
 
                 // Add an entry for the multi-key path, and then fall through to BSONType::Object.
                 _addMultiKey(*path, multikeyPaths);
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(elem, *path, keys))
+                if (_addKeyForEmptyLeaf(elem, *path, keys, multikeyPaths))
                     break;
 
                 _traverseWildcard(
@@ -135,7 +136,7 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
                 break;
 
             default:
-                _addKey(elem, *path, keys);
+                _addKey(elem, *path, keys, multikeyPaths);
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
@@ -146,10 +147,11 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
 bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
                                                  const FieldRef& fullPath,
                                                  bool enclosingObjIsArray,
-                                                 BSONObjSet* keys) const {
+                                                 BSONObjSet* keys,
+                                                 BSONObjSet* multikeyPaths) const {
     // If this element is an array whose parent is also an array, index it as a value.
     if (enclosingObjIsArray && elem.type() == BSONType::Array) {
-        _addKey(elem, fullPath, keys);
+        _addKey(elem, fullPath, keys, multikeyPaths);
         return true;
     }
     return false;
@@ -157,12 +159,16 @@ bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
 
 bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
                                                const FieldRef& fullPath,
-                                               BSONObjSet* keys) const {
+                                               BSONObjSet* keys,
+                                               BSONObjSet* multikeyPaths) const {
     invariant(elem.isABSONObj());
     if (elem.embeddedObject().isEmpty()) {
         // In keeping with the behaviour of regular indexes, an empty object is indexed as-is while
         // empty arrays are indexed as 'undefined'.
-        _addKey(elem.type() == BSONType::Array ? BSONElement{} : elem, fullPath, keys);
+        _addKey(elem.type() == BSONType::Array ? BSONElement{} : elem,
+                fullPath,
+                keys,
+                multikeyPaths);
         return true;
     }
     return false;
@@ -170,10 +176,16 @@ bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
 
 void WildcardKeyGenerator::_addKey(BSONElement elem,
                                    const FieldRef& fullPath,
-                                   BSONObjSet* keys) const {
-    // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
+                                   BSONObjSet* keys,
+                                   BSONObjSet* multikeyPaths) const {
+    // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }, or of the
+    // form { "": <path id>, "": <collation-aware value> } for version 2 indexes.
     BSONObjBuilder bob;
-    bob.append("", fullPath.dottedField());
+    if (_pathDictionary) {
+        bob.append("", _pathDictionary->getOrAssignPathId(fullPath.dottedField(), multikeyPaths));
+    } else {
+        bob.append("", fullPath.dottedField());
+    }
     if (elem) {
         CollationIndexKey::collationAwareIndexKeyAppend(elem, _collator, &bob);
     } else {
@@ -30,10 +30,18 @@
 
 #include "mongo/db/exec/projection_exec_agg.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/index/wildcard_path_dictionary.h"
 #include "mongo/db/query/collation/collator_interface.h"
 
 namespace mongo {
 
+/**
+ * The format of the keys in a $** index. Version 1 indexes store the full dotted path of each
+ * indexed field in front of its value, whereas version 2 indexes store the integer id which the
+ * index's WildcardPathDictionary assigns to the path.
+ */
+enum WildcardIndexVersion { WILDCARD_INDEX_VERSION_1 = 1, WILDCARD_INDEX_VERSION_2 = 2 };
+
 /**
  * This class is responsible for generating an aggregation projection based on the keyPattern and
  * pathProjection specs, and for subsequently extracting the set of all path-value pairs for each
@@ -51,17 +59,26 @@ public:
     static std::unique_ptr<ProjectionExecAgg> createProjectionExec(BSONObj keyPattern,
                                                                    BSONObj pathProjection);
 
+    /**
+     * If 'pathDictionary' is non-null, keys are generated in the version 2 format, with each path
+     * replaced by its id in 'pathDictionary'.
+     */
     WildcardKeyGenerator(BSONObj keyPattern,
                          BSONObj pathProjection,
-                         const CollatorInterface* collator);
+                         const CollatorInterface* collator,
+                         WildcardPathDictionary* pathDictionary = nullptr);
 
     /**
      * Applies the appropriate Wildcard projection to the input doc, and then adds one key-value
      * pair to the BSONObjSet 'keys' for each leaf node in the post-projection document:
      *      { '': 'path.to.field', '': <collation-aware-field-value> }
+     * or, for version 2 keys:
+     *      { '': <path id>, '': <collation-aware-field-value> }
      * Also adds one entry to 'multikeyPaths' for each array encountered in the post-projection
      * document, in the following format:
      *      { '': 1, '': 'path.to.array' }
+     * For version 2 keys, 'multikeyPaths' additionally receives the dictionary entry key of each
+     * path whose entry has not yet been durably written to the index.
      */
     void generateKeys(BSONObj inputDoc, BSONObjSet* keys, BSONObjSet* multikeyPaths) const;
 
@@ -75,17 +92,25 @@ private:
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(const FieldRef& fullPath, BSONObjSet* multikeyPaths) const;
-    void _addKey(BSONElement elem, const FieldRef& fullPath, BSONObjSet* keys) const;
+    void _addKey(BSONElement elem,
+                 const FieldRef& fullPath,
+                 BSONObjSet* keys,
+                 BSONObjSet* multikeyPaths) const;
 
     // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
     bool _addKeyForNestedArray(BSONElement elem,
                                const FieldRef& fullPath,
                                bool enclosingObjIsArray,
-                               BSONObjSet* keys) const;
-    bool _addKeyForEmptyLeaf(BSONElement elem, const FieldRef& fullPath, BSONObjSet* keys) const;
+                               BSONObjSet* keys,
+                               BSONObjSet* multikeyPaths) const;
+    bool _addKeyForEmptyLeaf(BSONElement elem,
+                             const FieldRef& fullPath,
+                             BSONObjSet* keys,
+                             BSONObjSet* multikeyPaths) const;
 
     std::unique_ptr<ProjectionExecAgg> _projExec;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
+    WildcardPathDictionary* const _pathDictionary;
 };
 }  // namespace mongo
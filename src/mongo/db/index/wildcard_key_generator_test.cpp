@@ -967,5 +967,66 @@ TEST(WildcardKeyGeneratorDottedFieldsTest, DoNotIndexDottedFieldsWithSimilarSubp
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+// Version 2 key format tests.
+
+TEST(WildcardKeyGeneratorCompactFormatTest, ReplacePathsWithDictionaryIds) {
+    WildcardPathDictionary pathDictionary;
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"), {}, nullptr, &pathDictionary};
+
+    auto inputDoc = fromjson("{a: 1, b: {c: [1, 2]}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 3, '': 1}"),
+                                    fromjson("{'': 4, '': 1}"),
+                                    fromjson("{'': 4, '': 2}")});
+
+    auto expectedMultikeyPaths = makeKeySet({fromjson("{'': 1, '': 'b.c'}"),
+                                             fromjson("{'': 2, '': 'a', '': 3}"),
+                                             fromjson("{'': 2, '': 'b.c', '': 4}")});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+    ASSERT_EQ(pathDictionary.size(), 2U);
+}
+
+TEST(WildcardKeyGeneratorCompactFormatTest, OnlyWriteEntryKeysUntilDurable) {
+    WildcardPathDictionary pathDictionary;
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"), {}, nullptr, &pathDictionary};
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: 1, b: 2}"), &outputKeys, &multikeyMetadataKeys);
+    pathDictionary.markDurable("a");
+
+    // The id of each path is reused, but only the entry for 'b' still needs to be written.
+    auto expectedKeys = makeKeySet({fromjson("{'': 3, '': 5}"), fromjson("{'': 4, '': 6}")});
+    auto expectedMultikeyPaths = makeKeySet({fromjson("{'': 2, '': 'b', '': 4}")});
+
+    outputKeys = makeKeySet();
+    multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: 5, b: 6}"), &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorCompactFormatTest, LoadedEntriesAreDurableAndReserveTheirIds) {
+    WildcardPathDictionary pathDictionary;
+    pathDictionary.loadEntryKey(WildcardPathDictionary::makeEntryKey("x", 7));
+    pathDictionary.loadEntryKey(WildcardPathDictionary::makeEntryKey("x.y", 5));
+
+    auto entryKeys = makeKeySet();
+    ASSERT_EQ(pathDictionary.getOrAssignPathId("x", &entryKeys), 7);
+    ASSERT_EQ(pathDictionary.getOrAssignPathId("x.z", &entryKeys), 8);
+
+    ASSERT(assertKeysetsEqual(makeKeySet({fromjson("{'': 2, '': 'x.z', '': 8}")}), entryKeys));
+    ASSERT(pathDictionary.findSubpathIds("x") == std::vector<long long>({5, 8}));
+    ASSERT_EQ(*pathDictionary.findPathId("x.y"), 5);
+    ASSERT_FALSE(pathDictionary.findPathId("y"));
+}
+
 }  // namespace
 }  // namespace mongo
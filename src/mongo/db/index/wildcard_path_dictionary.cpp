@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/wildcard_path_dictionary.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+constexpr int WildcardPathDictionary::kEntryKeyPrefix;
+constexpr long long WildcardPathDictionary::kFirstPathId;
+
+BSONObj WildcardPathDictionary::makeEntryKey(StringData path, long long pathId) {
+    return BSON("" << kEntryKeyPrefix << "" << path << "" << pathId);
+}
+
+bool WildcardPathDictionary::isEntryKey(const BSONObj& key) {
+    const auto firstElem = key.firstElement();
+    return firstElem.isNumber() && firstElem.numberInt() == kEntryKeyPrefix;
+}
+
+void WildcardPathDictionary::loadEntryKey(const BSONObj& key) {
+    BSONObjIterator iter(key);
+    invariant(iter.more());
+    const auto prefixElem = iter.next();
+    invariant(prefixElem.isNumber() && prefixElem.numberInt() == kEntryKeyPrefix);
+    invariant(iter.more());
+    const auto pathElem = iter.next();
+    invariant(pathElem.type() == BSONType::String);
+    invariant(iter.more());
+    const auto idElem = iter.next();
+    invariant(idElem.isNumber());
+    invariant(!iter.more());
+
+    const long long pathId = idElem.numberLong();
+    invariant(pathId >= kFirstPathId);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _entries[pathElem.str()] = {pathId, true};
+    _nextPathId = std::max(_nextPathId, pathId + 1);
+}
+
+long long WildcardPathDictionary::getOrAssignPathId(StringData path, BSONObjSet* entryKeys) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _entries.find(path.toString());
+    if (it == _entries.end()) {
+        it = _entries.emplace(path.toString(), Entry{_nextPathId++, false}).first;
+    }
+    if (entryKeys && !it->second.durable) {
+        entryKeys->insert(makeEntryKey(path, it->second.pathId));
+    }
+    return it->second.pathId;
+}
+
+void WildcardPathDictionary::markDurable(StringData path) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _entries.find(path.toString());
+    if (it != _entries.end()) {
+        it->second.durable = true;
+    }
+}
+
+boost::optional<long long> WildcardPathDictionary::findPathId(StringData path) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _entries.find(path.toString());
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+    return it->second.pathId;
+}
+
+std::vector<long long> WildcardPathDictionary::findSubpathIds(StringData path) const {
+    // Every strict subpath of 'path' sorts within ["path.", "path/"), since '/' follows '.'.
+    const auto subpathStart = path.toString() + '.';
+    const auto subpathEnd = path.toString() + static_cast<char>('.' + 1);
+
+    std::vector<long long> pathIds;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (auto it = _entries.lower_bound(subpathStart);
+             it != _entries.end() && it->first < subpathEnd;
+             ++it) {
+            pathIds.push_back(it->second.pathId);
+        }
+    }
+    std::sort(pathIds.begin(), pathIds.end());
+    return pathIds;
+}
+
+size_t WildcardPathDictionary::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _entries.size();
+}
+
+}  // namespace mongo
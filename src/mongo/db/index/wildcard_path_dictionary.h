@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+/**
+ * Maps each path indexed by a version 2 $** index to the integer id which its keys store in place
+ * of the full dotted path string. Each entry is also persisted in the index itself as a metadata
+ * key of the form { '': 2, '': 'path.to.field', '': <path id> }, stored under the same reserved
+ * RecordId as the multikey metadata keys, so that the dictionary can be rebuilt when the index is
+ * opened and the planner can enumerate the indexed paths without scanning the index.
+ *
+ * An entry's metadata key is written alongside the data keys of every document which uses the path
+ * until a write containing it has committed; from then on, documents only produce data keys.
+ *
+ * This class is thread-safe.
+ */
+class WildcardPathDictionary {
+public:
+    // The leading value of the dictionary entry keys. Multikey metadata keys lead with 1.
+    static constexpr int kEntryKeyPrefix = 2;
+
+    // Path ids start above both metadata key prefixes, so that data keys never share their range.
+    static constexpr long long kFirstPathId = 3;
+
+    /**
+     * Returns the dictionary entry key which maps 'path' to 'pathId'.
+     */
+    static BSONObj makeEntryKey(StringData path, long long pathId);
+
+    /**
+     * Returns true if 'key' is a dictionary entry key rather than a multikey metadata key.
+     */
+    static bool isEntryKey(const BSONObj& key);
+
+    /**
+     * Records the entry held by 'key', which has been read back from the index and is therefore
+     * already durable.
+     */
+    void loadEntryKey(const BSONObj& key);
+
+    /**
+     * Returns the id of 'path', assigning it the next free id if it has not been seen before. If
+     * 'entryKeys' is non-null and the entry is not yet known to be durable, adds its entry key to
+     * 'entryKeys' so that it will be written together with the data keys that refer to it.
+     */
+    long long getOrAssignPathId(StringData path, BSONObjSet* entryKeys);
+
+    /**
+     * Records that a write of the entry key for 'path' has committed.
+     */
+    void markDurable(StringData path);
+
+    /**
+     * Returns the id of 'path', or boost::none if no document has been indexed with that path.
+     */
+    boost::optional<long long> findPathId(StringData path) const;
+
+    /**
+     * Returns the ids of every known strict subpath of 'path', that is every path which begins with
+     * 'path' followed by a '.', in ascending order.
+     */
+    std::vector<long long> findSubpathIds(StringData path) const;
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        long long pathId;
+        bool durable;
+    };
+
+    mutable stdx::mutex _mutex;
+
+    // Ordered by path so that the subpaths of any path form a contiguous range.
+    std::map<std::string, Entry> _entries;
+    long long _nextPathId = kFirstPathId;
+};
+
+}  // namespace mongo
@@ -52,6 +52,8 @@
 #include "mongo/db/auth/security_key.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/async_rotatable_file_appender.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event.h"
@@ -211,6 +213,24 @@ void forkServerOrDie() {
 }
 
 MONGO_EXPORT_SERVER_PARAMETER(maxLogSizeKB, int, logger::LogContext::kDefaultMaxLogSizeKB);
+
+// Number of messages buffered for the background thread which writes the log file. Zero, the
+// default, writes each message to the log file on the thread which logged it.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logAsyncBufferSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 1024 * 1024) {
+            return Status(ErrorCodes::BadValue,
+                          "logAsyncBufferSize must be between 0 and 1048576");
+        }
+        return Status::OK();
+    });
+
+// What to do when the buffer of the background log writer is full: "block" the logging thread
+// until there is room, or "drop" the message.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logAsyncOverflowPolicy, std::string, "block")
+    ->withValidator([](const std::string& newVal) {
+        return logger::AsyncLogWriter::parseOverflowPolicy(newVal).getStatus();
+    });
 MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
                           ("GlobalLogManager", "EndStartupOptionHandling", "ForkServer"),
                           ("default"))
@@ -298,12 +318,30 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
         LogManager* manager = logger::globalLogManager();
         manager->getGlobalDomain()->clearAppenders();
-        manager->getGlobalDomain()->attachAppender(
-            std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
-        manager->getNamedDomain("javascriptOutput")
-            ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        if (logAsyncBufferSize > 0) {
+            using logger::AsyncLogWriter;
+            using logger::AsyncRotatableFileAppender;
+
+            // Never destroyed, since messages may be logged until the process exits.
+            auto asyncWriter = new AsyncLogWriter(
+                writer.getValue(),
+                logAsyncBufferSize,
+                uassertStatusOK(AsyncLogWriter::parseOverflowPolicy(logAsyncOverflowPolicy)));
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<AsyncRotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), asyncWriter));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(
+                    std::make_unique<AsyncRotatableFileAppender<MessageEventEphemeral>>(
+                        std::make_unique<MessageEventDetailsEncoder>(), asyncWriter));
+        } else {
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        }
 
         if (serverGlobalParams.logAppend && exists) {
             log() << "***** SERVER RESTARTED *****";
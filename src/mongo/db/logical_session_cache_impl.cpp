@@ -92,9 +92,9 @@ LogicalSessionCacheImpl::~LogicalSessionCacheImpl() {
 }
 
 Status LogicalSessionCacheImpl::promote(LogicalSessionId lsid) {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    auto it = _activeSessions.find(lsid);
-    if (it == _activeSessions.end()) {
+    auto partition = _activeSessions.lockOnePartition(lsid);
+    auto it = partition->find(lsid);
+    if (it == partition->end()) {
         return {ErrorCodes::NoSuchSession, "no matching session record found in the cache"};
     }
 
@@ -167,8 +167,7 @@ Date_t LogicalSessionCacheImpl::now() {
 }
 
 size_t LogicalSessionCacheImpl::size() {
-    stdx::lock_guard<stdx::mutex> lock(_cacheMutex);
-    return _activeSessions.size();
+    return static_cast<size_t>(_activeSessionsCount.load());
 }
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
@@ -303,7 +302,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     LogicalSessionIdMap<LogicalSessionRecord> activeSessions;
 
     // backSwapper creates a guard that in the case of a exception
-    // replaces the ending or active sessions that swapped out of of LogicalSessionCache,
+    // replaces the ending sessions that swapped out of of LogicalSessionCache,
     // and merges in any records that had been added since we swapped them
     // out.
     auto backSwapper = [this](auto& member, auto& temp) {
@@ -321,9 +320,31 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         using std::swap;
         stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
         swap(explicitlyEndingSessions, _endingSessions);
-        swap(activeSessions, _activeSessions);
     }
-    auto activeSessionsBackSwapper = backSwapper(_activeSessions, activeSessions);
+
+    // The active sessions are taken out one partition at a time, so records added concurrently to
+    // a partition which has already been emptied remain in the cache until the next refresh.
+    for (size_t partitionId = 0; partitionId < kNumActiveSessionsPartitions; ++partitionId) {
+        LogicalSessionIdMap<LogicalSessionRecord> partitionSessions;
+        {
+            auto partition = _activeSessions.lockOnePartitionById(partitionId);
+            using std::swap;
+            swap(partitionSessions, *partition);
+        }
+        _activeSessionsCount.subtractAndFetch(partitionSessions.size());
+        activeSessions.insert(partitionSessions.begin(), partitionSessions.end());
+    }
+
+    // In the case of an exception, puts the active sessions back into their partitions, keeping
+    // any records for the same sessions that had been added since they were taken out.
+    auto activeSessionsBackSwapper = MakeGuard([this, &activeSessions] {
+        for (const auto& it : activeSessions) {
+            auto partition = _activeSessions.lockOnePartition(it.first);
+            if (partition->emplace(it).second) {
+                _activeSessionsCount.fetchAndAdd(1);
+            }
+        }
+    });
     auto explicitlyEndingBackSwaper = backSwapper(_endingSessions, explicitlyEndingSessions);
 
     // remove all explicitlyEndingSessions from activeSessions
@@ -372,10 +393,10 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     auto openCursorSessions = _service->getOpenCursorSessions();
     // Exclude sessions added to _activeSessions from the openCursorSession to avoid race between
     // killing cursors on the removed sessions and creating sessions.
-    {
-        stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+    for (size_t partitionId = 0; partitionId < kNumActiveSessionsPartitions; ++partitionId) {
+        auto partition = _activeSessions.lockOnePartitionById(partitionId);
 
-        for (const auto& it : _activeSessions) {
+        for (const auto& it : *partition) {
             auto newSessionIt = openCursorSessions.find(it.first);
             if (newSessionIt != openCursorSessions.end()) {
                 openCursorSessions.erase(newSessionIt);
@@ -415,37 +436,48 @@ void LogicalSessionCacheImpl::endSessions(const LogicalSessionIdSet& sessions) {
 
 LogicalSessionCacheStats LogicalSessionCacheImpl::getStats() {
     stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    _stats.setActiveSessionsCount(_activeSessions.size());
+    _stats.setActiveSessionsCount(size());
     return _stats;
 }
 
 Status LogicalSessionCacheImpl::_addToCache(LogicalSessionRecord record) {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    if (_activeSessions.size() >= static_cast<size_t>(maxSessions)) {
+    auto partition = _activeSessions.lockOnePartition(record.getId());
+    if (partition->count(record.getId())) {
+        return Status::OK();
+    }
+
+    // Reserve a slot for the new record before inserting it, so that concurrent insertions into
+    // different partitions cannot take the cache past 'maxSessions' between them.
+    if (_activeSessionsCount.fetchAndAdd(1) >= maxSessions) {
+        _activeSessionsCount.subtractAndFetch(1);
         return {ErrorCodes::TooManyLogicalSessions, "cannot add session into the cache"};
     }
-    _activeSessions.insert(std::make_pair(record.getId(), record));
+    partition->insert(std::make_pair(record.getId(), record));
     return Status::OK();
 }
 
 std::vector<LogicalSessionId> LogicalSessionCacheImpl::listIds() const {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
     std::vector<LogicalSessionId> ret;
-    ret.reserve(_activeSessions.size());
-    for (const auto& id : _activeSessions) {
-        ret.push_back(id.first);
+    ret.reserve(_activeSessionsCount.load());
+    for (size_t partitionId = 0; partitionId < kNumActiveSessionsPartitions; ++partitionId) {
+        auto partition = _activeSessions.lockOnePartitionById(partitionId);
+        for (const auto& id : *partition) {
+            ret.push_back(id.first);
+        }
     }
     return ret;
 }
 
 std::vector<LogicalSessionId> LogicalSessionCacheImpl::listIds(
     const std::vector<SHA256Block>& userDigests) const {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
     std::vector<LogicalSessionId> ret;
-    for (const auto& it : _activeSessions) {
-        if (std::find(userDigests.cbegin(), userDigests.cend(), it.first.getUid()) !=
-            userDigests.cend()) {
-            ret.push_back(it.first);
+    for (size_t partitionId = 0; partitionId < kNumActiveSessionsPartitions; ++partitionId) {
+        auto partition = _activeSessions.lockOnePartitionById(partitionId);
+        for (const auto& it : *partition) {
+            if (std::find(userDigests.cbegin(), userDigests.cend(), it.first.getUid()) !=
+                userDigests.cend()) {
+                ret.push_back(it.first);
+            }
         }
     }
     return ret;
@@ -453,9 +485,9 @@ std::vector<LogicalSessionId> LogicalSessionCacheImpl::listIds(
 
 boost::optional<LogicalSessionRecord> LogicalSessionCacheImpl::peekCached(
     const LogicalSessionId& id) const {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    const auto it = _activeSessions.find(id);
-    if (it == _activeSessions.end()) {
+    auto partition = _activeSessions.lockOnePartition(id);
+    const auto it = partition->find(id);
+    if (it == partition->end()) {
         return boost::none;
     }
     return it->second;
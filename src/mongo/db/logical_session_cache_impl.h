@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/logical_session_cache.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/refresh_sessions_gen.h"
@@ -144,10 +145,12 @@ private:
     bool _isDead(const LogicalSessionRecord& record, Date_t now) const;
 
     /**
-     * Takes the lock and inserts the given record into the cache.
+     * Takes the lock of the record's partition and inserts the given record into the cache.
      */
     Status _addToCache(LogicalSessionRecord record);
 
+    static constexpr size_t kNumActiveSessionsPartitions = 16;
+
     const Milliseconds _refreshInterval;
     const Minutes _sessionTimeout;
 
@@ -161,9 +164,18 @@ private:
     mutable stdx::mutex _reaperMutex;
     std::shared_ptr<TransactionReaper> _transactionReaper;
 
+    // Protects '_stats' and '_endingSessions'.
     mutable stdx::mutex _cacheMutex;
 
-    LogicalSessionIdMap<LogicalSessionRecord> _activeSessions;
+    // The active sessions, divided between partitions by the hash of their id, so that promoting
+    // or vivifying different sessions rarely contends on the same lock.
+    mutable Partitioned<LogicalSessionIdMap<LogicalSessionRecord>, kNumActiveSessionsPartitions>
+        _activeSessions;
+
+    // The total number of records across all of the '_activeSessions' partitions. A slot is
+    // reserved here before a record is inserted, which enforces 'maxSessions' without a global
+    // lock and lets size() be answered without taking any lock.
+    AtomicInt64 _activeSessionsCount{0};
 
     LogicalSessionIdSet _endingSessions;
 
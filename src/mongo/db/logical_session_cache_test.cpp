@@ -246,6 +246,41 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     ASSERT(cache()->refreshNow(getClient()).isOK());
 }
 
+// Test that the records taken out of the cache by a failed refresh are put back into it
+TEST_F(LogicalSessionCacheTest, FailedRefreshKeepsActiveSessions) {
+    const size_t count = 100;
+    std::vector<LogicalSessionId> lsids;
+    for (size_t i = 0; i < count; i++) {
+        auto record = makeLogicalSessionRecordForTest();
+        lsids.push_back(record.getId());
+        ASSERT_OK(cache()->startSession(opCtx(), record));
+    }
+    ASSERT_EQ(count, cache()->size());
+    ASSERT_EQ(count, cache()->listIds().size());
+
+    sessions()->setRefreshHook([](const LogicalSessionRecordSet& sessions) {
+        return Status(ErrorCodes::HostUnreachable, "refresh failed");
+    });
+
+    clearOpCtx();
+    ASSERT_NOT_OK(cache()->refreshNow(getClient()));
+
+    ASSERT_EQ(count, cache()->size());
+    ASSERT_EQ(count, cache()->listIds().size());
+    for (const auto& lsid : lsids) {
+        ASSERT_OK(cache()->promote(lsid));
+        ASSERT(cache()->peekCached(lsid));
+    }
+
+    // A successful refresh flushes the records to the sessions collection and empties the cache.
+    sessions()->clearHooks();
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    ASSERT_EQ(0U, cache()->size());
+    for (const auto& lsid : lsids) {
+        ASSERT(sessions()->has(lsid));
+    }
+}
+
 //
 TEST_F(LogicalSessionCacheTest, RefreshMatrixSessionState) {
     const std::vector<std::vector<std::string>> stateNames = {
@@ -85,6 +85,13 @@ private:
     UUID::Hash _hasher;
 };
 
+/**
+ * Spreads sessions over the partitions of a Partitioned container by the hash of their id.
+ */
+inline std::size_t partitionOf(const LogicalSessionId& lsid, const std::size_t nPartitions) {
+    return LogicalSessionIdHash()(lsid) % nPartitions;
+}
+
 struct LogicalSessionRecordHash {
     std::size_t operator()(const LogicalSessionRecord& lsid) const {
         return _hasher(lsid.getId().getId());
@@ -107,6 +107,14 @@ public:
         return *_query;
     }
 
+    /**
+     * The original geo specification provided by the user, from which the GeoExpression was
+     * parsed.
+     */
+    const BSONObj& getRawObj() const {
+        return _rawObj;
+    }
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
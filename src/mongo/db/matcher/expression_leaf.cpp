@@ -31,8 +31,10 @@
 #include "mongo/db/matcher/expression_leaf.h"
 
 #include <cmath>
-#include <pcrecpp.h>
+#include <cstring>
+#include <pcre.h>
 
+#include "mongo/base/disallow_copying.h"
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
@@ -197,44 +199,281 @@ constexpr StringData GTEMatchExpression::kName;
 
 // ---------------
 
-// TODO: move
-inline pcrecpp::RE_Options flags2options(const char* flags) {
-    pcrecpp::RE_Options options;
-    options.set_utf8(true);
-    while (flags && *flags) {
-        if (*flags == 'i')
-            options.set_caseless(true);
-        else if (*flags == 'm')
-            options.set_multiline(true);
-        else if (*flags == 'x')
-            options.set_extended(true);
-        else if (*flags == 's')
-            options.set_dotall(true);
-        flags++;
+namespace {
+
+// Escape sequences which match a single character or assert a position, and which are never
+// followed by an argument. Any other alphanumeric escape ends the search for a required literal.
+constexpr StringData kSingleAtomEscapes = "dDwWsShHvVRbBAzZG"_sd;
+
+bool isAsciiAlnum(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+char asciiToLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+/**
+ * Returns the longest run of literal characters which every string matched by 'regex' must
+ * contain, or an empty string if none was found. The scan is conservative: it gives up on
+ * alternations, stops at the first group, backreference or other construct it does not
+ * understand, and treats quantified characters as optional.
+ *
+ * When 'caseless' is true the returned literal is lowercased and contains only ASCII characters
+ * whose case-insensitive matches are exactly their ASCII upper and lower case. This excludes 'k'
+ * and 's', which in UTF-8 mode also match the Kelvin sign and the long s.
+ */
+std::string requiredLiteral(StringData regex, bool caseless) {
+    if (regex.find('|') != std::string::npos) {
+        return "";
+    }
+
+    std::string best;
+    std::string run;
+    auto endRun = [&] {
+        if (run.size() > best.size()) {
+            best = run;
+        }
+        run.clear();
+    };
+
+    size_t i = 0;
+    while (i < regex.size()) {
+        const size_t atomStart = i;
+        const char c = regex[i];
+        StringData atom;
+
+        if (c == '\\') {
+            if (i + 1 >= regex.size()) {
+                break;
+            }
+            const char escaped = regex[i + 1];
+            if (isAsciiAlnum(escaped)) {
+                if (kSingleAtomEscapes.find(escaped) == std::string::npos) {
+                    break;
+                }
+            } else if (static_cast<unsigned char>(escaped) >= 0x80) {
+                break;
+            } else {
+                // A backslash followed by punctuation or whitespace matches that character.
+                atom = regex.substr(i + 1, 1);
+            }
+            i += 2;
+        } else if (c == '[') {
+            size_t j = i + 1;
+            if (j < regex.size() && regex[j] == '^') {
+                ++j;
+            }
+            if (j < regex.size() && regex[j] == ']') {
+                ++j;
+            }
+            while (j < regex.size() && regex[j] != ']' && regex[j] != '[') {
+                j += (regex[j] == '\\') ? 2 : 1;
+            }
+            if (j >= regex.size() || regex[j] == '[') {
+                // Unterminated, or containing a POSIX class which we do not attempt to skip.
+                break;
+            }
+            i = j + 1;
+        } else if (c == '.' || c == '^' || c == '$') {
+            ++i;
+        } else if (std::strchr("()*+?{", c)) {
+            break;
+        } else if (static_cast<unsigned char>(c) >= 0x80) {
+            // Keep a multi-byte UTF-8 character together, since a quantifier applies to all of it.
+            ++i;
+            while (i < regex.size() && (static_cast<unsigned char>(regex[i]) & 0xC0) == 0x80) {
+                ++i;
+            }
+            atom = regex.substr(atomStart, i - atomStart);
+        } else {
+            atom = regex.substr(i, 1);
+            ++i;
+        }
+
+        if (caseless && !atom.empty()) {
+            const char lit = atom[0];
+            if (atom.size() != 1 || static_cast<unsigned char>(lit) >= 0x80 ||
+                asciiToLower(lit) == 'k' || asciiToLower(lit) == 's') {
+                atom = StringData();
+            }
+        }
+
+        const char quantifier = i < regex.size() ? regex[i] : '\0';
+        if (quantifier == '{') {
+            endRun();
+            break;
+        } else if (quantifier == '?' || quantifier == '*' || quantifier == '+') {
+            // The atom is required at least once only for '+', and either way nothing after it
+            // may be appended to the current run.
+            if (quantifier == '+') {
+                run.append(atom.rawData(), atom.size());
+            }
+            endRun();
+            ++i;
+            if (i < regex.size() && (regex[i] == '?' || regex[i] == '+')) {
+                // Lazy or possessive modifier.
+                ++i;
+            }
+        } else if (!atom.empty()) {
+            run.append(atom.rawData(), atom.size());
+        } else {
+            endRun();
+        }
+    }
+    endRun();
+
+    if (caseless) {
+        for (auto&& lit : best) {
+            lit = asciiToLower(lit);
+        }
+    }
+    return best;
+}
+
+/**
+ * Returns true if 'data' contains 'literal'. If 'caseless' is true, 'literal' must be lowercase
+ * ASCII and the comparison ignores ASCII case.
+ */
+bool containsLiteral(StringData data, StringData literal, bool caseless) {
+    if (literal.size() > data.size()) {
+        return false;
+    }
+
+    const char* const begin = data.rawData();
+    const char* const last = begin + (data.size() - literal.size());
+    const char first = literal[0];
+
+    if (!caseless) {
+        for (const char* pos = begin; pos <= last; ++pos) {
+            pos = static_cast<const char*>(std::memchr(pos, first, last - pos + 1));
+            if (!pos) {
+                return false;
+            }
+            if (std::memcmp(pos + 1, literal.rawData() + 1, literal.size() - 1) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for (const char* pos = begin; pos <= last; ++pos) {
+        if (asciiToLower(*pos) != first) {
+            continue;
+        }
+        size_t k = 1;
+        while (k < literal.size() && asciiToLower(pos[k]) == literal[k]) {
+            ++k;
+        }
+        if (k == literal.size()) {
+            return true;
+        }
     }
-    return options;
+    return false;
 }
 
+}  // namespace
+
+class RegexMatchExpression::CompiledRegex {
+    MONGO_DISALLOW_COPYING(CompiledRegex);
+
+public:
+    CompiledRegex(const std::string& regex, const std::string& flags) {
+        int options = PCRE_UTF8;
+        bool caseless = false;
+        bool extended = false;
+        for (auto&& flag : flags) {
+            if (flag == 'i') {
+                options |= PCRE_CASELESS;
+                caseless = true;
+            } else if (flag == 'm') {
+                options |= PCRE_MULTILINE;
+            } else if (flag == 'x') {
+                options |= PCRE_EXTENDED;
+                extended = true;
+            } else if (flag == 's') {
+                options |= PCRE_DOTALL;
+            }
+        }
+
+        const char* error = nullptr;
+        int errorOffset = 0;
+        _code = pcre_compile(regex.c_str(), options, &error, &errorOffset, nullptr);
+        if (!_code) {
+            // A malformed pattern is accepted by the parser but never matches anything.
+            return;
+        }
+
+        // Studying the pattern finds the set of possible starting bytes and the minimum subject
+        // length, and JIT-compiles it when the PCRE library was built with JIT support. The JIT
+        // request is ignored otherwise. A null result just means there was nothing to record.
+        _extra = pcre_study(_code, PCRE_STUDY_JIT_COMPILE, &error);
+
+        // Whitespace and comments are not literal in extended mode, so don't prefilter.
+        if (!extended) {
+            _literal = requiredLiteral(regex, caseless);
+            _caseless = caseless;
+        }
+    }
+
+    ~CompiledRegex() {
+        if (_extra) {
+            pcre_free_study(_extra);
+        }
+        if (_code) {
+            pcre_free(_code);
+        }
+    }
+
+    bool partialMatch(StringData data) const {
+        if (!_code) {
+            return false;
+        }
+
+        // Most subjects which can't match are rejected here without running the pattern.
+        if (!_literal.empty() && !containsLiteral(data, _literal, _caseless)) {
+            return false;
+        }
+
+        const int size = static_cast<int>(data.size());
+        int rc = pcre_exec(_code, _extra, data.rawData(), size, 0, 0, nullptr, 0);
+        if (rc == PCRE_ERROR_JIT_STACKLIMIT) {
+            // The JIT code ran out of stack. Fall back to the interpreter, which doesn't share
+            // this limit, rather than reporting a spurious non-match.
+            pcre_extra interpreted = *_extra;
+            interpreted.flags &= ~PCRE_EXTRA_EXECUTABLE_JIT;
+            rc = pcre_exec(_code, &interpreted, data.rawData(), size, 0, 0, nullptr, 0);
+        }
+        return rc >= 0;
+    }
+
+private:
+    pcre* _code = nullptr;
+    pcre_extra* _extra = nullptr;
+    std::string _literal;
+    bool _caseless = false;
+};
+
 const std::set<char> RegexMatchExpression::kValidRegexFlags = {'i', 'm', 's', 'x'};
 constexpr size_t RegexMatchExpression::kMaxPatternSize;
 
 RegexMatchExpression::RegexMatchExpression(StringData path, const BSONElement& e)
-    : LeafMatchExpression(REGEX, path),
-      _regex(e.regex()),
-      _flags(e.regexFlags()),
-      _re(new pcrecpp::RE(_regex.c_str(), flags2options(_flags.c_str()))) {
+    : LeafMatchExpression(REGEX, path), _regex(e.regex()), _flags(e.regexFlags()) {
     uassert(ErrorCodes::BadValue, "regex not a regex", e.type() == RegEx);
     _init();
 }
 
 RegexMatchExpression::RegexMatchExpression(StringData path, StringData regex, StringData options)
-    : LeafMatchExpression(REGEX, path),
-      _regex(regex.toString()),
-      _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), flags2options(_flags.c_str()))) {
+    : LeafMatchExpression(REGEX, path), _regex(regex.toString()), _flags(options.toString()) {
     _init();
 }
 
+RegexMatchExpression::RegexMatchExpression(StringData path,
+                                           const std::string& regex,
+                                           const std::string& flags,
+                                           std::shared_ptr<const CompiledRegex> re)
+    : LeafMatchExpression(REGEX, path), _regex(regex), _flags(flags), _re(std::move(re)) {}
+
 void RegexMatchExpression::_init() {
     uassert(
         ErrorCodes::BadValue, "Regular expression is too long", _regex.size() <= kMaxPatternSize);
@@ -246,10 +485,21 @@ void RegexMatchExpression::_init() {
     uassert(ErrorCodes::BadValue,
             "Regular expression options string cannot contain an embedded null byte",
             _flags.find('\0') == std::string::npos);
+
+    _re = std::make_shared<CompiledRegex>(_regex, _flags);
 }
 
 RegexMatchExpression::~RegexMatchExpression() {}
 
+std::unique_ptr<MatchExpression> RegexMatchExpression::shallowClone() const {
+    // The clone shares the compiled pattern rather than compiling it again.
+    std::unique_ptr<RegexMatchExpression> e(new RegexMatchExpression(path(), _regex, _flags, _re));
+    if (getTag()) {
+        e->setTag(getTag()->clone());
+    }
+    return std::move(e);
+}
+
 bool RegexMatchExpression::equivalent(const MatchExpression* other) const {
     if (matchType() != other->matchType())
         return false;
@@ -263,11 +513,9 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
     switch (e.type()) {
         case String:
         case Symbol: {
-            // String values stored in documents can contain embedded NUL bytes. We construct a
-            // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
-            // 'data' early.
-            pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
-            return _re->PartialMatch(data);
+            // String values stored in documents can contain embedded NUL bytes, so we match
+            // against the full length of the string to avoid truncating it early.
+            return _re->partialMatch(StringData(e.valuestr(), e.valuestrsize() - 1));
         }
         case RegEx:
             return _regex == e.regex() && _flags == e.regexFlags();
@@ -37,10 +37,6 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/unordered_map.h"
 
-namespace pcrecpp {
-class RE;
-}  // namespace pcrecpp;
-
 namespace mongo {
 
 class CollatorInterface;
@@ -289,14 +285,7 @@ public:
 
     ~RegexMatchExpression();
 
-    virtual std::unique_ptr<MatchExpression> shallowClone() const {
-        std::unique_ptr<RegexMatchExpression> e =
-            stdx::make_unique<RegexMatchExpression>(path(), _regex, _flags);
-        if (getTag()) {
-            e->setTag(getTag()->clone());
-        }
-        return std::move(e);
-    }
+    virtual std::unique_ptr<MatchExpression> shallowClone() const;
 
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
 
@@ -322,11 +311,27 @@ private:
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
     }
 
+    /**
+     * The compiled form of the pattern, along with any literal substring which must be present in
+     * every matching string. Defined in the .cpp file so that the PCRE headers are not exposed.
+     */
+    class CompiledRegex;
+
+    /**
+     * Used by shallowClone() to share the already compiled pattern with the clone.
+     */
+    RegexMatchExpression(StringData path,
+                         const std::string& regex,
+                         const std::string& flags,
+                         std::shared_ptr<const CompiledRegex> re);
+
     void _init();
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+
+    // Immutable once constructed, and therefore safe to share between clones.
+    std::shared_ptr<const CompiledRegex> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -994,6 +994,66 @@ TEST(RegexMatchExpression, RegexAcceptsUCPOption) {
                                   << "\u304C")));
 }
 
+TEST(RegexMatchExpression, MatchesWhenRequiredLiteralIsPresent) {
+    RegexMatchExpression regex("a", "error.*timeout", "");
+    ASSERT(regex.matchesBSON(BSON("a"
+                                  << "error: connection timeout")));
+    ASSERT_FALSE(regex.matchesBSON(BSON("a"
+                                        << "error: connection refused")));
+    ASSERT_FALSE(regex.matchesBSON(BSON("a"
+                                        << "timeout before error")));
+}
+
+TEST(RegexMatchExpression, OptionalCharactersAreNotRequired) {
+    RegexMatchExpression optional("a", "x?yz", "");
+    ASSERT(optional.matchesBSON(BSON("a"
+                                     << "yz")));
+    RegexMatchExpression star("a", "xy*z", "");
+    ASSERT(star.matchesBSON(BSON("a"
+                                 << "xz")));
+    RegexMatchExpression zeroRepeat("a", "xy{0}z", "");
+    ASSERT(zeroRepeat.matchesBSON(BSON("a"
+                                       << "xz")));
+    RegexMatchExpression group("a", "(xy)?z", "");
+    ASSERT(group.matchesBSON(BSON("a"
+                                  << "z")));
+    RegexMatchExpression alternation("a", "xyz|w", "");
+    ASSERT(alternation.matchesBSON(BSON("a"
+                                        << "w")));
+}
+
+TEST(RegexMatchExpression, CaseInsensitiveRequiredLiteral) {
+    RegexMatchExpression regex("a", "error.*timeout", "i");
+    ASSERT(regex.matchesBSON(BSON("a"
+                                  << "ERROR: Connection TimeOut")));
+    ASSERT_FALSE(regex.matchesBSON(BSON("a"
+                                        << "ERROR: Connection Refused")));
+}
+
+TEST(RegexMatchExpression, CaseInsensitiveLiteralMatchesUnicodeCaseFolding) {
+    // In UTF-8 mode a case-insensitive 'k' also matches the Kelvin sign.
+    RegexMatchExpression regex("a", "kelvin", "i");
+    ASSERT(regex.matchesBSON(BSON("a"
+                                  << "\u212Aelvin")));
+}
+
+TEST(RegexMatchExpression, RequiredLiteralAfterEmbeddedNullByte) {
+    RegexMatchExpression regex("a", "bc", "");
+    BSONObjBuilder builder;
+    builder.append("a", StringData("a\0bc", 4));
+    ASSERT(regex.matchesBSON(builder.obj()));
+}
+
+TEST(RegexMatchExpression, ClonedExpressionMatchesLikeOriginal) {
+    RegexMatchExpression regex("a", "ab+c", "i");
+    auto clone = regex.shallowClone();
+    ASSERT(clone->equivalent(&regex));
+    ASSERT(clone->matchesBSON(BSON("a"
+                                   << "xABBC")));
+    ASSERT_FALSE(clone->matchesBSON(BSON("a"
+                                         << "xAC")));
+}
+
 TEST(ModMatchExpression, MatchesElement) {
     BSONObj match = BSON("a" << 1);
     BSONObj largerMatch = BSON("a" << 4.0);
@@ -60,6 +60,10 @@ enum class AccumulatorDocumentsNeeded {
     // Accumulator only needs to see one document in a group, and when there is a sort order, that
     // document must be the last document.
     kLastDocument,
+
+    // Accumulator only needs to see the document in a group with the greatest value of its
+    // argument.
+    kGreatestValueDocument,
 };
 
 class Accumulator : public RefCountable {
@@ -76,6 +80,14 @@ public:
         processInternal(input, merging);
     }
 
+    /** Process a batch of inputs, in order, with the same result as calling process() on each.
+     *  Accumulators that can consume many values more cheaply than one at a time override
+     *  processBatchInternal().
+     */
+    void processBatch(const std::vector<Value>& inputs, bool merging) {
+        processBatchInternal(inputs, merging);
+    }
+
     /** Marks the end of the evaluate() phase and return accumulated result.
      *  toBeMerged should be true when the outputs will be merged by process().
      */
@@ -109,6 +121,13 @@ protected:
     /// Update subclass's internal state based on input
     virtual void processInternal(const Value& input, bool merging) = 0;
 
+    /// Update subclass's internal state based on a batch of inputs
+    virtual void processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+        for (auto&& input : inputs) {
+            processInternal(input, merging);
+        }
+    }
+
     const boost::intrusive_ptr<ExpressionContext>& getExpressionContext() const {
         return _expCtx;
     }
@@ -194,6 +213,7 @@ public:
     explicit AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -238,6 +258,13 @@ public:
         return true;
     }
 
+    AccumulatorDocumentsNeeded documentsNeeded() const final {
+        // $max ignores nullish values, which sort before all others, so the greatest value in a
+        // group is its result. $min has no such document when the group has nullish values.
+        return _sense == MAX ? AccumulatorDocumentsNeeded::kGreatestValueDocument
+                             : AccumulatorDocumentsNeeded::kAllDocuments;
+    }
+
 private:
     Value _val;
     const Sense _sense;
@@ -282,6 +309,7 @@ public:
     explicit AccumulatorAvg(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -52,6 +52,9 @@ namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision
 const char countName[] = "count";
+
+// Number of unboxed inputs of each type gathered before handing them to the summation.
+const size_t kBatchBufferSize = 256;
 }  // namespace
 
 void AccumulatorAvg::processInternal(const Value& input, bool merging) {
@@ -92,6 +95,51 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    // Unbox the inputs into flat arrays so that the summation can consume them without any per
+    // value dispatch. The type treatment matches processInternal() above.
+    double doubles[kBatchBufferSize];
+    long long longs[kBatchBufferSize];
+    size_t numDoubles = 0;
+    size_t numLongs = 0;
+
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberDecimal:
+                _decimalTotal = _decimalTotal.add(input.getDecimal());
+                _isDecimal = true;
+                break;
+            case NumberLong:
+                longs[numLongs++] = input.getLong();
+                if (numLongs == kBatchBufferSize) {
+                    _nonDecimalTotal.addLongs(longs, numLongs);
+                    numLongs = 0;
+                }
+                break;
+            case NumberInt:
+            case NumberDouble:
+                doubles[numDoubles++] = input.getDouble();
+                if (numDoubles == kBatchBufferSize) {
+                    _nonDecimalTotal.addDoubles(doubles, numDoubles);
+                    numDoubles = 0;
+                }
+                break;
+            default:
+                dassert(!input.numeric());
+                continue;
+        }
+        _count++;
+    }
+
+    _nonDecimalTotal.addLongs(longs, numLongs);
+    _nonDecimalTotal.addDoubles(doubles, numDoubles);
+}
+
 intrusive_ptr<Accumulator> AccumulatorAvg::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorAvg(expCtx);
@@ -52,6 +52,9 @@ const char* AccumulatorSum::getOpName() const {
 namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision.
+
+// Number of unboxed inputs of each type gathered before handing them to the summation.
+const size_t kBatchBufferSize = 256;
 }  // namespace
 
 
@@ -84,6 +87,53 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        // Merge documents are rare and already summarize many inputs.
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    // Unbox the inputs into flat arrays so that the summation can consume them without any per
+    // value dispatch.
+    double doubles[kBatchBufferSize];
+    long long longs[kBatchBufferSize];
+    size_t numDoubles = 0;
+    size_t numLongs = 0;
+
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberInt:
+            case NumberLong:
+                longs[numLongs++] = input.coerceToLong();
+                if (numLongs == kBatchBufferSize) {
+                    nonDecimalTotal.addLongs(longs, numLongs);
+                    numLongs = 0;
+                }
+                break;
+            case NumberDouble:
+                doubles[numDoubles++] = input.getDouble();
+                if (numDoubles == kBatchBufferSize) {
+                    nonDecimalTotal.addDoubles(doubles, numDoubles);
+                    numDoubles = 0;
+                }
+                break;
+            case NumberDecimal:
+                decimalTotal = decimalTotal.add(input.coerceToDecimal());
+                break;
+            default:
+                dassert(!input.numeric());
+                continue;
+        }
+
+        // Upgrade to the widest type required to hold the result.
+        totalType = Value::getWidestNumeric(totalType, input.getType());
+    }
+
+    nonDecimalTotal.addLongs(longs, numLongs);
+    nonDecimalTotal.addDoubles(doubles, numDoubles);
+}
+
 intrusive_ptr<Accumulator> AccumulatorSum::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorSum(expCtx);
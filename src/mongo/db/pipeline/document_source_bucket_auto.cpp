@@ -91,6 +91,7 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     if (!_sorter) {
         SortOptions opts;
         opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+        opts.memoryTracker = &_memoryTracker;
         if (pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
             opts.extSortAllowed = true;
             opts.tempDir = pExpCtx->tempDir;
@@ -108,6 +109,7 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
         _sorter->add(extractKey(nextDoc), nextDoc);
+        _memoryTracker.set(_sorter->memUsed());
         _nDocuments++;
     }
     return next;
@@ -158,6 +160,8 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
 void DocumentSourceBucketAuto::populateBuckets() {
     invariant(_sorter);
     _sortedInput.reset(_sorter->done());
+    _usedDisk = _sorter->usedDisk() || _usedDisk;
+    _numSpills += _sorter->numFiles();
     _sorter.reset();
 
     // If there are no buckets, then we don't need to populate anything.
@@ -328,6 +332,7 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
+    _memoryTracker.set(0);
     _bucketsIterator = _buckets.end();
 }
 
@@ -351,6 +356,12 @@ Value DocumentSourceBucketAuto::serialize(
     }
     insides["output"] = outputSpec.freezeToValue();
 
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
+        return Value{Document{{getSourceName(), insides.freezeToValue()},
+                              {"usedDisk", _usedDisk},
+                              {"spills", _numSpills},
+                              {"peakMemoryUsageBytes", _memoryTracker.peakMemoryBytes()}}};
+    }
     return Value{Document{{getSourceName(), insides.freezeToValue()}}};
 }
 
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/granularity_rounder.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/util/memory_usage_tracker.h"
 
 namespace mongo {
 
@@ -44,6 +45,9 @@ namespace mongo {
 class DocumentSourceBucketAuto final : public DocumentSource, public NeedsMergerDocumentSource {
 public:
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+    bool usedDisk() final {
+        return _usedDisk;
+    }
     DepsTracker::State getDependencies(DepsTracker* deps) const final;
     GetNextResult getNext() final;
     const char* getSourceName() const final;
@@ -158,6 +162,11 @@ private:
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
     long long _nDocuments = 0;
+    bool _usedDisk = false;  // Keeps track of whether the sorter spilled to disk.
+    int _numSpills = 0;      // Number of files the sorter spilled its input to.
+
+    // Tracks the memory held by the sorter, charged to the operation's total.
+    MemoryUsageTracker _memoryTracker{pExpCtx->memoryTracker};
 };
 
 }  // namespace mongo
@@ -380,6 +380,41 @@ TEST_F(BucketAutoTests, ShouldBeAbleToCorrectlySpillToDisk) {
     ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
 }
 
+TEST_F(BucketAutoTests, ShouldReportSpillsInExplainWithExecutionStats) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceBucketAutoTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$a", vps);
+
+    const int numBuckets = 2;
+    auto bucketAutoStage = DocumentSourceBucketAuto::create(
+        expCtx, groupByExpression, numBuckets, {}, nullptr, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"a", 0}, {"largeStr", largeStr}},
+                                            Document{{"a", 1}, {"largeStr", largeStr}},
+                                            Document{{"a", 2}, {"largeStr", largeStr}},
+                                            Document{{"a", 3}, {"largeStr", largeStr}}});
+    bucketAutoStage->setSource(mock.get());
+    ASSERT_FALSE(bucketAutoStage->usedDisk());
+
+    ASSERT_TRUE(bucketAutoStage->getNext().isAdvanced());
+    ASSERT_TRUE(bucketAutoStage->getNext().isAdvanced());
+    ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
+    ASSERT_TRUE(bucketAutoStage->usedDisk());
+
+    auto explained = bucketAutoStage->serialize(ExplainOptions::Verbosity::kExecStats);
+    ASSERT_VALUE_EQ(explained["usedDisk"], Value(true));
+    ASSERT_GTE(explained["spills"].getInt(), 2);
+
+    explained = bucketAutoStage->serialize(ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_TRUE(explained["usedDisk"].missing());
+}
+
 TEST_F(BucketAutoTests, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto expCtx = getExpCtx();
 
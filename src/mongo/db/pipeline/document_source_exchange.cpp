@@ -87,6 +87,7 @@ Exchange::Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter>
     for (int idx = 0; idx < _spec.getConsumers(); ++idx) {
         _consumers.emplace_back(std::make_unique<ExchangeBuffer>());
     }
+    _consumerBatches.resize(_consumers.size());
 
     if (_policy == ExchangePolicyEnum::kKeyRange) {
         uassert(50900,
@@ -228,6 +229,16 @@ std::vector<FieldPath> Exchange::extractKeyPaths(const BSONObj& keyPattern) {
 }
 
 DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx, size_t consumerId) {
+    auto& batch = _consumerBatches[consumerId];
+
+    // Return the results handed off to this consumer earlier without taking the lock, unless some
+    // other thread has failed in the meantime.
+    if (!batch.empty() && !_loadFailed.load()) {
+        auto doc = std::move(batch.front());
+        batch.pop_front();
+        return doc;
+    }
+
     // Grab a lock.
     stdx::unique_lock<stdx::mutex> lk(_mutex);
 
@@ -238,7 +249,9 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx, size_t
 
         // Check if we have a document.
         if (!_consumers[consumerId]->isEmpty()) {
-            auto doc = _consumers[consumerId]->getNext();
+            // Take everything that has been buffered for this consumer at once.
+            invariant(batch.empty());
+            _consumers[consumerId]->takeAll(&batch);
 
             // See if the loading is blocked on this consumer and if so unblock it.
             if (_loadingThreadId == consumerId) {
@@ -246,6 +259,8 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx, size_t
                 _haveBufferSpace.notify_all();
             }
 
+            auto doc = std::move(batch.front());
+            batch.pop_front();
             return doc;
         }
 
@@ -280,6 +295,7 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx, size_t
                 _haveBufferSpace.notify_all();
             } catch (const DBException& ex) {
                 _errorInLoadNextBatch = ex.toStatus();
+                _loadFailed.store(true);
 
                 // We have to wake up all other blocked threads so they can detect the error and
                 // fail too. They can be woken up only after _errorInLoadNextBatch has been set.
@@ -380,6 +396,8 @@ size_t Exchange::getTargetConsumer(const Document& input) {
 }
 
 void Exchange::dispose(OperationContext* opCtx, size_t consumerId) {
+    _consumerBatches[consumerId].clear();
+
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
     invariant(_disposeRunDown < getConsumers());
@@ -397,17 +415,11 @@ void Exchange::dispose(OperationContext* opCtx, size_t consumerId) {
     }
 }
 
-DocumentSource::GetNextResult Exchange::ExchangeBuffer::getNext() {
-    invariant(!_buffer.empty());
-
-    auto result = std::move(_buffer.front());
-    _buffer.pop_front();
-
-    if (result.isAdvanced()) {
-        _bytesInBuffer -= result.getDocument().getApproximateSize();
-    }
+void Exchange::ExchangeBuffer::takeAll(std::deque<DocumentSource::GetNextResult>* batch) {
+    invariant(batch->empty());
 
-    return result;
+    batch->swap(_buffer);
+    _bytesInBuffer = 0;
 }
 
 bool Exchange::ExchangeBuffer::appendDocument(DocumentSource::GetNextResult input, size_t limit) {
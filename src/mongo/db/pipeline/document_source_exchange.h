@@ -35,6 +35,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/exchange_spec_gen.h"
 #include "mongo/db/pipeline/field_path.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 
@@ -91,7 +92,13 @@ private:
     class ExchangeBuffer {
     public:
         bool appendDocument(DocumentSource::GetNextResult input, size_t limit);
-        DocumentSource::GetNextResult getNext();
+
+        /**
+         * Moves all of the buffered results into 'batch', which must be empty, leaving this buffer
+         * empty.
+         */
+        void takeAll(std::deque<DocumentSource::GetNextResult>* batch);
+
         bool isEmpty() const {
             return _buffer.empty();
         }
@@ -130,7 +137,8 @@ private:
     // to prevent deadlocks.
     const bool _orderPreserving;
 
-    // A maximum size of buffer per consumer.
+    // A maximum size of buffer per consumer. A consumer may additionally hold up to one buffer's
+    // worth of results which it has taken out of its buffer but not yet returned.
     const size_t _maxBufferSize;
 
     // An input to the exchange operator
@@ -147,6 +155,10 @@ private:
     // state all other producing threads will fail too.
     Status _errorInLoadNextBatch{Status::OK()};
 
+    // Set together with '_errorInLoadNextBatch', so that consumers can check for a failure without
+    // taking '_mutex'.
+    AtomicWord<bool> _loadFailed{false};
+
     size_t _roundRobinCounter{0};
 
     // A rundown counter of consumers disposing of the pipelines. Only the last consumer will
@@ -154,6 +166,12 @@ private:
     size_t _disposeRunDown{0};
 
     std::vector<std::unique_ptr<ExchangeBuffer>> _consumers;
+
+    // The results each consumer has taken out of its buffer but not yet returned. A consumer hands
+    // off its whole buffer at once, so that it only needs to take '_mutex' once per batch rather
+    // than once per document. Each batch is only ever accessed by its consumer, and so is not
+    // protected by '_mutex'.
+    std::vector<std::deque<DocumentSource::GetNextResult>> _consumerBatches;
 };
 
 class DocumentSourceExchange final : public DocumentSource {
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <numeric>
+
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace {
+
+// Number of distinct documents the generated input cycles through.
+const int kPoolSize = 4096;
+
+// Number of documents pushed through the exchange by each run.
+const long long kNumDocs = 1 << 20;
+
+/**
+ * An implementation of the MongoProcessInterface that is okay with changing the OperationContext,
+ * but has no other parts of the interface implemented.
+ */
+class StubMongoProcessOkWithOpCtxChanges : public StubMongoProcessInterface {
+public:
+    void setOperationContext(OperationContext* opCtx) final {
+        return;
+    }
+};
+
+/**
+ * Produces a fixed number of documents by cycling through a small pool of pre-built documents, so
+ * that generating the input does not dominate the cost of the exchange being measured.
+ */
+class DocumentSourceGenerator final : public DocumentSourceMock {
+public:
+    DocumentSourceGenerator(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                            const std::vector<Document>& pool,
+                            long long numDocs)
+        : DocumentSourceMock({}, expCtx), _pool(pool), _remaining(numDocs) {}
+
+    GetNextResult getNext() final {
+        if (_remaining == 0) {
+            return GetNextResult::makeEOF();
+        }
+        --_remaining;
+        return Document(_pool[_remaining % _pool.size()]);
+    }
+
+private:
+    const std::vector<Document>& _pool;
+    long long _remaining;
+};
+
+/**
+ * Distributes 'kNumDocs' documents among state.range(0) consumers, each of which runs on its own
+ * thread, using exchange buffers of state.range(1) bytes.
+ */
+void runExchange(benchmark::State& state, ExchangePolicyEnum policy) {
+    const size_t numConsumers = state.range(0);
+    const size_t bufferSize = state.range(1);
+
+    std::vector<Document> pool;
+    for (int i = 0; i < kPoolSize; ++i) {
+        pool.push_back(Document{{"a", i}, {"b", "aaaaaaaaaaaaaaaaaaaaaaaaaaa"_sd}});
+    }
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    expCtx->mongoProcessInterface = std::make_shared<StubMongoProcessOkWithOpCtxChanges>();
+
+    long long docsPerRun = 0;
+    for (auto keepRunning : state) {
+        ExchangeSpec spec;
+        spec.setPolicy(policy);
+        spec.setConsumers(numConsumers);
+        spec.setBufferSize(bufferSize);
+        if (policy == ExchangePolicyEnum::kKeyRange) {
+            spec.setKey(BSON("a" << 1));
+            std::vector<BSONObj> boundaries{BSON("a" << MINKEY)};
+            for (size_t idx = 1; idx < numConsumers; ++idx) {
+                boundaries.push_back(BSON("a" << static_cast<int>(idx * kPoolSize / numConsumers)));
+            }
+            boundaries.push_back(BSON("a" << MAXKEY));
+            spec.setBoundaries(boundaries);
+        }
+
+        boost::intrusive_ptr<DocumentSourceGenerator> source(
+            new DocumentSourceGenerator(expCtx, pool, kNumDocs));
+        boost::intrusive_ptr<Exchange> exchange =
+            new Exchange(spec, uassertStatusOK(Pipeline::create({source}, expCtx)));
+
+        std::vector<long long> docsConsumed(numConsumers, 0);
+        std::vector<stdx::thread> consumers;
+        for (size_t id = 0; id < numConsumers; ++id) {
+            consumers.emplace_back([&, id] {
+                for (auto input = exchange->getNext(expCtx->opCtx, id); input.isAdvanced();
+                     input = exchange->getNext(expCtx->opCtx, id)) {
+                    ++docsConsumed[id];
+                }
+            });
+        }
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+        for (size_t id = 0; id < numConsumers; ++id) {
+            exchange->dispose(expCtx->opCtx, id);
+        }
+
+        docsPerRun = std::accumulate(docsConsumed.begin(), docsConsumed.end(), 0LL);
+    }
+
+    state.SetItemsProcessed(state.iterations() * docsPerRun);
+}
+
+void BM_ExchangeRoundRobin(benchmark::State& state) {
+    runExchange(state, ExchangePolicyEnum::kRoundRobin);
+}
+
+void BM_ExchangeBroadcast(benchmark::State& state) {
+    runExchange(state, ExchangePolicyEnum::kBroadcast);
+}
+
+void BM_ExchangeKeyRange(benchmark::State& state) {
+    runExchange(state, ExchangePolicyEnum::kKeyRange);
+}
+
+// Arguments are {number of consumers, buffer size in bytes}.
+BENCHMARK(BM_ExchangeRoundRobin)
+    ->Args({1, 1024 * 1024})
+    ->Args({4, 1024 * 1024})
+    ->Args({16, 1024 * 1024})
+    ->Args({4, 4 * 1024})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_ExchangeBroadcast)
+    ->Args({4, 1024 * 1024})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_ExchangeKeyRange)
+    ->Args({4, 1024 * 1024})
+    ->Args({16, 1024 * 1024})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/executor/network_interface_factory.h"
 #include "mongo/executor/thread_pool_task_executor.h"
@@ -133,6 +134,32 @@ TEST_F(DocumentSourceExchangeTest, SimpleExchange1Consumer) {
     ASSERT_EQ(docs, nDocs);
 }
 
+TEST_F(DocumentSourceExchangeTest, SimpleExchange1ConsumerPreservesOrderAcrossBatches) {
+    const size_t nDocs = 500;
+
+    auto source = getMockSource(nDocs);
+
+    // A buffer this small fills up after a few documents, so the consumer takes many batches.
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+    spec.setConsumers(1);
+    spec.setBufferSize(256);
+
+    boost::intrusive_ptr<Exchange> ex =
+        new Exchange(spec, unittest::assertGet(Pipeline::create({source}, getExpCtx())));
+
+    auto input = ex->getNext(getExpCtx()->opCtx, 0);
+
+    size_t docs = 0;
+    for (; input.isAdvanced(); input = ex->getNext(getExpCtx()->opCtx, 0)) {
+        ASSERT_VALUE_EQ(input.getDocument()["a"], Value(static_cast<int>(docs)));
+        ++docs;
+    }
+
+    ASSERT_EQ(docs, nDocs);
+    ASSERT_TRUE(input.isEOF());
+}
+
 TEST_F(DocumentSourceExchangeTest, SimpleExchangeNConsumer) {
     const size_t nDocs = 500;
     auto source = getMockSource(500);
@@ -58,7 +58,9 @@ using std::vector;
 DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelines,
                                          const intrusive_ptr<ExpressionContext>& expCtx)
     : DocumentSource(expCtx),
-      _teeBuffer(TeeBuffer::create(facetPipelines.size())),
+      _teeBuffer(TeeBuffer::create(facetPipelines.size(),
+                                   internalQueryFacetBufferSizeBytes.load(),
+                                   expCtx->memoryTracker)),
       _facets(std::move(facetPipelines)) {
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
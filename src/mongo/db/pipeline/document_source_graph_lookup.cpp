@@ -174,6 +174,7 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _memoryTracker.set(0);
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -393,6 +394,16 @@ void DocumentSourceGraphLookUp::checkMemoryUsage() {
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
+    _memoryTracker.set(_visitedUsageBytes + _frontierUsageBytes + _cache.getMemoryUsage());
+
+    // The cache is all this stage can give up when the pipeline is over its memory budget.
+    if (_memoryTracker.shouldReleaseMemory()) {
+        _cache.evictDownTo(0);
+        _memoryTracker.set(_visitedUsageBytes + _frontierUsageBytes);
+        uassert(50985,
+                "$graphLookup reached the memory budget of its pipeline",
+                !_memoryTracker.shouldReleaseMemory());
+    }
 }
 
 void DocumentSourceGraphLookUp::serializeToArray(
@@ -427,7 +438,12 @@ void DocumentSourceGraphLookUp::serializeToArray(
                                       << (indexPath ? Value((*indexPath).fullPath()) : Value())));
     }
 
-    array.push_back(Value(DOC(getSourceName() << spec.freeze())));
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
+        array.push_back(Value(DOC(getSourceName() << spec.freeze() << "peakMemoryUsageBytes"
+                                                  << _memoryTracker.peakMemoryBytes())));
+    } else {
+        array.push_back(Value(DOC(getSourceName() << spec.freeze())));
+    }
 
     // If we are not explaining, the output of this method must be parseable, so serialize our
     // $unwind into a separate stage.
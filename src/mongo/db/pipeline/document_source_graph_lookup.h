@@ -33,6 +33,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/util/memory_usage_tracker.h"
 
 namespace mongo {
 
@@ -192,6 +193,10 @@ private:
     size_t _visitedUsageBytes = 0;
     size_t _frontierUsageBytes = 0;
 
+    // Tracks the memory held by the visited set, the frontier and the cache, charged to the
+    // operation's total.
+    MemoryUsageTracker _memoryTracker{pExpCtx->memoryTracker};
+
     // Only used during the breadth-first search, tracks the set of values on the current frontier.
     ValueUnorderedSet _frontier;
 
@@ -47,6 +47,16 @@ using std::pair;
 using std::shared_ptr;
 using std::vector;
 
+namespace {
+// Number of input documents an unsorted $group evaluates before handing their accumulator
+// arguments to the accumulators in bulk.
+const size_t kGroupBatchSize = 1024;
+
+// Approximate size of a hash table node, beyond the key and value stored in it: the link to the
+// next node and the cached hash.
+const size_t kHashNodeOverheadBytes = 2 * sizeof(void*);
+}  // namespace
+
 Document GroupFromFirstDocumentTransformation::applyTransformation(const Document& input) {
     MutableDocument output(_accumulatorExprs.size());
 
@@ -95,9 +105,10 @@ DocumentSource::GetModPathsReturn GroupFromFirstDocumentTransformation::getModif
 std::unique_ptr<GroupFromFirstDocumentTransformation> GroupFromFirstDocumentTransformation::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
     const std::string& groupId,
-    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs) {
-    return std::make_unique<GroupFromFirstDocumentTransformation>(groupId,
-                                                                  std::move(accumulatorExprs));
+    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs,
+    std::vector<BSONObj> firstDocumentSorts) {
+    return std::make_unique<GroupFromFirstDocumentTransformation>(
+        groupId, std::move(accumulatorExprs), std::move(firstDocumentSorts));
 }
 
 constexpr StringData DocumentSourceGroup::kStageName;
@@ -141,7 +152,9 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
 
     _currentId = _firstPartOfNextGroup.first;
     const size_t numAccumulators = _accumulatedFields.size();
-    while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
+    const Value currentKey = getSpilledGroupKey(_currentId);
+    while (getGroupsComparator().evaluate(currentKey ==
+                                          getSpilledGroupKey(_firstPartOfNextGroup.first))) {
         // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
         // At loop exit, it is the first value to be processed in the next group.
         switch (numAccumulators) {  // mirrors switch in spill()
@@ -165,7 +178,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
         _firstPartOfNextGroup = _sorterIterator->next();
     }
 
-    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    return makeDocument(
+        getSpilledGroupId(_currentId), _currentAccumulators, pExpCtx->needsMerge);
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
@@ -173,7 +187,9 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
-    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    const Value& id = _groupByComparisonKey ? _groupIds.at(&groupsIterator->second)
+                                            : groupsIterator->first;
+    Document out = makeDocument(id, groupsIterator->second, pExpCtx->needsMerge);
 
     if (++groupsIterator == _groups->end())
         dispose();
@@ -221,8 +237,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
 
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = getGroupsComparator().makeUnorderedValueMap<Accumulators>();
+    _groupIds.clear();
     _sorterIterator.reset();
+    _memoryTracker.set(0);
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -276,10 +294,15 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
-    if (explain && findRelevantInputSort()) {
-        return Value(DOC("$streamingGroup" << insides.freeze()));
+    const StringData stageName =
+        explain && findRelevantInputSort() ? "$streamingGroup"_sd : kStageName;
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
+        return Value(DOC(stageName << insides.freeze() << "usedDisk" << _usedDisk << "spills"
+                                   << _numSpills
+                                   << "peakMemoryUsageBytes"
+                                   << _memoryTracker.peakMemoryBytes()));
     }
-    return Value(DOC(getSourceName() << insides.freeze()));
+    return Value(DOC(stageName << insides.freeze()));
 }
 
 DepsTracker::State DocumentSourceGroup::getDependencies(DepsTracker* deps) const {
@@ -338,10 +361,12 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _doingMerge(false),
       _maxMemoryUsageBytes(maxMemoryUsageBytes ? *maxMemoryUsageBytes
                                                : internalDocumentSourceGroupMaxMemoryBytes.load()),
+      _memoryTracker(pExpCtx->memoryTracker),
       _inputSort(BSONObj()),
       _streaming(false),
       _initialized(false),
-      _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
+      _groupByComparisonKey(pExpCtx->getCollator() != nullptr),
+      _groups(getGroupsComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
       _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos) {}
 
@@ -558,64 +583,89 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
     for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
-            uassert(16945,
-                    "Exceeded memory limit for $group, but didn't allow external sort."
-                    " Pass allowDiskUse:true to opt in.",
-                    _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+        if (_memoryUsageBytes + _batchArgsBytes > _maxMemoryUsageBytes ||
+            _memoryTracker.shouldReleaseMemory()) {
+            // The buffered arguments may have pushed the groups over the limit. Bring the memory
+            // accounting up to date before deciding whether to spill.
+            if (!_batchDocGroups.empty()) {
+                processBufferedBatch();
+            }
+
+            // Spill when over this stage's own limit, or when the pipeline as a whole is over its
+            // memory budget.
+            if (_memoryUsageBytes > _maxMemoryUsageBytes || _memoryTracker.shouldReleaseMemory()) {
+                uassert(16945,
+                        "Exceeded memory limit for $group, but didn't allow external sort."
+                        " Pass allowDiskUse:true to opt in.",
+                        _allowDiskUse);
+                _sortedFiles.push_back(spill());
+                _memoryUsageBytes = 0;
+                _memoryTracker.set(0);
+            }
         }
 
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
+        Value key = _groupByComparisonKey ? pExpCtx->getCollationComparisonKey(id) : id;
 
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+        // Look for the key in the map. If it's not there, add a new entry with a blank
+        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'key' and
         // looking it up in '_groups' multiple times.
         const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
+        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[key];
         const bool inserted = _groups->size() != oldSize;
 
         if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
+            // Charge for the map entry and the accumulator pointers as well, or many small groups
+            // are undercounted. The accumulators themselves are charged after processing.
+            _memoryUsageBytes += key.getApproximateSize() + kHashNodeOverheadBytes +
+                sizeof(Accumulators) + numAccumulators * sizeof(intrusive_ptr<Accumulator>);
+            if (_groupByComparisonKey) {
+                _memoryUsageBytes +=
+                    id.getApproximateSize() + kHashNodeOverheadBytes + sizeof(Accumulators*);
+                _groupIds.emplace(&group, std::move(id));
+            }
 
             // Add the accumulators
             group.reserve(numAccumulators);
             for (auto&& accumulatedField : _accumulatedFields) {
                 group.push_back(accumulatedField.makeAccumulator(pExpCtx));
             }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
         }
 
-        /* tickle all the accumulators for the group we found */
+        /* buffer the arguments for all the accumulators of the group we found */
         dassert(numAccumulators == group.size());
 
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(_accumulatedFields[i].expression->evaluate(rootDocument),
-                              _doingMerge);
+        auto batchGroup = _batchGroupIndex.emplace(&group, _batchGroups.size());
+        if (batchGroup.second) {
+            _batchGroups.push_back(&group);
+            _batchGroupInserted.push_back(inserted);
+        }
+        _batchDocGroups.push_back(batchGroup.first->second);
 
-            _memoryUsageBytes += group[i]->memUsageForSorter();
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _batchArgs.push_back(accumulatedField.expression->evaluate(rootDocument));
+            _batchArgsBytes += _batchArgs.back().getApproximateSize();
         }
 
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
+        // Keep the operation's total current while buffering, since it is checked against the
+        // pipeline's memory budget for every document.
+        _memoryTracker.set(_memoryUsageBytes + _batchArgsBytes);
 
-                _sortedFiles.push_back(spill());
-            }
+        // In debug builds, a document of an existing group is processed right away, so that the
+        // stress spill below happens for every duplicate id as it arrives.
+        if (_batchDocGroups.size() == kGroupBatchSize || (kDebugBuild && !inserted)) {
+            processBufferedBatch();
         }
     }
 
+    // Whether we reached EOF or are pausing, the groups must be up to date before returning.
+    if (!_batchDocGroups.empty()) {
+        processBufferedBatch();
+    }
+
     switch (input.getStatus()) {
         case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
             MONGO_UNREACHABLE;  // We consumed all advances above.
@@ -632,10 +682,12 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 }
 
                 // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+                _groups = getGroupsComparator().makeUnorderedValueMap<Accumulators>();
+                _groupIds.clear();
+                _memoryTracker.set(0);
 
                 _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
+                    _sortedFiles, SortOptions(), SorterComparator(getGroupsComparator())));
 
                 // prepare current to accumulate data
                 _currentAccumulators.reserve(numAccumulators);
@@ -659,31 +711,105 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+void DocumentSourceGroup::processBufferedBatch() {
+    const size_t numAccumulators = _accumulatedFields.size();
+    const size_t numDocs = _batchDocGroups.size();
+    const size_t numGroups = _batchGroups.size();
+
+    // Counting sort of the buffered documents by group. This keeps the documents of each group in
+    // input order, which order-sensitive accumulators such as $push and $last depend on.
+    vector<size_t> groupStarts(numGroups + 1, 0);
+    for (size_t doc = 0; doc < numDocs; doc++) {
+        groupStarts[_batchDocGroups[doc] + 1]++;
+    }
+    for (size_t groupIndex = 0; groupIndex < numGroups; groupIndex++) {
+        groupStarts[groupIndex + 1] += groupStarts[groupIndex];
+    }
+    vector<size_t> docsByGroup(numDocs);
+    vector<size_t> nextSlot(groupStarts.begin(), groupStarts.end() - 1);
+    for (size_t doc = 0; doc < numDocs; doc++) {
+        docsByGroup[nextSlot[_batchDocGroups[doc]]++] = doc;
+    }
+
+    bool sawDuplicate = false;
+    vector<Value> groupArgs;
+    for (size_t groupIndex = 0; groupIndex < numGroups; groupIndex++) {
+        Accumulators& group = *_batchGroups[groupIndex];
+        const size_t begin = groupStarts[groupIndex];
+        const size_t end = groupStarts[groupIndex + 1];
+
+        if (!_batchGroupInserted[groupIndex]) {
+            for (auto&& groupObj : group) {
+                // subtract old mem usage. New usage added back after processing.
+                _memoryUsageBytes -= groupObj->memUsageForSorter();
+            }
+        }
+        sawDuplicate = sawDuplicate || !_batchGroupInserted[groupIndex] || end - begin > 1;
+
+        for (size_t i = 0; i < numAccumulators; i++) {
+            if (end - begin == 1) {
+                group[i]->process(_batchArgs[docsByGroup[begin] * numAccumulators + i],
+                                  _doingMerge);
+            } else {
+                groupArgs.clear();
+                for (size_t slot = begin; slot < end; slot++) {
+                    groupArgs.push_back(
+                        std::move(_batchArgs[docsByGroup[slot] * numAccumulators + i]));
+                }
+                group[i]->processBatch(groupArgs, _doingMerge);
+            }
+
+            _memoryUsageBytes += group[i]->memUsageForSorter();
+        }
+    }
+
+    _batchGroups.clear();
+    _batchGroupInserted.clear();
+    _batchGroupIndex.clear();
+    _batchDocGroups.clear();
+    _batchArgs.clear();
+    _batchArgsBytes = 0;
+
+    _memoryTracker.set(_memoryUsageBytes);
+
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (sawDuplicate &&              // is a dup
+            !pExpCtx->inMongos &&        // can't spill to disk in mongos
+            !_allowDiskUse &&            // don't change behavior when testing external sort
+            _sortedFiles.size() < 20) {  // don't open too many FDs
+
+            _sortedFiles.push_back(spill());
+        }
+    }
+}
+
 bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
 
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     _usedDisk = true;
+    ++_numSpills;
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups->size());
     for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
         ptrs.push_back(&*it);
     }
 
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(getGroupsComparator()));
 
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
     switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
         case 0:                           // no values, essentially a distinct
             for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+                writer.addAlreadySorted(makeSpillKey(*ptrs[i]), Value());
             }
             break;
 
         case 1:  // just one value, use optimized serialization as single Value
             for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
+                writer.addAlreadySorted(makeSpillKey(*ptrs[i]),
                                         ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
             }
             break;
@@ -694,16 +820,41 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
                 for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
                     accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
                 }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+                writer.addAlreadySorted(makeSpillKey(*ptrs[i]), Value(std::move(accums)));
             }
             break;
     }
 
     _groups->clear();
+    _groupIds.clear();
 
     return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
 }
 
+const ValueComparator& DocumentSourceGroup::getGroupsComparator() const {
+    // Comparison keys are compared binary, which orders them the way the collation orders the _ids
+    // they were computed from.
+    return _groupByComparisonKey ? ValueComparator::kInstance : pExpCtx->getValueComparator();
+}
+
+Value DocumentSourceGroup::makeSpillKey(const GroupsMap::value_type& group) const {
+    if (!_groupByComparisonKey) {
+        return group.first;
+    }
+
+    // The groups are merged on the comparison key, so it goes first. Groups with equal comparison
+    // keys but different _ids from different spills still end up next to each other.
+    return Value(vector<Value>{group.first, _groupIds.at(&group.second)});
+}
+
+Value DocumentSourceGroup::getSpilledGroupKey(const Value& spillKey) const {
+    return _groupByComparisonKey ? spillKey[0] : spillKey;
+}
+
+Value DocumentSourceGroup::getSpilledGroupId(const Value& spillKey) const {
+    return _groupByComparisonKey ? spillKey[1] : spillKey;
+}
+
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
     if (true) {
         // Until streaming $group correctly handles nullish values, the streaming behavior is
@@ -972,7 +1123,7 @@ bool DocumentSourceGroup::canRunInParallelBeforeOut(
 }
 
 std::unique_ptr<GroupFromFirstDocumentTransformation>
-DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
+DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument(const BSONObj& inputSort) const {
     if (!_idFieldNames.empty()) {
         // This transformation is only intended for $group stages that group on a single field.
         return nullptr;
@@ -996,12 +1147,70 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
 
     const auto groupId = fieldPath.tail().fullPath();
 
-    // We can't do this transformation if there are any non-$first accumulators.
+    // Work out which document of each group the accumulators need. We can't do this
+    // transformation if any accumulator needs more than one document.
+    bool needsFirstDocument = false;
+    bool needsLastDocument = false;
+    boost::optional<std::string> greatestValuePath;
     for (auto&& accumulator : _accumulatedFields) {
-        if (AccumulatorDocumentsNeeded::kFirstDocument !=
-            accumulator.makeAccumulator(pExpCtx)->documentsNeeded()) {
+        switch (accumulator.makeAccumulator(pExpCtx)->documentsNeeded()) {
+            case AccumulatorDocumentsNeeded::kFirstDocument:
+                needsFirstDocument = true;
+                break;
+            case AccumulatorDocumentsNeeded::kLastDocument:
+                needsLastDocument = true;
+                break;
+            case AccumulatorDocumentsNeeded::kGreatestValueDocument: {
+                auto argExpr = dynamic_cast<ExpressionFieldPath*>(accumulator.expression.get());
+                if (!argExpr || !argExpr->isRootFieldPath() ||
+                    argExpr->getFieldPath().getPathLength() == 1) {
+                    return nullptr;
+                }
+
+                // Every document of a group has the greatest value of the group key.
+                const auto argPath = argExpr->getFieldPath().tail().fullPath();
+                if (argPath == groupId) {
+                    break;
+                }
+                if (greatestValuePath && *greatestValuePath != argPath) {
+                    return nullptr;
+                }
+                greatestValuePath = argPath;
+                break;
+            }
+            case AccumulatorDocumentsNeeded::kAllDocuments:
+                return nullptr;
+        }
+    }
+
+    std::vector<BSONObj> firstDocumentSorts;
+    if (!inputSort.isEmpty()) {
+        if (greatestValuePath || (needsFirstDocument && needsLastDocument)) {
             return nullptr;
         }
+
+        if (!needsLastDocument) {
+            firstDocumentSorts.push_back(inputSort);
+        } else {
+            // The last document in a sort order is the first document in the reverse order.
+            BSONObjBuilder reverseSort;
+            for (auto&& elem : inputSort) {
+                if (!elem.isNumber()) {
+                    // Sorts by metadata such as the text score can't be reversed.
+                    return nullptr;
+                }
+                reverseSort.append(elem.fieldName(), elem.number() > 0 ? -1 : 1);
+            }
+            firstDocumentSorts.push_back(reverseSort.obj());
+        }
+    } else if (greatestValuePath) {
+        // Without a sort any document will do for $first and $last, so read the document with the
+        // greatest value first. An index can provide either of these sorts when scanned in one
+        // direction or the other, depending on the direction of its first field.
+        firstDocumentSorts.push_back(BSON(groupId << 1 << *greatestValuePath << -1));
+        firstDocumentSorts.push_back(BSON(groupId << -1 << *greatestValuePath << -1));
+    } else {
+        firstDocumentSorts.push_back(BSONObj());
     }
 
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> fields;
@@ -1011,7 +1220,8 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
         fields.push_back(std::make_pair(accumulator.fieldName, accumulator.expression));
     }
 
-    return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
+    return GroupFromFirstDocumentTransformation::create(
+        pExpCtx, groupId, std::move(fields), std::move(firstDocumentSorts));
 }
 }  // namespace mongo
 
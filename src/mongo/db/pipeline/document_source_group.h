@@ -36,6 +36,8 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/memory_usage_tracker.h"
 
 namespace mongo {
 
@@ -49,8 +51,11 @@ class GroupFromFirstDocumentTransformation final : public TransformerInterface {
 public:
     GroupFromFirstDocumentTransformation(
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs)
-        : _accumulatorExprs(std::move(accumulatorExprs)), _groupId(groupId) {}
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        std::vector<BSONObj> firstDocumentSorts)
+        : _accumulatorExprs(std::move(accumulatorExprs)),
+          _groupId(groupId),
+          _firstDocumentSorts(std::move(firstDocumentSorts)) {}
 
     TransformerType getType() const final {
         return TransformerType::kGroupFromFirstDocument;
@@ -64,6 +69,14 @@ public:
         return _groupId;
     }
 
+    /**
+     * The sort orders, in order of preference, under which the first document of each group is
+     * the document this transformation must see. An empty sort pattern means any document will do.
+     */
+    const std::vector<BSONObj>& firstDocumentSorts() const {
+        return _firstDocumentSorts;
+    }
+
     Document applyTransformation(const Document& input) final;
 
     void optimize() final;
@@ -78,11 +91,13 @@ public:
     static std::unique_ptr<GroupFromFirstDocumentTransformation> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs);
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        std::vector<BSONObj> firstDocumentSorts);
 
 private:
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> _accumulatorExprs;
     std::string _groupId;
+    std::vector<BSONObj> _firstDocumentSorts;
 };
 
 class DocumentSourceGroup final : public DocumentSource, public NeedsMergerDocumentSource {
@@ -169,14 +184,21 @@ public:
     /**
      * When possible, creates a document transformer that transforms the first document in a group
      * into one of the output documents of the $group stage. This is possible when we are grouping
-     * on a single field and all accumulators are $first (or there are no accumluators).
+     * on a single field and every accumulator can be computed from a single document of the group:
+     *  - all accumulators are $first, and the groups are read in the order of 'inputSort', the
+     *    pattern of the $sort preceding this stage (or there are no accumulators),
+     *  - all accumulators are $last, and the groups are read in the reverse of 'inputSort', or
+     *  - there is no preceding $sort, the accumulators are $first, $last and $max over a single
+     *    field, and the groups are read in descending order of that field.
+     * The transformation records these sort orders in its firstDocumentSorts().
      *
      * It is sometimes possible to use a DISTINCT_SCAN to scan the first document of each group,
      * in which case this transformation can replace the actual $group stage in the pipeline
-     * (SERVER-9507).
+     * (SERVER-9507). If the DISTINCT_SCAN is covered, the $group is then computed from index keys
+     * alone.
      */
-    std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument()
-        const;
+    std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument(
+        const BSONObj& inputSort = BSONObj()) const;
 
 protected:
     void doDispose() final;
@@ -213,14 +235,43 @@ private:
     GetNextResult initialize();
 
     /**
-     * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
-     * does not exhaust the previous stage before returning, and thus does not maintain as large a
-     * store of documents at any one time, only an unsorted group can spill to disk.
+     * Spill groups map to disk and returns an iterator to the file. Note: A sorted (streaming)
+     * $group only ever holds the accumulators of the group currently being built, so it never
+     * needs to spill; only an unsorted group can spill to disk.
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Hands the accumulator arguments buffered for the current batch of input documents to the
+     * accumulators of their groups, with one processBatch() call per group and accumulator, and
+     * updates the memory accounting. Leaves the batch empty.
+     */
+    void processBufferedBatch();
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
+    /**
+     * Returns the comparator defining equality and order of the keys of '_groups' and of the
+     * spilled groups. It outlives this stage.
+     */
+    const ValueComparator& getGroupsComparator() const;
+
+    /**
+     * Returns the key under which the group in '_groups' is written when spilling, which is the
+     * group's _id, or the pair [comparison key, _id] when '_groupByComparisonKey' is true.
+     */
+    Value makeSpillKey(const GroupsMap::value_type& group) const;
+
+    /**
+     * Returns the part of a spilled key that spilled groups are merged on.
+     */
+    Value getSpilledGroupKey(const Value& spillKey) const;
+
+    /**
+     * Returns the _id of the group a spilled key belongs to.
+     */
+    Value getSpilledGroupId(const Value& spillKey) const;
+
     /**
      * Computes the internal representation of the group key.
      */
@@ -240,9 +291,11 @@ private:
     std::vector<AccumulationStatement> _accumulatedFields;
 
     bool _usedDisk;  // Keeps track of whether this $group spilled to disk.
+    long long _numSpills = 0;  // Number of times this $group wrote its groups to a sorted file.
     bool _doingMerge;
     size_t _memoryUsageBytes = 0;
     size_t _maxMemoryUsageBytes;
+    MemoryUsageTracker _memoryTracker;  // Mirrors '_memoryUsageBytes' into the operation's total.
     std::vector<std::string> _idFieldNames;  // used when id is a document
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
 
@@ -253,6 +306,13 @@ private:
     Value _currentId;
     Accumulators _currentAccumulators;
 
+    // Under a non-simple collation, '_groups' is keyed by the collation comparison key of each
+    // group's _id instead of the _id itself. The collator is then applied once per input document,
+    // and the hashing, equality checks and sorting of groups are binary. The _id each group was
+    // created with is kept in '_groupIds', keyed by the group's accumulators.
+    const bool _groupByComparisonKey;
+    stdx::unordered_map<const Accumulators*, Value> _groupIds;
+
     // We use boost::optional to defer initialization until the ExpressionContext containing the
     // correct comparator is injected, since the groups must be built using the comparator's
     // definition of equality.
@@ -268,6 +328,18 @@ private:
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
     const bool _allowDiskUse;
 
+    // Used by an unsorted $group to process its input in batches. For each buffered document we
+    // keep the index of its group within the batch and the evaluated argument of each
+    // accumulator, flattened as '_batchArgs[docIndex * numAccumulators + accumulatorIndex]'.
+    // Pointers into '_groups' stay valid because the map never rehashes its nodes, and the batch
+    // is always emptied before spilling.
+    std::vector<Accumulators*> _batchGroups;  // Distinct groups, in order of first appearance.
+    std::vector<char> _batchGroupInserted;    // Whether each group was created during the batch.
+    stdx::unordered_map<Accumulators*, size_t> _batchGroupIndex;
+    std::vector<size_t> _batchDocGroups;
+    std::vector<Value> _batchArgs;
+    size_t _batchArgsBytes = 0;  // Approximate size of '_batchArgs', not yet in the accounting.
+
     std::pair<Value, Value> _firstPartOfNextGroup;
     // Only used when '_sorted' is true.
     boost::optional<Document> _firstDocOfNextGroup;
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/value.h"
+
+namespace mongo {
+namespace {
+
+// Number of distinct group keys in the generated input.
+const int kNumKeys = 16;
+
+// Number of distinct documents the generated input cycles through.
+const int kPoolSize = 4096;
+
+/**
+ * Produces a fixed number of documents by cycling through a small pool of pre-built documents, so
+ * that generating the input does not dominate the cost of the $group being measured and so that
+ * even very large inputs do not need to be held in memory.
+ */
+class DocumentSourceGenerator final : public DocumentSourceMock {
+public:
+    DocumentSourceGenerator(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                            const std::vector<Document>& pool,
+                            long long numDocs)
+        : DocumentSourceMock({}, expCtx), _pool(pool), _remaining(numDocs) {}
+
+    GetNextResult getNext() final {
+        if (_remaining == 0) {
+            return GetNextResult::makeEOF();
+        }
+        --_remaining;
+        return Document(_pool[_remaining % _pool.size()]);
+    }
+
+private:
+    const std::vector<Document>& _pool;
+    long long _remaining;
+};
+
+std::vector<Document> makeDocumentPool() {
+    std::vector<Document> pool;
+    pool.reserve(kPoolSize);
+    for (int i = 0; i < kPoolSize; ++i) {
+        pool.push_back(Document{{"key", i % kNumKeys}, {"x", i * 0.25}, {"n", i}});
+    }
+    return pool;
+}
+
+void runGroup(benchmark::State& state, const BSONObj& spec) {
+    const long long numDocs = state.range(0);
+    const auto pool = makeDocumentPool();
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    // Debug builds otherwise spill to disk on every duplicate group key.
+    expCtx->inMongos = true;
+
+    for (auto keepRunning : state) {
+        auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+        boost::intrusive_ptr<DocumentSourceGenerator> source(
+            new DocumentSourceGenerator(expCtx, pool, numDocs));
+        group->setSource(source.get());
+
+        long long numGroups = 0;
+        for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+            ++numGroups;
+        }
+        invariant(numGroups == std::min<long long>(numDocs, kNumKeys));
+        benchmark::DoNotOptimize(numGroups);
+    }
+
+    state.SetItemsProcessed(state.iterations() * numDocs);
+}
+
+void BM_GroupSumLowCardinality(benchmark::State& state) {
+    runGroup(state, fromjson("{$group: {_id: '$key', total: {$sum: '$x'}, count: {$sum: 1}}}"));
+}
+
+void BM_GroupAvgLowCardinality(benchmark::State& state) {
+    runGroup(state, fromjson("{$group: {_id: '$key', meanX: {$avg: '$x'}, meanN: {$avg: '$n'}}}"));
+}
+
+void BM_GroupMixedLowCardinality(benchmark::State& state) {
+    runGroup(state,
+             fromjson("{$group: {_id: '$key', total: {$sum: '$x'}, mean: {$avg: '$n'}, "
+                      "lo: {$min: '$x'}, hi: {$max: '$x'}, sd: {$stdDevPop: '$n'}}}"));
+}
+
+BENCHMARK(BM_GroupSumLowCardinality)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupAvgLowCardinality)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupMixedLowCardinality)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// Full-size runs over 100 million documents. These take tens of seconds each, so only run them
+// once.
+BENCHMARK(BM_GroupSumLowCardinality)
+    ->Arg(100 * 1000 * 1000)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupMixedLowCardinality)
+    ->Arg(100 * 1000 * 1000)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
@@ -47,6 +47,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
@@ -139,6 +140,152 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     ASSERT_EQ(idSet.count(2), 1UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldReportSpillsInExplainWithExecutionStats) {
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement pushStatement{"spaceHog",
+                                        ExpressionFieldPath::parse(expCtx, "$largeStr", vps),
+                                        AccumulationStatement::getFactory("$push")};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$_id", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement}, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                            Document{{"_id", 1}, {"largeStr", largeStr}},
+                                            Document{{"_id", 2}, {"largeStr", largeStr}}});
+    group->setSource(mock.get());
+
+    // Before running, nothing has been written to disk.
+    auto explained = group->serialize(ExplainOptions::Verbosity::kExecStats);
+    ASSERT_VALUE_EQ(explained["usedDisk"], Value(false));
+    ASSERT_VALUE_EQ(explained["spills"], Value(0LL));
+
+    size_t numResults = 0;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        ++numResults;
+    }
+    ASSERT_EQ(numResults, 3UL);
+
+    explained = group->serialize(ExplainOptions::Verbosity::kExecStats);
+    ASSERT_VALUE_EQ(explained["usedDisk"], Value(true));
+    ASSERT_GTE(explained["spills"].getLong(), 2LL);
+
+    // Execution statistics are not reported at lower verbosities.
+    explained = group->serialize(ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_TRUE(explained["usedDisk"].missing());
+    ASSERT_TRUE(explained["spills"].missing());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldSpillWhenPipelineIsOverItsMemoryBudget) {
+    auto expCtx = getExpCtx();
+    expCtx->memoryTracker = std::make_shared<MemoryUsageTracker>(nullptr, 2000);
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement pushStatement{"spaceHog",
+                                        ExpressionFieldPath::parse(expCtx, "$largeStr", vps),
+                                        AccumulationStatement::getFactory("$push")};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$_id", vps);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {pushStatement});
+
+    // The stage's own limit is far above what these documents use; only the budget of the
+    // pipeline makes it spill.
+    string largeStr(1000, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                            Document{{"_id", 1}, {"largeStr", largeStr}},
+                                            Document{{"_id", 2}, {"largeStr", largeStr}}});
+    group->setSource(mock.get());
+
+    size_t numResults = 0;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        ++numResults;
+    }
+    ASSERT_EQ(numResults, 3UL);
+
+    auto explained = group->serialize(ExplainOptions::Verbosity::kExecStats);
+    ASSERT_VALUE_EQ(explained["usedDisk"], Value(true));
+    ASSERT_LT(explained["peakMemoryUsageBytes"].getLong(), 3 * 1000LL);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldTrackPeakMemoryUsage) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Prevent the debug build from spilling on duplicate keys.
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement pushStatement{"spaceHog",
+                                        ExpressionFieldPath::parse(expCtx, "$largeStr", vps),
+                                        AccumulationStatement::getFactory("$push")};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$_id", vps);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {pushStatement});
+
+    string largeStr(1000, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                            Document{{"_id", 1}, {"largeStr", largeStr}},
+                                            Document{{"_id", 0}, {"largeStr", largeStr}}});
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isAdvanced());
+
+    // All of the groups are held in memory, and are charged to the operation as a whole.
+    auto explained = group->serialize(ExplainOptions::Verbosity::kExecStats);
+    const long long peak = explained["peakMemoryUsageBytes"].getLong();
+    ASSERT_GT(peak, 3 * 1000LL);
+    ASSERT_EQ(expCtx->memoryTracker->currentMemoryBytes(), peak);
+
+    ASSERT_TRUE(group->getNext().isAdvanced());
+    ASSERT_TRUE(group->getNext().isEOF());
+
+    // Once exhausted, the groups are freed but the peak is still reported.
+    ASSERT_EQ(expCtx->memoryTracker->currentMemoryBytes(), 0LL);
+    explained = group->serialize(ExplainOptions::Verbosity::kExecStats);
+    ASSERT_VALUE_EQ(explained["peakMemoryUsageBytes"], Value(peak));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldChargeEachGroupForMoreThanItsKey) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Prevent the debug build from spilling on duplicate keys.
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement countStatement{"count",
+                                         ExpressionConstant::create(expCtx, Value(1)),
+                                         AccumulationStatement::getFactory("$sum")};
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionFieldPath::parse(expCtx, "$_id", vps), {countStatement});
+
+    const int numGroups = 100;
+    deque<DocumentSource::GetNextResult> docs;
+    for (int i = 0; i < numGroups; ++i) {
+        docs.push_back(Document{{"_id", i}});
+    }
+    auto mock = DocumentSourceMock::create(docs);
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isAdvanced());
+
+    // Every group holds its map entry and a vector of accumulator pointers besides its key and
+    // its accumulator.
+    auto accumulator = AccumulationStatement::getFactory("$sum")(expCtx);
+    accumulator->process(Value(1), false);
+    const long long minBytesPerGroup = Value(0).getApproximateSize() +
+        accumulator->memUsageForSorter() + sizeof(std::vector<void*>) + sizeof(void*);
+
+    auto explained = group->serialize(ExplainOptions::Verbosity::kExecStats);
+    const long long peak = explained["peakMemoryUsageBytes"].getLong();
+    ASSERT_GTE(peak, numGroups * minBytesPerGroup);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSetIsTooLarge) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
@@ -189,6 +336,80 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), AssertionException, 16945);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldGroupByCollationAndOutputFirstIdOfEachGroup) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Prevent the debug build from spilling on duplicate keys.
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    expCtx->setCollator(&collator);
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement countStatement{"count",
+                                         ExpressionConstant::create(expCtx, Value(1)),
+                                         AccumulationStatement::getFactory("$sum")};
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionFieldPath::parse(expCtx, "$key", vps), {countStatement});
+    auto mock = DocumentSourceMock::create({Document{{"key", "Abc"_sd}},
+                                            Document{{"key", "abc"_sd}},
+                                            Document{{"key", "xyz"_sd}},
+                                            Document{{"key", "ABC"_sd}}});
+    group->setSource(mock.get());
+
+    std::map<std::string, int> counts;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        counts[doc["_id"].getString()] = doc["count"].coerceToInt();
+    }
+    ASSERT_EQ(counts.size(), 2UL);
+    ASSERT_EQ(counts["Abc"], 3);
+    ASSERT_EQ(counts["xyz"], 1);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldGroupByCollationWhileSpilled) {
+    auto expCtx = getExpCtx();
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    expCtx->setCollator(&collator);
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement pushStatement{"spaceHog",
+                                        ExpressionFieldPath::parse(expCtx, "$largeStr", vps),
+                                        AccumulationStatement::getFactory("$push")};
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             ExpressionFieldPath::parse(expCtx, "$key", vps),
+                                             {pushStatement},
+                                             maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"key", "b"_sd}, {"largeStr", largeStr}},
+                                            Document{{"key", "A"_sd}, {"largeStr", largeStr}},
+                                            Document{{"key", "B"_sd}, {"largeStr", largeStr}},
+                                            Document{{"key", "a"_sd}, {"largeStr", largeStr}},
+                                            Document{{"key", "c"_sd}, {"largeStr", largeStr}}});
+    group->setSource(mock.get());
+
+    // The spilled groups come back in the order of the collation, with the _id of one of the
+    // documents in each group.
+    vector<std::pair<string, size_t>> results;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        results.emplace_back(doc["_id"].getString(), doc["spaceHog"].getArrayLength());
+    }
+    ASSERT_TRUE(group->serialize(ExplainOptions::Verbosity::kExecStats)["usedDisk"].getBool());
+
+    ASSERT_EQ(results.size(), 3UL);
+    ASSERT_TRUE(results[0].first == "A" || results[0].first == "a");
+    ASSERT_EQ(results[0].second, 2UL);
+    ASSERT_TRUE(results[1].first == "B" || results[1].first == "b");
+    ASSERT_EQ(results[1].second, 2UL);
+    ASSERT_EQ(results[2].first, "c");
+    ASSERT_EQ(results[2].second, 1UL);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldReportSingleFieldGroupKeyAsARename) {
     auto expCtx = getExpCtx();
     VariablesParseState vps = expCtx->variablesParseState;
@@ -227,6 +448,62 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+intrusive_ptr<DocumentSourceGroup> makeGroup(const intrusive_ptr<ExpressionContext>& expCtx,
+                                             const BSONObj& spec) {
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    return static_cast<DocumentSourceGroup*>(group.get());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRewriteFirstAccumulatorsUnderTheInputSort) {
+    auto group = makeGroup(getExpCtx(), fromjson("{$group: {_id: '$a', b: {$first: '$b'}}}"));
+    auto transform = group->rewriteGroupAsTransformOnFirstDocument(BSON("a" << 1 << "b" << -1));
+    ASSERT(transform);
+    ASSERT_EQ(transform->groupId(), "a");
+    ASSERT_EQ(transform->firstDocumentSorts().size(), 1UL);
+    ASSERT_BSONOBJ_EQ(transform->firstDocumentSorts()[0], BSON("a" << 1 << "b" << -1));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRewriteLastAccumulatorsUnderTheReverseInputSort) {
+    auto group = makeGroup(getExpCtx(), fromjson("{$group: {_id: '$a', b: {$last: '$b'}}}"));
+    auto transform = group->rewriteGroupAsTransformOnFirstDocument(BSON("a" << 1 << "b" << -1));
+    ASSERT(transform);
+    ASSERT_EQ(transform->firstDocumentSorts().size(), 1UL);
+    ASSERT_BSONOBJ_EQ(transform->firstDocumentSorts()[0], BSON("a" << -1 << "b" << 1));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotRewriteMixedFirstAndLastAccumulatorsUnderASort) {
+    auto group = makeGroup(getExpCtx(),
+                           fromjson("{$group: {_id: '$a', b: {$first: '$b'}, c: {$last: '$c'}}}"));
+    ASSERT_FALSE(group->rewriteGroupAsTransformOnFirstDocument(BSON("a" << 1)));
+    ASSERT(group->rewriteGroupAsTransformOnFirstDocument());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRewriteMaxAccumulatorAsDescendingSort) {
+    auto group = makeGroup(
+        getExpCtx(), fromjson("{$group: {_id: '$a', latest: {$max: '$ts'}, v: {$first: '$v'}}}"));
+    auto transform = group->rewriteGroupAsTransformOnFirstDocument();
+    ASSERT(transform);
+    ASSERT_EQ(transform->firstDocumentSorts().size(), 2UL);
+    ASSERT_BSONOBJ_EQ(transform->firstDocumentSorts()[0], BSON("a" << 1 << "ts" << -1));
+    ASSERT_BSONOBJ_EQ(transform->firstDocumentSorts()[1], BSON("a" << -1 << "ts" << -1));
+
+    // The document with the greatest value need not be the first in a user-specified sort.
+    ASSERT_FALSE(group->rewriteGroupAsTransformOnFirstDocument(BSON("a" << 1)));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotRewriteMinOrMaxOfDifferentFields) {
+    auto expCtx = getExpCtx();
+    ASSERT_FALSE(makeGroup(expCtx, fromjson("{$group: {_id: '$a', b: {$min: '$b'}}}"))
+                     ->rewriteGroupAsTransformOnFirstDocument());
+    ASSERT_FALSE(
+        makeGroup(expCtx, fromjson("{$group: {_id: '$a', b: {$max: '$b'}, c: {$max: '$c'}}}"))
+            ->rewriteGroupAsTransformOnFirstDocument());
+    ASSERT_FALSE(makeGroup(expCtx, fromjson("{$group: {_id: '$a', b: {$max: {$add: ['$b', 1]}}}}"))
+                     ->rewriteGroupAsTransformOnFirstDocument());
+    ASSERT_FALSE(makeGroup(expCtx, fromjson("{$group: {_id: '$a', n: {$sum: 1}}}"))
+                     ->rewriteGroupAsTransformOnFirstDocument());
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -38,7 +38,6 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
-#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
 
 namespace mongo {
@@ -126,10 +125,14 @@ DocumentSource::GetNextResult DocumentSourceSort::getNext() {
 void DocumentSourceSort::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     if (explain) {  // always one Value for combined $sort + $limit
-        array.push_back(
-            Value(DOC(kStageName << DOC(
-                          "sortKey" << sortKeyPattern(SortKeySerialization::kForExplain) << "limit"
-                                    << (_limitSrc ? Value(_limitSrc->getLimit()) : Value())))));
+        MutableDocument out(DOC(
+            kStageName << DOC("sortKey" << sortKeyPattern(SortKeySerialization::kForExplain)
+                                        << "limit"
+                                        << (_limitSrc ? Value(_limitSrc->getLimit()) : Value()))));
+        if (*explain >= ExplainOptions::Verbosity::kExecStats) {
+            out["peakMemoryUsageBytes"] = Value(_memoryTracker.peakMemoryBytes());
+        }
+        array.push_back(out.freezeToValue());
     } else {  // one Value for $sort and maybe a Value for $limit
         MutableDocument inner(sortKeyPattern(SortKeySerialization::kForPipelineSerialization));
         array.push_back(Value(DOC(kStageName << inner.freeze())));
@@ -142,6 +145,7 @@ void DocumentSourceSort::serializeToArray(
 
 void DocumentSourceSort::doDispose() {
     _output.reset();
+    _memoryTracker.set(0);
 }
 
 long long DocumentSourceSort::getLimit() const {
@@ -307,6 +311,7 @@ SortOptions DocumentSourceSort::makeSortOptions() const {
         opts.limit = _limitSrc->getLimit();
 
     opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+    opts.memoryTracker = &_memoryTracker;
     if (pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
         opts.extSortAllowed = true;
         opts.tempDir = pExpCtx->tempDir;
@@ -339,6 +344,7 @@ void DocumentSourceSort::loadDocument(Document&& doc) {
     // documents, and wouldn't use this method.
     std::tie(sortKey, docForSorter) = extractSortKey(std::move(doc));
     _sorter->add(sortKey, docForSorter);
+    _memoryTracker.set(_sorter->memUsed());
 }
 
 void DocumentSourceSort::loadingDone() {
@@ -355,35 +361,6 @@ bool DocumentSourceSort::usedDisk() {
     return _usedDisk;
 }
 
-Value DocumentSourceSort::getCollationComparisonKey(const Value& val) const {
-    const auto collator = pExpCtx->getCollator();
-
-    // If the collation is the simple collation, the value itself is the comparison key.
-    if (!collator) {
-        return val;
-    }
-
-    // If 'val' is not a collatable type, there's no need to do any work.
-    if (!CollationIndexKey::isCollatableType(val.getType())) {
-        return val;
-    }
-
-    // If 'val' is a string, directly use the collator to obtain a comparison key.
-    if (val.getType() == BSONType::String) {
-        auto compKey = collator->getComparisonKey(val.getString());
-        return Value(compKey.getKeyData());
-    }
-
-    // Otherwise, for non-string collatable types, take the slow path and round-trip the value
-    // through BSON.
-    BSONObjBuilder input;
-    val.addToBsonObj(&input, ""_sd);
-
-    BSONObjBuilder output;
-    CollationIndexKey::collationAwareIndexKeyAppend(input.obj().firstElement(), collator, &output);
-    return Value(output.obj().firstElement());
-}
-
 StatusWith<Value> DocumentSourceSort::extractKeyPart(const Document& doc,
                                                      const SortPatternPart& patternPart) const {
     Value plainKey;
@@ -400,7 +377,7 @@ StatusWith<Value> DocumentSourceSort::extractKeyPart(const Document& doc,
         plainKey = patternPart.expression->evaluate(doc);
     }
 
-    return getCollationComparisonKey(plainKey);
+    return pExpCtx->getCollationComparisonKey(plainKey);
 }
 
 StatusWith<Value> DocumentSourceSort::extractKeyFast(const Document& doc) const {
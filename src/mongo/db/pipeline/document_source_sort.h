@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/util/memory_usage_tracker.h"
 
 namespace mongo {
 
@@ -225,13 +226,6 @@ private:
      */
     BSONObj extractKeyWithArray(const Document& doc) const;
 
-    /**
-     * Returns the comparison key used to sort 'val' with the collation of the ExpressionContext.
-     * Note that these comparison keys should always be sorted with the simple (i.e. binary)
-     * collation.
-     */
-    Value getCollationComparisonKey(const Value& val) const;
-
     int compare(const Value& lhs, const Value& rhs) const;
 
     /**
@@ -262,6 +256,9 @@ private:
     std::unique_ptr<MySorter> _sorter;
     std::unique_ptr<MySorter::Iterator> _output;
     bool _usedDisk = false;
+
+    // Tracks the memory held by the sorter, charged to the operation's total.
+    MemoryUsageTracker _memoryTracker{pExpCtx->memoryTracker};
 };
 
 }  // namespace mongo
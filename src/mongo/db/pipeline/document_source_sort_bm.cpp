@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <functional>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/collation/collator_factory_icu.h"
+#include "mongo/platform/random.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+// Number of distinct names in the generated input, spelled in a mix of cases.
+const int kNumNames = 1000;
+
+/**
+ * Generates documents shaped like the entries of a product catalog, with a 'name' string whose
+ * capitalization varies from document to document.
+ */
+std::deque<DocumentSource::GetNextResult> makeCatalog(long long numDocs) {
+    static const char* const kWords[] = {
+        "Widget", "gadget", "Gizmo", "sprocket", "Flange", "bracket", "Valve", "hinge"};
+
+    PseudoRandom random(42);
+    std::deque<DocumentSource::GetNextResult> docs;
+    for (long long i = 0; i < numDocs; ++i) {
+        const int id = random.nextInt32(kNumNames);
+        std::string name = str::stream() << kWords[id % 8] << " " << kWords[(id / 8) % 8]
+                                         << " model " << id;
+        if (random.nextInt32(2)) {
+            std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        }
+        docs.emplace_back(Document{{"name", name}, {"price", i * 0.01}});
+    }
+    return docs;
+}
+
+/**
+ * Returns a case-insensitive collator if 'collated' is true, or nullptr for the simple collation.
+ */
+std::unique_ptr<CollatorInterface> makeCollator(bool collated) {
+    if (!collated) {
+        return nullptr;
+    }
+    return uassertStatusOK(CollatorFactoryICU().makeFromBSON(BSON("locale"
+                                                                  << "en"
+                                                                  << "strength"
+                                                                  << 2)));
+}
+
+boost::intrusive_ptr<ExpressionContextForTest> makeExpCtx(const CollatorInterface* collator) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    // Debug builds otherwise spill $group to disk on every duplicate key.
+    expCtx->inMongos = true;
+    expCtx->setCollator(collator);
+    return expCtx;
+}
+
+void runStage(benchmark::State& state,
+              const boost::intrusive_ptr<ExpressionContextForTest>& expCtx,
+              const std::function<boost::intrusive_ptr<DocumentSource>()>& makeStage) {
+    const auto docs = makeCatalog(state.range(0));
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto source = DocumentSourceMock::create(docs);
+        auto stage = makeStage();
+        stage->setSource(source.get());
+        state.ResumeTiming();
+
+        long long numResults = 0;
+        for (auto next = stage->getNext(); next.isAdvanced(); next = stage->getNext()) {
+            ++numResults;
+        }
+        benchmark::DoNotOptimize(numResults);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void runSort(benchmark::State& state, bool collated) {
+    const auto collator = makeCollator(collated);
+    auto expCtx = makeExpCtx(collator.get());
+    runStage(state, expCtx, [&] { return DocumentSourceSort::create(expCtx, BSON("name" << 1)); });
+}
+
+void runGroup(benchmark::State& state, bool collated) {
+    const auto collator = makeCollator(collated);
+    auto expCtx = makeExpCtx(collator.get());
+    const BSONObj spec = BSON("$group" << BSON("_id"
+                                               << "$name"
+                                               << "total"
+                                               << BSON("$sum"
+                                                       << "$price")));
+    runStage(state, expCtx, [&] {
+        return DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    });
+}
+
+void BM_SortSimple(benchmark::State& state) {
+    runSort(state, false);
+}
+
+void BM_SortCaseInsensitive(benchmark::State& state) {
+    runSort(state, true);
+}
+
+void BM_GroupSimple(benchmark::State& state) {
+    runGroup(state, false);
+}
+
+void BM_GroupCaseInsensitive(benchmark::State& state) {
+    runGroup(state, true);
+}
+
+BENCHMARK(BM_SortSimple)->Arg(100 * 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortCaseInsensitive)->Arg(100 * 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupSimple)->Arg(100 * 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupCaseInsensitive)->Arg(100 * 1000)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
@@ -30,8 +30,10 @@
 
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_knobs.h"
 
 namespace mongo {
 
@@ -60,6 +62,8 @@ ExpressionContext::ExpressionContext(OperationContext* opCtx,
     _ownedCollator = std::move(collator);
     _resolvedNamespaces = std::move(resolvedNamespaces);
     uuid = std::move(collUUID);
+    memoryTracker = std::make_shared<MemoryUsageTracker>(
+        nullptr, internalDocumentSourcePipelineMaxMemoryBytes.load());
 }
 
 ExpressionContext::ExpressionContext(OperationContext* opCtx, const CollatorInterface* collator)
@@ -131,6 +135,33 @@ void ExpressionContext::setCollator(const CollatorInterface* collator) {
     _valueComparator = ValueComparator(_collator);
 }
 
+Value ExpressionContext::getCollationComparisonKey(const Value& val) const {
+    // If the collation is the simple collation, the value itself is the comparison key.
+    if (!_collator) {
+        return val;
+    }
+
+    // If 'val' is not a collatable type, there's no need to do any work.
+    if (!CollationIndexKey::isCollatableType(val.getType())) {
+        return val;
+    }
+
+    // If 'val' is a string, directly use the collator to obtain a comparison key.
+    if (val.getType() == BSONType::String) {
+        auto compKey = _collator->getComparisonKey(val.getString());
+        return Value(compKey.getKeyData());
+    }
+
+    // Otherwise, for non-string collatable types, take the slow path and round-trip the value
+    // through BSON.
+    BSONObjBuilder input;
+    val.addToBsonObj(&input, ""_sd);
+
+    BSONObjBuilder output;
+    CollationIndexKey::collationAwareIndexKeyAppend(input.obj().firstElement(), _collator, &output);
+    return Value(output.obj().firstElement());
+}
+
 intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     NamespaceString ns,
     boost::optional<UUID> uuid,
@@ -147,6 +178,7 @@ intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     expCtx->allowDiskUse = allowDiskUse;
     expCtx->bypassDocumentValidation = bypassDocumentValidation;
     expCtx->subPipelineDepth = subPipelineDepth;
+    expCtx->memoryTracker = memoryTracker;
 
     expCtx->tempDir = tempDir;
 
@@ -48,6 +48,7 @@
 #include "mongo/db/query/tailable_mode.h"
 #include "mongo/db/server_options.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/memory_usage_tracker.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/uuid.h"
 
@@ -153,6 +154,14 @@ public:
         return _valueComparator;
     }
 
+    /**
+     * Returns a Value which compares to other comparison keys, under the simple collation, the way
+     * 'val' compares to other Values under this context's collation. Computing the key applies the
+     * collator to each string in 'val' once, so that repeated comparisons against it are binary.
+     * Under the simple collation, 'val' is its own comparison key.
+     */
+    Value getCollationComparisonKey(const Value& val) const;
+
     /**
      * Temporarily resets the collator to be 'newCollator'. Returns a CollatorStash which will reset
      * the collator back to the old value upon destruction.
@@ -237,6 +246,13 @@ public:
     // Tracks the depth of nested aggregation sub-pipelines. Used to enforce depth limits.
     size_t subPipelineDepth = 0;
 
+    // Operation-wide memory accounting. Stages which buffer documents charge their usage to child
+    // trackers of this one, and sub-pipelines share it with their parent pipeline, so that it
+    // reflects the memory used by the whole aggregation. For an aggregation request, its limit is
+    // internalDocumentSourcePipelineMaxMemoryBytes, and stages which can spill to disk do so when
+    // it is exceeded. This pointer is always non-null.
+    std::shared_ptr<MemoryUsageTracker> memoryTracker = std::make_shared<MemoryUsageTracker>();
+
     // If set, this will disallow use of features introduced in versions above the provided version.
     boost::optional<ServerGlobalParams::FeatureCompatibility::Version>
         maxFeatureCompatibilityVersion;
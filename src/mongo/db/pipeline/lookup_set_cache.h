@@ -152,6 +152,13 @@ public:
         }
     }
 
+    /**
+     * Returns the approximate number of bytes held by the cache.
+     */
+    size_t getMemoryUsage() const {
+        return _memoryUsage;
+    }
+
     /**
      * Returns the number of elements in the cache.
      */
@@ -35,6 +35,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -311,6 +312,13 @@ void Pipeline::reattachToOperationContext(OperationContext* opCtx) {
     pCtx->opCtx = opCtx;
     pCtx->mongoProcessInterface->setOperationContext(opCtx);
 
+    // Report the memory used by this pipeline in $currentOp for the operation now running it, e.g.
+    // a getMore on the pipeline's cursor.
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        CurOp::get(opCtx)->setMemoryTracker_inlock(pCtx->memoryTracker);
+    }
+
     for (auto&& source : _sources) {
         source->reattachToOperationContext(opCtx);
     }
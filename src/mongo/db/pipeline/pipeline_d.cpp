@@ -400,7 +400,7 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
 
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage;
     if (groupStage) {
-        rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
+        rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument(sortObj);
     }
 
     // Create the PlanExecutor.
@@ -544,51 +544,56 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
     }
 
     if (rewrittenGroupStage) {
-        BSONObj emptySort;
-
         // See if the query system can handle the $group and $sort stage using a DISTINCT_SCAN
-        // (SERVER-9507). Note that passing the empty projection (as we do for some of the
-        // attemptToGetExecutor() calls below) causes getExecutorDistinct() to ignore some otherwise
-        // valid DISTINCT_SCAN plans, so we pass the projection and exclude the
+        // (SERVER-9507), under any of the sorts that make the first document of each group the one
+        // the rewritten $group needs. Note that passing the empty projection (as we do for some of
+        // the attemptToGetExecutor() calls below) causes getExecutorDistinct() to ignore some
+        // otherwise valid DISTINCT_SCAN plans, so we pass the projection and exclude the
         // NO_UNCOVERED_PROJECTIONS planner parameter.
-        auto swExecutorGrouped = attemptToGetExecutor(opCtx,
-                                                      collection,
-                                                      nss,
-                                                      expCtx,
-                                                      oplogReplay,
-                                                      queryObj,
-                                                      *projectionObj,
-                                                      sortObj ? *sortObj : emptySort,
-                                                      rewrittenGroupStage->groupId(),
-                                                      aggRequest,
-                                                      plannerOpts,
-                                                      matcherFeatures);
-
-        if (swExecutorGrouped.isOK()) {
-            // Any $limit stage before the $group stage should make the pipeline ineligible for this
-            // optimization.
-            invariant(!sortStage || !sortStage->getLimitSrc());
-
-            // We remove the $sort and $group stages that begin the pipeline, because the executor
-            // will handle the sort, and the groupTransform (added below) will handle the $group
-            // stage.
-            pipeline->popFrontWithName(DocumentSourceSort::kStageName);
-            pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
-
-            boost::intrusive_ptr<DocumentSource> groupTransform(
-                new DocumentSourceSingleDocumentTransformation(
-                    expCtx,
-                    std::move(rewrittenGroupStage),
-                    "$groupByDistinctScan",
-                    false /* independentOfAnyCollection */));
-            pipeline->addInitialSource(groupTransform);
-
-            return swExecutorGrouped;
-        } else if (swExecutorGrouped == ErrorCodes::QueryPlanKilled) {
-            return {ErrorCodes::OperationFailed,
-                    str::stream() << "Failed to determine whether query system can provide a "
-                                     "DISTINCT_SCAN grouping: "
-                                  << swExecutorGrouped.getStatus().toString()};
+        for (auto&& groupSort : rewrittenGroupStage->firstDocumentSorts()) {
+            auto swExecutorGrouped = attemptToGetExecutor(opCtx,
+                                                          collection,
+                                                          nss,
+                                                          expCtx,
+                                                          oplogReplay,
+                                                          queryObj,
+                                                          *projectionObj,
+                                                          groupSort,
+                                                          rewrittenGroupStage->groupId(),
+                                                          aggRequest,
+                                                          plannerOpts,
+                                                          matcherFeatures);
+
+            if (swExecutorGrouped.isOK()) {
+                // Any $limit stage before the $group stage should make the pipeline ineligible for
+                // this optimization.
+                invariant(!sortStage || !sortStage->getLimitSrc());
+
+                // We remove the $sort and $group stages that begin the pipeline, because the
+                // executor will handle the sort, and the groupTransform (added below) will handle
+                // the $group stage.
+                pipeline->popFrontWithName(DocumentSourceSort::kStageName);
+                pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+
+                // The executor returns its results in the order of the sort it was planned with,
+                // which need not be the order of the $sort stage it replaces.
+                *sortObj = groupSort;
+
+                boost::intrusive_ptr<DocumentSource> groupTransform(
+                    new DocumentSourceSingleDocumentTransformation(
+                        expCtx,
+                        std::move(rewrittenGroupStage),
+                        "$groupByDistinctScan",
+                        false /* independentOfAnyCollection */));
+                pipeline->addInitialSource(groupTransform);
+
+                return swExecutorGrouped;
+            } else if (swExecutorGrouped == ErrorCodes::QueryPlanKilled) {
+                return {ErrorCodes::OperationFailed,
+                        str::stream() << "Failed to determine whether query system can provide a "
+                                         "DISTINCT_SCAN grouping: "
+                                      << swExecutorGrouped.getStatus().toString()};
+            }
         }
     }
 
@@ -36,16 +36,21 @@
 
 namespace mongo {
 
-TeeBuffer::TeeBuffer(size_t nConsumers, size_t bufferSizeBytes)
-    : _bufferSizeBytes(bufferSizeBytes), _consumers(nConsumers) {}
-
-boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferSizeBytes) {
+TeeBuffer::TeeBuffer(size_t nConsumers,
+                     size_t bufferSizeBytes,
+                     std::shared_ptr<MemoryUsageTracker> memoryTracker)
+    : _bufferSizeBytes(bufferSizeBytes),
+      _memoryTracker(std::move(memoryTracker)),
+      _consumers(nConsumers) {}
+
+boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(
+    size_t nConsumers, int bufferSizeBytes, std::shared_ptr<MemoryUsageTracker> memoryTracker) {
     uassert(40309, "need at least one consumer for a TeeBuffer", nConsumers > 0);
     uassert(40310,
             str::stream() << "TeeBuffer requires a positive buffer size, was given "
                           << bufferSizeBytes,
             bufferSizeBytes > 0);
-    return new TeeBuffer(nConsumers, bufferSizeBytes);
+    return new TeeBuffer(nConsumers, bufferSizeBytes, std::move(memoryTracker));
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
@@ -79,12 +84,17 @@ void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
 
+    _memoryTracker.set(0);
+
     auto input = _source->getNext();
     for (; input.isAdvanced(); input = _source->getNext()) {
         bytesInBuffer += input.getDocument().getApproximateSize();
         _buffer.push_back(std::move(input));
+        _memoryTracker.set(bytesInBuffer);
 
-        if (bytesInBuffer >= _bufferSizeBytes) {
+        // A smaller batch is the only way to use less memory here, since the facets cannot consume
+        // the batch until it has been loaded.
+        if (bytesInBuffer >= _bufferSizeBytes || _memoryTracker.shouldReleaseMemory()) {
             break;  // Need to break here so we don't get the next input and accidentally ignore it.
         }
     }
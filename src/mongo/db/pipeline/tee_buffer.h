@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/memory_usage_tracker.h"
 
 namespace mongo {
 
@@ -49,10 +50,14 @@ class TeeBuffer : public RefCountable {
 public:
     /**
      * Creates a TeeBuffer that will make results available to 'nConsumers' consumers. Note that
-     * 'bufferSizeBytes' is a soft cap, and may be exceeded by one document's worth (~16MB).
+     * 'bufferSizeBytes' is a soft cap, and may be exceeded by one document's worth (~16MB). If
+     * 'memoryTracker' is given, the buffered documents are charged to a child of it, and batches
+     * are cut short when it asks for memory to be released.
      */
     static boost::intrusive_ptr<TeeBuffer> create(
-        size_t nConsumers, int bufferSizeBytes = internalQueryFacetBufferSizeBytes.load());
+        size_t nConsumers,
+        int bufferSizeBytes = internalQueryFacetBufferSizeBytes.load(),
+        std::shared_ptr<MemoryUsageTracker> memoryTracker = nullptr);
 
     void setSource(DocumentSource* source) {
         _source = source;
@@ -69,6 +74,7 @@ public:
                 return info.stillInUse;
             })) {
             _buffer.clear();
+            _memoryTracker.set(0);
             if (_source) {
                 _source->dispose();
             }
@@ -83,12 +89,14 @@ public:
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
 private:
-    TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
+    TeeBuffer(size_t nConsumers,
+              size_t bufferSizeBytes,
+              std::shared_ptr<MemoryUsageTracker> memoryTracker);
 
     /**
      * Clears '_buffer', then keeps requesting results from '_source' and pushing them all into
-     * '_buffer', until more than '_bufferSizeBytes' of documents have been returned, or until
-     * '_source' is exhausted.
+     * '_buffer', until more than '_bufferSizeBytes' of documents have been returned, until the
+     * memory tracker asks for memory to be released, or until '_source' is exhausted.
      */
     void loadNextBatch();
 
@@ -96,6 +104,7 @@ private:
 
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
+    MemoryUsageTracker _memoryTracker;
 
     struct ConsumerInfo {
         bool stillInUse = true;
@@ -31,7 +31,6 @@
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
@@ -75,20 +74,26 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
-
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const icu::UnicodeString unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Write the sort key straight into a buffer on the stack, which holds the keys of most strings,
+    // rather than into a heap-allocated icu::CollationKey that would then be copied. ICU returns
+    // the full length of the key even if it does not fit, in which case it is generated again into
+    // a buffer of that size.
+    uint8_t stackBuffer[kSortKeyStackBufferSize];
+    std::unique_ptr<uint8_t[]> heapBuffer;
+    uint8_t* keyBuffer = stackBuffer;
+    int32_t keyLength = _collator->getSortKey(unicodeString, keyBuffer, sizeof(stackBuffer));
+    if (keyLength > static_cast<int32_t>(sizeof(stackBuffer))) {
+        heapBuffer.reset(new uint8_t[keyLength]);
+        keyBuffer = heapBuffer.get();
+        keyLength = _collator->getSortKey(unicodeString, keyBuffer, keyLength);
+    }
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
@@ -53,6 +53,10 @@ public:
     ComparisonKey getComparisonKey(StringData stringData) const final;
 
 private:
+    // Size of the buffer on the stack into which getComparisonKey() first tries to write the sort
+    // key. Sort keys take a few bytes per character, so this covers strings of up to ~100 chars.
+    static constexpr int32_t kSortKeyStackBufferSize = 256;
+
     // The ICU implementation of the collator to which we delegate interesting work. Const methods
     // on the ICU collator are expected to be thread-safe.
     const std::unique_ptr<icu::Collator> _collator;
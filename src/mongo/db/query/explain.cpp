@@ -359,8 +359,14 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (spec->maxTs) {
             bob->append("maxTs", *(spec->maxTs));
         }
+        if (spec->filterThreads > 0) {
+            bob->appendNumber("filterThreads", spec->filterThreads);
+        }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
+            if (spec->filterThreads > 0) {
+                bob->appendNumber("filterBatches", spec->filterBatches);
+            }
         }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
@@ -440,6 +446,12 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsExamined);
             bob->appendNumber("alreadyHasObj", spec->alreadyHasObj);
+            if (spec->batchSize) {
+                bob->appendNumber("batchSize", spec->batchSize);
+                bob->appendNumber("batches", spec->batches);
+                bob->appendNumber("docsFetchedInBatches", spec->docsFetchedInBatches);
+                bob->appendNumber("backwardSeeksAvoided", spec->backwardSeeksAvoided);
+            }
         }
     } else if (STAGE_GEO_NEAR_2D == stats.stageType || STAGE_GEO_NEAR_2DSPHERE == stats.stageType) {
         NearStats* spec = static_cast<NearStats*>(stats.specific.get());
@@ -490,6 +502,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         bob->appendBool("isPartial", spec->isPartial);
         bob->append("indexVersion", spec->indexVersion);
         bob->append("direction", spec->direction > 0 ? "forward" : "backward");
+        if (spec->isSkipScan) {
+            bob->appendBool("isSkipScan", true);
+        }
 
         if ((topLevelBob->len() + spec->indexBounds.objsize()) > kMaxStatsBSONSize) {
             bob->append("warning", "index bounds omitted due to BSON size limit");
@@ -561,8 +576,20 @@ void Explain::statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_TEXT_OR == stats.stageType) {
         TextOrStats* spec = static_cast<TextOrStats*>(stats.specific.get());
 
+        if (spec->limit > 0) {
+            bob->appendNumber("limit", spec->limit);
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->fetches);
+
+            if (spec->limit > 0) {
+                bob->appendBool("stoppedEarly", spec->stoppedEarly);
+                if (spec->stoppedEarly) {
+                    bob->append("scoreThreshold", spec->scoreThreshold);
+                    bob->appendNumber("termScansCutShort", spec->termScansCutShort);
+                }
+            }
         }
     } else if (STAGE_UPDATE == stats.stageType) {
         UpdateStats* spec = static_cast<UpdateStats*>(stats.specific.get());
@@ -37,6 +37,8 @@
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -126,6 +128,71 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     return cover;
 }
 
+namespace {
+
+/**
+ * A bounded LRU cache of 2dsphere coverings. Computing a covering is expensive for complex
+ * geometries, and workloads often query the same few geometries over and over.
+ */
+class S2CoveringCache {
+public:
+    static constexpr size_t kMaxEntries = 1024;
+
+    bool find(const std::string& key, std::vector<S2CellId>* out) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _cache.promote(key);
+        if (it == _cache.end()) {
+            return false;
+        }
+        *out = it->second;
+        return true;
+    }
+
+    void add(const std::string& key, const std::vector<S2CellId>& cover) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _cache.add(key, cover);
+    }
+
+    void clear() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _cache.clear();
+    }
+
+private:
+    stdx::mutex _mutex;
+    LRUCache<std::string, std::vector<S2CellId>> _cache{kMaxEntries};
+};
+
+S2CoveringCache s2CoveringCache;
+
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCoveringCached(const S2Region& region,
+                                                                   StringData cacheKey) {
+    if (cacheKey.empty() || !internalQueryS2GeoCacheCoverings.load()) {
+        return get2dsphereCovering(region);
+    }
+
+    // The covering also depends on the coverer's parameters, which can change at runtime.
+    StringBuilder fullKey;
+    fullKey << internalQueryS2GeoCoarsestLevel.load() << ',' << internalQueryS2GeoFinestLevel.load()
+            << ',' << internalQueryS2GeoMaxCells.load() << ',' << cacheKey;
+    const std::string key = fullKey.str();
+
+    std::vector<S2CellId> cover;
+    if (s2CoveringCache.find(key, &cover)) {
+        return cover;
+    }
+
+    cover = get2dsphereCovering(region);
+    s2CoveringCache.add(key, cover);
+    return cover;
+}
+
+void ExpressionMapping::clear2dsphereCoveringCache_forTest() {
+    s2CoveringCache.clear();
+}
+
 void ExpressionMapping::cover2dsphere(const S2Region& region,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
@@ -133,6 +200,14 @@ void ExpressionMapping::cover2dsphere(const S2Region& region,
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
+void ExpressionMapping::cover2dsphereCached(const S2Region& region,
+                                            StringData cacheKey,
+                                            const S2IndexingParams& indexingParams,
+                                            OrderedIntervalList* oilOut) {
+    std::vector<S2CellId> cover = get2dsphereCoveringCached(region, cacheKey);
+    S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
+}
+
 namespace {
 bool compareIntervals(const Interval& a, const Interval& b) {
     return a.precedes(b);
@@ -181,9 +256,11 @@ void ExpressionMapping::S2CellIdsToIntervals(const std::vector<S2CellId>& interv
     }
 }
 
-void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2CellId>& intervalSet,
-                                                        const S2IndexingParams& indexParams,
-                                                        OrderedIntervalList* oilOut) {
+void ExpressionMapping::S2CellIdsToIntervalsWithParents(
+    const std::vector<S2CellId>& intervalSet,
+    const S2IndexingParams& indexParams,
+    OrderedIntervalList* oilOut,
+    std::unordered_set<S2CellId>* seenParents) {  // NOLINT
     // There may be duplicates when going up parent cells if two cells share a parent
     std::unordered_set<S2CellId> exactSet;  // NOLINT
     for (const S2CellId& interval : intervalSet) {
@@ -214,6 +291,9 @@ void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2Cell
     }
 
     for (const S2CellId& exact : exactSet) {
+        if (seenParents && !seenParents->insert(exact).second) {
+            continue;
+        }
         BSONObj exactBSON = S2CellIdToIndexKey(exact, indexParams.indexVersion);
         oilOut->intervals.push_back(IndexBoundsBuilder::makePointInterval(exactBSON));
     }
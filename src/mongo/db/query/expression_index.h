@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 #include "mongo/db/geo/hash.h"
@@ -64,19 +65,44 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * Like get2dsphereCovering(), but first consults a small process-wide cache of recently
+     * computed coverings, so that repeated queries over the same geometry do not recompute it.
+     * 'cacheKey' must uniquely identify 'region'. An empty 'cacheKey' bypasses the cache.
+     */
+    static std::vector<S2CellId> get2dsphereCoveringCached(const S2Region& region,
+                                                           StringData cacheKey);
+
+    /**
+     * Empties the cache used by get2dsphereCoveringCached(). For testing only.
+     */
+    static void clear2dsphereCoveringCache_forTest();
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
 
     // Creates an ordered interval list from range intervals and
-    // traverses cell parents for exact intervals up to coarsestIndexedLevel
-    static void S2CellIdsToIntervalsWithParents(const std::vector<S2CellId>& interval,
-                                                const S2IndexingParams& indexParams,
-                                                OrderedIntervalList* out);
+    // traverses cell parents for exact intervals up to coarsestIndexedLevel.
+    // If 'seenParents' is non-null, parent cells already in it are skipped and the
+    // others are added to it, so that successive calls only scan each parent once.
+    static void S2CellIdsToIntervalsWithParents(
+        const std::vector<S2CellId>& interval,
+        const S2IndexingParams& indexParams,
+        OrderedIntervalList* out,
+        std::unordered_set<S2CellId>* seenParents = nullptr);  // NOLINT
 
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
+
+    /**
+     * Like cover2dsphere(), but using get2dsphereCoveringCached().
+     */
+    static void cover2dsphereCached(const S2Region& region,
+                                    StringData cacheKey,
+                                    const S2IndexingParams& indexParams,
+                                    OrderedIntervalList* oilOut);
 };
 
 }  // namespace mongo
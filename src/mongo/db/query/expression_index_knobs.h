@@ -59,4 +59,7 @@ extern AtomicInt32 internalQueryS2GeoCoarsestLevel;
 // What is the maximum cell count that we want? (advisory, not a hard threshold)
 extern AtomicInt32 internalQueryS2GeoMaxCells;
 
+// Should coverings of repeated query geometries and geoNear annuli be cached?
+extern AtomicBool internalQueryS2GeoCacheCoverings;
+
 }  // namespace mongo
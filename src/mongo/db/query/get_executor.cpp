@@ -132,22 +132,28 @@ IndexEntry indexEntryFromIndexCatalogEntry(OperationContext* opCtx, const IndexC
 
     const bool isMultikey = desc->isMultikey(opCtx);
 
-    return {desc->keyPattern(),
-            desc->getIndexType(),
-            isMultikey,
-            // The fixed-size vector of multikey paths stored in the index catalog.
-            ice.getMultikeyPaths(opCtx),
-            // The set of multikey paths from special metadata keys stored in the index itself.
-            // Indexes that have these metadata keys do not store a fixed-size vector of multikey
-            // metadata in the index catalog. Depending on the index type, an index uses one of
-            // these mechanisms (or neither), but not both.
-            isMultikey ? accessMethod->getMultikeyPathSet(opCtx) : std::set<FieldRef>{},
-            desc->isSparse(),
-            desc->unique(),
-            IndexEntry::Identifier{desc->indexName()},
-            ice.getFilterExpression(),
-            desc->infoObj(),
-            ice.getCollator()};
+    IndexEntry entry{desc->keyPattern(),
+                     desc->getIndexType(),
+                     isMultikey,
+                     // The fixed-size vector of multikey paths stored in the index catalog.
+                     ice.getMultikeyPaths(opCtx),
+                     // The set of multikey paths from special metadata keys stored in the index
+                     // itself. Indexes that have these metadata keys do not store a fixed-size
+                     // vector of multikey metadata in the index catalog. Depending on the index
+                     // type, an index uses one of these mechanisms (or neither), but not both.
+                     isMultikey ? accessMethod->getMultikeyPathSet(opCtx) : std::set<FieldRef>{},
+                     desc->isSparse(),
+                     desc->unique(),
+                     IndexEntry::Identifier{desc->indexName()},
+                     ice.getFilterExpression(),
+                     desc->infoObj(),
+                     ice.getCollator()};
+
+    if (desc->getIndexType() == IndexType::INDEX_WILDCARD) {
+        entry.wildcardPathDictionary =
+            static_cast<const WildcardAccessMethod*>(accessMethod)->getPathDictionary();
+    }
+    return entry;
 }
 
 void fillOutPlannerParams(OperationContext* opCtx,
@@ -212,6 +218,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
 
+    if (internalQueryPlannerGenerateSkipScans.load()) {
+        plannerParams->options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    }
+
     plannerParams->options |= QueryPlannerParams::SPLIT_LIMITED_SORT;
 
     if (shouldWaitForOplogVisibility(
@@ -1304,7 +1314,8 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCount(
 
 bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
                                   const string& field,
-                                  bool strictDistinctOnly) {
+                                  bool strictDistinctOnly,
+                                  const BSONObj& sortPattern) {
     QuerySolutionNode* root = soln->root.get();
 
     // Root stage must be a project.
@@ -1409,6 +1420,20 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
             // array component.
             return false;
         }
+
+        // Nor can we use it if any field of the sort is multikey. An array is ordered by its
+        // elements in the index, so the first document of each distinct value need not be the one
+        // the sort asks for. For example, a $group with {$max: "$ts"} is planned with the sort
+        // {groupKey: 1, ts: -1}, but $max orders an array above any number.
+        size_t keyPatternFieldIndex = 0;
+        for (auto&& elem : indexScanNode->index.keyPattern) {
+            if (sortPattern.hasField(elem.fieldNameStringData()) &&
+                keyPatternFieldIndex < multikeyPaths.size() &&
+                !multikeyPaths[keyPatternFieldIndex].empty()) {
+                return false;
+            }
+            ++keyPatternFieldIndex;
+        }
     }
 
     // Make a new DistinctNode. We will swap this for the ixscan in the provided solution.
@@ -1591,8 +1616,10 @@ Status getExecutorDistinctFromIndexSolutions(OperationContext* opCtx,
                                              QueryOrExecutor* queryOrExecutor) {
     // We look for a solution that has an ixscan we can turn into a distinctixscan
     for (size_t i = 0; i < solutions.size(); ++i) {
-        if (turnIxscanIntoDistinctIxscan(
-                solutions[i].get(), parsedDistinct->getKey(), strictDistinctOnly)) {
+        if (turnIxscanIntoDistinctIxscan(solutions[i].get(),
+                                         parsedDistinct->getKey(),
+                                         strictDistinctOnly,
+                                         queryOrExecutor->cq->getQueryRequest().getSort())) {
             // Build and return the SSR over solutions[i].
             unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
             unique_ptr<QuerySolution> currentSolution = std::move(solutions[i]);
@@ -125,12 +125,16 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorLega
  * documents that need to be examined to compute the results of a distinct command, but it may not
  * guarantee that there are no duplicate values for the distinct field.
  *
+ * 'sortPattern' is the sort the solution was planned with, if any. No field of it may be multikey,
+ * since the DISTINCT_SCAN returns the first document of each distinct value in index order.
+ *
  * If the provided solution could be mutated successfully, returns true, otherwise returns
  * false.
  */
 bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
                                   const std::string& field,
-                                  bool strictDistinctOnly);
+                                  bool strictDistinctOnly,
+                                  const BSONObj& sortPattern);
 
 /**
  * Get an executor that potentially uses a DISTINCT_SCAN, intended for either a "distinct" command
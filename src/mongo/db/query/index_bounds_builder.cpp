@@ -111,6 +111,162 @@ bool stringMayHaveUnescapedPipe(StringData str) {
     return false;
 }
 
+// Limits on the bounds generated for a regex which is a case-insensitive prefix or an alternation
+// of prefixes. Each letter of a case-insensitive prefix doubles the number of intervals.
+const size_t kMaxRegexPrefixIntervals = 64;
+const size_t kMaxCaseInsensitivePrefixLetters = 4;
+
+bool isAsciiLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/**
+ * Splits 'regex' into its top-level alternatives. Returns an empty vector if the regex contains an
+ * alternation nested inside a group, or a \Q...\E sequence, since those are not split correctly.
+ */
+std::vector<std::string> splitTopLevelAlternation(StringData regex) {
+    std::vector<std::string> branches(1);
+    int depth = 0;
+    bool inCharacterClass = false;
+    for (size_t i = 0; i < regex.size(); ++i) {
+        const char c = regex[i];
+        if (c == '\\') {
+            if (i + 1 < regex.size() && regex[i + 1] == 'Q') {
+                return {};
+            }
+            branches.back() += c;
+            if (++i < regex.size()) {
+                branches.back() += regex[i];
+            }
+            continue;
+        }
+
+        if (inCharacterClass) {
+            inCharacterClass = (c != ']');
+        } else if (c == '[') {
+            inCharacterClass = true;
+            // A ']' directly after the opening bracket, or after a leading '^', is a literal.
+            if (i + 1 < regex.size() && regex[i + 1] == '^') {
+                branches.back() += regex[++i];
+            }
+            if (i + 1 < regex.size() && regex[i + 1] == ']') {
+                branches.back() += c;
+                branches.back() += regex[++i];
+                continue;
+            }
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (c == '|') {
+            if (depth != 0) {
+                return {};
+            }
+            branches.emplace_back();
+            continue;
+        }
+        branches.back() += c;
+    }
+    return branches;
+}
+
+/**
+ * Appends to 'out' every combination of upper and lower case of the letters in 'prefix', after
+ * truncating it so that the number of combinations stays bounded. Returns false if nothing of the
+ * prefix remains.
+ *
+ * The prefix is truncated before any non-ASCII character, and before 'k' and 's', since in UTF-8
+ * mode those also match characters outside of ASCII when the regex is case-insensitive (the Kelvin
+ * sign and the long s).
+ */
+bool appendCaseInsensitivePrefixes(std::string prefix, std::vector<std::string>* out) {
+    size_t letters = 0;
+    size_t length = 0;
+    for (; length < prefix.size(); ++length) {
+        const char c = prefix[length];
+        if (static_cast<unsigned char>(c) >= 0x80 || c == 'k' || c == 'K' || c == 's' ||
+            c == 'S') {
+            break;
+        }
+        if (isAsciiLetter(c)) {
+            if (letters == kMaxCaseInsensitivePrefixLetters) {
+                break;
+            }
+            ++letters;
+        }
+    }
+    prefix.resize(length);
+    if (prefix.empty()) {
+        return false;
+    }
+
+    const size_t firstVariant = out->size();
+    out->push_back(prefix);
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (!isAsciiLetter(prefix[i])) {
+            continue;
+        }
+        const size_t numVariants = out->size();
+        for (size_t j = firstVariant; j < numVariants; ++j) {
+            std::string variant = (*out)[j];
+            variant[i] ^= 0x20;  // Flip the case of an ASCII letter.
+            out->push_back(std::move(variant));
+        }
+    }
+    return true;
+}
+
+/**
+ * Handles the regexes which simpleRegex() does not: a case-insensitive anchored prefix, and a
+ * top-level alternation in which every branch is an anchored prefix. On success fills 'prefixes'
+ * with strings such that every string matched by the regex starts with one of them, and returns
+ * true. Such bounds are always INEXACT_COVERED.
+ */
+bool regexPrefixes(const std::string& regex,
+                   const std::string& flags,
+                   const IndexEntry& index,
+                   std::vector<std::string>* prefixes) {
+    bool caseInsensitive = false;
+    std::string otherFlags;
+    for (auto&& flag : flags) {
+        if (flag == 'i') {
+            caseInsensitive = true;
+        } else if (flag == 'x') {
+            // A comment in extended mode may contain a '|'.
+            return false;
+        } else {
+            otherFlags += flag;
+        }
+    }
+
+    const auto branches = splitTopLevelAlternation(regex);
+    if (branches.empty() || (branches.size() == 1 && !caseInsensitive)) {
+        return false;
+    }
+
+    for (auto&& branch : branches) {
+        IndexBoundsBuilder::BoundsTightness unusedTightness;
+        const std::string prefix = IndexBoundsBuilder::simpleRegex(
+            branch.c_str(), otherFlags.c_str(), index, &unusedTightness);
+        if (prefix.empty()) {
+            return false;
+        }
+
+        if (caseInsensitive) {
+            if (!appendCaseInsensitivePrefixes(prefix, prefixes)) {
+                return false;
+            }
+        } else {
+            prefixes->push_back(prefix);
+        }
+
+        if (prefixes->size() > kMaxRegexPrefixIntervals) {
+            return false;
+        }
+    }
+    return true;
+}
+
 const BSONObj kUndefinedElementObj = BSON("" << BSONUndefined);
 const BSONObj kNullElementObj = BSON("" << BSONNULL);
 
@@ -708,7 +864,12 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            // The user's geo specification determines the region, so identical specifications
+            // can share a covering.
+            const BSONObj& rawObj = gme->getRawObj();
+            const StringData cacheKey =
+                rawObj.isEmpty() ? StringData() : StringData(rawObj.objdata(), rawObj.objsize());
+            ExpressionMapping::cover2dsphereCached(region, cacheKey, indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if (mongoutils::str::equals("2d", elt.valuestrsafe())) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
@@ -910,11 +1071,23 @@ void IndexBoundsBuilder::translateRegex(const RegexMatchExpression* rme,
         simpleRegex(rme->getString().c_str(), rme->getFlags().c_str(), index, tightnessOut);
 
     // Note that 'tightnessOut' is set by simpleRegex above.
+    std::vector<std::string> prefixes;
     if (!start.empty()) {
         string end = start;
         end[end.size() - 1]++;
         oilOut->intervals.push_back(
             makeRangeInterval(start, end, BoundInclusion::kIncludeStartKeyOnly));
+    } else if (!index.collator &&
+               regexPrefixes(rme->getString(), rme->getFlags(), index, &prefixes)) {
+        // The regex still has to be applied to the keys in these ranges.
+        for (auto&& prefix : prefixes) {
+            string end = prefix;
+            end[end.size() - 1]++;
+            oilOut->intervals.push_back(
+                makeRangeInterval(prefix, end, BoundInclusion::kIncludeStartKeyOnly));
+        }
+        unionize(oilOut);
+        *tightnessOut = IndexBoundsBuilder::INEXACT_COVERED;
     } else {
         BSONObjBuilder bob;
         bob.appendMinForType("", String);
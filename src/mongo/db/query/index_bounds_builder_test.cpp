@@ -33,12 +33,17 @@
 #include <limits>
 #include <memory>
 
+#include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/expression_index.h"
+#include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/unittest/unittest.h"
+#include "third_party/s2/s2cap.h"
+#include "third_party/s2/s2cellid.h"
+#include "third_party/s2/s2latlng.h"
 
 using namespace mongo;
 
@@ -1615,6 +1620,128 @@ TEST(IndexBoundsBuilderTest, SimplePrefixRegex) {
     ASSERT(tightness == IndexBoundsBuilder::EXACT);
 }
 
+TEST(IndexBoundsBuilderTest, CaseInsensitivePrefixRegex) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^ab/i}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 5U);
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[0].compare(Interval(fromjson("{'': 'AB', '': 'AC'}"), true, false)));
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[1].compare(Interval(fromjson("{'': 'Ab', '': 'Ac'}"), true, false)));
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[2].compare(Interval(fromjson("{'': 'aB', '': 'aC'}"), true, false)));
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[3].compare(Interval(fromjson("{'': 'ab', '': 'ac'}"), true, false)));
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[4].compare(Interval(fromjson("{'': /^ab/i, '': /^ab/i}"), true, true)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST(IndexBoundsBuilderTest, CaseInsensitivePrefixRegexStopsBeforeLettersWithUnicodeFolding) {
+    // With the 'i' flag, 'k' also matches the Kelvin sign, so only the 'o' can be used.
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^ok/i}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 3U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(fromjson("{'': 'O', '': 'P'}"), true, false)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[1].compare(Interval(fromjson("{'': 'o', '': 'p'}"), true, false)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST(IndexBoundsBuilderTest, CaseInsensitiveRegexWithoutPrefixUsesAllStrings) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^kb/i}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 2U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(fromjson("{'': '', '': {}}"), true, false)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST(IndexBoundsBuilderTest, AlternationOfPrefixRegexes) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^foo|^ba[rz]|^qux.*/}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 4U);
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[0].compare(Interval(fromjson("{'': 'ba', '': 'bb'}"), true, false)));
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[1].compare(Interval(fromjson("{'': 'foo', '': 'fop'}"), true, false)));
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[2].compare(Interval(fromjson("{'': 'qux', '': 'quy'}"), true, false)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST(IndexBoundsBuilderTest, AlternationOfOverlappingPrefixRegexesIsUnioned) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^ab|^abc/}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 2U);
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[0].compare(Interval(fromjson("{'': 'ab', '': 'ac'}"), true, false)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST(IndexBoundsBuilderTest, NestedAlternationRegexUsesAllStrings) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^(foo|bar)/}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 2U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(fromjson("{'': '', '': {}}"), true, false)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
+TEST(IndexBoundsBuilderTest, AlternationWithEmptyBranchUsesAllStrings) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: /^foo|/}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.intervals.size(), 2U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(fromjson("{'': '', '': {}}"), true, false)));
+    ASSERT(tightness == IndexBoundsBuilder::INEXACT_COVERED);
+}
+
 //
 // isSingleInterval
 //
@@ -2994,4 +3121,49 @@ TEST(IndexBoundsBuilderTest, IntersectizeBasic) {
     ASSERT_TRUE(oil2 == expectedIntersection);
 }
 
+TEST(ExpressionMappingTest, CachedS2CoveringMatchesUncachedCovering) {
+    ExpressionMapping::clear2dsphereCoveringCache_forTest();
+    const S2Cap cap = S2Cap::FromAxisAngle(S2LatLng::FromDegrees(40.7, -74.0).ToPoint(),
+                                           S1Angle::Radians(1000 / kRadiusOfEarthInMeters));
+
+    const auto expected = ExpressionMapping::get2dsphereCovering(cap);
+    ASSERT_FALSE(expected.empty());
+    ASSERT(expected == ExpressionMapping::get2dsphereCoveringCached(cap, "cap"));
+    ASSERT(expected == ExpressionMapping::get2dsphereCoveringCached(cap, "cap"));
+
+    // Changing the coverer's parameters must not return the covering cached under the old ones.
+    const int originalMaxCells = internalQueryS2GeoMaxCells.load();
+    internalQueryS2GeoMaxCells.store(4);
+    const auto coarser = ExpressionMapping::get2dsphereCovering(cap);
+    ASSERT(coarser == ExpressionMapping::get2dsphereCoveringCached(cap, "cap"));
+    internalQueryS2GeoMaxCells.store(originalMaxCells);
+
+    ExpressionMapping::clear2dsphereCoveringCache_forTest();
+}
+
+TEST(ExpressionMappingTest, S2CellIdsToIntervalsWithParentsSkipsSeenParents) {
+    const S2Cap cap = S2Cap::FromAxisAngle(S2LatLng::FromDegrees(40.7, -74.0).ToPoint(),
+                                           S1Angle::Radians(1000 / kRadiusOfEarthInMeters));
+    const auto cover = ExpressionMapping::get2dsphereCovering(cap);
+
+    S2IndexingParams params;
+    params.coarsestIndexedLevel = 0;
+    params.indexVersion = S2_INDEX_VERSION_3;
+
+    OrderedIntervalList withoutSeen;
+    ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, params, &withoutSeen);
+
+    std::unordered_set<S2CellId> seenParents;  // NOLINT
+    OrderedIntervalList first;
+    ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, params, &first, &seenParents);
+    ASSERT_TRUE(first == withoutSeen);
+    ASSERT_FALSE(seenParents.empty());
+
+    // Only the covering's own ranges remain once all of its parents have been seen.
+    OrderedIntervalList second;
+    ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, params, &second, &seenParents);
+    ASSERT_EQUALS(cover.size(), second.intervals.size());
+    ASSERT_EQUALS(first.intervals.size(), cover.size() + seenParents.size());
+}
+
 }  // namespace
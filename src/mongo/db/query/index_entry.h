@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -41,6 +42,7 @@ namespace mongo {
 
 class CollatorInterface;
 class MatchExpression;
+class WildcardPathDictionary;
 
 /**
  * This name sucks, but every name involving 'index' is used somewhere.
@@ -217,6 +219,10 @@ struct IndexEntry {
     // Null if this index orders strings according to the simple binary compare. If non-null,
     // represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* collator = nullptr;
+
+    // Non-null only for version 2 $** indexes, whose keys store an id from this dictionary in place
+    // of each path. The planner uses it to translate the paths in the bounds into those ids.
+    std::shared_ptr<const WildcardPathDictionary> wildcardPathDictionary;
 };
 
 std::ostream& operator<<(std::ostream& stream, const IndexEntry::Identifier& ident);
@@ -45,6 +45,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
@@ -1291,6 +1292,96 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeSkipScan(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    if (index.type != INDEX_BTREE || index.multikey || index.sparse || index.filterExpr ||
+        index.keyPattern.nFields() < 2) {
+        return nullptr;
+    }
+
+    // Rate a copy of the query against this index alone, so that we reuse the usual rules about
+    // which predicates an index field can answer (collation, null semantics and so on).
+    unique_ptr<MatchExpression> root = query.root()->shallowClone();
+    root->resetTag();
+    QueryPlannerIXSelect::rateIndices(
+        root.get(), "", std::vector<IndexEntry>{index}, query.getCollator());
+
+    std::vector<MatchExpression*> preds;
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            preds.push_back(root->getChild(i));
+        }
+    } else {
+        preds.push_back(root.get());
+    }
+
+    std::vector<OrderedIntervalList> fields(index.keyPattern.nFields());
+    std::vector<BSONElement> keyPatternElts;
+    for (auto&& elt : index.keyPattern) {
+        keyPatternElts.push_back(elt);
+    }
+
+    for (auto&& pred : preds) {
+        auto tag = static_cast<RelevantTag*>(pred->getTag());
+        if (!tag) {
+            continue;
+        }
+        if (!tag->first.empty()) {
+            // A predicate over the leading field lets the enumerator build ordinary bounds.
+            return nullptr;
+        }
+        if (tag->notFirst.empty()) {
+            continue;
+        }
+
+        for (size_t pos = 1; pos < keyPatternElts.size(); ++pos) {
+            if (keyPatternElts[pos].fieldNameStringData() != tag->path) {
+                continue;
+            }
+
+            // The fetch below re-applies the whole filter, so the tightness doesn't matter.
+            IndexBoundsBuilder::BoundsTightness tightness;
+            if (fields[pos].name.empty()) {
+                IndexBoundsBuilder::translate(
+                    pred, keyPatternElts[pos], index, &fields[pos], &tightness);
+            } else {
+                IndexBoundsBuilder::translateAndIntersect(
+                    pred, keyPatternElts[pos], index, &fields[pos], &tightness);
+            }
+        }
+    }
+
+    bool hasConstrainedField = false;
+    for (size_t pos = 1; pos < fields.size(); ++pos) {
+        if (fields[pos].name.empty()) {
+            continue;
+        }
+        if (fields[pos].intervals.size() != 1 || !fields[pos].intervals[0].isMinToMax()) {
+            hasConstrainedField = true;
+        }
+    }
+    if (!hasConstrainedField) {
+        return nullptr;
+    }
+
+    auto isn = stdx::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+    isn->isSkipScan = true;
+    for (size_t pos = 0; pos < fields.size(); ++pos) {
+        if (fields[pos].name.empty()) {
+            IndexBoundsBuilder::allValuesForField(keyPatternElts[pos], &fields[pos]);
+        }
+    }
+    isn->bounds.fields = std::move(fields);
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    auto fetch = stdx::make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return std::move(fetch);
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
@@ -118,6 +118,17 @@ public:
                                                             const BSONObj& startKey,
                                                             const BSONObj& endKey);
 
+    /**
+     * Return a plan that answers 'query' by skipping through 'index' one distinct value of its
+     * unconstrained leading fields at a time, scanning only the bounds of the constrained fields
+     * that follow. Returns nullptr unless 'index' is a non-multikey, non-sparse, non-partial btree
+     * index whose leading field has no predicates and at least one later field has predicates
+     * that generate bounds.
+     */
+    static std::unique_ptr<QuerySolutionNode> makeSkipScan(const IndexEntry& index,
+                                                           const CanonicalQuery& query,
+                                                           const QueryPlannerParams& params);
+
     /**
      * Consructs a data access plan for 'query' which answers the predicate contained in 'root'.
      * Assumes the presence of the passed in indices. Planning behavior is controlled by the
@@ -551,6 +551,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         // We have a true limit. The limit can be combined with the SORT stage.
         sort->limit =
             static_cast<size_t>(*qr.getLimit()) + static_cast<size_t>(qr.getSkip().value_or(0));
+
+        // A top-k sort by text score directly over the TEXT node only needs the highest scoring
+        // documents from it, which the TEXT node can produce without scoring every match.
+        QuerySolutionNode* sortedNode = keyGenNode->children[0];
+        if (internalQueryPlannerEnableTextTopK.load() && STAGE_TEXT == sortedNode->getType() &&
+            sortObj.nFields() == 1 && QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+            static_cast<TextNode*>(sortedNode)->limit = sort->limit;
+        }
     } else if (qr.getNToReturn()) {
         // We have an ntoreturn specified by an OP_QUERY style find. This is used
         // by clients to mean both batchSize and limit.
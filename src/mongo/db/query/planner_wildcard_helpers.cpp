@@ -32,10 +32,12 @@
 
 #include "mongo/db/query/planner_wildcard_helpers.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/index/wildcard_key_generator.h"
+#include "mongo/db/index/wildcard_path_dictionary.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/util/log.h"
 
@@ -287,6 +289,28 @@ bool boundsOverlapObjectTypeBracket(const OrderedIntervalList& oil) {
     // If we're here, then all the OIL's bounds precede the object type bracket.
     return false;
 }
+
+/**
+ * Appends intervals covering exactly the ids in 'pathIds' to 'pathIntervals', in ascending order.
+ * Path ids are integers, so each run of consecutive ids can be covered by a single closed range.
+ */
+void appendPathIdIntervals(std::vector<long long> pathIds, std::vector<Interval>* pathIntervals) {
+    std::sort(pathIds.begin(), pathIds.end());
+    pathIds.erase(std::unique(pathIds.begin(), pathIds.end()), pathIds.end());
+    for (size_t runStart = 0; runStart < pathIds.size();) {
+        size_t runEnd = runStart;
+        while (runEnd + 1 < pathIds.size() && pathIds[runEnd + 1] == pathIds[runEnd] + 1) {
+            ++runEnd;
+        }
+        pathIntervals->push_back(runStart == runEnd
+                                     ? IndexBoundsBuilder::makePointInterval(
+                                           BSON("" << pathIds[runStart]))
+                                     : IndexBoundsBuilder::makeRangeInterval(
+                                           BSON("" << pathIds[runStart] << "" << pathIds[runEnd]),
+                                           BoundInclusion::kIncludeBothStartAndEndKeys));
+        runStart = runEnd + 1;
+    }
+}
 }  // namespace
 
 void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
@@ -350,6 +374,7 @@ void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
                          wildcardIndex.filterExpr,
                          wildcardIndex.infoObj,
                          wildcardIndex.collator);
+        entry.wildcardPathDictionary = wildcardIndex.wildcardPathDictionary;
 
         invariant("$_path"_sd != fieldName);
         out->push_back(std::move(entry));
@@ -443,14 +468,30 @@ void finalizeWildcardIndexScanConfiguration(IndexScanNode* scan) {
 
     // Add a $_path point-interval for each path that needs to be traversed in the index. If subpath
     // bounds are required, then we must add a further range interval on ["path.","path/").
+    // Version 2 $** indexes store each path's id from the path dictionary in place of the path, so
+    // for these we instead look up the ids of the path and of any of its known subpaths. Paths
+    // which are absent from the dictionary have not been indexed, and need no bounds at all.
     static const char subPathStart = '.', subPathEnd = static_cast<char>('.' + 1);
     auto& pathIntervals = bounds->fields.front().intervals;
+    const auto& pathDictionary = index->wildcardPathDictionary;
+    std::vector<long long> pathIds;
     for (const auto& fieldPath : paths) {
         auto path = fieldPath.dottedField().toString();
-        pathIntervals.push_back(IndexBoundsBuilder::makePointInterval(path));
+        if (pathDictionary) {
+            if (auto pathId = pathDictionary->findPathId(path)) {
+                pathIds.push_back(*pathId);
+            }
+        } else {
+            pathIntervals.push_back(IndexBoundsBuilder::makePointInterval(path));
+        }
         if (requiresSubpathBounds) {
-            pathIntervals.push_back(IndexBoundsBuilder::makeRangeInterval(
-                path + subPathStart, path + subPathEnd, BoundInclusion::kIncludeStartKeyOnly));
+            if (pathDictionary) {
+                const auto subpathIds = pathDictionary->findSubpathIds(path);
+                pathIds.insert(pathIds.end(), subpathIds.begin(), subpathIds.end());
+            } else {
+                pathIntervals.push_back(IndexBoundsBuilder::makeRangeInterval(
+                    path + subPathStart, path + subPathEnd, BoundInclusion::kIncludeStartKeyOnly));
+            }
 
             // Queries which scan subpaths for a single wildcard index should be deduped. The index
             // bounds may include multiple keys associated with the same document. Therefore, we
@@ -458,6 +499,9 @@ void finalizeWildcardIndexScanConfiguration(IndexScanNode* scan) {
             scan->shouldDedup = true;
         }
     }
+    if (pathDictionary) {
+        appendPathIdIntervals(std::move(pathIds), &pathIntervals);
+    }
     // Ensure that the bounds' intervals are correctly aligned.
     IndexBoundsBuilder::alignBounds(bounds, index->keyPattern);
 }
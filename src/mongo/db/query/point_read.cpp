@@ -0,0 +1,258 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/point_read.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/projection.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/query/collation/collation_index_key.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/indexability.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/s/collection_sharding_state.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns true if 'elt', as a predicate of the filter, is an equality match against a literal
+ * which selects exactly the documents with that key in an index on the field. Mirrors
+ * CanonicalQuery::isSimpleIdQuery().
+ */
+bool isLiteralEquality(BSONElement elt) {
+    if (elt.type() == BSONType::Object) {
+        // A literal object match, unless the object is a set of query operators.
+        return elt.Obj().firstElementFieldName()[0] != '$';
+    }
+
+    return Indexability::isExactBoundsGenerating(elt);
+}
+
+/**
+ * Returns true if 'fieldName' names a top-level field of the document.
+ */
+bool isTopLevelField(StringData fieldName) {
+    return !fieldName.empty() && fieldName[0] != '$' && fieldName.find('.') == std::string::npos;
+}
+
+/**
+ * Populates 'includedFields' and returns true if 'projection' is an inclusion projection of
+ * top-level fields, which can be applied with ProjectionStage::transformSimpleInclusion(). Returns
+ * false for any other projection.
+ */
+bool getSimpleInclusionFields(const BSONObj& projection, StringMap<bool>* includedFields) {
+    bool includeId = true;
+    for (auto&& elt : projection) {
+        if (!elt.isNumber() && !elt.isBoolean()) {
+            return false;
+        }
+
+        const auto fieldName = elt.fieldNameStringData();
+        if (fieldName == "_id"_sd) {
+            includeId = elt.trueValue();
+            continue;
+        }
+
+        if (!elt.trueValue() || !isTopLevelField(fieldName)) {
+            return false;
+        }
+        (*includedFields)[fieldName] = true;
+    }
+
+    // A projection such as {_id: 0} excludes fields rather than including them.
+    if (includedFields->empty()) {
+        return false;
+    }
+
+    if (includeId) {
+        (*includedFields)["_id"] = true;
+    }
+    return true;
+}
+
+/**
+ * Returns a ready, unique, non-partial index on exactly 'fieldName', or nullptr if there is none.
+ */
+const IndexDescriptor* findUniqueIndex(OperationContext* opCtx,
+                                       const IndexCatalog* catalog,
+                                       StringData fieldName) {
+    for (int direction : {1, -1}) {
+        std::vector<IndexDescriptor*> indexes;
+        catalog->findIndexesByKeyPattern(
+            opCtx, BSON(fieldName << direction), false /* includeUnfinishedIndexes */, &indexes);
+        for (auto index : indexes) {
+            if (index->unique() && !index->isPartial()) {
+                return index;
+            }
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+PointRead::PointRead(const IndexDescriptor* index, BSONObj key, FieldSet includedFields)
+    : _index(index), _key(std::move(key)), _includedFields(std::move(includedFields)) {}
+
+boost::optional<PointRead> PointRead::make(OperationContext* opCtx,
+                                           Collection* collection,
+                                           const QueryRequest& qr) {
+    invariant(collection);
+
+    if (!internalQueryEnablePointReadFastPath.load()) {
+        return boost::none;
+    }
+
+    // Anything which could change which document is returned, or the shape of the reply, is left
+    // to the regular query path. A non-empty collation is excluded even when it could not affect
+    // the result, so that it is still validated.
+    if (!qr.getSort().isEmpty() || !qr.getHint().isEmpty() || !qr.getCollation().isEmpty() ||
+        !qr.getMin().isEmpty() || !qr.getMax().isEmpty() || qr.getSkip() || qr.returnKey() ||
+        qr.showRecordId() || qr.isTailable() || qr.isOplogReplay() || qr.isExplain()) {
+        return boost::none;
+    }
+
+    // A batch size of zero asks for an empty first batch and a cursor.
+    const auto batchSize = qr.getEffectiveBatchSize();
+    if ((batchSize && *batchSize <= 0) || (qr.getLimit() && *qr.getLimit() <= 0)) {
+        return boost::none;
+    }
+
+    const BSONObj& filter = qr.getFilter();
+    if (filter.nFields() != 1) {
+        return boost::none;
+    }
+    const BSONElement elt = filter.firstElement();
+    if (!isTopLevelField(elt.fieldNameStringData()) || !isLiteralEquality(elt)) {
+        return boost::none;
+    }
+
+    FieldSet includedFields;
+    if (!qr.getProj().isEmpty() && !getSimpleInclusionFields(qr.getProj(), &includedFields)) {
+        return boost::none;
+    }
+
+    // Documents of a sharded collection may have to be filtered out as orphans.
+    if (CollectionShardingState::get(opCtx, collection->ns())->getMetadata(opCtx)->isSharded()) {
+        return boost::none;
+    }
+
+    const IndexCatalog* catalog = collection->getIndexCatalog();
+    const IndexDescriptor* index = elt.fieldNameStringData() == "_id"_sd
+        ? catalog->findIdIndex(opCtx)
+        : findUniqueIndex(opCtx, catalog, elt.fieldNameStringData());
+    if (!index) {
+        return boost::none;
+    }
+
+    // The query is evaluated with the collection's default collation, which must agree with the
+    // index's for string comparisons to give the same answer.
+    if (CollationIndexKey::isCollatableType(elt.type()) &&
+        !CollatorInterface::collatorsMatch(collection->getDefaultCollator(),
+                                           catalog->getEntry(index)->getCollator())) {
+        return boost::none;
+    }
+
+    return PointRead(index, filter, std::move(includedFields));
+}
+
+long long PointRead::execute(OperationContext* opCtx,
+                             Collection* collection,
+                             CursorResponseBuilder* batch) {
+    const IndexAccessMethod* accessMethod = collection->getIndexCatalog()->getIndex(_index);
+
+    _keysExamined = 0;
+    _docsExamined = 0;
+    _nReturned = writeConflictRetry(opCtx, "find", collection->ns().ns(), [&]() -> long long {
+        const RecordId recordId = accessMethod->findSingle(opCtx, _key);
+        if (recordId.isNull()) {
+            return 0;
+        }
+        _keysExamined = 1;
+
+        // The record is appended to the reply straight from the storage engine's buffer, which
+        // stays valid for as long as the cursor is positioned on it.
+        auto cursor = collection->getCursor(opCtx);
+        auto record = cursor->seekExact(recordId);
+        if (!record) {
+            return 0;
+        }
+        _docsExamined = 1;
+
+        if (_includedFields.empty()) {
+            batch->append(record->data.toBson());
+        } else {
+            BSONObjBuilder bob;
+            ProjectionStage::transformSimpleInclusion(record->data.toBson(), _includedFields, bob);
+            batch->append(bob.done());
+        }
+        return 1;
+    });
+    return _nReturned;
+}
+
+std::string PointRead::getPlanSummary() const {
+    if (_index->isIdIndex()) {
+        return "IDHACK";
+    }
+    return "IXSCAN " + _index->keyPattern().toString();
+}
+
+BSONObj PointRead::getStats() const {
+    BSONObjBuilder bob;
+    if (_index->isIdIndex()) {
+        bob.append("stage", "IDHACK");
+        bob.appendNumber("nReturned", _nReturned);
+        bob.appendNumber("keysExamined", _keysExamined);
+        bob.appendNumber("docsExamined", _docsExamined);
+        return bob.obj();
+    }
+
+    bob.append("stage", "FETCH");
+    bob.appendNumber("nReturned", _nReturned);
+    bob.appendNumber("docsExamined", _docsExamined);
+    BSONObjBuilder inputStage(bob.subobjStart("inputStage"));
+    inputStage.append("stage", "IXSCAN");
+    inputStage.appendNumber("nReturned", _keysExamined);
+    inputStage.append("keyPattern", _index->keyPattern());
+    inputStage.append("indexName", _index->indexName());
+    inputStage.appendNumber("keysExamined", _keysExamined);
+    inputStage.doneFast();
+    return bob.obj();
+}
+
+}  // namespace mongo
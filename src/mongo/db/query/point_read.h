@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class Collection;
+class CursorResponseBuilder;
+class IndexDescriptor;
+class OperationContext;
+class QueryRequest;
+
+/**
+ * A find which can be answered by looking up a single key in a unique index: an equality match on
+ * '_id', or on the field of a unique single-field index, with no sort, skip, hint or other
+ * modifiers and at most a simple inclusion projection. Such a find returns at most one document,
+ * so it is run directly against the index and the record store rather than being canonicalized,
+ * planned and executed by a PlanExecutor.
+ */
+class PointRead {
+public:
+    /**
+     * Returns a PointRead for the find described by 'qr' if it is eligible for the fast path, or
+     * boost::none if it must go through the regular query machinery. 'collection' must not be
+     * null.
+     */
+    static boost::optional<PointRead> make(OperationContext* opCtx,
+                                           Collection* collection,
+                                           const QueryRequest& qr);
+
+    /**
+     * Looks up the matching document and, if there is one, appends it to 'batch' after applying
+     * the projection. Returns the number of documents appended.
+     */
+    long long execute(OperationContext* opCtx,
+                      Collection* collection,
+                      CursorResponseBuilder* batch);
+
+    /**
+     * Returns the plan summary the query planner would have reported for the same find.
+     */
+    std::string getPlanSummary() const;
+
+    /**
+     * Returns the execution stats of the last call to execute(), in the format used by explain.
+     */
+    BSONObj getStats() const;
+
+    const IndexDescriptor* getIndex() const {
+        return _index;
+    }
+
+    long long getKeysExamined() const {
+        return _keysExamined;
+    }
+
+    long long getDocsExamined() const {
+        return _docsExamined;
+    }
+
+private:
+    using FieldSet = StringMap<bool>;
+
+    PointRead(const IndexDescriptor* index, BSONObj key, FieldSet includedFields);
+
+    const IndexDescriptor* _index;
+
+    // The key to look up, in the form of the query's filter, e.g. {_id: 5}.
+    BSONObj _key;
+
+    // The fields kept by the projection, or empty if the whole document is returned.
+    FieldSet _includedFields;
+
+    long long _keysExamined = 0;
+    long long _docsExamined = 0;
+    long long _nReturned = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/point_read.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/rpc/op_msg_rpc_impls.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.point_read_bm");
+const int kNumDocs = 10 * 1000;
+
+/**
+ * Starts up an ephemeralForTest storage engine holding a collection of 'kNumDocs' documents with
+ * integer _ids.
+ */
+class PointReadBenchmarkFixture : public ServiceContextMongoDTest {
+public:
+    PointReadBenchmarkFixture() {
+        auto service = getServiceContext();
+        auto replCoord = stdx::make_unique<repl::ReplicationCoordinatorMock>(service);
+        invariant(replCoord->setFollowerMode(repl::MemberState::RS_PRIMARY));
+        repl::ReplicationCoordinator::set(service, std::move(replCoord));
+
+        _opCtx = makeOperationContext();
+
+        repl::StorageInterfaceImpl storage;
+        uassertStatusOK(storage.createCollection(_opCtx.get(), kNss, CollectionOptions()));
+
+        std::vector<InsertStatement> docs;
+        for (int i = 0; i < kNumDocs; ++i) {
+            docs.emplace_back(BSON("_id" << i << "a" << i << "payload" << std::string(100, 'x')));
+        }
+        uassertStatusOK(storage.insertDocuments(_opCtx.get(), kNss, docs));
+    }
+
+    OperationContext* getOperationContext() {
+        return _opCtx.get();
+    }
+
+private:
+    void _doTest() final {}
+
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+BSONObj makeFindCommand(int id) {
+    return BSON("find" << kNss.coll() << "filter" << BSON("_id" << id));
+}
+
+/**
+ * Answers a find by _id with the PointRead fast path, up to the point of the reply being built.
+ */
+void BM_FindByIdPointRead(benchmark::State& state) {
+    PointReadBenchmarkFixture fixture;
+    auto opCtx = fixture.getOperationContext();
+
+    int id = 0;
+    for (auto keepRunning : state) {
+        auto qr = uassertStatusOK(
+            QueryRequest::makeFromFindCommand(kNss, makeFindCommand(id), false /* isExplain */));
+        AutoGetCollectionForReadCommand ctx(opCtx, kNss);
+
+        auto pointRead = PointRead::make(opCtx, ctx.getCollection(), *qr);
+        invariant(pointRead);
+
+        rpc::OpMsgReplyBuilder reply;
+        CursorResponseBuilder::Options options;
+        options.isInitialResponse = true;
+        CursorResponseBuilder firstBatch(&reply, options);
+        invariant(pointRead->execute(opCtx, ctx.getCollection(), &firstBatch) == 1);
+        firstBatch.done(0, kNss.ns());
+        benchmark::DoNotOptimize(reply.done());
+
+        id = (id + 1) % kNumDocs;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Answers the same find by canonicalizing it and running the PlanExecutor the planner builds for
+ * it, as the find command does for queries which are not eligible for the fast path.
+ */
+void BM_FindByIdPlanExecutor(benchmark::State& state) {
+    PointReadBenchmarkFixture fixture;
+    auto opCtx = fixture.getOperationContext();
+
+    int id = 0;
+    for (auto keepRunning : state) {
+        auto qr = uassertStatusOK(
+            QueryRequest::makeFromFindCommand(kNss, makeFindCommand(id), false /* isExplain */));
+        AutoGetCollectionForReadCommand ctx(opCtx, kNss);
+
+        const ExtensionsCallbackReal extensionsCallback(opCtx, &kNss);
+        auto cq = uassertStatusOK(
+            CanonicalQuery::canonicalize(opCtx,
+                                         std::move(qr),
+                                         boost::intrusive_ptr<ExpressionContext>(),
+                                         extensionsCallback,
+                                         MatchExpressionParser::kAllowAllSpecialFeatures));
+        auto exec =
+            uassertStatusOK(getExecutorFind(opCtx, ctx.getCollection(), kNss, std::move(cq)));
+
+        rpc::OpMsgReplyBuilder reply;
+        CursorResponseBuilder::Options options;
+        options.isInitialResponse = true;
+        CursorResponseBuilder firstBatch(&reply, options);
+        BSONObj obj;
+        while (exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED) {
+            firstBatch.append(obj);
+        }
+        firstBatch.done(0, kNss.ns());
+        benchmark::DoNotOptimize(reply.done());
+
+        id = (id + 1) % kNumDocs;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindByIdPointRead);
+BENCHMARK(BM_FindByIdPlanExecutor);
+
+}  // namespace
+}  // namespace mongo
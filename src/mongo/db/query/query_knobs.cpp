@@ -79,6 +79,43 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecMaxBlockingSortBytes, int, 32 * 1
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldIterations, int, 128);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldPeriodMS, int, 10);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecFetchBatchSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 10000) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryExecFetchBatchSize must be between 0 and 10000");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecCollScanFilterThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryExecCollScanFilterThreads must be between 0 and 64");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecCollScanFilterBatchSize, int, 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 100000) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryExecCollScanFilterBatchSize must be between 1 and 100000");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecCollScanFilterBatchBytes, int, 4 * 1024 * 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64 * 1024 * 1024) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryExecCollScanFilterBatchBytes must be between 1 and "
+                          "67108864");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetBufferSizeBytes, int, 100 * 1024 * 1024);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceSortMaxBlockingSortBytes,
@@ -103,6 +140,17 @@ MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupMaxMemoryBytes,
         return Status::OK();
     });
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourcePipelineMaxMemoryBytes,
+                              long long,
+                              500 * 1024 * 1024)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourcePipelineMaxMemoryBytes must be >= 0");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalInsertMaxBatchSize,
                               int,
                               internalQueryExecYieldIterations.load() / 2);
@@ -113,7 +161,15 @@ MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupCacheSizeBytes, int, 1
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerGenerateCoveredWholeIndexScans, bool, false);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerGenerateSkipScans, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableTextTopK, bool, true);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryIgnoreUnknownJSONSchemaKeywords, bool, false);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnablePointReadFastPath, bool, true);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryProhibitBlockingMergeOnMongoS, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMapReduceEnableNativeFunctions, bool, true);
 }  // namespace mongo
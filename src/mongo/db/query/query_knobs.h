@@ -105,9 +105,20 @@ extern AtomicInt32 internalQueryMaxScansToExplode;
 // Allow the planner to generate covered whole index scans, rather than falling back to a COLLSCAN.
 extern AtomicBool internalQueryPlannerGenerateCoveredWholeIndexScans;
 
+// Allow the planner to generate skip scans over compound indexes whose leading fields are not
+// constrained by the query. These plans compete with a collection scan.
+extern AtomicBool internalQueryPlannerGenerateSkipScans;
+
+// Let a $text search sorted by text score with a limit stop reading the text index once no other
+// document can score high enough to be returned.
+extern AtomicBool internalQueryPlannerEnableTextTopK;
+
 // Ignore unknown JSON Schema keywords.
 extern AtomicBool internalQueryIgnoreUnknownJSONSchemaKeywords;
 
+// Answer finds for a single key of a unique index without planning them.
+extern AtomicBool internalQueryEnablePointReadFastPath;
+
 //
 // Query execution.
 //
@@ -120,6 +131,17 @@ extern AtomicInt32 internalQueryExecYieldIterations;
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// If greater than 1, FETCH stages buffer this many index entries and read their documents in
+// RecordId order.
+extern AtomicInt32 internalQueryExecFetchBatchSize;
+
+// If non-zero, COLLSCAN stages evaluate their filter over batches of at most
+// internalQueryExecCollScanFilterBatchSize records and internalQueryExecCollScanFilterBatchBytes
+// bytes using this many extra threads.
+extern AtomicInt32 internalQueryExecCollScanFilterThreads;
+extern AtomicInt32 internalQueryExecCollScanFilterBatchSize;
+extern AtomicInt32 internalQueryExecCollScanFilterBatchBytes;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
@@ -130,6 +152,11 @@ extern AtomicInt64 internalDocumentSourceSortMaxBlockingSortBytes;
 
 extern AtomicInt64 internalDocumentSourceGroupMaxMemoryBytes;
 
+// The memory budget of a whole aggregation, including its sub-pipelines. Stages which can spill to
+// disk do so once the pipeline is over it, even if they are within their own limits. 0 means there
+// is no budget.
+extern AtomicInt64 internalDocumentSourcePipelineMaxMemoryBytes;
+
 extern AtomicInt32 internalInsertMaxBatchSize;
 
 extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
@@ -137,4 +164,8 @@ extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 extern AtomicInt32 internalDocumentSourceLookupCacheSizeBytes;
 
 extern AtomicBool internalQueryProhibitBlockingMergeOnMongoS;
+
+// Apply mapReduce map and reduce functions of a few common shapes in C++ rather than in the JS
+// engine.
+extern AtomicBool internalQueryMapReduceEnableNativeFunctions;
 }  // namespace mongo
@@ -96,6 +96,10 @@ struct QueryPlannerParams {
         // return exactly one document per value of the distinct field. See the comments above the
         // declaration of getExecutorDistinct() for more detail.
         STRICT_DISTINCT_ONLY = 1 << 11,
+
+        // Set this to generate skip scan plans over compound indexes whose leading fields the
+        // query does not constrain.
+        GENERATE_SKIP_SCANS = 1 << 12,
     };
 
     // See Options enum above.
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+class QueryPlannerSkipScanTest : public QueryPlannerTest {
+protected:
+    void setUp() final {
+        QueryPlannerTest::setUp();
+        params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    }
+};
+
+TEST_F(QueryPlannerSkipScanTest, SkipScanRacesCollscanWhenLeadingFieldIsUnconstrained) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+
+    runQuery(fromjson("{ts: {$gt: 5}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {ts: {$gt: 5}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {ts: {$gt: 5}}, node: {ixscan: {pattern: {tenant: 1, ts: 1}, bounds: "
+        "{tenant: [['MinKey','MaxKey',true,true]], ts: [[5,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, NoSkipScanWithoutOption) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+
+    runQuery(fromjson("{ts: {$gt: 5}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {ts: {$gt: 5}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, NoSkipScanWhenLeadingFieldIsConstrained) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+
+    runQuery(fromjson("{tenant: 'a', ts: {$gt: 5}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {tenant: 1, ts: 1}, bounds: "
+        "{tenant: [['a','a',true,true]], ts: [[5,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, NoSkipScanOverMultikeyOrSparseIndex) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1), true);
+    addIndex(BSON("region" << 1 << "ts" << 1), false, true);
+
+    runQuery(fromjson("{ts: {$gt: 5}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {ts: {$gt: 5}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, SkipScanIntersectsBoundsOverSeveralTrailingFields) {
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+
+    runQuery(fromjson("{c: {$gte: 1}, b: {$lt: 3}, d: 4}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {c: {$gte: 1}, b: {$lt: 3}, d: 4}, node: {ixscan: {pattern: "
+        "{a: 1, b: 1, c: 1}, bounds: {a: [['MinKey','MaxKey',true,true]], "
+        "b: [[-Infinity,3,true,false]], c: [[1,Infinity,true,true]]}}}}}");
+
+    runQuery(fromjson("{c: {$gte: 1, $lte: 5}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {a: 1, b: 1, c: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [['MinKey','MaxKey',true,true]], "
+        "c: [[1,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, SkipScanAlignsBoundsWithDescendingLeadingField) {
+    addIndex(BSON("tenant" << -1 << "ts" << 1));
+
+    runQuery(fromjson("{ts: {$lt: 3}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {tenant: -1, ts: 1}, bounds: "
+        "{tenant: [['MaxKey','MinKey',true,true]], ts: [[-Infinity,3,true,false]]}}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, SkipScanCompetesWithOtherIndexedPlansWithoutCollscan) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    addIndex(BSON("x" << 1));
+
+    runQuery(fromjson("{x: 1, ts: {$gt: 5}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {ts: {$gt: 5}}, node: {ixscan: {pattern: {x: 1}, "
+        "bounds: {x: [[1,1,true,true]]}}}}}");
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {tenant: 1, ts: 1}, bounds: "
+        "{tenant: [['MinKey','MaxKey',true,true]], ts: [[5,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, NoSkipScanWhenTrailingPredicateIsUnbounded) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+
+    runQuery(fromjson("{ts: {$exists: true}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerSkipScanTest, NoSkipScanUnderOr) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+
+    runQuery(fromjson("{$or: [{ts: 1}, {x: 2}]}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+}  // namespace
+}  // namespace mongo
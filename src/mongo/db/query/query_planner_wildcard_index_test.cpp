@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/index/wildcard_path_dictionary.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/unittest/death_test.h"
@@ -55,7 +56,8 @@ protected:
     void addWildcardIndex(BSONObj keyPattern,
                           const std::set<std::string>& multikeyPathSet = {},
                           BSONObj wildcardProjection = BSONObj{},
-                          MatchExpression* partialFilterExpr = nullptr) {
+                          MatchExpression* partialFilterExpr = nullptr,
+                          std::shared_ptr<const WildcardPathDictionary> pathDictionary = nullptr) {
         // Convert the set of std::string to a set of FieldRef.
         std::set<FieldRef> multikeyFieldRefs;
         for (auto&& path : multikeyPathSet) {
@@ -77,6 +79,16 @@ protected:
                                             partialFilterExpr,
                                             std::move(infoObj),
                                             nullptr});  // collator
+        params.indices.back().wildcardPathDictionary = std::move(pathDictionary);
+    }
+
+    // Adds a version 2 $** index whose path dictionary assigns ids to 'paths' in order.
+    void addCompactWildcardIndex(BSONObj keyPattern, const std::vector<std::string>& paths) {
+        auto pathDictionary = std::make_shared<WildcardPathDictionary>();
+        for (auto&& path : paths) {
+            pathDictionary->getOrAssignPathId(path, nullptr);
+        }
+        addWildcardIndex(std::move(keyPattern), {}, BSONObj{}, nullptr, std::move(pathDictionary));
     }
 };
 
@@ -1840,4 +1852,56 @@ TEST_F(QueryPlannerWildcardTest, TypeOfArrayWithWildcardIndex) {
         "{$_path: [['a','a',true,true], ['a.','a/', true, false]], "
         "a:[['MinKey','MaxKey',true,true]]}}}}}");
 }
+
+//
+// Version 2 $** index tests.
+//
+
+TEST_F(QueryPlannerWildcardTest, CompactFormatEqualityUsesPathIdBounds) {
+    // The ids are assigned in order starting from 3, so 'a' has id 4.
+    addCompactWildcardIndex(BSON("$**" << 1), {"b", "a", "a.b"});
+    runQuery(fromjson("{a: {$eq: 5}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: "
+        "{ixscan: {filter: null, pattern: {'$_path': 1, a: 1},"
+        "bounds: {'$_path': [[4,4,true,true]], a: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, CompactFormatSubpathBoundsEnumeratePathDictionary) {
+    addCompactWildcardIndex(BSON("$**" << 1), {"x", "x.y", "x.z", "xy", "w.x", "x.y.z"});
+    runQuery(fromjson("{x: {$exists: true}}"));
+
+    // 'x' and its subpaths have ids 3, 4, 5 and 8, while 'xy' and 'w.x' are not subpaths of 'x'.
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: "
+        "{ixscan: {filter: null, pattern: {'$_path': 1, x: 1},"
+        "bounds: {'$_path': [[3,5,true,true],[8,8,true,true]], x: "
+        "[['MinKey','MaxKey',true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, CompactFormatUnindexedPathHasEmptyPathBounds) {
+    addCompactWildcardIndex(BSON("$**" << 1), {"a"});
+    runQuery(fromjson("{b: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: "
+        "{ixscan: {filter: null, pattern: {'$_path': 1, b: 1},"
+        "bounds: {'$_path': [], b: [[1,1,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, CompactFormatDescendingIndexReversesPathIdBounds) {
+    addCompactWildcardIndex(BSON("$**" << -1), {"a", "a.b"});
+    runQuery(fromjson("{a: {$exists: true}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: "
+        "{ixscan: {filter: null, pattern: {'$_path': -1, a: -1},"
+        "bounds: {'$_path': [[4,3,true,true]], a: "
+        "[['MaxKey','MinKey',true,true]]}}}}}");
+}
 }  // namespace mongo
@@ -202,6 +202,10 @@ void TextNode::appendToString(mongoutils::str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (limit > 0) {
+        addIndent(ss, indent + 1);
+        *ss << "limit = " << limit << '\n';
+    }
     if (NULL != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->toString();
@@ -216,6 +220,7 @@ QuerySolutionNode* TextNode::clone() const {
     copy->_sort = this->_sort;
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->limit = this->limit;
 
     return copy;
 }
@@ -534,6 +539,10 @@ void IndexScanNode::appendToString(mongoutils::str::stream* ss, int indent) cons
     }
     addIndent(ss, indent + 1);
     *ss << "direction = " << direction << '\n';
+    if (isSkipScan) {
+        addIndent(ss, indent + 1);
+        *ss << "isSkipScan = 1\n";
+    }
     addIndent(ss, indent + 1);
     *ss << "bounds = " << bounds.toString() << '\n';
     addCommon(ss, indent);
@@ -820,6 +829,7 @@ QuerySolutionNode* IndexScanNode::clone() const {
     copy->_sorts = this->_sorts;
     copy->direction = this->direction;
     copy->addKeyMetadata = this->addKeyMetadata;
+    copy->isSkipScan = this->isSkipScan;
     copy->bounds = this->bounds;
     copy->queryCollator = this->queryCollator;
 
@@ -843,7 +853,7 @@ bool filtersAreEquivalent(const MatchExpression* lhs, const MatchExpression* rhs
 bool IndexScanNode::operator==(const IndexScanNode& other) const {
     return filtersAreEquivalent(filter.get(), other.filter.get()) && index == other.index &&
         direction == other.direction && addKeyMetadata == other.addKeyMetadata &&
-        bounds == other.bounds;
+        isSkipScan == other.isSkipScan && bounds == other.bounds;
 }
 
 //
@@ -277,6 +277,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, the parent of this node is a top-k sort by text score, so only the 'limit'
+    // documents with the highest text scores are needed.
+    size_t limit = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -507,6 +511,10 @@ struct IndexScanNode : public QuerySolutionNode {
 
     bool shouldDedup = false;
 
+    // True if the leading fields of the index are unconstrained and the scan seeks past each of
+    // their distinct values to the bounds of the fields that follow.
+    bool isSkipScan = false;
+
     IndexBounds bounds;
 
     const CollatorInterface* queryCollator;
@@ -56,6 +56,7 @@
 #include "mongo/db/exec/text.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
@@ -65,6 +66,43 @@ namespace mongo {
 using std::unique_ptr;
 using stdx::make_unique;
 
+namespace {
+
+/**
+ * Returns whether the order of the results of 'target' matters to the plan rooted at 'node', or
+ * boost::none if 'target' is not in that plan. The order only does not matter if it is discarded
+ * by a blocking sort before any stage that depends on it.
+ */
+boost::optional<bool> orderMatters(const QuerySolutionNode* node,
+                                   const QuerySolutionNode* target) {
+    if (node == target) {
+        return true;
+    }
+
+    for (auto&& child : node->children) {
+        auto childOrderMatters = orderMatters(child, target);
+        if (!childOrderMatters) {
+            continue;
+        }
+
+        switch (node->getType()) {
+            case STAGE_SORT:
+                return false;
+            case STAGE_FETCH:
+            case STAGE_PROJECTION:
+            case STAGE_SHARDING_FILTER:
+            case STAGE_SORT_KEY_GENERATOR:
+                return childOrderMatters;
+            default:
+                return true;
+        }
+    }
+
+    return boost::none;
+}
+
+}  // namespace
+
 PlanStage* buildStages(OperationContext* opCtx,
                        Collection* collection,
                        const CanonicalQuery& cq,
@@ -106,6 +144,7 @@ PlanStage* buildStages(OperationContext* opCtx,
             params.direction = ixn->direction;
             params.addKeyMetadata = ixn->addKeyMetadata;
             params.shouldDedup = ixn->shouldDedup;
+            params.isSkipScan = ixn->isSkipScan;
             return new IndexScan(opCtx, std::move(params), ws, ixn->filter.get());
         }
         case STAGE_FETCH: {
@@ -114,7 +153,11 @@ PlanStage* buildStages(OperationContext* opCtx,
             if (nullptr == childStage) {
                 return nullptr;
             }
-            return new FetchStage(opCtx, ws, childStage, fn->filter.get(), collection);
+            const size_t batchSize = std::max(internalQueryExecFetchBatchSize.load(), 0);
+            const bool preserveOrder =
+                batchSize <= 1 || orderMatters(qsol.root.get(), fn).value_or(true);
+            return new FetchStage(
+                opCtx, ws, childStage, fn->filter.get(), collection, batchSize, preserveOrder);
         }
         case STAGE_SORT: {
             const SortNode* sn = static_cast<const SortNode*>(root);
@@ -290,6 +333,7 @@ PlanStage* buildStages(OperationContext* opCtx,
             // fail in this case (this improvement is being tracked by SERVER-21510).
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = (cq.getProj() && cq.getProj()->wantTextScore());
+            params.limit = node->limit;
             return new TextStage(opCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
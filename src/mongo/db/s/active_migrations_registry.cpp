@@ -46,7 +46,7 @@ const auto getRegistry = ServiceContext::declareDecoration<ActiveMigrationsRegis
 ActiveMigrationsRegistry::ActiveMigrationsRegistry() = default;
 
 ActiveMigrationsRegistry::~ActiveMigrationsRegistry() {
-    invariant(!_activeMoveChunkState);
+    invariant(_activeMoveChunkStates.empty());
 }
 
 ActiveMigrationsRegistry& ActiveMigrationsRegistry::get(ServiceContext* service) {
@@ -60,68 +60,57 @@ ActiveMigrationsRegistry& ActiveMigrationsRegistry::get(OperationContext* opCtx)
 StatusWith<ScopedDonateChunk> ActiveMigrationsRegistry::registerDonateChunk(
     const MoveChunkRequest& args) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    if (_activeReceiveChunkState) {
-        return _activeReceiveChunkState->constructErrorStatus();
-    }
+    const auto& nss = args.getNss();
 
-    if (_activeMoveChunkState) {
-        if (_activeMoveChunkState->args == args) {
-            return {ScopedDonateChunk(nullptr, false, _activeMoveChunkState->notification)};
-        }
+    auto it = _activeMoveChunkStates.find(nss);
+    if (it != _activeMoveChunkStates.end() && it->second.args == args) {
+        return {ScopedDonateChunk(nullptr, false, it->second.notification, nss)};
+    }
 
-        return _activeMoveChunkState->constructErrorStatus();
+    auto status = _checkNoMigrationOf(lk, nss);
+    if (!status.isOK()) {
+        return status;
     }
 
-    _activeMoveChunkState.emplace(args);
+    it = _activeMoveChunkStates.emplace(nss, args).first;
 
-    return {ScopedDonateChunk(this, true, _activeMoveChunkState->notification)};
+    return {ScopedDonateChunk(this, true, it->second.notification, nss)};
 }
 
 StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
     const NamespaceString& nss, const ChunkRange& chunkRange, const ShardId& fromShardId) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    if (_activeReceiveChunkState) {
-        return _activeReceiveChunkState->constructErrorStatus();
-    }
 
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->constructErrorStatus();
+    auto status = _checkNoMigrationOf(lk, nss);
+    if (!status.isOK()) {
+        return status;
     }
 
-    _activeReceiveChunkState.emplace(nss, chunkRange, fromShardId);
+    _activeReceiveChunkStates.emplace(nss, ActiveReceiveChunkState(nss, chunkRange, fromShardId));
 
-    return {ScopedReceiveChunk(this)};
+    return {ScopedReceiveChunk(this, nss)};
 }
 
-boost::optional<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
+std::vector<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNamespaces() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->args.getNss();
+    std::vector<NamespaceString> namespaces;
+    for (const auto& entry : _activeMoveChunkStates) {
+        namespaces.push_back(entry.first);
     }
 
-    return boost::none;
+    return namespaces;
 }
 
 BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContext* opCtx) {
-    boost::optional<NamespaceString> nss;
-    {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
-
-        if (_activeMoveChunkState) {
-            nss = _activeMoveChunkState->args.getNss();
-        }
-    }
-
     // The state of the MigrationSourceManager could change between taking and releasing the mutex
-    // above and then taking the collection lock here, but that's fine because it isn't important to
+    // and then taking the collection lock here, but that's fine because it isn't important to
     // return information on a migration that just ended or started. This is just best effort and
     // desireable for reporting, and then diagnosing, migrations that are stuck.
-    if (nss) {
+    for (const auto& nss : getActiveDonateChunkNamespaces()) {
         // Lock the collection so nothing changes while we're getting the migration report.
-        AutoGetCollection autoColl(opCtx, nss.get(), MODE_IS);
+        AutoGetCollection autoColl(opCtx, nss, MODE_IS);
 
-        if (auto msm =
-                MigrationSourceManager::get(CollectionShardingRuntime::get(opCtx, nss.get()))) {
+        if (auto msm = MigrationSourceManager::get(CollectionShardingRuntime::get(opCtx, nss))) {
             return msm->getMigrationStatusReport();
         }
     }
@@ -129,16 +118,28 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     return BSONObj();
 }
 
-void ActiveMigrationsRegistry::_clearDonateChunk() {
+Status ActiveMigrationsRegistry::_checkNoMigrationOf(WithLock, const NamespaceString& nss) const {
+    auto moveIt = _activeMoveChunkStates.find(nss);
+    if (moveIt != _activeMoveChunkStates.end()) {
+        return moveIt->second.constructErrorStatus();
+    }
+
+    auto receiveIt = _activeReceiveChunkStates.find(nss);
+    if (receiveIt != _activeReceiveChunkStates.end()) {
+        return receiveIt->second.constructErrorStatus();
+    }
+
+    return Status::OK();
+}
+
+void ActiveMigrationsRegistry::_clearDonateChunk(const NamespaceString& nss) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    invariant(_activeMoveChunkState);
-    _activeMoveChunkState.reset();
+    invariant(_activeMoveChunkStates.erase(nss) == 1);
 }
 
-void ActiveMigrationsRegistry::_clearReceiveChunk() {
+void ActiveMigrationsRegistry::_clearReceiveChunk(const NamespaceString& nss) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    invariant(_activeReceiveChunkState);
-    _activeReceiveChunkState.reset();
+    invariant(_activeReceiveChunkStates.erase(nss) == 1);
 }
 
 Status ActiveMigrationsRegistry::ActiveMoveChunkState::constructErrorStatus() const {
@@ -165,16 +166,18 @@ Status ActiveMigrationsRegistry::ActiveReceiveChunkState::constructErrorStatus()
 
 ScopedDonateChunk::ScopedDonateChunk(ActiveMigrationsRegistry* registry,
                                      bool shouldExecute,
-                                     std::shared_ptr<Notification<Status>> completionNotification)
+                                     std::shared_ptr<Notification<Status>> completionNotification,
+                                     NamespaceString nss)
     : _registry(registry),
       _shouldExecute(shouldExecute),
-      _completionNotification(std::move(completionNotification)) {}
+      _completionNotification(std::move(completionNotification)),
+      _nss(std::move(nss)) {}
 
 ScopedDonateChunk::~ScopedDonateChunk() {
     if (_registry && _shouldExecute) {
         // If this is a newly started migration the caller must always signal on completion
         invariant(*_completionNotification);
-        _registry->_clearDonateChunk();
+        _registry->_clearDonateChunk(_nss);
     }
 }
 
@@ -188,6 +191,7 @@ ScopedDonateChunk& ScopedDonateChunk::operator=(ScopedDonateChunk&& other) {
         other._registry = nullptr;
         _shouldExecute = other._shouldExecute;
         _completionNotification = std::move(other._completionNotification);
+        _nss = std::move(other._nss);
     }
 
     return *this;
@@ -203,11 +207,12 @@ Status ScopedDonateChunk::waitForCompletion(OperationContext* opCtx) {
     return _completionNotification->get(opCtx);
 }
 
-ScopedReceiveChunk::ScopedReceiveChunk(ActiveMigrationsRegistry* registry) : _registry(registry) {}
+ScopedReceiveChunk::ScopedReceiveChunk(ActiveMigrationsRegistry* registry, NamespaceString nss)
+    : _registry(registry), _nss(std::move(nss)) {}
 
 ScopedReceiveChunk::~ScopedReceiveChunk() {
     if (_registry) {
-        _registry->_clearReceiveChunk();
+        _registry->_clearReceiveChunk(_nss);
     }
 }
 
@@ -219,6 +224,7 @@ ScopedReceiveChunk& ScopedReceiveChunk::operator=(ScopedReceiveChunk&& other) {
     if (&other != this) {
         _registry = other._registry;
         other._registry = nullptr;
+        _nss = std::move(other._nss);
     }
 
     return *this;
@@ -29,6 +29,8 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <map>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/s/migration_session_id.h"
@@ -36,6 +38,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/notification.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -46,8 +49,12 @@ template <typename T>
 class StatusWith;
 
 /**
- * Thread-safe object that keeps track of the active migrations running on a node and limits them
- * to only one per shard. There is only one instance of this object per shard.
+ * Thread-safe object that keeps track of the active migrations running on a node. A shard may
+ * donate and receive chunks of several collections at once, but takes part in at most one migration
+ * of each collection, since a collection has a single MigrationSourceManager and the donor and
+ * recipient sides of a collection's metadata must not change under each other. The number of
+ * concurrent migrations is left to the balancer. There is only one instance of this object per
+ * shard.
  */
 class ActiveMigrationsRegistry {
     MONGO_DISALLOW_COPYING(ActiveMigrationsRegistry);
@@ -60,22 +67,23 @@ public:
     static ActiveMigrationsRegistry& get(OperationContext* opCtx);
 
     /**
-     * If there are no migrations running on this shard, registers an active migration with the
-     * specified arguments. Returns a ScopedDonateChunk, which must be signaled by the
-     * caller before it goes out of scope.
+     * If there are no migrations of the collection running on this shard, registers an active
+     * migration with the specified arguments. Returns a ScopedDonateChunk, which must be signaled
+     * by the caller before it goes out of scope.
      *
-     * If there is an active migration already running on this shard and it has the exact same
-     * arguments, returns a ScopedDonateChunk. The ScopedDonateChunk can be used to join the
-     * already running migration.
+     * If there is an active donation of the collection already running on this shard and it has
+     * the exact same arguments, returns a ScopedDonateChunk. The ScopedDonateChunk can be used to
+     * join the already running migration.
      *
      * Otherwise returns a ConflictingOperationInProgress error.
      */
     StatusWith<ScopedDonateChunk> registerDonateChunk(const MoveChunkRequest& args);
 
     /**
-     * If there are no migrations running on this shard, registers an active receive operation with
-     * the specified session id and returns a ScopedReceiveChunk. The ScopedReceiveChunk will
-     * unregister the migration when the ScopedReceiveChunk goes out of scope.
+     * If there are no migrations of the collection running on this shard, registers an active
+     * receive operation for the specified chunk and returns a ScopedReceiveChunk. The
+     * ScopedReceiveChunk will unregister the migration when the ScopedReceiveChunk goes out of
+     * scope.
      *
      * Otherwise returns a ConflictingOperationInProgress error.
      */
@@ -84,16 +92,16 @@ public:
                                                         const ShardId& fromShardId);
 
     /**
-     * If a migration has been previously registered through a call to registerDonateChunk, returns
-     * that namespace. Otherwise returns boost::none.
+     * Returns the namespaces of the migrations previously registered through calls to
+     * registerDonateChunk, in namespace order.
      */
-    boost::optional<NamespaceString> getActiveDonateChunkNss();
+    std::vector<NamespaceString> getActiveDonateChunkNamespaces();
 
     /**
-     * Returns a report on the active migration if there currently is one. Otherwise, returns an
-     * empty BSONObj.
+     * Returns a report on an active donation if there currently is one, the one of the first
+     * namespace if there are several. Otherwise, returns an empty BSONObj.
      *
-     * Takes an IS lock on the namespace of the active migration, if one is active.
+     * Takes an IS lock on the namespace of each active donation until one is reported.
      */
     BSONObj getActiveMigrationStatusReport(OperationContext* opCtx);
 
@@ -138,26 +146,32 @@ private:
         ShardId fromShardId;
     };
 
+    /**
+     * Returns the error for a new migration of 'nss' if it conflicts with an active donation or
+     * receive of the same collection. Otherwise returns OK.
+     */
+    Status _checkNoMigrationOf(WithLock, const NamespaceString& nss) const;
+
     /**
      * Unregisters a previously registered namespace with an ongoing migration. Must only be called
      * if a previous call to registerDonateChunk has succeeded.
      */
-    void _clearDonateChunk();
+    void _clearDonateChunk(const NamespaceString& nss);
 
     /**
      * Unregisters a previously registered incoming migration. Must only be called if a previous
      * call to registerReceiveChunk has succeeded.
      */
-    void _clearReceiveChunk();
+    void _clearReceiveChunk(const NamespaceString& nss);
 
     // Protects the state below
     stdx::mutex _mutex;
 
-    // If there is an active moveChunk operation, this field contains the original request
-    boost::optional<ActiveMoveChunkState> _activeMoveChunkState;
+    // The original requests of the active moveChunk operations, by namespace
+    std::map<NamespaceString, ActiveMoveChunkState> _activeMoveChunkStates;
 
-    // If there is an active chunk receive operation, this field contains the original session id
-    boost::optional<ActiveReceiveChunkState> _activeReceiveChunkState;
+    // The active chunk receive operations, by namespace
+    std::map<NamespaceString, ActiveReceiveChunkState> _activeReceiveChunkStates;
 };
 
 /**
@@ -171,7 +185,8 @@ class ScopedDonateChunk {
 public:
     ScopedDonateChunk(ActiveMigrationsRegistry* registry,
                       bool shouldExecute,
-                      std::shared_ptr<Notification<Status>> completionNotification);
+                      std::shared_ptr<Notification<Status>> completionNotification,
+                      NamespaceString nss);
     ~ScopedDonateChunk();
 
     ScopedDonateChunk(ScopedDonateChunk&&);
@@ -212,6 +227,9 @@ private:
 
     // This is the future, which will be signaled at the end of a migration
     std::shared_ptr<Notification<Status>> _completionNotification;
+
+    // Namespace of the migration, under which it is registered
+    NamespaceString _nss;
 };
 
 /**
@@ -222,7 +240,7 @@ class ScopedReceiveChunk {
     MONGO_DISALLOW_COPYING(ScopedReceiveChunk);
 
 public:
-    ScopedReceiveChunk(ActiveMigrationsRegistry* registry);
+    ScopedReceiveChunk(ActiveMigrationsRegistry* registry, NamespaceString nss);
     ~ScopedReceiveChunk();
 
     ScopedReceiveChunk(ScopedReceiveChunk&&);
@@ -231,6 +249,9 @@ public:
 private:
     // Registry from which to unregister the migration. Not owned.
     ActiveMigrationsRegistry* _registry;
+
+    // Namespace of the migration, under which it is registered
+    NamespaceString _nss;
 };
 
 }  // namespace mongo
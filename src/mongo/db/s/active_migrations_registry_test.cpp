@@ -46,7 +46,9 @@ protected:
     ActiveMigrationsRegistry _registry;
 };
 
-MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss) {
+MoveChunkRequest createMoveChunkRequest(
+    const NamespaceString& nss,
+    const ChunkRange& range = ChunkRange(BSON("Key" << -100), BSON("Key" << 100))) {
     const ChunkVersion chunkVersion(1, 2, OID::gen());
 
     BSONObjBuilder builder;
@@ -57,7 +59,7 @@ MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss) {
         assertGet(ConnectionString::parse("TestConfigRS/CS1:12345,CS2:12345,CS3:12345")),
         ShardId("shard0001"),
         ShardId("shard0002"),
-        ChunkRange(BSON("Key" << -100), BSON("Key" << 100)),
+        range,
         1024,
         MigrationSecondaryThrottleOptions::create(MigrationSecondaryThrottleOptions::kOff),
         true);
@@ -79,32 +81,74 @@ TEST_F(MoveChunkRegistration, ScopedDonateChunkMoveConstructorAndAssignment) {
     originalScopedDonateChunk.signalComplete(Status::OK());
 }
 
-TEST_F(MoveChunkRegistration, GetActiveMigrationNamespace) {
-    ASSERT(!_registry.getActiveDonateChunkNss());
+TEST_F(MoveChunkRegistration, GetActiveMigrationNamespaces) {
+    ASSERT(_registry.getActiveDonateChunkNamespaces().empty());
 
-    const NamespaceString nss("TestDB", "TestColl");
+    const NamespaceString nss1("TestDB", "TestColl1");
+    const NamespaceString nss2("TestDB", "TestColl2");
 
-    auto originalScopedDonateChunk =
-        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
+    auto scopedDonateChunk2 =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss2)));
+    auto scopedDonateChunk1 =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss1)));
 
-    ASSERT_EQ(nss.ns(), _registry.getActiveDonateChunkNss()->ns());
+    const auto namespaces = _registry.getActiveDonateChunkNamespaces();
+    ASSERT_EQ(2U, namespaces.size());
+    ASSERT_EQ(nss1.ns(), namespaces[0].ns());
+    ASSERT_EQ(nss2.ns(), namespaces[1].ns());
 
-    // Need to signal the registered migration so the destructor doesn't invariant
-    originalScopedDonateChunk.signalComplete(Status::OK());
+    // Need to signal the registered migrations so the destructors don't invariant
+    scopedDonateChunk1.signalComplete(Status::OK());
+    scopedDonateChunk2.signalComplete(Status::OK());
+
+    ASSERT(_registry.getActiveDonateChunkNamespaces().empty());
 }
 
-TEST_F(MoveChunkRegistration, SecondMigrationReturnsConflictingOperationInProgress) {
-    auto originalScopedDonateChunk = assertGet(_registry.registerDonateChunk(
+TEST_F(MoveChunkRegistration, MigrationsOfDifferentCollectionsCanRunConcurrently) {
+    auto scopedDonateChunk = assertGet(_registry.registerDonateChunk(
         createMoveChunkRequest(NamespaceString("TestDB", "TestColl1"))));
+    ASSERT(scopedDonateChunk.mustExecute());
+
+    auto secondScopedDonateChunk = assertGet(_registry.registerDonateChunk(
+        createMoveChunkRequest(NamespaceString("TestDB", "TestColl2"))));
+    ASSERT(secondScopedDonateChunk.mustExecute());
+
+    auto scopedReceiveChunk =
+        assertGet(_registry.registerReceiveChunk(NamespaceString("TestDB", "TestColl3"),
+                                                 ChunkRange(BSON("Key" << 0), BSON("Key" << 10)),
+                                                 ShardId("shard0001")));
+
+    scopedDonateChunk.signalComplete(Status::OK());
+    secondScopedDonateChunk.signalComplete(Status::OK());
+}
+
+TEST_F(MoveChunkRegistration, SecondMigrationOfCollectionReturnsConflictingOperationInProgress) {
+    const NamespaceString nss("TestDB", "TestColl");
+
+    auto originalScopedDonateChunk =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
 
     auto secondScopedDonateChunkStatus = _registry.registerDonateChunk(
-        createMoveChunkRequest(NamespaceString("TestDB", "TestColl2")));
+        createMoveChunkRequest(nss, ChunkRange(BSON("Key" << 100), BSON("Key" << 200))));
     ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
               secondScopedDonateChunkStatus.getStatus());
 
     originalScopedDonateChunk.signalComplete(Status::OK());
 }
 
+TEST_F(MoveChunkRegistration, ReceiveOfDonatedCollectionReturnsConflictingOperationInProgress) {
+    const NamespaceString nss("TestDB", "TestColl");
+
+    auto originalScopedDonateChunk =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
+
+    auto scopedReceiveChunkStatus = _registry.registerReceiveChunk(
+        nss, ChunkRange(BSON("Key" << 100), BSON("Key" << 200)), ShardId("shard0001"));
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress, scopedReceiveChunkStatus.getStatus());
+
+    originalScopedDonateChunk.signalComplete(Status::OK());
+}
+
 TEST_F(MoveChunkRegistration, SecondMigrationWithSameArgumentsJoinsFirst) {
     auto originalScopedDonateChunk = assertGet(_registry.registerDonateChunk(
         createMoveChunkRequest(NamespaceString("TestDB", "TestColl"))));
@@ -33,10 +33,12 @@
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy_impl.h"
 
 #include <algorithm>
+#include <map>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog/type_collection.h"
 #include "mongo/s/catalog/type_tags.h"
@@ -54,6 +56,17 @@ using std::shared_ptr;
 using std::unique_ptr;
 using std::vector;
 
+// Number of migrations, each of a different collection, which a balancer round may schedule
+// to or from the same shard.
+MONGO_EXPORT_SERVER_PARAMETER(maxConcurrentMigrationsPerShard, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 16) {
+            return Status(ErrorCodes::BadValue,
+                          "maxConcurrentMigrationsPerShard must be between 1 and 16");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 /**
@@ -254,7 +267,11 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     }
 
     MigrateInfoVector candidateChunks;
-    std::set<ShardId> usedShards;
+
+    // Number of migrations scheduled so far to or from each shard. Within a collection a shard
+    // takes part in at most one migration, so only the collections are concurrent.
+    std::map<ShardId, int> migrationsPerShard;
+    const int maxMigrationsPerShard = maxConcurrentMigrationsPerShard.load();
 
     std::shuffle(collections.begin(), collections.end(), _random);
 
@@ -270,6 +287,13 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        std::set<ShardId> usedShards;
+        for (const auto& shardMigrations : migrationsPerShard) {
+            if (shardMigrations.second >= maxMigrationsPerShard) {
+                usedShards.insert(shardMigrations.first);
+            }
+        }
+
         auto candidatesStatus =
             _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
@@ -281,6 +305,11 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        for (const auto& migrateInfo : candidatesStatus.getValue()) {
+            ++migrationsPerShard[migrateInfo.from];
+            ++migrationsPerShard[migrateInfo.to];
+        }
+
         candidateChunks.insert(candidateChunks.end(),
                                std::make_move_iterator(candidatesStatus.getValue().begin()),
                                std::make_move_iterator(candidatesStatus.getValue().end()));
@@ -48,16 +48,19 @@
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -69,11 +72,32 @@ MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchDelayMS, int, 20)
         return Status::OK();
     });
 
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterMaxReplicationLagSecs, int, 10)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "rangeDeleterMaxReplicationLagSecs must not be negative");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using Deletion = CollectionRangeDeleter::Deletion;
 using DeleteNotification = CollectionRangeDeleter::DeleteNotification;
 
+// Bounds on the delay between batches while range deletion is being throttled.
+const Milliseconds kMinThrottledDelay{100};
+const Milliseconds kMaxThrottledDelay{10 * 1000};
+
+// Factor by which the delay between batches grows while the storage engine cache is under
+// pressure.
+const double kCachePressureBackoff{4};
+
+// Bound on the size of the documents deleted in one batch, so that a batch of large documents does
+// not need more cache than its storage transaction can hold.
+const long long kMaxRangeDeleterBatchBytes = 16 * 1024 * 1024;
+
 const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 WriteConcernOptions::SyncMode::UNSET,
                                                 WriteConcernOptions::kWriteConcernTimeoutSharding);
@@ -91,6 +115,52 @@ boost::optional<DeleteNotification> checkOverlap(std::list<Deletion> const& dele
     return boost::none;
 }
 
+/**
+ * Returns how long to wait before the next batch of range deletions. This is
+ * rangeDeleterBatchDelayMS, unless the majority commit point lags too far behind this node's
+ * writes or the storage engine cache is under pressure, in which case the delay grows with the
+ * lag or pressure so that range deletion yields to user traffic.
+ */
+Milliseconds getRangeDeleterBatchDelay(OperationContext* opCtx) {
+    const long long delayMillis = rangeDeleterBatchDelayMS.load();
+    double backoff = 1;
+
+    const int maxLagSecs = rangeDeleterMaxReplicationLagSecs.load();
+    auto* const replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (maxLagSecs > 0 &&
+        replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet) {
+        const auto lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp().getSecs();
+        const auto lastCommitted = replCoord->getLastCommittedOpTime().getTimestamp().getSecs();
+        if (lastApplied > lastCommitted + maxLagSecs) {
+            backoff *= double(lastApplied - lastCommitted) / maxLagSecs;
+        }
+    }
+
+    // Failing to read the cache statistics must not fail the range deletion, so it is then taken
+    // as no pressure.
+    bool cacheUnderPressure = false;
+    try {
+        cacheUnderPressure =
+            opCtx->getServiceContext()->getStorageEngine()->isCacheUnderPressure(opCtx);
+    } catch (const DBException& ex) {
+        LOG(1) << "Unable to check whether the storage engine cache is under pressure"
+               << causedBy(redact(ex));
+    }
+
+    if (cacheUnderPressure) {
+        backoff *= kCachePressureBackoff;
+    }
+
+    if (backoff == 1) {
+        return Milliseconds(delayMillis);
+    }
+
+    ShardingStatistics::get(opCtx).countRangeDeletionThrottled.addAndFetch(1);
+    const double throttledMillis =
+        std::max(delayMillis, durationCount<Milliseconds>(kMinThrottledDelay)) * backoff;
+    return std::min(Milliseconds(static_cast<long long>(throttledMillis)), kMaxThrottledDelay);
+}
+
 }  // namespace
 
 CollectionRangeDeleter::CollectionRangeDeleter() = default;
@@ -254,6 +324,8 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
             }
         }();
 
+        const auto delay = getRangeDeleterBatchDelay(opCtx);
+
         // Get the lock again to finish off this range (including notifying, if necessary).
         // Don't allow lock interrupts while cleaning up.
         UninterruptibleLockGuard noInterrupt(opCtx->lockState());
@@ -289,7 +361,7 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
                    << redact(self->_orphans.front().range.toString()) << " next.";
         }
 
-        return Date_t::now() + stdx::chrono::milliseconds{rangeDeleterBatchDelayMS.load()};
+        return Date_t::now() + delay;
     }
 
     invariant(range);
@@ -297,7 +369,7 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
     invariant(wrote.getValue() > 0);
 
     notification.abandon();
-    return Date_t::now() + stdx::chrono::milliseconds{rangeDeleterBatchDelayMS.load()};
+    return Date_t::now() + getRangeDeleterBatchDelay(opCtx);
 }
 
 StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
@@ -354,8 +426,18 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
     auto exec = InternalPlanner::indexScan(
         opCtx, collection, descriptor, min, max, halfOpen, manual, forward, fetch);
 
-    int numDeleted = 0;
-    do {
+    Timer timer;
+
+    // Look up the whole batch first, and then delete it in a single storage transaction, which
+    // costs much less than committing every delete on its own.
+    struct DocToDelete {
+        RecordId rloc;
+        BSONObj obj;  // Only kept if the documents are to be saved before deletion.
+    };
+    std::vector<DocToDelete> batch;
+    long long batchBytes = 0;
+    while (static_cast<int>(batch.size()) < maxToDelete &&
+           batchBytes < kMaxRangeDeleterBatchBytes) {
         RecordId rloc;
         BSONObj obj;
         PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
@@ -371,28 +453,50 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
         }
         invariant(PlanExecutor::ADVANCED == state);
 
-        exec->saveState();
-        writeConflictRetry(opCtx, "delete range", nss.ns(), [&] {
-            WriteUnitOfWork wuow(opCtx);
-            if (saver) {
-                uassertStatusOK(saver->goingToDelete(obj));
+        batchBytes += obj.objsize();
+        batch.push_back({rloc, saver ? obj.getOwned() : BSONObj()});
+    }
+    exec.reset();
+
+    if (batch.empty()) {
+        return 0;
+    }
+
+    // The documents were found in shard key order. Deleting them in RecordId order instead visits
+    // the record store sequentially.
+    std::sort(batch.begin(), batch.end(), [](const DocToDelete& lhs, const DocToDelete& rhs) {
+        return lhs.rloc < rhs.rloc;
+    });
+
+    if (saver) {
+        for (const auto& doc : batch) {
+            uassertStatusOK(saver->goingToDelete(doc.obj));
+        }
+    }
+
+    bool isRetry = false;
+    writeConflictRetry(opCtx, "delete range", nss.ns(), [&] {
+        WriteUnitOfWork wuow(opCtx);
+        for (const auto& doc : batch) {
+            // After a write conflict the snapshot in which the documents were found is gone, and
+            // the conflicting writer may have deleted some of them.
+            Snapshotted<BSONObj> unused;
+            if (isRetry && !collection->findDoc(opCtx, doc.rloc, &unused)) {
+                continue;
             }
-            collection->deleteDocument(opCtx, kUninitializedStmtId, rloc, nullptr, true);
-            wuow.commit();
-        });
-        auto restoreStateStatus = exec->restoreState();
-        if (!restoreStateStatus.isOK()) {
-            warning() << "error restoring cursor state while trying to delete " << redact(min)
-                      << " to " << redact(max) << " in " << nss
-                      << ", stats: " << Explain::getWinningPlanStats(exec.get()) << ": "
-                      << redact(restoreStateStatus);
-            break;
+            collection->deleteDocument(opCtx, kUninitializedStmtId, doc.rloc, nullptr, true);
         }
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+        isRetry = true;
+        wuow.commit();
+    });
 
-    } while (++numDeleted < maxToDelete);
+    auto& shardingStatistics = ShardingStatistics::get(opCtx);
+    shardingStatistics.countDocsDeletedOnDonor.addAndFetch(batch.size());
+    shardingStatistics.countBytesDeletedOnDonor.addAndFetch(batchBytes);
+    shardingStatistics.countRangeDeletionBatches.addAndFetch(1);
+    shardingStatistics.totalRangeDeletionTimeMillis.addAndFetch(timer.millis());
 
-    return numDeleted;
+    return batch.size();
 }
 
 auto CollectionRangeDeleter::overlaps(ChunkRange const& range) const
@@ -39,6 +39,7 @@
 #include "mongo/db/keypattern.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/chunk_version.h"
@@ -231,6 +232,39 @@ TEST_F(CollectionRangeDeleterTest, MultipleCleanupNextRangeCalls) {
     ASSERT_EQUALS(0ULL, dbclient.count(kAdminSysVer.ns(), BSON(kShardKey << "startRangeDeletion")));
 }
 
+// Tests that a batch of deletions is reported in the sharding statistics.
+TEST_F(CollectionRangeDeleterTest, BatchedDeletionUpdatesStatistics) {
+    CollectionRangeDeleter rangeDeleter;
+    DBDirectClient dbclient(operationContext());
+    long long bytesInRange = 0;
+    for (int i = 1; i <= 5; ++i) {
+        const BSONObj doc = BSON("_id" << i << kShardKey << i);
+        bytesInRange += doc.objsize();
+        dbclient.insert(kNss.toString(), doc);
+    }
+    ASSERT_EQUALS(5ULL, dbclient.count(kNss.toString(), BSON(kShardKey << LT << 10)));
+
+    std::list<Deletion> ranges;
+    auto deletion = Deletion{ChunkRange(BSON(kShardKey << 0), BSON(kShardKey << 10)), Date_t{}};
+    ranges.emplace_back(std::move(deletion));
+    rangeDeleter.add(std::move(ranges));
+
+    auto& shardingStatistics = ShardingStatistics::get(operationContext());
+    const auto docsBefore = shardingStatistics.countDocsDeletedOnDonor.load();
+    const auto bytesBefore = shardingStatistics.countBytesDeletedOnDonor.load();
+    const auto batchesBefore = shardingStatistics.countRangeDeletionBatches.load();
+
+    ASSERT_TRUE(next(rangeDeleter, 100));
+    ASSERT_EQUALS(0ULL, dbclient.count(kNss.toString(), BSON(kShardKey << LT << 10)));
+
+    ASSERT_EQ(docsBefore + 5, shardingStatistics.countDocsDeletedOnDonor.load());
+    ASSERT_EQ(bytesBefore + bytesInRange, shardingStatistics.countBytesDeletedOnDonor.load());
+    ASSERT_EQ(batchesBefore + 1, shardingStatistics.countRangeDeletionBatches.load());
+
+    ASSERT_TRUE(next(rangeDeleter, 100));
+    ASSERT_FALSE(next(rangeDeleter, 100));
+}
+
 // Tests the case that there are two ranges to clean, each containing multiple documents.
 TEST_F(CollectionRangeDeleterTest, MultipleDocumentsInMultipleRangesToClean) {
     CollectionRangeDeleter rangeDeleter;
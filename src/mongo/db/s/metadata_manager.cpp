@@ -38,11 +38,13 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/range_arithmetic.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/grid.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/time_support.h"
 
 // MetadataManager maintains pointers to CollectionMetadata objects in a member list named
@@ -108,6 +110,27 @@
 //  new entries are pushed onto the back, popped off the front.
 
 namespace mongo {
+
+namespace {
+
+// Every batch of the range deleter is deleted in a single WriteUnitOfWork, which must stay small
+// enough for the storage engine to hold in cache.
+const int kMaxRangeDeleterBatchSize = 10000;
+
+}  // namespace
+
+// Number of documents the range deleter deletes in one storage transaction. 0 means to use
+// internalQueryExecYieldIterations, up to kMaxRangeDeleterBatchSize.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > kMaxRangeDeleterBatchSize) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "rangeDeleterBatchSize must be between 0 and "
+                                        << kMaxRangeDeleterBatchSize);
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using TaskExecutor = executor::TaskExecutor;
@@ -147,7 +170,11 @@ void scheduleCleanup(executor::TaskExecutor* executor,
             auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
             auto opCtx = uniqueOpCtx.get();
 
-            const int maxToDelete = std::max(int(internalQueryExecYieldIterations.load()), 1);
+            const int batchSize = rangeDeleterBatchSize.load();
+            const int maxToDelete = batchSize
+                ? batchSize
+                : std::min(std::max(int(internalQueryExecYieldIterations.load()), 1),
+                           kMaxRangeDeleterBatchSize);
 
             MONGO_FAIL_POINT_PAUSE_WHILE_SET(suspendRangeDeletion);
 
@@ -448,32 +448,65 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::lock_guard<stdx::mutex> sl(_mutex);
-
-    std::set<RecordId>::iterator it;
+    const int arrSizeAtStart = arrBuilder->arrSize();
+
+    // Claim the record ids of about as many documents as fit in the batch, so that the documents
+    // can be read without holding '_mutex'. A recipient may clone over several streams, and
+    // concurrent requests then read disjoint sets of documents in parallel. Claim more if all the
+    // claimed documents have been deleted in the meantime, because an empty batch would tell the
+    // recipient that the clone is done.
+    std::vector<RecordId> locs;
+    while (arrBuilder->arrSize() == arrSizeAtStart) {
+        locs.clear();
+        {
+            stdx::lock_guard<stdx::mutex> sl(_mutex);
+
+            const auto averageObjectSize = std::max<uint64_t>(_averageObjectSizeForCloneLocs, 1);
+            const auto spaceLeft = std::max(BSONObjMaxUserSize - arrBuilder->len(), 0);
+            const size_t maxLocs = spaceLeft / averageObjectSize + 1;
+
+            auto it = _cloneLocs.begin();
+            for (; it != _cloneLocs.end() && locs.size() < maxLocs; ++it) {
+                locs.push_back(*it);
+            }
+            _cloneLocs.erase(_cloneLocs.begin(), it);
+        }
 
-    for (it = _cloneLocs.begin(); it != _cloneLocs.end(); ++it) {
-        // We must always make progress in this method by at least one document because empty return
-        // indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
+        if (locs.empty()) {
             break;
         }
 
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, *it, &doc)) {
-            // Use the builder size instead of accumulating the document sizes directly so that we
-            // take into consideration the overhead of BSONArray indices.
-            if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+        auto it = locs.begin();
+        for (; it != locs.end(); ++it) {
+            // We must always make progress in this method by at least one document because empty
+            // return indicates there is no more initial clone data.
+            if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
                 break;
             }
 
-            arrBuilder->append(doc.value());
-            ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+            Snapshotted<BSONObj> doc;
+            if (collection->findDoc(opCtx, *it, &doc)) {
+                // Use the builder size instead of accumulating the document sizes directly so that
+                // we take into consideration the overhead of BSONArray indices.
+                if (arrBuilder->arrSize() &&
+                    (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+                    break;
+                }
+
+                arrBuilder->append(doc.value());
+                ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+            }
         }
-    }
 
-    _cloneLocs.erase(_cloneLocs.begin(), it);
+        // Give back the record ids which did not make it into the batch. We only stop early once
+        // the batch is not empty, so the stream which made this request comes back for more
+        // before it finishes.
+        if (it != locs.end()) {
+            stdx::lock_guard<stdx::mutex> sl(_mutex);
+            _cloneLocs.insert(it, locs.end());
+            break;
+        }
+    }
 
     return Status::OK();
 }
@@ -52,41 +52,44 @@ namespace {
 
 /**
  * Shortcut class to perform the appropriate checks and acquire the cloner associated with the
- * currently active migration. Uses the currently registered migration for this shard and ensures
- * the session ids match.
+ * currently active migration. Finds the donation registered for this shard whose cloner has the
+ * requested session id, since the shard may be donating chunks of several collections at once.
  */
 class AutoGetActiveCloner {
     MONGO_DISALLOW_COPYING(AutoGetActiveCloner);
 
 public:
     AutoGetActiveCloner(OperationContext* opCtx, const MigrationSessionId& migrationSessionId) {
-        const auto nss = ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNss();
-        uassert(ErrorCodes::NotYetInitialized, "No active migrations were found", nss);
-
-        // Once the collection is locked, the migration status cannot change
-        _autoColl.emplace(opCtx, *nss, MODE_IS);
-
-        uassert(ErrorCodes::NamespaceNotFound,
-                str::stream() << "Collection " << nss->ns() << " does not exist",
-                _autoColl->getCollection());
-
-        if (auto msm = MigrationSourceManager::get(CollectionShardingRuntime::get(opCtx, *nss))) {
-            // It is now safe to access the cloner
-            _chunkCloner = dynamic_cast<MigrationChunkClonerSourceLegacy*>(msm->getCloner());
-            invariant(_chunkCloner);
+        const auto namespaces =
+            ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNamespaces();
+        uassert(
+            ErrorCodes::NotYetInitialized, "No active migrations were found", !namespaces.empty());
+
+        for (const auto& nss : namespaces) {
+            // Once the collection is locked, the migration status cannot change
+            _autoColl.emplace(opCtx, nss, MODE_IS);
+
+            auto msm = _autoColl->getCollection()
+                ? MigrationSourceManager::get(CollectionShardingRuntime::get(opCtx, nss))
+                : nullptr;
+            if (msm) {
+                // It is now safe to access the cloner
+                _chunkCloner = dynamic_cast<MigrationChunkClonerSourceLegacy*>(msm->getCloner());
+                invariant(_chunkCloner);
+
+                if (migrationSessionId.matches(_chunkCloner->getSessionId())) {
+                    return;
+                }
+            }
 
-        } else {
-            uasserted(ErrorCodes::IllegalOperation,
-                      str::stream() << "No active migrations were found for collection "
-                                    << nss->ns());
+            _chunkCloner = nullptr;
+            _autoColl.reset();
         }
 
-        // Ensure the session ids are correct
-        uassert(ErrorCodes::IllegalOperation,
-                str::stream() << "Requested migration session id " << migrationSessionId.toString()
-                              << " does not match active session id "
-                              << _chunkCloner->getSessionId().toString(),
-                migrationSessionId.matches(_chunkCloner->getSessionId()));
+        uasserted(ErrorCodes::IllegalOperation,
+                  str::stream() << "Requested migration session id "
+                                << migrationSessionId.toString()
+                                << " does not match the session id of any active migration");
     }
 
     Database* getDb() const {
@@ -109,7 +112,7 @@ private:
     boost::optional<AutoGetCollection> _autoColl;
 
     // Contains the active cloner for the namespace
-    MigrationChunkClonerSourceLegacy* _chunkCloner;
+    MigrationChunkClonerSourceLegacy* _chunkCloner{nullptr};
 };
 
 class InitialCloneCommand : public BasicCommand {
@@ -32,6 +32,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -53,6 +54,7 @@
 #include "mongo/db/s/move_timing_helper.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/client/shard_registry.h"
@@ -65,12 +67,46 @@
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/producer_consumer_queue.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
+
+// Number of concurrent _migrateClone requests with which a recipient clones a chunk from the donor.
+MONGO_EXPORT_SERVER_PARAMETER(migrationCloneStreams, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue, "migrationCloneStreams must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
+// Number of threads with which a recipient inserts the cloned documents.
+MONGO_EXPORT_SERVER_PARAMETER(migrationCloneInserterThreads, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "migrationCloneInserterThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
-const auto getMigrationDestinationManager =
-    ServiceContext::declareDecoration<MigrationDestinationManager>();
+// Number of instances of finished migrations which are kept around, so that their donors can still
+// find out how they ended.
+const size_t kMaxInactiveMigrationDestinationManagers = 8;
+
+/**
+ * The instances of MigrationDestinationManager of a shard, by the session id of their migrations,
+ * in the order in which they were created.
+ */
+struct MigrationDestinationManagers {
+    stdx::mutex mutex;
+    std::list<std::pair<std::string, std::shared_ptr<MigrationDestinationManager>>> managers;
+};
+
+const auto getMigrationDestinationManagers =
+    ServiceContext::declareDecoration<MigrationDestinationManagers>();
 
 const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 // Note: Even though we're setting UNSET here,
@@ -216,8 +252,75 @@ MigrationDestinationManager::MigrationDestinationManager() = default;
 
 MigrationDestinationManager::~MigrationDestinationManager() = default;
 
-MigrationDestinationManager* MigrationDestinationManager::get(OperationContext* opCtx) {
-    return &getMigrationDestinationManager(opCtx->getServiceContext());
+std::shared_ptr<MigrationDestinationManager> MigrationDestinationManager::create(
+    OperationContext* opCtx, const MigrationSessionId& sessionId) {
+    auto& mdms = getMigrationDestinationManagers(opCtx->getServiceContext());
+
+    auto mdm = std::make_shared<MigrationDestinationManager>();
+
+    std::vector<std::shared_ptr<MigrationDestinationManager>> evicted;
+    {
+        stdx::lock_guard<stdx::mutex> lk(mdms.mutex);
+
+        auto numInactive = std::count_if(
+            mdms.managers.begin(), mdms.managers.end(), [](const auto& entry) {
+                return !entry.second->isActive();
+            });
+
+        // Evicts the oldest instances of finished migrations first.
+        for (auto it = mdms.managers.begin();
+             it != mdms.managers.end() &&
+             numInactive > static_cast<long>(kMaxInactiveMigrationDestinationManagers);) {
+            if (it->second->isActive()) {
+                ++it;
+                continue;
+            }
+            evicted.push_back(std::move(it->second));
+            it = mdms.managers.erase(it);
+            --numInactive;
+        }
+
+        mdms.managers.emplace_back(sessionId.toString(), mdm);
+    }
+
+    // The migrate threads of the evicted instances have finished their migrations, so they are
+    // about to exit, if they have not already.
+    for (auto& evictedMdm : evicted) {
+        if (evictedMdm->_migrateThreadHandle.joinable()) {
+            evictedMdm->_migrateThreadHandle.join();
+        }
+    }
+
+    return mdm;
+}
+
+std::shared_ptr<MigrationDestinationManager> MigrationDestinationManager::get(
+    OperationContext* opCtx, const MigrationSessionId& sessionId) {
+    auto& mdms = getMigrationDestinationManagers(opCtx->getServiceContext());
+    const auto key = sessionId.toString();
+
+    stdx::lock_guard<stdx::mutex> lk(mdms.mutex);
+    for (const auto& entry : mdms.managers) {
+        if (entry.first == key) {
+            return entry.second;
+        }
+    }
+
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<MigrationDestinationManager>> MigrationDestinationManager::getAll(
+    OperationContext* opCtx) {
+    auto& mdms = getMigrationDestinationManagers(opCtx->getServiceContext());
+
+    std::vector<std::shared_ptr<MigrationDestinationManager>> all;
+
+    stdx::lock_guard<stdx::mutex> lk(mdms.mutex);
+    for (const auto& entry : mdms.managers) {
+        all.push_back(entry.second);
+    }
+
+    return all;
 }
 
 MigrationDestinationManager::State MigrationDestinationManager::getState() const {
@@ -357,12 +460,8 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
     _sessionId = cloneRequest.getSessionId();
     _scopedReceiveChunk = std::move(scopedReceiveChunk);
 
-    // TODO: If we are here, the migrate thread must have completed, otherwise _active above
-    // would be false, so this would never block. There is no better place with the current
-    // implementation where to join the thread.
-    if (_migrateThreadHandle.joinable()) {
-        _migrateThreadHandle.join();
-    }
+    // Each instance receives a single migration, so its migrate thread is started only once.
+    invariant(!_migrateThreadHandle.joinable());
 
     _sessionMigration =
         stdx::make_unique<SessionCatalogMigrationDestination>(_fromShard, *_sessionId);
@@ -376,48 +475,124 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 void MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     stdx::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    stdx::function<BSONObj(OperationContext*)> fetchBatchFn) {
-
-    ProducerConsumerQueue<BSONObj> batches(1);
-    stdx::thread inserterThread{[&] {
-        Client::initThreadIfNotAlready("chunkInserter");
-        auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
-        auto consumerGuard = MakeGuard([&] { batches.closeConsumerEnd(); });
-        try {
-            while (true) {
-                auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
+    stdx::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numFetchers,
+    int numInserters) {
+    invariant(numFetchers >= 1 && numInserters >= 1);
+
+    // Interrupts the main operation when a helper thread fails, so that the error surfaces on the
+    // main thread.
+    auto killMainOperation = [opCtx](const Status& status) {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(opCtx, status.code());
+    };
+
+    // Holding more batches than there are inserters would only use more memory.
+    ProducerConsumerQueue<BSONObj> batches(numInserters);
+
+    std::vector<stdx::thread> inserterThreads;
+    auto inserterThreadsJoinGuard = MakeGuard([&] {
+        batches.closeProducerEnd();
+        for (auto& thread : inserterThreads) {
+            thread.join();
+        }
+    });
+    for (int i = 0; i < numInserters; ++i) {
+        inserterThreads.emplace_back([&] {
+            Client::initThreadIfNotAlready("chunkInserter");
+            auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
+            try {
+                while (true) {
+                    // Throws ProducerConsumerQueueEndClosed once all fetchers are done and the
+                    // queue is drained.
+                    auto nextBatch = batches.pop(inserterOpCtx.get());
+                    insertBatchFn(inserterOpCtx.get(), nextBatch["objects"].Obj());
                 }
-                insertBatchFn(inserterOpCtx.get(), arr);
+            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                return;
+            } catch (...) {
+                killMainOperation(exceptionToStatus());
+                log() << "Batch insertion failed " << causedBy(redact(exceptionToStatus()));
             }
-        } catch (...) {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            opCtx->getServiceContext()->killOperation(opCtx, exceptionToStatus().code());
-            log() << "Batch insertion failed " << causedBy(redact(exceptionToStatus()));
+            batches.closeConsumerEnd();
+        });
+    }
+
+    // Each fetcher pulls batches from the donor until it returns an empty one. The donor hands
+    // disjoint sets of documents to concurrent requests, so all fetchers together clone the chunk.
+    // The main thread is one of the fetchers, the others run on helper threads.
+    auto fetchAll = [&](OperationContext* fetcherOpCtx) {
+        while (true) {
+            fetcherOpCtx->checkForInterrupt();
+
+            auto res = fetchBatchFn(fetcherOpCtx);
+            if (res["objects"].Obj().isEmpty()) {
+                return;
+            }
+
+            fetcherOpCtx->checkForInterrupt();
+            batches.push(res.getOwned(), fetcherOpCtx);
+        }
+    };
+
+    stdx::mutex fetchersMutex;
+    std::vector<OperationContext*> fetcherOpCtxs;
+    std::vector<stdx::thread> fetcherThreads;
+    auto fetcherThreadsJoinGuard = MakeGuard([&] {
+        // Only runs if the main thread failed. Interrupt the other fetchers, which may be waiting
+        // for the donor or for room in the queue.
+        {
+            stdx::lock_guard<stdx::mutex> lk(fetchersMutex);
+            for (auto fetcherOpCtx : fetcherOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*fetcherOpCtx->getClient());
+                fetcherOpCtx->getServiceContext()->killOperation(fetcherOpCtx,
+                                                                 ErrorCodes::Interrupted);
+            }
+        }
+        batches.closeConsumerEnd();
+        for (auto& thread : fetcherThreads) {
+            thread.join();
         }
-    }};
-    auto inserterThreadJoinGuard = MakeGuard([&] {
-        batches.closeProducerEnd();
-        inserterThread.join();
     });
+    for (int i = 1; i < numFetchers; ++i) {
+        fetcherThreads.emplace_back([&] {
+            Client::initThreadIfNotAlready("chunkFetcher");
+            auto fetcherOpCtx = Client::getCurrent()->makeOperationContext();
+            {
+                stdx::lock_guard<stdx::mutex> lk(fetchersMutex);
+                fetcherOpCtxs.push_back(fetcherOpCtx.get());
+            }
+            ON_BLOCK_EXIT([&] {
+                stdx::lock_guard<stdx::mutex> lk(fetchersMutex);
+                fetcherOpCtxs.erase(
+                    std::find(fetcherOpCtxs.begin(), fetcherOpCtxs.end(), fetcherOpCtx.get()));
+            });
 
-    while (true) {
-        opCtx->checkForInterrupt();
+            try {
+                fetchAll(fetcherOpCtx.get());
+            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                // An inserter failed, and has already interrupted the main operation.
+            } catch (...) {
+                killMainOperation(exceptionToStatus());
+                log() << "Batch fetching failed " << causedBy(redact(exceptionToStatus()));
+            }
+        });
+    }
 
-        auto res = fetchBatchFn(opCtx);
+    fetchAll(opCtx);
 
-        opCtx->checkForInterrupt();
-        batches.push(res.getOwned(), opCtx);
-        auto arr = res["objects"].Obj();
-        if (arr.isEmpty()) {
-            inserterThreadJoinGuard.Dismiss();
-            inserterThread.join();
-            opCtx->checkForInterrupt();
-            break;
-        }
+    fetcherThreadsJoinGuard.Dismiss();
+    for (auto& thread : fetcherThreads) {
+        thread.join();
     }
+
+    inserterThreadsJoinGuard.Dismiss();
+    batches.closeProducerEnd();
+    for (auto& thread : inserterThreads) {
+        thread.join();
+    }
+
+    opCtx->checkForInterrupt();
 }
 
 Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
@@ -831,7 +1006,17 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx) {
             return res.response;
         };
 
-        cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        Timer cloneTimer;
+        cloneDocumentsFromDonor(opCtx,
+                                insertBatchFn,
+                                fetchBatchFn,
+                                migrationCloneStreams.load(),
+                                migrationCloneInserterThreads.load());
+
+        {
+            stdx::lock_guard<stdx::mutex> statsLock(_mutex);
+            timing.setCloneStats(_numCloned, _clonedBytes, Milliseconds(cloneTimer.millis()));
+        }
 
         timing.done(3);
         MONGO_FAIL_POINT_PAUSE_WHILE_SET(migrateThreadHangAtStep3);
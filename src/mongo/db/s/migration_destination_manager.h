@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
@@ -60,7 +62,10 @@ class OpTime;
 }
 
 /**
- * Drives the receiving side of the MongoD migration process. One instance exists per shard.
+ * Drives the receiving side of the MongoD migration process. One instance exists per incoming
+ * migration, so that a shard can receive chunks of several collections at once, and is found
+ * through the session id of its migration. Within a migration, documents are cloned over several
+ * concurrent streams.
  */
 class MigrationDestinationManager {
     MONGO_DISALLOW_COPYING(MigrationDestinationManager);
@@ -72,11 +77,25 @@ public:
     ~MigrationDestinationManager();
 
     /**
-     * Returns the singleton instance of the migration destination manager.
-     *
-     * TODO (SERVER-25333): This should become per-collection instance instead of singleton.
+     * Creates the instance which receives the migration with session id 'sessionId', which must
+     * then be started. Instances of migrations which have finished are kept for a while, so that
+     * their donors can still find out how they ended.
      */
-    static MigrationDestinationManager* get(OperationContext* opCtx);
+    static std::shared_ptr<MigrationDestinationManager> create(
+        OperationContext* opCtx, const MigrationSessionId& sessionId);
+
+    /**
+     * Returns the instance which receives, or has received, the migration with session id
+     * 'sessionId', or nullptr if there is none.
+     */
+    static std::shared_ptr<MigrationDestinationManager> get(OperationContext* opCtx,
+                                                            const MigrationSessionId& sessionId);
+
+    /**
+     * Returns the instances of all migrations being received, or recently received, by this shard.
+     */
+    static std::vector<std::shared_ptr<MigrationDestinationManager>> getAll(
+        OperationContext* opCtx);
 
     State getState() const;
     void setState(State newState);
@@ -108,12 +127,17 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. 'fetchBatchFn' is called concurrently by 'numFetchers'
+     * threads, each until it returns an empty batch, and the batches are inserted by
+     * 'numInserters' threads through 'insertBatchFn'. Errors on any thread are thrown on the
+     * calling thread.
      */
     static void cloneDocumentsFromDonor(
         OperationContext* opCtx,
         stdx::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        stdx::function<BSONObj(OperationContext*)> fetchBatchFn);
+        stdx::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numFetchers = 1,
+        int numInserters = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -122,7 +146,7 @@ public:
     Status abort(const MigrationSessionId& sessionId);
 
     /**
-     * Same as 'abort' above, but unconditionally aborts the current migration without checking the
+     * Same as 'abort' above, but unconditionally aborts the migration without checking the
      * session id. Only used for backwards compatibility.
      */
     void abortWithoutSessionIdCheck();
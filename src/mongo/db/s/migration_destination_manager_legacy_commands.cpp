@@ -46,6 +46,7 @@
 #include "mongo/s/request_types/migration_secondary_throttle_options.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 namespace {
@@ -103,18 +104,19 @@ public:
             uassertStatusOK(ChunkMoveWriteConcernOptions::getEffectiveWriteConcern(
                 opCtx, cloneRequest.getSecondaryThrottle()));
 
-        // Ensure this shard is not currently receiving or donating any chunks.
+        // Ensure this shard is not currently receiving or donating any chunks of the collection.
         auto scopedReceiveChunk(
             uassertStatusOK(ActiveMigrationsRegistry::get(opCtx).registerReceiveChunk(
                 nss, chunkRange, cloneRequest.getFromShardId())));
 
         uassertStatusOK(
-            MigrationDestinationManager::get(opCtx)->start(opCtx,
-                                                           nss,
-                                                           std::move(scopedReceiveChunk),
-                                                           cloneRequest,
-                                                           shardVersion.epoch(),
-                                                           writeConcern));
+            MigrationDestinationManager::create(opCtx, cloneRequest.getSessionId())
+                ->start(opCtx,
+                        nss,
+                        std::move(scopedReceiveChunk),
+                        cloneRequest,
+                        shardVersion.epoch(),
+                        writeConcern));
 
         result.appendBool("started", true);
         return true;
@@ -155,7 +157,27 @@ public:
              const BSONObj& cmdObj,
              BSONObjBuilder& result) override {
         bool waitForSteadyOrDone = cmdObj["waitForSteadyOrDone"].boolean();
-        MigrationDestinationManager::get(opCtx)->report(result, opCtx, waitForSteadyOrDone);
+
+        auto migrationSessionIdStatus(MigrationSessionId::extractFromBSON(cmdObj));
+        if (migrationSessionIdStatus == ErrorCodes::NoSuchKey) {
+            // Without a session id, reports the migration which this shard began receiving last.
+            auto const mdms = MigrationDestinationManager::getAll(opCtx);
+            if (mdms.empty()) {
+                result.appendBool("active", false);
+            } else {
+                mdms.back()->report(result, opCtx, waitForSteadyOrDone);
+            }
+            return true;
+        }
+
+        auto const mdm =
+            MigrationDestinationManager::get(opCtx, uassertStatusOK(migrationSessionIdStatus));
+        uassert(ErrorCodes::IllegalOperation,
+                str::stream() << "No migration with session id "
+                              << migrationSessionIdStatus.getValue().toString()
+                              << " is being received by this shard",
+                mdm);
+        mdm->report(result, opCtx, waitForSteadyOrDone);
         return true;
     }
 
@@ -195,7 +217,12 @@ public:
              const BSONObj& cmdObj,
              BSONObjBuilder& result) override {
         auto const sessionId = uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj));
-        auto const mdm = MigrationDestinationManager::get(opCtx);
+        auto const mdm = MigrationDestinationManager::get(opCtx, sessionId);
+        uassert(ErrorCodes::CommandFailed,
+                str::stream() << "startCommit received commit request for session "
+                              << sessionId.toString()
+                              << ", which is not being received by this shard",
+                mdm);
         Status const status = mdm->startCommit(sessionId);
         mdm->report(result, opCtx, false);
         if (!status.isOK()) {
@@ -239,11 +266,17 @@ public:
              const std::string&,
              const BSONObj& cmdObj,
              BSONObjBuilder& result) override {
-        auto const mdm = MigrationDestinationManager::get(opCtx);
-
         auto migrationSessionIdStatus(MigrationSessionId::extractFromBSON(cmdObj));
 
         if (migrationSessionIdStatus.isOK()) {
+            auto const mdm =
+                MigrationDestinationManager::get(opCtx, migrationSessionIdStatus.getValue());
+            if (!mdm) {
+                // There is nothing to abort.
+                result.appendBool("active", false);
+                return true;
+            }
+
             Status const status = mdm->abort(migrationSessionIdStatus.getValue());
             mdm->report(result, opCtx, false);
             if (!status.isOK()) {
@@ -251,8 +284,13 @@ public:
                 uassertStatusOK(status);
             }
         } else if (migrationSessionIdStatus == ErrorCodes::NoSuchKey) {
-            mdm->abortWithoutSessionIdCheck();
-            mdm->report(result, opCtx, false);
+            // Without a session id, aborts every migration being received by this shard.
+            for (auto const& mdm : MigrationDestinationManager::getAll(opCtx)) {
+                if (mdm->isActive()) {
+                    mdm->abortWithoutSessionIdCheck();
+                }
+            }
+            result.appendBool("active", false);
         }
 
         uassertStatusOK(migrationSessionIdStatus.getStatus());
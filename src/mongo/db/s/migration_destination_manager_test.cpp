@@ -28,8 +28,12 @@
 
 #include "mongo/platform/basic.h"
 
+#include <set>
+
 #include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/s/shard_server_test_fixture.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -104,6 +108,43 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that documents fetched over several streams and inserted by several threads all arrive.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithParallelStreams) {
+    const int kNumBatches = 100;
+    AtomicInt32 nextBatch{0};
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+
+        const int batch = nextBatch.fetchAndAdd(1);
+        BSONArrayBuilder arrayBuilder(fetchBatchResultBuilder.subarrayStart("objects"));
+        if (batch < kNumBatches) {
+            arrayBuilder.append(createDocument(batch * 2));
+            arrayBuilder.append(createDocument(batch * 2 + 1));
+        }
+        arrayBuilder.done();
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    stdx::mutex resultMutex;
+    std::set<int> resultIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<stdx::mutex> lk(resultMutex);
+        for (auto&& docToClone : docs) {
+            ASSERT(resultIds.insert(docToClone.Obj()["_id"].numberInt()).second);
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4, 4);
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches * 2), resultIds.size());
+    ASSERT_EQ(0, *resultIds.begin());
+    ASSERT_EQ(kNumBatches * 2 - 1, *resultIds.rbegin());
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
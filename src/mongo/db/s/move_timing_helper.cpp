@@ -32,6 +32,8 @@
 
 #include "mongo/db/s/move_timing_helper.h"
 
+#include <algorithm>
+
 #include "mongo/db/client.h"
 #include "mongo/db/curop.h"
 #include "mongo/s/grid.h"
@@ -93,6 +95,20 @@ MoveTimingHelper::~MoveTimingHelper() {
     }
 }
 
+void MoveTimingHelper::setCloneStats(long long numCloned,
+                                     long long clonedBytes,
+                                     Milliseconds elapsed) {
+    // Avoid dividing by zero for chunks cloned in less than a millisecond.
+    const double seconds = std::max<long long>(elapsed.count(), 1) / 1000.0;
+
+    BSONObjBuilder cloneBuilder(_b.subobjStart("clone"));
+    cloneBuilder.appendNumber("docs", numCloned);
+    cloneBuilder.appendNumber("bytes", clonedBytes);
+    cloneBuilder.appendNumber("millis", durationCount<Milliseconds>(elapsed));
+    cloneBuilder.append("docsPerSecond", numCloned / seconds);
+    cloneBuilder.append("bytesPerSecond", clonedBytes / seconds);
+}
+
 void MoveTimingHelper::done(int step) {
     invariant(step == ++_nextStep);
     invariant(step <= _totalNumSteps);
@@ -32,6 +32,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/s/shard_id.h"
+#include "mongo/util/time_support.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -54,6 +55,12 @@ public:
 
     void done(int step);
 
+    /**
+     * Records how many documents and bytes the initial clone of the chunk copied, and how long it
+     * took, along with the resulting throughput. Logged to the changelog with the step timings.
+     */
+    void setCloneStats(long long numCloned, long long clonedBytes, Milliseconds elapsed);
+
 private:
     // Measures how long the receiving of a chunk takes
     Timer _t;
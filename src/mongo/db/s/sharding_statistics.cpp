@@ -61,6 +61,10 @@ void ShardingStatistics::report(BSONObjBuilder* builder) const {
     builder->append("countDocsClonedOnDonor", countDocsClonedOnDonor.load());
     builder->append("countRecipientMoveChunkStarted", countRecipientMoveChunkStarted.load());
     builder->append("countDocsDeletedOnDonor", countDocsDeletedOnDonor.load());
+    builder->append("countBytesDeletedOnDonor", countBytesDeletedOnDonor.load());
+    builder->append("countRangeDeletionBatches", countRangeDeletionBatches.load());
+    builder->append("totalRangeDeletionTimeMillis", totalRangeDeletionTimeMillis.load());
+    builder->append("countRangeDeletionThrottled", countRangeDeletionThrottled.load());
 }
 
 }  // namespace mongo
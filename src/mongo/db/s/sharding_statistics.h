@@ -68,6 +68,23 @@ struct ShardingStatistics {
     // node by the rangeDeleter.
     AtomicInt64 countDocsDeletedOnDonor{0};
 
+    // Cumulative, always-increasing counter of how many bytes of documents have been deleted on
+    // the donor node by the rangeDeleter.
+    AtomicInt64 countBytesDeletedOnDonor{0};
+
+    // Cumulative, always-increasing counter of how many batches of documents the rangeDeleter has
+    // deleted, each in its own storage transaction.
+    AtomicInt64 countRangeDeletionBatches{0};
+
+    // Cumulative, always-increasing counter of how much time the rangeDeleter spent finding and
+    // deleting documents. Together with countDocsDeletedOnDonor and countBytesDeletedOnDonor this
+    // gives the range deletion throughput.
+    AtomicInt64 totalRangeDeletionTimeMillis{0};
+
+    // Cumulative, always-increasing counter of how many times the rangeDeleter waited longer than
+    // rangeDeleterBatchDelayMS between batches because of replication lag or cache pressure.
+    AtomicInt64 countRangeDeletionThrottled{0};
+
     // Cumulative, always-increasing counter of how many chunks this node started to receive
     // (whether the receiving succeeded or not)
     AtomicInt64 countRecipientMoveChunkStarted{0};
@@ -32,17 +32,21 @@
 
 #include "mongo/db/s/split_vector.h"
 
+#include <cmath>
+
 #include "mongo/base/status_with.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -50,12 +54,131 @@ namespace {
 
 const int kMaxObjectPerChunk{250000};
 
+// Below this many sampled keys per resulting chunk, the relative standard error of the estimated
+// chunk sizes (about 1/sqrt(samples per chunk)) exceeds 20% and the index is scanned instead.
+const double kMinSamplesPerChunk{25};
+
+// Upper bound on the number of documents drawn per requested sample, so that sampling a chunk
+// which only holds a small part of the collection stays cheap.
+const long long kMaxDrawsPerSample{10};
+
+// Chunks whose estimated size is at least this many bytes get their split points estimated from
+// a random sample of their documents instead of from a scan of every key in the chunk. A value of
+// 0 disables sampling.
+MONGO_EXPORT_SERVER_PARAMETER(splitVectorSamplingThresholdBytes, long long, 256 * 1024 * 1024)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "splitVectorSamplingThresholdBytes must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+// Number of in-range documents to sample when estimating the split points of a large chunk.
+MONGO_EXPORT_SERVER_PARAMETER(splitVectorSampleSize, int, 10000)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 100 || newVal > 1000 * 1000) {
+            return Status(ErrorCodes::BadValue,
+                          "splitVectorSampleSize must be between 100 and 1000000");
+        }
+        return Status::OK();
+    });
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
 
+/**
+ * Draws random documents from 'collection' until 'sampleSize' of them have a key in the range
+ * [minKey, maxKey) of the index 'idx', or until too many have been drawn. Returns the keys of the
+ * in-range documents, in index format and sorted in index order, and sets 'numDrawn' to the total
+ * number of documents drawn. Returns boost::none if the storage engine cannot draw random
+ * documents.
+ */
+boost::optional<std::vector<BSONObj>> sampleKeysInRange(OperationContext* opCtx,
+                                                        Collection* collection,
+                                                        IndexDescriptor* idx,
+                                                        const BSONObj& minKey,
+                                                        const BSONObj& maxKey,
+                                                        long long sampleSize,
+                                                        long long* numDrawn) {
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    const IndexAccessMethod* iam = collection->getIndexCatalog()->getIndex(idx);
+    const Ordering ordering = Ordering::make(idx->keyPattern());
+
+    std::vector<BSONObj> sampledKeys;
+    *numDrawn = 0;
+    while (static_cast<long long>(sampledKeys.size()) < sampleSize &&
+           *numDrawn < sampleSize * kMaxDrawsPerSample) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        ++*numDrawn;
+
+        BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        iam->getKeys(record->data.toBson(),
+                     IndexAccessMethod::GetKeysMode::kRelaxConstraints,
+                     &keys,
+                     nullptr,
+                     nullptr);
+        if (keys.empty()) {
+            continue;
+        }
+
+        // The shard key fields are single-valued, so all of the keys of a multikey document share
+        // the shard key prefix.
+        const BSONObj& key = *keys.begin();
+        if (key.woCompare(minKey, ordering, false) >= 0 &&
+            key.woCompare(maxKey, ordering, false) < 0) {
+            sampledKeys.push_back(key.getOwned());
+        }
+    }
+
+    std::sort(sampledKeys.begin(),
+              sampledKeys.end(),
+              [&ordering](const BSONObj& lhs, const BSONObj& rhs) {
+                  return lhs.woCompare(rhs, ordering, false) < 0;
+              });
+    return sampledKeys;
+}
+
 }  // namespace
 
+std::vector<BSONObj> splitPointsFromSample(const std::vector<BSONObj>& sampledKeys,
+                                           double samplesPerChunk,
+                                           boost::optional<long long> maxSplitPoints) {
+    std::vector<BSONObj> splitKeys;
+    if (sampledKeys.empty()) {
+        return splitKeys;
+    }
+
+    // Mirrors the index scan below: the first key is a sentinel, and a key equal to the previous
+    // split point is never used as a split point.
+    splitKeys.push_back(sampledKeys.front());
+
+    double currCount = 0;
+    for (const auto& key : sampledKeys) {
+        currCount++;
+        if (currCount > samplesPerChunk && key.woCompare(splitKeys.back()) != 0) {
+            splitKeys.push_back(key);
+            currCount = 0;
+
+            if (maxSplitPoints && maxSplitPoints.get() &&
+                static_cast<long long>(splitKeys.size()) > maxSplitPoints.get()) {
+                break;
+            }
+        }
+    }
+
+    splitKeys.erase(splitKeys.begin());
+    return splitKeys;
+}
+
 StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              const NamespaceString& nss,
                                              const BSONObj& keyPattern,
@@ -150,6 +273,63 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
             keyCount = maxChunkObjects.get();
         }
 
+        //
+        // For large chunks, estimate the split points from a random sample of the documents in the
+        // chunk. Every sampled key stands for 'recCount / numDrawn' documents, so using every
+        // 'keyCount * numDrawn / recCount'-th sampled key splits the chunk into pieces of about
+        // 'keyCount' documents. If the chunk turns out to be smaller than the threshold, or there
+        // are too few samples to bound the error, fall back to the precise index scan below.
+        //
+
+        const long long samplingThresholdBytes = splitVectorSamplingThresholdBytes.load();
+        if (samplingThresholdBytes > 0 && dataSize >= samplingThresholdBytes) {
+            Timer timer;
+            long long numDrawn = 0;
+            auto sampledKeys = sampleKeysInRange(
+                opCtx, collection, idx, minKey, maxKey, splitVectorSampleSize.load(), &numDrawn);
+
+            if (sampledKeys && !sampledKeys->empty()) {
+                const double inRangeFraction = double(sampledKeys->size()) / numDrawn;
+                const long long estimatedChunkBytes = inRangeFraction * dataSize;
+                const long long estimatedChunkDocs = inRangeFraction * recCount;
+
+                // A forced split cuts the chunk in half.
+                const long long docsPerChunk = force ? estimatedChunkDocs / 2 : keyCount;
+                const double samplesPerChunk = double(docsPerChunk) * numDrawn / recCount;
+
+                if (estimatedChunkBytes >= samplingThresholdBytes &&
+                    samplesPerChunk >= kMinSamplesPerChunk) {
+                    std::vector<BSONObj> sampledShardKeys;
+                    sampledShardKeys.reserve(sampledKeys->size());
+                    for (const auto& key : *sampledKeys) {
+                        sampledShardKeys.push_back(
+                            dotted_path_support::extractElementsBasedOnTemplate(
+                                prettyKey(idx->keyPattern(), key), keyPattern));
+                    }
+
+                    splitKeys =
+                        splitPointsFromSample(sampledShardKeys, samplesPerChunk, maxSplitPoints);
+
+                    LOG(1) << "estimated " << splitKeys.size() << " split points for chunk "
+                           << nss.toString() << " " << redact(minKey) << " -->> " << redact(maxKey)
+                           << " from " << sampledKeys->size() << " sampled keys out of "
+                           << numDrawn << " documents drawn, estimated chunk size "
+                           << estimatedChunkBytes << " bytes, relative standard error of the "
+                           << "resulting chunk sizes " << 1 / std::sqrt(samplesPerChunk)
+                           << ", took " << timer.millis() << "ms";
+
+                    std::sort(splitKeys.begin(),
+                              splitKeys.end(),
+                              SimpleBSONObjComparator::kInstance.makeLessThan());
+                    return splitKeys;
+                }
+            }
+
+            LOG(1) << "not sampling split points for chunk " << nss.toString() << " "
+                   << redact(minKey) << " -->> " << redact(maxKey) << ", falling back to a "
+                   << "full index scan";
+        }
+
         //
         // Traverse the index and add the keyCount-th key to the result vector. If that key
         // appeared in the vector before, we omit it. The invariant here is that all the
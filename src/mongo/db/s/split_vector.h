@@ -54,6 +54,11 @@ class StatusWith;
  * be specified.
  * If force is set, split at the halfway point of the chunk. This also effectively
  * makes maxChunkSize equal the size of the chunk.
+ *
+ * For chunks of at least splitVectorSamplingThresholdBytes, the split points are estimated from a
+ * random sample of the chunk's documents rather than by scanning the shard key index over the
+ * whole chunk. The precise scan is used if the storage engine cannot sample or if the sample is
+ * too small to bound the error of the resulting chunk sizes.
  */
 StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              const NamespaceString& nss,
@@ -66,4 +71,14 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxChunkSize,
                                              boost::optional<long long> maxChunkSizeBytes);
 
+/**
+ * Given 'sampledKeys', a sorted random sample of the shard keys in a chunk, picks split points so
+ * that each resulting chunk holds about 'samplesPerChunk' of the sampled keys. Like splitVector,
+ * never returns the first key, never returns the same key twice and returns at most
+ * 'maxSplitPoints' keys if it is set. Exposed for testing.
+ */
+std::vector<BSONObj> splitPointsFromSample(const std::vector<BSONObj>& sampledKeys,
+                                           double samplesPerChunk,
+                                           boost::optional<long long> maxSplitPoints);
+
 }  // namespace mongo
@@ -300,5 +300,63 @@ TEST_F(SplitVectorTest, NoMaxChunkSize) {
     ASSERT_EQUALS(status.code(), ErrorCodes::InvalidOptions);
 }
 
+TEST(SplitPointsFromSampleTest, EveryNthSampledKey) {
+    std::vector<BSONObj> sampledKeys;
+    for (int i = 0; i < 100; i++) {
+        sampledKeys.push_back(BSON(kPattern << i));
+    }
+
+    std::vector<BSONObj> splitKeys = splitPointsFromSample(sampledKeys, 25, boost::none);
+    std::vector<BSONObj> expected = {
+        BSON(kPattern << 25), BSON(kPattern << 51), BSON(kPattern << 77)};
+    ASSERT_EQ(splitKeys.size(), expected.size());
+
+    for (auto splitKeysIt = splitKeys.begin(), expectedIt = expected.begin();
+         splitKeysIt != splitKeys.end() && expectedIt != expected.end();
+         ++splitKeysIt, ++expectedIt) {
+        ASSERT_BSONOBJ_EQ(*splitKeysIt, *expectedIt);
+    }
+}
+
+TEST(SplitPointsFromSampleTest, SkipsRepeatedKeys) {
+    // Half of the sample is a single key, which must not be used as a split point twice.
+    std::vector<BSONObj> sampledKeys;
+    for (int i = 0; i < 100; i++) {
+        sampledKeys.push_back(BSON(kPattern << (i < 10 || i >= 60 ? i : 10)));
+    }
+
+    std::vector<BSONObj> splitKeys = splitPointsFromSample(sampledKeys, 20, boost::none);
+    std::vector<BSONObj> expected = {
+        BSON(kPattern << 10), BSON(kPattern << 60), BSON(kPattern << 81)};
+    ASSERT_EQ(splitKeys.size(), expected.size());
+
+    for (auto splitKeysIt = splitKeys.begin(), expectedIt = expected.begin();
+         splitKeysIt != splitKeys.end() && expectedIt != expected.end();
+         ++splitKeysIt, ++expectedIt) {
+        ASSERT_BSONOBJ_EQ(*splitKeysIt, *expectedIt);
+    }
+}
+
+TEST(SplitPointsFromSampleTest, MaxSplitPoints) {
+    std::vector<BSONObj> sampledKeys;
+    for (int i = 0; i < 100; i++) {
+        sampledKeys.push_back(BSON(kPattern << i));
+    }
+
+    std::vector<BSONObj> splitKeys = splitPointsFromSample(sampledKeys, 10, 2LL);
+    std::vector<BSONObj> expected = {BSON(kPattern << 10), BSON(kPattern << 21)};
+    ASSERT_EQ(splitKeys.size(), expected.size());
+
+    for (auto splitKeysIt = splitKeys.begin(), expectedIt = expected.begin();
+         splitKeysIt != splitKeys.end() && expectedIt != expected.end();
+         ++splitKeysIt, ++expectedIt) {
+        ASSERT_BSONOBJ_EQ(*splitKeysIt, *expectedIt);
+    }
+}
+
+TEST(SplitPointsFromSampleTest, EmptySample) {
+    ASSERT(splitPointsFromSample({}, 10, boost::none).empty());
+}
+
 }  // namespace
 }  // namespace mongo
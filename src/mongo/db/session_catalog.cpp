@@ -52,15 +52,16 @@ const auto operationSessionDecoration =
 }  // namespace
 
 SessionCatalog::~SessionCatalog() {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-    for (const auto& entry : _sessions) {
-        auto& sri = entry.second;
-        invariant(!sri->checkedOut);
+    auto allPartitions = _sessions.lockAllPartitions();
+    for (const auto& partition : allPartitions) {
+        for (const auto& entry : partition) {
+            auto& sri = entry.second;
+            invariant(!sri->checkedOut);
+        }
     }
 }
 
 void SessionCatalog::reset_forTest() {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
     _sessions.clear();
 }
 
@@ -79,23 +80,34 @@ ScopedCheckedOutSession SessionCatalog::checkOutSession(OperationContext* opCtx)
 
     const auto lsid = *opCtx->getLogicalSessionId();
 
-    stdx::unique_lock<stdx::mutex> ul(_mutex);
+    while (true) {
+        _waitForSessionCheckoutAllowed(opCtx);
 
-    while (!_isSessionCheckoutAllowed()) {
-        opCtx->waitForConditionOrInterrupt(_checkingOutSessionsAllowedCond, ul);
-    }
+        auto partition = _sessions.lockOnePartition(lsid);
+
+        auto sri = _getOrCreateSessionRuntimeInfo(partition, opCtx, lsid);
+
+        // Wait until the session is no longer checked out
+        opCtx->waitForConditionOrInterrupt(
+            sri->availableCondVar, partition.lock(), [&sri]() { return !sri->checkedOut; });
 
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, lsid);
+        invariant(!sri->checkedOut);
+        sri->checkedOut = true;
+        _numCheckedOutSessions.fetchAndAdd(1);
 
-    // Wait until the session is no longer checked out
-    opCtx->waitForConditionOrInterrupt(
-        sri->availableCondVar, ul, [&sri]() { return !sri->checkedOut; });
+        if (_isSessionCheckoutAllowed()) {
+            return ScopedCheckedOutSession(opCtx, ScopedSession(std::move(sri)));
+        }
 
-    invariant(!sri->checkedOut);
-    sri->checkedOut = true;
-    ++_numCheckedOutSessions;
+        // A PreventCheckingOutSessionsBlock was created concurrently and may already be waiting
+        // for the checked out sessions to drain, so give the session back and wait for it to go
+        // out of scope.
+        sri->checkedOut = false;
+        sri->availableCondVar.notify_one();
+        partition.lock().unlock();
 
-    return ScopedCheckedOutSession(opCtx, ScopedSession(std::move(sri)));
+        _decrementNumCheckedOutSessions();
+    }
 }
 
 ScopedSession SessionCatalog::getOrCreateSession(OperationContext* opCtx,
@@ -104,9 +116,11 @@ ScopedSession SessionCatalog::getOrCreateSession(OperationContext* opCtx,
     invariant(!opCtx->getLogicalSessionId());
     invariant(!opCtx->getTxnNumber());
 
+    invariant(_isSessionCheckoutAllowed());
+
     auto ss = [&] {
-        stdx::unique_lock<stdx::mutex> ul(_mutex);
-        return ScopedSession(_getOrCreateSessionRuntimeInfo(ul, opCtx, lsid));
+        auto partition = _sessions.lockOnePartition(lsid);
+        return ScopedSession(_getOrCreateSessionRuntimeInfo(partition, opCtx, lsid));
     }();
 
     return ss;
@@ -124,7 +138,8 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
                 !opCtx->getLogicalSessionId());
     }
 
-    const auto invalidateSessionFn = [&](WithLock, SessionRuntimeInfoMap::iterator it) {
+    const auto invalidateSessionFn = [&](
+        WithLock, SessionRuntimeInfoMap* sessions, SessionRuntimeInfoMap::iterator it) {
         auto& sri = it->second;
         auto const txnParticipant =
             TransactionParticipant::getFromNonCheckedOutSession(&sri->txnState);
@@ -133,24 +148,28 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
         // We cannot remove checked-out sessions from the cache, because operations expect to find
         // them there to check back in
         if (!sri->checkedOut) {
-            _sessions.erase(it);
+            sessions->erase(it);
         }
     };
 
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-
     if (singleSessionDoc) {
         const auto lsid = LogicalSessionId::parse(IDLParserErrorContext("lsid"),
                                                   singleSessionDoc->getField("_id").Obj());
 
-        auto it = _sessions.find(lsid);
-        if (it != _sessions.end()) {
-            invalidateSessionFn(lg, it);
+        auto partition = _sessions.lockOnePartition(lsid);
+
+        auto it = partition->find(lsid);
+        if (it != partition->end()) {
+            invalidateSessionFn(partition.lock(), &*partition, it);
         }
     } else {
-        auto it = _sessions.begin();
-        while (it != _sessions.end()) {
-            invalidateSessionFn(lg, it++);
+        for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+            auto partition = _sessions.lockOnePartitionById(partitionId);
+
+            auto it = partition->begin();
+            while (it != partition->end()) {
+                invalidateSessionFn(partition.lock(), &*partition, it++);
+            }
         }
     }
 }
@@ -158,43 +177,70 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
 void SessionCatalog::scanSessions(OperationContext* opCtx,
                                   const SessionKiller::Matcher& matcher,
                                   const ScanSessionsCallbackFn& workerFn) {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
+    LOG(2) << "Beginning scanSessions.";
 
-    LOG(2) << "Beginning scanSessions. Scanning " << _sessions.size() << " sessions.";
+    size_t numScanned = 0;
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _sessions.lockOnePartitionById(partitionId);
 
-    for (auto& sessionEntry : _sessions) {
-        if (matcher.match(sessionEntry.first)) {
-            workerFn(opCtx, &sessionEntry.second->txnState);
+        numScanned += partition->size();
+        for (auto& sessionEntry : *partition) {
+            if (matcher.match(sessionEntry.first)) {
+                workerFn(opCtx, &sessionEntry.second->txnState);
+            }
         }
     }
+
+    LOG(2) << "Finished scanSessions. Scanned " << numScanned << " sessions.";
 }
 
 std::shared_ptr<SessionCatalog::SessionRuntimeInfo> SessionCatalog::_getOrCreateSessionRuntimeInfo(
-    WithLock, OperationContext* opCtx, const LogicalSessionId& lsid) {
+    const PartitionedSessionRuntimeInfoMap::OnePartition& partition,
+    OperationContext* opCtx,
+    const LogicalSessionId& lsid) {
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());
-    invariant(_isSessionCheckoutAllowed());
 
-    auto it = _sessions.find(lsid);
-    if (it == _sessions.end()) {
-        it = _sessions.emplace(lsid, std::make_shared<SessionRuntimeInfo>(lsid)).first;
+    auto it = partition->find(lsid);
+    if (it == partition->end()) {
+        it = partition->emplace(lsid, std::make_shared<SessionRuntimeInfo>(lsid)).first;
     }
 
     return it->second;
 }
 
 void SessionCatalog::_releaseSession(const LogicalSessionId& lsid) {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
+    {
+        auto partition = _sessions.lockOnePartition(lsid);
+
+        auto it = partition->find(lsid);
+        invariant(it != partition->end());
+
+        auto& sri = it->second;
+        invariant(sri->checkedOut);
+
+        sri->checkedOut = false;
+        sri->availableCondVar.notify_one();
+    }
+
+    _decrementNumCheckedOutSessions();
+}
 
-    auto it = _sessions.find(lsid);
-    invariant(it != _sessions.end());
+void SessionCatalog::_waitForSessionCheckoutAllowed(OperationContext* opCtx) {
+    if (_isSessionCheckoutAllowed()) {
+        return;
+    }
 
-    auto& sri = it->second;
-    invariant(sri->checkedOut);
+    stdx::unique_lock<stdx::mutex> ul(_mutex);
+    while (!_isSessionCheckoutAllowed()) {
+        opCtx->waitForConditionOrInterrupt(_checkingOutSessionsAllowedCond, ul);
+    }
+}
 
-    sri->checkedOut = false;
-    sri->availableCondVar.notify_one();
-    --_numCheckedOutSessions;
-    if (_numCheckedOutSessions == 0) {
+void SessionCatalog::_decrementNumCheckedOutSessions() {
+    // Only a PreventCheckingOutSessionsBlock waits for the count to reach 0, so the mutex needs to
+    // be taken only when one is in scope.
+    if (_numCheckedOutSessions.subtractAndFetch(1) == 0 && !_isSessionCheckoutAllowed()) {
+        stdx::lock_guard<stdx::mutex> lg(_mutex);
         _allSessionsCheckedInCond.notify_all();
     }
 }
@@ -205,15 +251,14 @@ SessionCatalog::PreventCheckingOutSessionsBlock::PreventCheckingOutSessionsBlock
     invariant(sessionCatalog);
 
     stdx::lock_guard<stdx::mutex> lg(sessionCatalog->_mutex);
-    ++sessionCatalog->_preventSessionCheckoutRequests;
+    sessionCatalog->_preventSessionCheckoutRequests.fetchAndAdd(1);
 }
 
 SessionCatalog::PreventCheckingOutSessionsBlock::~PreventCheckingOutSessionsBlock() {
     stdx::lock_guard<stdx::mutex> lg(_sessionCatalog->_mutex);
 
-    invariant(_sessionCatalog->_preventSessionCheckoutRequests > 0);
-    --_sessionCatalog->_preventSessionCheckoutRequests;
-    if (_sessionCatalog->_preventSessionCheckoutRequests == 0) {
+    invariant(_sessionCatalog->_preventSessionCheckoutRequests.load() > 0);
+    if (_sessionCatalog->_preventSessionCheckoutRequests.subtractAndFetch(1) == 0) {
         _sessionCatalog->_checkingOutSessionsAllowedCond.notify_all();
     }
 }
@@ -223,7 +268,7 @@ void SessionCatalog::PreventCheckingOutSessionsBlock::waitForAllSessionsToBeChec
     stdx::unique_lock<stdx::mutex> ul(_sessionCatalog->_mutex);
 
     invariant(!_sessionCatalog->_isSessionCheckoutAllowed());
-    while (_sessionCatalog->_numCheckedOutSessions > 0) {
+    while (_sessionCatalog->_numCheckedOutSessions.load() > 0) {
         opCtx->waitForConditionOrInterrupt(_sessionCatalog->_allSessionsCheckedInCond, ul);
     }
 }
@@ -31,9 +31,11 @@
 #include <boost/optional.hpp>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/session.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
@@ -110,8 +112,9 @@ public:
     void invalidateSessions(OperationContext* opCtx, boost::optional<BSONObj> singleSessionDoc);
 
     /**
-     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks each
+     * partition of the SessionCatalog in turn, so Sessions created or removed concurrently with the
+     * scan may or may not be visited.
      * TODO SERVER-33850: Take Matcher out of the SessionKiller namespace.
      */
     using ScanSessionsCallbackFn = stdx::function<void(OperationContext*, Session*)>;
@@ -128,8 +131,8 @@ private:
         // check it out.
         bool checkedOut{false};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the partition of '_sessions'
+        // which owns the session to protect the state transitions.
         stdx::condition_variable availableCondVar;
 
         // Must only be accessed when the state is kInUse and only by the operation context, which
@@ -141,34 +144,56 @@ private:
                                                       std::shared_ptr<SessionRuntimeInfo>,
                                                       LogicalSessionIdHash>;
 
+    static constexpr size_t kNumPartitions = 16;
+
+    using PartitionedSessionRuntimeInfoMap = Partitioned<SessionRuntimeInfoMap, kNumPartitions>;
+
     /**
-     * May release and re-acquire it zero or more times before returning. The returned
-     * 'SessionRuntimeInfo' is guaranteed to be linked on the catalog's _txnTable as long as the
-     * lock is held.
+     * Returns the runtime info for 'lsid', creating it if necessary. The returned
+     * 'SessionRuntimeInfo' is guaranteed to be linked on the partition's map as long as the
+     * partition's lock is held.
      */
     std::shared_ptr<SessionRuntimeInfo> _getOrCreateSessionRuntimeInfo(
-        WithLock, OperationContext* opCtx, const LogicalSessionId& lsid);
+        const PartitionedSessionRuntimeInfoMap::OnePartition& partition,
+        OperationContext* opCtx,
+        const LogicalSessionId& lsid);
 
     /**
      * Makes a session, previously checked out through 'checkoutSession', available again.
      */
     void _releaseSession(const LogicalSessionId& lsid);
 
+    /**
+     * Blocks until no PreventCheckingOutSessionsBlock is in scope.
+     */
+    void _waitForSessionCheckoutAllowed(OperationContext* opCtx);
+
+    /**
+     * Decrements the count of checked out sessions, waking up any waiters for it to reach 0.
+     */
+    void _decrementNumCheckedOutSessions();
+
     bool _isSessionCheckoutAllowed() const {
-        return _preventSessionCheckoutRequests == 0;
+        return _preventSessionCheckoutRequests.load() == 0;
     };
 
-    // Protects members below.
-    stdx::mutex _mutex;
+    // Owns the Session objects for all current Sessions. The sessions are divided between
+    // partitions by the hash of their id, so that operations on different sessions rarely contend
+    // with each other. The mutex of a partition also protects the check-out state of every session
+    // in it.
+    PartitionedSessionRuntimeInfoMap _sessions;
 
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    // Count of the number of Sessions that are currently checked out. A session is counted before
+    // its checkout checks '_preventSessionCheckoutRequests', and PreventCheckingOutSessionsBlock
+    // sets that before waiting for this count to reach 0, so that one of them always observes the
+    // other without the checkout path having to take '_mutex'.
+    AtomicUInt32 _numCheckedOutSessions{0};
 
-    // Count of the number of Sessions that are currently checked out.
-    uint32_t _numCheckedOutSessions{0};
+    // When >0 all Session checkout or creation requests will block. Only modified under '_mutex'.
+    AtomicUInt32 _preventSessionCheckoutRequests{0};
 
-    // When >0 all Session checkout or creation requests will block.
-    uint32_t _preventSessionCheckoutRequests{0};
+    // Protects waiting on the conditions below. Never acquired while holding a partition's mutex.
+    stdx::mutex _mutex;
 
     // Condition that is signaled when the number of checked out sessions goes to 0.
     stdx::condition_variable _allSessionsCheckedInCond;
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/logical_session_cache_impl.h"
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/service_liaison_mock.h"
+#include "mongo/db/session_catalog.h"
+#include "mongo/db/sessions_collection_mock.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 128;
+
+/**
+ * Each thread checks out and releases its own session, so that the only contention between
+ * threads is on the SessionCatalog's internal synchronization.
+ */
+void BM_CheckOutSession(benchmark::State& state) {
+    auto client = getGlobalServiceContext()->makeClient(
+        str::stream() << "session catalog client for thread " << state.thread_index);
+    auto opCtx = client->makeOperationContext();
+    opCtx->setLogicalSessionId(makeLogicalSessionIdForTest());
+    auto catalog = SessionCatalog::get(opCtx.get());
+
+    for (auto keepRunning : state) {
+        auto scopedSession = catalog->checkOutSession(opCtx.get());
+        benchmark::DoNotOptimize(scopedSession.get());
+    }
+}
+
+class LogicalSessionCacheTest : public benchmark::Fixture {
+protected:
+    std::unique_ptr<LogicalSessionCacheImpl> cache;
+};
+
+/**
+ * Each thread repeatedly vivifies its own session in a shared cache, which is the work done for
+ * every command that carries an lsid.
+ */
+BENCHMARK_DEFINE_F(LogicalSessionCacheTest, BM_Vivify)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        cache = stdx::make_unique<LogicalSessionCacheImpl>(
+            stdx::make_unique<MockServiceLiaison>(std::make_shared<MockServiceLiaisonImpl>()),
+            stdx::make_unique<MockSessionsCollection>(
+                std::make_shared<MockSessionsCollectionImpl>()),
+            nullptr);
+    }
+
+    const auto record = makeLogicalSessionRecordForTest();
+
+    for (auto keepRunning : state) {
+        if (!cache->promote(record.getId()).isOK()) {
+            uassertStatusOK(cache->startSession(nullptr, record));
+        }
+    }
+
+    if (state.thread_index == 0) {
+        cache.reset();
+    }
+}
+
+BENCHMARK(BM_CheckOutSession)->ThreadRange(1, kMaxPerfThreads);
+
+BENCHMARK_REGISTER_F(LogicalSessionCacheTest, BM_Vivify)->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
@@ -30,11 +30,13 @@
 
 #include "mongo/db/repl/mock_repl_coord_server_fixture.h"
 #include "mongo/db/session_catalog.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -303,5 +305,48 @@ TEST_F(SessionCatalogTest, MultiplePreventCheckingOutSessionsBlocks) {
     ASSERT_EQ(lsid1, ocs->get(opCtx())->getSessionId());
 }
 
+TEST_F(SessionCatalogTest, PreventCheckingOutSessionsBlocksWithConcurrentCheckouts) {
+    // Sessions with different ids are spread across the catalog's partitions, so each checkout
+    // below races with the PreventCheckingOutSessionsBlocks without sharing any lock with them.
+    const int kNumThreads = 8;
+    AtomicWord<bool> done{false};
+    AtomicWord<bool> blocked{false};
+    AtomicInt64 numCheckOutsWhileBlocked{0};
+
+    std::vector<stdx::future<void>> futures;
+    for (int i = 0; i < kNumThreads; ++i) {
+        futures.push_back(stdx::async(stdx::launch::async, [&] {
+            ON_BLOCK_EXIT([&] { Client::destroy(); });
+            Client::initThreadIfNotAlready();
+            auto sideOpCtx = Client::getCurrent()->makeOperationContext();
+            sideOpCtx->setLogicalSessionId(makeLogicalSessionIdForTest());
+
+            while (!done.load()) {
+                auto scopedSession =
+                    SessionCatalog::get(sideOpCtx.get())->checkOutSession(sideOpCtx.get());
+                if (blocked.load()) {
+                    numCheckOutsWhileBlocked.fetchAndAdd(1);
+                }
+            }
+        }));
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        SessionCatalog::PreventCheckingOutSessionsBlock preventCheckoutBlock(catalog());
+        preventCheckoutBlock.waitForAllSessionsToBeCheckedIn(opCtx());
+
+        blocked.store(true);
+        sleepmillis(1);
+        blocked.store(false);
+    }
+
+    done.store(true);
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    ASSERT_EQ(0, numCheckOutsWhileBlocked.load());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -79,6 +79,14 @@ inline std::string myErrnoWithDescription() {
     return sb.str();
 }
 
+/**
+ * Returns true if the tracker the sorter's memory is charged to is over a memory budget, and asks
+ * the sorter to release its memory.
+ */
+inline bool shouldReleaseMemory(const SortOptions& opts) {
+    return opts.memoryTracker && opts.memoryTracker->shouldReleaseMemory();
+}
+
 template <typename Data, typename Comparator>
 void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs) {
 #if defined(MONGO_CONFIG_DEBUG_BUILD) && !defined(_MSC_VER)
@@ -418,7 +426,7 @@ public:
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _opts.maxMemoryUsageBytes || shouldReleaseMemory(_opts))
             spill();
     }
 
@@ -476,7 +484,8 @@ private:
                       str::stream()
                           << "Sort exceeded memory limit of "
                           << _opts.maxMemoryUsageBytes
-                          << " bytes, but did not opt in to external sorting. Aborting operation."
+                          << " bytes, or the memory budget of its operation, but did not opt in"
+                          << " to external sorting. Aborting operation."
                           << " Pass allowDiskUse:true to opt in.");
         }
 
@@ -595,7 +604,7 @@ public:
             if (_data.size() == _opts.limit)
                 std::make_heap(_data.begin(), _data.end(), less);
 
-            if (_memUsed > _opts.maxMemoryUsageBytes)
+            if (_memUsed > _opts.maxMemoryUsageBytes || shouldReleaseMemory(_opts))
                 spill();
 
             return;
@@ -618,7 +627,7 @@ public:
         _data.back() = contender;
         std::push_heap(_data.begin(), _data.end(), less);
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _opts.maxMemoryUsageBytes || shouldReleaseMemory(_opts))
             spill();
     }
 
@@ -755,7 +764,8 @@ private:
                       str::stream()
                           << "Sort exceeded memory limit of "
                           << _opts.maxMemoryUsageBytes
-                          << " bytes, but did not opt in to external sorting. Aborting operation."
+                          << " bytes, or the memory budget of its operation, but did not opt in"
+                          << " to external sorting. Aborting operation."
                           << " Pass allowDiskUse:true to opt in.");
         }
 
@@ -37,6 +37,7 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/util/builder.h"
+#include "mongo/util/memory_usage_tracker.h"
 
 /**
  * This is the public API for the Sorter (both in-memory and external)
@@ -99,7 +100,15 @@ struct SortOptions {
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    /// If set, the tracker the sorter's owner charges the sorter's memory usage to. The sorter
+    /// also spills, or uasserts if it can't, when the tracker asks it to release memory.
+    const MemoryUsageTracker* memoryTracker;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          memoryTracker(nullptr) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +131,11 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& MemoryTracker(const MemoryUsageTracker* newMemoryTracker) {
+        memoryTracker = newMemoryTracker;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -105,6 +105,22 @@ public:
 
     void append(BSONObjBuilder& b);
 
+    const AtomicInt64* getLogicalBytesIn() const {
+        return &_together.logicalBytesIn;
+    }
+    const AtomicInt64* getLogicalBytesOut() const {
+        return &_logicalBytesOut;
+    }
+    const AtomicInt64* getPhysicalBytesIn() const {
+        return &_physicalBytesIn;
+    }
+    const AtomicInt64* getPhysicalBytesOut() const {
+        return &_physicalBytesOut;
+    }
+    const AtomicInt64* getRequests() const {
+        return &_together.requests;
+    }
+
 private:
     CacheAligned<AtomicInt64> _physicalBytesIn{0};
     CacheAligned<AtomicInt64> _physicalBytesOut{0};
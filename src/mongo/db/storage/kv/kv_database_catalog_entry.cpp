@@ -86,7 +86,7 @@ IndexAccessMethod* KVDatabaseCatalogEntry::getIndex(OperationContext* opCtx,
         return new TwoDAccessMethod(index, sdi);
 
     if (IndexNames::WILDCARD == type)
-        return new WildcardAccessMethod(index, sdi);
+        return new WildcardAccessMethod(opCtx, index, sdi);
 
     log() << "Can't find index for keyPattern " << desc->keyPattern();
     MONGO_UNREACHABLE;
@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+const StringData kMaterializedViewCountFieldName = "__mvCount"_sd;
+
+namespace {
+
+Status unsupported(const std::string& reason) {
+    return {ErrorCodes::OptionNotSupportedOnView,
+            str::stream() << "Pipeline cannot define a materialized view: " << reason};
+}
+
+/**
+ * Returns true if the $project or $addFields 'spec' can change or remove the _id field.
+ */
+bool touchesId(StringData stageName, const BSONObj& spec) {
+    for (auto&& field : spec) {
+        const auto fieldName = field.fieldNameStringData();
+        if (fieldName.startsWith("_id.")) {
+            // Even an inclusion of a path inside _id replaces _id with part of itself.
+            return true;
+        }
+        if (fieldName != "_id") {
+            continue;
+        }
+        // Only an inclusion of the whole _id in a $project leaves it as it is.
+        const bool isInclusion = (field.isBoolean() || field.isNumber()) && field.trueValue();
+        if (stageName != "$project" || !isInclusion) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Status validateGroupSpec(const BSONObj& spec) {
+    for (auto&& field : spec) {
+        const auto fieldName = field.fieldNameStringData();
+        if (fieldName == "_id") {
+            continue;
+        }
+        if (fieldName == kMaterializedViewCountFieldName) {
+            return unsupported(str::stream() << "the field name '" << fieldName
+                                             << "' is reserved");
+        }
+        if (field.type() != BSONType::Object || field.Obj().nFields() != 1 ||
+            field.Obj().firstElement().fieldNameStringData() != "$sum") {
+            return unsupported(str::stream() << "the $group field '" << fieldName
+                                             << "' must use the $sum accumulator");
+        }
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+Status validateMaterializedViewPipeline(const std::vector<BSONObj>& pipeline) {
+    const bool grouped = isGroupedMaterializedViewPipeline(pipeline);
+
+    for (size_t i = 0; i < pipeline.size(); ++i) {
+        const BSONObj& stage = pipeline[i];
+        if (stage.nFields() != 1 || stage.firstElement().type() != BSONType::Object) {
+            return unsupported(str::stream() << "invalid stage " << stage);
+        }
+
+        const auto stageName = stage.firstElement().fieldNameStringData();
+        const BSONObj spec = stage.firstElement().Obj();
+
+        if (stageName == "$group") {
+            if (i + 1 != pipeline.size()) {
+                return unsupported("$group must be the last stage");
+            }
+            auto status = validateGroupSpec(spec);
+            if (!status.isOK()) {
+                return status;
+            }
+        } else if (stageName == "$match") {
+            if (spec.hasField("$text")) {
+                return unsupported("$text is not supported");
+            }
+        } else if (stageName == "$project" || stageName == "$addFields") {
+            // Without a $group, each view document is kept under the _id of the document it was
+            // computed from.
+            if (!grouped && touchesId(stageName, spec)) {
+                return unsupported(str::stream() << stageName
+                                                 << " must not change the _id field unless the "
+                                                    "pipeline ends with $group");
+            }
+        } else {
+            return unsupported(str::stream() << "the stage " << stageName << " is not supported");
+        }
+    }
+    return Status::OK();
+}
+
+bool isGroupedMaterializedViewPipeline(const std::vector<BSONObj>& pipeline) {
+    return !pipeline.empty() && pipeline.back().firstElement().fieldNameStringData() == "$group";
+}
+
+std::vector<BSONObj> makeMaterializedViewMaintenancePipeline(const std::vector<BSONObj>& pipeline) {
+    std::vector<BSONObj> maintenance = pipeline;
+    if (isGroupedMaterializedViewPipeline(pipeline)) {
+        BSONObjBuilder group;
+        group.appendElements(pipeline.back().firstElement().Obj());
+        group.append(kMaterializedViewCountFieldName, BSON("$sum" << 1));
+        maintenance.back() = BSON("$group" << group.obj());
+    }
+    return maintenance;
+}
+
+std::vector<BSONObj> makeMaterializedViewReadPipeline(const std::vector<BSONObj>& pipeline) {
+    if (!isGroupedMaterializedViewPipeline(pipeline)) {
+        return {};
+    }
+    return {BSON("$project" << BSON(kMaterializedViewCountFieldName << 0))};
+}
+
+}  // namespace mongo
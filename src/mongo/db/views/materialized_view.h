@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Name of the field in which the backing collection of a materialized view with a $group stage
+ * counts the documents that contribute to each group. It lets the server drop a group once its
+ * last document goes away, and is hidden from readers of the view.
+ */
+extern const StringData kMaterializedViewCountFieldName;
+
+/**
+ * Returns Status::OK if 'pipeline' can define a materialized view, that is, if its result can be
+ * maintained incrementally from the documents inserted into and removed from the underlying
+ * collection. Such a pipeline is made of $match, $project and $addFields stages which leave each
+ * document's _id unchanged, optionally followed by a final $group stage whose accumulators are all
+ * $sum. Otherwise, returns ErrorCodes::OptionNotSupportedOnView.
+ */
+Status validateMaterializedViewPipeline(const std::vector<BSONObj>& pipeline);
+
+/**
+ * Returns true if the materialized view 'pipeline' ends with a $group stage.
+ */
+bool isGroupedMaterializedViewPipeline(const std::vector<BSONObj>& pipeline);
+
+/**
+ * Returns the pipeline that computes the contents of the materialized view 'pipeline' for a set of
+ * documents of the underlying collection. It differs from 'pipeline' only in that its $group stage
+ * also counts the documents in each group.
+ */
+std::vector<BSONObj> makeMaterializedViewMaintenancePipeline(const std::vector<BSONObj>& pipeline);
+
+/**
+ * Returns the pipeline to run over the backing collection of the materialized view 'pipeline' to
+ * obtain the view's documents.
+ */
+std::vector<BSONObj> makeMaterializedViewReadPipeline(const std::vector<BSONObj>& pipeline);
+
+}  // namespace mongo
@@ -0,0 +1,418 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_maintenance.h"
+
+#include <limits>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/views/materialized_view.h"
+#include "mongo/db/views/view.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+// Number of documents fed through the maintenance pipeline at a time while computing the contents
+// of a materialized view from scratch.
+const size_t kRebuildBatchSize = 1000;
+
+// Largest collection, by data size, from which a materialized view is built. The whole build runs
+// in the WriteUnitOfWork of the create or rename, under the database lock in MODE_X, so it must
+// stay small enough for the storage engine to hold it in cache.
+MONGO_EXPORT_SERVER_PARAMETER(materializedViewMaxBuildSourceBytes, long long, 64 * 1024 * 1024)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "materializedViewMaxBuildSourceBytes must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+/**
+ * Feeds a fixed set of documents of the underlying collection into the maintenance pipeline of a
+ * materialized view.
+ */
+class DocumentSourceMaterializedViewInput final : public DocumentSource {
+public:
+    DocumentSourceMaterializedViewInput(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                        const std::vector<BSONObj>& docs)
+        : DocumentSource(expCtx), _docs(docs) {}
+
+    GetNextResult getNext() final {
+        pExpCtx->checkForInterrupt();
+
+        if (_index == _docs.size()) {
+            return GetNextResult::makeEOF();
+        }
+        return Document(_docs[_index++]);
+    }
+
+    const char* getSourceName() const final {
+        return "$materializedViewInput";
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final {
+        return Value(Document{{getSourceName(), Document()}});
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kNone,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kAllowed);
+
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+private:
+    const std::vector<BSONObj>& _docs;
+    size_t _index = 0;
+};
+
+boost::intrusive_ptr<ExpressionContext> makeExpressionContext(OperationContext* opCtx,
+                                                              const ViewDefinition& view,
+                                                              const std::vector<BSONObj>& stages) {
+    AggregationRequest request(view.viewOn(), stages);
+    return new ExpressionContext(opCtx,
+                                 request,
+                                 CollatorInterface::cloneCollator(view.defaultCollator()),
+                                 // The maintenance pipeline only sees the documents it is given.
+                                 std::make_shared<StubMongoProcessInterface>(),
+                                 StringMap<ExpressionContext::ResolvedNamespace>(),
+                                 boost::none);
+}
+
+std::vector<Document> runMaintenancePipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                             const std::vector<BSONObj>& stages,
+                                             const std::vector<BSONObj>& docs) {
+    std::vector<Document> results;
+    if (docs.empty()) {
+        return results;
+    }
+
+    auto pipeline = uassertStatusOK(Pipeline::parse(stages, expCtx));
+    pipeline->addInitialSource(new DocumentSourceMaterializedViewInput(expCtx, docs));
+    while (auto next = pipeline->getNext()) {
+        results.push_back(std::move(*next));
+    }
+    return results;
+}
+
+Value negate(const Value& value) {
+    switch (value.getType()) {
+        case NumberInt:
+            if (value.getInt() == std::numeric_limits<int>::min()) {
+                return Value(-static_cast<long long>(value.getInt()));
+            }
+            return Value(-value.getInt());
+        case NumberLong:
+            if (value.getLong() == std::numeric_limits<long long>::min()) {
+                return Value(-static_cast<double>(value.getLong()));
+            }
+            return Value(-value.getLong());
+        case NumberDouble:
+            return Value(-value.getDouble());
+        case NumberDecimal:
+            return Value(value.getDecimal().negate());
+        default:
+            // $sum only produces numbers.
+            return value;
+    }
+}
+
+/**
+ * Negates the sums of a document of a grouped materialized view, turning it into the change that
+ * removes its documents from the group.
+ */
+Document negateGroup(const Document& group) {
+    MutableDocument negated(group);
+    auto it = group.fieldIterator();
+    while (it.more()) {
+        auto field = it.next();
+        if (field.first != "_id") {
+            negated.setField(field.first, negate(field.second));
+        }
+    }
+    return negated.freeze();
+}
+
+/**
+ * Adds up, field by field, two documents of a grouped materialized view with the same _id. The
+ * result keeps the _id of 'group'.
+ */
+Document combineGroups(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       const Document& group,
+                       const Document& delta) {
+    MutableDocument combined(group);
+    auto it = delta.fieldIterator();
+    while (it.more()) {
+        auto field = it.next();
+        if (field.first == "_id") {
+            continue;
+        }
+        auto sum = AccumulatorSum::create(expCtx);
+        sum->process(group[field.first], false);
+        sum->process(field.second, false);
+        combined.setField(field.first, sum->getValue(false));
+    }
+    return combined.freeze();
+}
+
+/**
+ * Replaces the backing collection document 'oldDoc' stored at 'rid' with 'newDoc', unless they
+ * are the same.
+ */
+void replaceDocument(OperationContext* opCtx,
+                     Collection* backing,
+                     const RecordId& rid,
+                     const Snapshotted<BSONObj>& oldDoc,
+                     const BSONObj& newDoc) {
+    if (oldDoc.value().binaryEqual(newDoc)) {
+        return;
+    }
+
+    CollectionUpdateArgs args;
+    args.update = newDoc;
+    args.criteria = BSON("_id" << newDoc["_id"]);
+    args.fromMigrate = false;
+
+    const bool assumeIndexesAreAffected = true;
+    backing->updateDocument(opCtx, rid, oldDoc, newDoc, assumeIndexesAreAffected, nullptr, &args);
+}
+
+void applyGroupedDelta(OperationContext* opCtx,
+                       Collection* backing,
+                       const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       const std::vector<Document>& removed,
+                       const std::vector<Document>& added) {
+    // Net out the changes to each group before touching the backing collection, so that an update
+    // within a group writes at most once.
+    auto deltas = expCtx->getValueComparator().makeUnorderedValueMap<Document>();
+    auto accumulate = [&](const Document& delta) {
+        auto it = deltas.find(delta["_id"]);
+        if (it == deltas.end()) {
+            deltas.emplace(delta["_id"], delta);
+        } else {
+            it->second = combineGroups(expCtx, it->second, delta);
+        }
+    };
+    for (auto&& group : removed) {
+        accumulate(negateGroup(group));
+    }
+    for (auto&& group : added) {
+        accumulate(group);
+    }
+
+    for (auto&& delta : deltas) {
+        const BSONObj deltaObj = delta.second.toBson();
+        const RecordId rid = Helpers::findById(opCtx, backing, BSON("_id" << deltaObj["_id"]));
+
+        Snapshotted<BSONObj> existing;
+        if (!rid.isNull() && backing->findDoc(opCtx, rid, &existing)) {
+            const Document combined =
+                combineGroups(expCtx, Document(existing.value()), delta.second);
+            if (combined[kMaterializedViewCountFieldName].coerceToLong() <= 0) {
+                backing->deleteDocument(opCtx, kUninitializedStmtId, rid, nullptr);
+            } else {
+                replaceDocument(opCtx, backing, rid, existing, combined.toBson());
+            }
+        } else if (delta.second[kMaterializedViewCountFieldName].coerceToLong() > 0) {
+            uassertStatusOK(backing->insertDocument(opCtx, InsertStatement(deltaObj), nullptr));
+        }
+    }
+}
+
+void applyDocumentDelta(OperationContext* opCtx,
+                        Collection* backing,
+                        const std::vector<Document>& removed,
+                        const std::vector<Document>& added) {
+    // Documents which are still in the view are overwritten below rather than deleted.
+    auto addedIds = ValueComparator().makeUnorderedValueSet();
+    for (auto&& doc : added) {
+        addedIds.insert(doc["_id"]);
+    }
+
+    for (auto&& doc : removed) {
+        if (addedIds.count(doc["_id"])) {
+            continue;
+        }
+        const BSONObj obj = doc.toBson();
+        const RecordId rid = Helpers::findById(opCtx, backing, BSON("_id" << obj["_id"]));
+        if (!rid.isNull()) {
+            backing->deleteDocument(opCtx, kUninitializedStmtId, rid, nullptr);
+        }
+    }
+
+    for (auto&& doc : added) {
+        const BSONObj obj = doc.toBson();
+        const RecordId rid = Helpers::findById(opCtx, backing, BSON("_id" << obj["_id"]));
+
+        Snapshotted<BSONObj> existing;
+        if (!rid.isNull() && backing->findDoc(opCtx, rid, &existing)) {
+            replaceDocument(opCtx, backing, rid, existing, obj);
+        } else {
+            uassertStatusOK(backing->insertDocument(opCtx, InsertStatement(obj), nullptr));
+        }
+    }
+}
+
+}  // namespace
+
+void createMaterializedViewBackingCollection(OperationContext* opCtx,
+                                             Database* db,
+                                             const ViewDefinition& view) {
+    invariant(opCtx->lockState()->isDbLockedForMode(db->name(), MODE_X));
+    invariant(view.isMaterialized());
+
+    uassert(ErrorCodes::NamespaceExists,
+            str::stream() << "Collection " << view.backingNss().ns()
+                          << " for the materialized view "
+                          << view.name().ns()
+                          << " already exists",
+            !db->getCollection(opCtx, view.backingNss()));
+
+    // Groups are looked up by _id with the collation of the view. The documents of other views
+    // keep the _id of the documents they were computed from, which never collide.
+    CollectionOptions options;
+    if (view.defaultCollator() && isGroupedMaterializedViewPipeline(view.pipeline())) {
+        options.collation = view.defaultCollator()->getSpec().toBSON();
+    }
+    invariant(db->createCollection(opCtx, view.backingNss().ns(), options));
+
+    rebuildMaterializedView(opCtx, db, view, view.viewOn());
+}
+
+void applyMaterializedViewDelta(OperationContext* opCtx,
+                                Database* db,
+                                const ViewDefinition& view,
+                                const std::vector<BSONObj>& removed,
+                                const std::vector<BSONObj>& added) {
+    invariant(view.isMaterialized());
+    if (removed.empty() && added.empty()) {
+        return;
+    }
+
+    Lock::CollectionLock backingLock(opCtx->lockState(), view.backingNss().ns(), MODE_IX);
+    Collection* backing = db->getCollection(opCtx, view.backingNss());
+    if (!backing) {
+        // Secondaries get the backing collection through replication.
+        return;
+    }
+
+    const auto stages = makeMaterializedViewMaintenancePipeline(view.pipeline());
+    auto expCtx = makeExpressionContext(opCtx, view, stages);
+    const auto removedResults = runMaintenancePipeline(expCtx, stages, removed);
+    const auto addedResults = runMaintenancePipeline(expCtx, stages, added);
+
+    if (isGroupedMaterializedViewPipeline(view.pipeline())) {
+        applyGroupedDelta(opCtx, backing, expCtx, removedResults, addedResults);
+    } else {
+        applyDocumentDelta(opCtx, backing, removedResults, addedResults);
+    }
+}
+
+void emptyMaterializedView(OperationContext* opCtx, Database* db, const ViewDefinition& view) {
+    invariant(opCtx->lockState()->isDbLockedForMode(db->name(), MODE_X));
+
+    Collection* backing = db->getCollection(opCtx, view.backingNss());
+    if (!backing) {
+        return;
+    }
+
+    std::vector<RecordId> records;
+    {
+        auto cursor = backing->getCursor(opCtx);
+        while (auto record = cursor->next()) {
+            records.push_back(record->id);
+        }
+    }
+
+    for (auto&& rid : records) {
+        backing->deleteDocument(opCtx, kUninitializedStmtId, rid, nullptr);
+    }
+}
+
+void rebuildMaterializedView(OperationContext* opCtx,
+                             Database* db,
+                             const ViewDefinition& view,
+                             const NamespaceString& source) {
+    emptyMaterializedView(opCtx, db, view);
+
+    Collection* sourceColl = db->getCollection(opCtx, source);
+    if (!sourceColl) {
+        return;
+    }
+
+    const long long maxSourceBytes = materializedViewMaxBuildSourceBytes.load();
+    const long long sourceBytes = sourceColl->dataSize(opCtx);
+    uassert(50984,
+            str::stream() << "Cannot build the materialized view " << view.name().ns()
+                          << " from the collection "
+                          << source.ns()
+                          << ": its data size of "
+                          << sourceBytes
+                          << " bytes exceeds materializedViewMaxBuildSourceBytes ("
+                          << maxSourceBytes
+                          << ")",
+            sourceBytes <= maxSourceBytes);
+
+    std::vector<BSONObj> batch;
+    auto cursor = sourceColl->getCursor(opCtx);
+    while (auto record = cursor->next()) {
+        batch.push_back(record->data.toBson().getOwned());
+        if (batch.size() == kRebuildBatchSize) {
+            applyMaterializedViewDelta(opCtx, db, view, {}, batch);
+            batch.clear();
+        }
+    }
+    applyMaterializedViewDelta(opCtx, db, view, {}, batch);
+}
+
+}  // namespace mongo
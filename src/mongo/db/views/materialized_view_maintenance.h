@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+class Database;
+class NamespaceString;
+class OperationContext;
+class ViewDefinition;
+
+/**
+ * Creates the backing collection of the materialized view 'view' in 'db' and fills it from the
+ * collection the view is defined on. The caller must hold the database lock in MODE_X and be in a
+ * WriteUnitOfWork. Throws as rebuildMaterializedView() does.
+ */
+void createMaterializedViewBackingCollection(OperationContext* opCtx,
+                                             Database* db,
+                                             const ViewDefinition& view);
+
+/**
+ * Brings the backing collection of the materialized view 'view' up to date after the documents
+ * 'removed' were deleted from, and the documents 'added' were inserted into, the collection the
+ * view is defined on. An update removes the pre-image of the document and adds its post-image.
+ * The caller must hold the database lock in at least MODE_IX and be in a WriteUnitOfWork.
+ */
+void applyMaterializedViewDelta(OperationContext* opCtx,
+                                Database* db,
+                                const ViewDefinition& view,
+                                const std::vector<BSONObj>& removed,
+                                const std::vector<BSONObj>& added);
+
+/**
+ * Removes all documents from the backing collection of the materialized view 'view', as when the
+ * collection the view is defined on goes away. The caller must hold the database lock in MODE_X
+ * and be in a WriteUnitOfWork.
+ */
+void emptyMaterializedView(OperationContext* opCtx, Database* db, const ViewDefinition& view);
+
+/**
+ * Recomputes the contents of the materialized view 'view' from the documents of the collection
+ * 'source', which is usually the collection the view is defined on. Empties the view if 'source'
+ * does not exist. The caller must hold the database lock in MODE_X and be in a WriteUnitOfWork.
+ *
+ * The view is built within that WriteUnitOfWork, so that it is never seen half built. Throws if
+ * the data size of 'source' exceeds the materializedViewMaxBuildSourceBytes server parameter.
+ */
+void rebuildMaterializedView(OperationContext* opCtx,
+                             Database* db,
+                             const ViewDefinition& view,
+                             const NamespaceString& source);
+
+}  // namespace mongo
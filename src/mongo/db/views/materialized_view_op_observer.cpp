@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_op_observer.h"
+
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/views/materialized_view_maintenance.h"
+#include "mongo/db/views/view.h"
+#include "mongo/db/views/view_catalog.h"
+#include "mongo/stdx/functional.h"
+
+namespace mongo {
+namespace {
+
+// The document that is about to be deleted from a collection with materialized views, saved by
+// aboutToDelete() for onDelete().
+const auto deletedDocumentDecoration =
+    OperationContext::declareDecoration<boost::optional<BSONObj>>();
+
+/**
+ * Calls 'callback' for each materialized view defined on 'nss', if writes to 'nss' should update
+ * them. Changes to the backing collections are replicated on their own, so they are not derived
+ * again while applying the oplog.
+ */
+void forEachMaterializedView(OperationContext* opCtx,
+                             const NamespaceString& nss,
+                             stdx::function<void(Database*, const ViewDefinition&)> callback) {
+    if (!ViewDefinition::anyMaterialized() || !opCtx->writesAreReplicated() || nss.isSystem()) {
+        return;
+    }
+    if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss)) {
+        return;
+    }
+
+    Database* db = DatabaseHolder::getDatabaseHolder().get(opCtx, nss.db());
+    if (!db) {
+        return;
+    }
+    for (auto&& view : db->getViewCatalog()->lookupMaterializedViewsOn(opCtx, nss)) {
+        callback(db, *view);
+    }
+}
+
+}  // namespace
+
+MaterializedViewOpObserver::MaterializedViewOpObserver() = default;
+
+MaterializedViewOpObserver::~MaterializedViewOpObserver() = default;
+
+void MaterializedViewOpObserver::onInserts(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           OptionalCollectionUUID uuid,
+                                           std::vector<InsertStatement>::const_iterator begin,
+                                           std::vector<InsertStatement>::const_iterator end,
+                                           bool fromMigrate) {
+    if (fromMigrate) {
+        return;
+    }
+
+    std::vector<BSONObj> added;
+    forEachMaterializedView(opCtx, nss, [&](Database* db, const ViewDefinition& view) {
+        if (added.empty()) {
+            for (auto it = begin; it != end; ++it) {
+                added.push_back(it->doc);
+            }
+        }
+        applyMaterializedViewDelta(opCtx, db, view, {}, added);
+    });
+}
+
+void MaterializedViewOpObserver::onUpdate(OperationContext* opCtx,
+                                          const OplogUpdateEntryArgs& args) {
+    if (args.updateArgs.fromMigrate) {
+        return;
+    }
+
+    forEachMaterializedView(opCtx, args.nss, [&](Database* db, const ViewDefinition& view) {
+        // Collection sets the pre-image of every update, in place or not, while materialized views
+        // exist.
+        invariant(args.updateArgs.preImageDoc);
+        applyMaterializedViewDelta(
+            opCtx, db, view, {*args.updateArgs.preImageDoc}, {args.updateArgs.updatedDoc});
+    });
+}
+
+void MaterializedViewOpObserver::aboutToDelete(OperationContext* opCtx,
+                                               const NamespaceString& nss,
+                                               const BSONObj& doc) {
+    auto& deletedDocument = deletedDocumentDecoration(opCtx);
+    deletedDocument = boost::none;
+    forEachMaterializedView(opCtx, nss, [&](Database* db, const ViewDefinition& view) {
+        if (!deletedDocument) {
+            deletedDocument = doc.getOwned();
+        }
+    });
+}
+
+void MaterializedViewOpObserver::onDelete(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          OptionalCollectionUUID uuid,
+                                          StmtId stmtId,
+                                          bool fromMigrate,
+                                          const boost::optional<BSONObj>& deletedDoc) {
+    // The backing collections are written to below, which goes through aboutToDelete() again.
+    auto deletedDocument = std::move(deletedDocumentDecoration(opCtx));
+    deletedDocumentDecoration(opCtx) = boost::none;
+    if (fromMigrate || !deletedDocument) {
+        return;
+    }
+
+    forEachMaterializedView(opCtx, nss, [&](Database* db, const ViewDefinition& view) {
+        applyMaterializedViewDelta(opCtx, db, view, {*deletedDocument}, {});
+    });
+}
+
+void MaterializedViewOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                    const NamespaceString& fromCollection,
+                                                    const NamespaceString& toCollection,
+                                                    OptionalCollectionUUID uuid,
+                                                    OptionalCollectionUUID dropTargetUUID,
+                                                    bool stayTemp) {
+    // The collection has already been renamed.
+    forEachMaterializedView(opCtx, fromCollection, [&](Database* db, const ViewDefinition& view) {
+        emptyMaterializedView(opCtx, db, view);
+    });
+    forEachMaterializedView(opCtx, toCollection, [&](Database* db, const ViewDefinition& view) {
+        rebuildMaterializedView(opCtx, db, view, toCollection);
+    });
+}
+
+void MaterializedViewOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                               const NamespaceString& collectionName,
+                                               OptionalCollectionUUID uuid) {
+    forEachMaterializedView(opCtx, collectionName, [&](Database* db, const ViewDefinition& view) {
+        emptyMaterializedView(opCtx, db, view);
+    });
+}
+
+}  // namespace mongo
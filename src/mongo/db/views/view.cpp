@@ -33,35 +33,72 @@
 #include <memory>
 
 #include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
+namespace {
+// Number of live ViewDefinition objects describing materialized views.
+AtomicInt64 materializedDefinitionCount;
+}  // namespace
 
 ViewDefinition::ViewDefinition(StringData dbName,
                                StringData viewName,
                                StringData viewOnName,
                                const BSONObj& pipeline,
-                               std::unique_ptr<CollatorInterface> collator)
-    : _viewNss(dbName, viewName), _viewOnNss(dbName, viewOnName), _collator(std::move(collator)) {
+                               std::unique_ptr<CollatorInterface> collator,
+                               bool materialized)
+    : _viewNss(dbName, viewName),
+      _viewOnNss(dbName, viewOnName),
+      _collator(std::move(collator)),
+      _materialized(materialized) {
     for (BSONElement e : pipeline) {
         _pipeline.push_back(e.Obj().getOwned());
     }
+    if (_materialized) {
+        _backingNss = NamespaceString(dbName,
+                                      NamespaceString::kSystemDotMaterializedPrefix.toString() +
+                                          viewName.toString());
+        materializedDefinitionCount.fetchAndAdd(1);
+    }
 }
 
 ViewDefinition::ViewDefinition(const ViewDefinition& other)
     : _viewNss(other._viewNss),
       _viewOnNss(other._viewOnNss),
       _collator(CollatorInterface::cloneCollator(other._collator.get())),
-      _pipeline(other._pipeline) {}
+      _pipeline(other._pipeline),
+      _materialized(other._materialized),
+      _backingNss(other._backingNss) {
+    if (_materialized) {
+        materializedDefinitionCount.fetchAndAdd(1);
+    }
+}
+
+ViewDefinition::~ViewDefinition() {
+    if (_materialized) {
+        materializedDefinitionCount.fetchAndSubtract(1);
+    }
+}
 
 ViewDefinition& ViewDefinition::operator=(const ViewDefinition& other) {
+    if (_materialized != other._materialized) {
+        materializedDefinitionCount.fetchAndAdd(other._materialized ? 1 : -1);
+    }
+
     _viewNss = other._viewNss;
     _viewOnNss = other._viewOnNss;
     _collator = CollatorInterface::cloneCollator(other._collator.get());
     _pipeline = other._pipeline;
+    _materialized = other._materialized;
+    _backingNss = other._backingNss;
 
     return *this;
 }
 
+bool ViewDefinition::anyMaterialized() {
+    return materializedDefinitionCount.load() > 0;
+}
+
 void ViewDefinition::setViewOn(const NamespaceString& viewOnNss) {
     invariant(_viewNss.db() == viewOnNss.db());
     _viewOnNss = viewOnNss;
@@ -46,12 +46,23 @@ public:
     /**
      * In the database 'dbName', create a new view 'viewName' on the view or collection
      * 'viewOnName'. Neither 'viewName' nor 'viewOnName' should include the name of the database.
+     * A 'materialized' view stores its contents in a backing collection, which the server keeps
+     * up to date as the collection 'viewOnName' changes.
      */
     ViewDefinition(StringData dbName,
                    StringData viewName,
                    StringData viewOnName,
                    const BSONObj& pipeline,
-                   std::unique_ptr<CollatorInterface> collation);
+                   std::unique_ptr<CollatorInterface> collation,
+                   bool materialized = false);
+
+    ~ViewDefinition();
+
+    /**
+     * Returns true if any materialized view definition exists in this process. Used to skip the
+     * maintenance of materialized views without consulting the view catalog.
+     */
+    static bool anyMaterialized();
 
     /**
      * Copying a view 'other' clones its collator and does a simple copy of all other fields.
@@ -74,6 +85,21 @@ public:
         return _viewOnNss;
     }
 
+    /**
+     * Returns true if the contents of this view are stored in the collection backingNss().
+     */
+    bool isMaterialized() const {
+        return _materialized;
+    }
+
+    /**
+     * @return The fully-qualified namespace of the collection holding the contents of this view.
+     * Only meaningful for materialized views.
+     */
+    const NamespaceString& backingNss() const {
+        return _backingNss;
+    }
+
     /**
      * Returns a vector of BSONObjs that represent the stages of the aggregation pipeline that
      * defines this view.
@@ -101,5 +127,7 @@ private:
     NamespaceString _viewOnNss;
     std::unique_ptr<CollatorInterface> _collator;
     std::vector<BSONObj> _pipeline;
+    bool _materialized = false;
+    NamespaceString _backingNss;
 };
 }  // namespace mongo
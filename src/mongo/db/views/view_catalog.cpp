@@ -50,6 +50,7 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/views/materialized_view.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_graph.h"
@@ -105,11 +106,13 @@ Status ViewCatalog::_reloadIfNeeded_inlock(OperationContext* opCtx) {
             }
         }
 
+        const bool materialized = view["materialized"].trueValue();
         _viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(viewName.db(),
                                                                    viewName.coll(),
                                                                    view["viewOn"].str(),
                                                                    pipeline,
-                                                                   std::move(collator.getValue()));
+                                                                   std::move(collator.getValue()),
+                                                                   materialized);
         return Status::OK();
     });
     _valid.store(status.isOK());
@@ -134,7 +137,8 @@ Status ViewCatalog::_createOrUpdateView_inlock(OperationContext* opCtx,
                                                const NamespaceString& viewName,
                                                const NamespaceString& viewOn,
                                                const BSONArray& pipeline,
-                                               std::unique_ptr<CollatorInterface> collator) {
+                                               std::unique_ptr<CollatorInterface> collator,
+                                               bool materialized) {
     _requireValidCatalog_inlock(opCtx);
 
     // Build the BSON definition for this view to be saved in the durable view catalog. If the
@@ -146,10 +150,17 @@ Status ViewCatalog::_createOrUpdateView_inlock(OperationContext* opCtx,
     if (collator) {
         viewDefBuilder.append("collation", collator->getSpec().toBSON());
     }
+    if (materialized) {
+        viewDefBuilder.append("materialized", true);
+    }
 
     BSONObj ownedPipeline = pipeline.getOwned();
-    auto view = std::make_shared<ViewDefinition>(
-        viewName.db(), viewName.coll(), viewOn.coll(), ownedPipeline, std::move(collator));
+    auto view = std::make_shared<ViewDefinition>(viewName.db(),
+                                                 viewName.coll(),
+                                                 viewOn.coll(),
+                                                 ownedPipeline,
+                                                 std::move(collator),
+                                                 materialized);
 
     // Check that the resulting dependency graph is acyclic and within the maximum depth.
     Status graphStatus = _upsertIntoGraph(opCtx, *(view.get()));
@@ -313,7 +324,8 @@ Status ViewCatalog::createView(OperationContext* opCtx,
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
                                const BSONArray& pipeline,
-                               const BSONObj& collation) {
+                               const BSONObj& collation,
+                               bool materialized) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
     if (viewName.db() != viewOn.db())
@@ -332,12 +344,29 @@ Status ViewCatalog::createView(OperationContext* opCtx,
             ErrorCodes::InvalidNamespace,
             "View name cannot start with 'system.', which is reserved for system namespaces");
 
+    if (materialized) {
+        if (viewOn.isSystem() || _lookup_inlock(opCtx, viewOn.ns()))
+            return Status(ErrorCodes::OptionNotSupportedOnView,
+                          "A materialized view must be defined on a non-system collection");
+
+        std::vector<BSONObj> stages;
+        for (auto&& stage : pipeline) {
+            if (stage.type() != BSONType::Object)
+                return Status(ErrorCodes::InvalidViewDefinition,
+                              "View 'pipeline' entries must be objects");
+            stages.push_back(stage.Obj());
+        }
+        auto status = validateMaterializedViewPipeline(stages);
+        if (!status.isOK())
+            return status;
+    }
+
     auto collator = parseCollator(opCtx, collation);
     if (!collator.isOK())
         return collator.getStatus();
 
     return _createOrUpdateView_inlock(
-        opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()));
+        opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()), materialized);
 }
 
 Status ViewCatalog::modifyView(OperationContext* opCtx,
@@ -355,6 +384,10 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
         return Status(ErrorCodes::NamespaceNotFound,
                       str::stream() << "cannot modify missing view " << viewName.ns());
 
+    if (viewPtr->isMaterialized())
+        return Status(ErrorCodes::OptionNotSupportedOnView,
+                      str::stream() << "cannot modify materialized view " << viewName.ns());
+
     if (!NamespaceString::validCollectionName(viewOn.coll()))
         return Status(ErrorCodes::InvalidNamespace,
                       str::stream() << "invalid name for 'viewOn': " << viewOn.coll());
@@ -369,7 +402,8 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
         viewName,
         viewOn,
         pipeline,
-        CollatorInterface::cloneCollator(savedDefinition.defaultCollator()));
+        CollatorInterface::cloneCollator(savedDefinition.defaultCollator()),
+        false);
 }
 
 Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& viewName) {
@@ -429,6 +463,25 @@ std::shared_ptr<ViewDefinition> ViewCatalog::lookup(OperationContext* opCtx, Str
     return _lookup_inlock(opCtx, ns);
 }
 
+std::vector<std::shared_ptr<ViewDefinition>> ViewCatalog::lookupMaterializedViewsOn(
+    OperationContext* opCtx, const NamespaceString& viewOn) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // Writes to the collection must not fail because of an invalid view definition. Until the
+    // catalog is fixed no view can be read, and its materialized views go stale.
+    std::vector<std::shared_ptr<ViewDefinition>> views;
+    if (!_reloadIfNeeded_inlock(opCtx).isOK()) {
+        return views;
+    }
+
+    for (auto&& view : _viewMap) {
+        if (view.second->isMaterialized() && view.second->viewOn() == viewOn) {
+            views.push_back(view.second);
+        }
+    }
+    return views;
+}
+
 StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                                                   const NamespaceString& nss) {
     stdx::unique_lock<stdx::mutex> lock(_mutex);
@@ -481,12 +534,23 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                     {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
             }
 
-            resolvedNss = &view->viewOn();
             if (!collation) {
                 collation = view->defaultCollator() ? view->defaultCollator()->getSpec().toBSON()
                                                     : CollationSpec::kSimpleSpec;
             }
 
+            // A materialized view is read from its backing collection, which already holds the
+            // result of the view's pipeline.
+            if (view->isMaterialized()) {
+                const auto toPrepend = makeMaterializedViewReadPipeline(view->pipeline());
+                resolvedPipeline.insert(
+                    resolvedPipeline.begin(), toPrepend.begin(), toPrepend.end());
+                return StatusWith<ResolvedView>(
+                    {view->backingNss(), std::move(resolvedPipeline), std::move(collation.get())});
+            }
+
+            resolvedNss = &view->viewOn();
+
             // Prepend the underlying view's pipeline to the current working pipeline.
             const std::vector<BSONObj>& toPrepend = view->pipeline();
             resolvedPipeline.insert(resolvedPipeline.begin(), toPrepend.begin(), toPrepend.end());
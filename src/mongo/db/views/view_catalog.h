@@ -79,13 +79,17 @@ public:
      * database's catalog, so the check for an existing collection with the same name must be done
      * before calling createView.
      *
+     * A 'materialized' view must be defined on a collection by a pipeline accepted by
+     * validateMaterializedViewPipeline(). Creating its backing collection is up to the caller.
+     *
      * Must be in WriteUnitOfWork. View creation rolls back if the unit of work aborts.
      */
     Status createView(OperationContext* opCtx,
                       const NamespaceString& viewName,
                       const NamespaceString& viewOn,
                       const BSONArray& pipeline,
-                      const BSONObj& collation);
+                      const BSONObj& collation,
+                      bool materialized = false);
 
     /**
      * Drop the view named 'viewName'.
@@ -95,7 +99,8 @@ public:
     Status dropView(OperationContext* opCtx, const NamespaceString& viewName);
 
     /**
-     * Modify the view named 'viewName' to have the new 'viewOn' and 'pipeline'.
+     * Modify the view named 'viewName' to have the new 'viewOn' and 'pipeline'. Materialized views
+     * cannot be modified.
      *
      * Must be in WriteUnitOfWork. The modification rolls back if the unit of work aborts.
      */
@@ -110,6 +115,13 @@ public:
      */
     std::shared_ptr<ViewDefinition> lookup(OperationContext* opCtx, StringData nss);
 
+    /**
+     * Returns the materialized views defined on the collection 'viewOn'. Unlike other methods,
+     * returns no views rather than throwing if the catalog cannot be loaded.
+     */
+    std::vector<std::shared_ptr<ViewDefinition>> lookupMaterializedViewsOn(
+        OperationContext* opCtx, const NamespaceString& viewOn);
+
     /**
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
@@ -140,7 +152,8 @@ private:
                                       const NamespaceString& viewName,
                                       const NamespaceString& viewOn,
                                       const BSONArray& pipeline,
-                                      std::unique_ptr<CollatorInterface> collator);
+                                      std::unique_ptr<CollatorInterface> collator,
+                                      bool materialized);
     /**
      * Parses the view definition pipeline, attempts to upsert into the view graph, and refreshes
      * the graph if necessary. Returns an error status if the resulting graph would be invalid.
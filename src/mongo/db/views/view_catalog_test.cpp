@@ -561,6 +561,121 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectlyExtractsDefaultCollation) {
                       expectedCollation.getValue()->getSpec().toBSON());
 }
 
+TEST_F(ViewCatalogFixture, CannotCreateMaterializedViewWithUnsupportedStage) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+    auto pipeline = BSON_ARRAY(BSON("$sort" << BSON("a" << 1)));
+
+    ASSERT_EQ(
+        ErrorCodes::OptionNotSupportedOnView,
+        viewCatalog.createView(opCtx.get(), viewName, viewOn, pipeline, emptyCollation, true));
+}
+
+TEST_F(ViewCatalogFixture, CannotCreateMaterializedViewWithNonDecomposableAccumulator) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+    auto pipeline = BSON_ARRAY(BSON("$group" << BSON("_id"
+                                                     << "$a"
+                                                     << "avg"
+                                                     << BSON("$avg"
+                                                             << "$b"))));
+
+    ASSERT_EQ(
+        ErrorCodes::OptionNotSupportedOnView,
+        viewCatalog.createView(opCtx.get(), viewName, viewOn, pipeline, emptyCollation, true));
+}
+
+TEST_F(ViewCatalogFixture, CannotCreateMaterializedViewWhichChangesIdWithoutGroup) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+    auto pipeline = BSON_ARRAY(BSON("$project" << BSON("_id"
+                                                       << "$a")));
+
+    ASSERT_EQ(
+        ErrorCodes::OptionNotSupportedOnView,
+        viewCatalog.createView(opCtx.get(), viewName, viewOn, pipeline, emptyCollation, true));
+}
+
+TEST_F(ViewCatalogFixture, CannotCreateMaterializedViewWhichIncludesPathInsideId) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+    auto pipeline = BSON_ARRAY(BSON("$project" << BSON("_id.x" << 1)));
+
+    ASSERT_EQ(
+        ErrorCodes::OptionNotSupportedOnView,
+        viewCatalog.createView(opCtx.get(), viewName, viewOn, pipeline, emptyCollation, true));
+}
+
+TEST_F(ViewCatalogFixture, CannotCreateMaterializedViewOnView) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(), view1, viewOn, emptyPipeline, emptyCollation));
+    ASSERT_EQ(
+        ErrorCodes::OptionNotSupportedOnView,
+        viewCatalog.createView(opCtx.get(), view2, view1, emptyPipeline, emptyCollation, true));
+}
+
+TEST_F(ViewCatalogFixture, CannotModifyMaterializedView) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+
+    ASSERT_OK(
+        viewCatalog.createView(opCtx.get(), viewName, viewOn, emptyPipeline, emptyCollation, true));
+    ASSERT_EQ(ErrorCodes::OptionNotSupportedOnView,
+              viewCatalog.modifyView(opCtx.get(), viewName, viewOn, emptyPipeline));
+}
+
+TEST_F(ViewCatalogFixture, LookupMaterializedViewsOn) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString view3("db.view3");
+    const NamespaceString viewOn("db.coll");
+    const NamespaceString otherViewOn("db.other");
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(), view1, viewOn, emptyPipeline, emptyCollation));
+    ASSERT_OK(
+        viewCatalog.createView(opCtx.get(), view2, viewOn, emptyPipeline, emptyCollation, true));
+    ASSERT_OK(viewCatalog.createView(
+        opCtx.get(), view3, otherViewOn, emptyPipeline, emptyCollation, true));
+
+    auto views = viewCatalog.lookupMaterializedViewsOn(opCtx.get(), viewOn);
+    ASSERT_EQ(1U, views.size());
+    ASSERT_EQ(view2, views[0]->name());
+    ASSERT_EQ(NamespaceString("db.system.materialized.view2"), views[0]->backingNss());
+}
+
+TEST_F(ViewCatalogFixture, ResolveMaterializedViewReadsBackingCollection) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+    auto groupPipeline = BSON_ARRAY(BSON("$group" << BSON("_id"
+                                                          << "$a"
+                                                          << "total"
+                                                          << BSON("$sum"
+                                                                  << "$b"))));
+    auto matchPipeline = BSON_ARRAY(BSON("$match" << BSON("total" << BSON("$gt" << 1))));
+
+    ASSERT_OK(
+        viewCatalog.createView(opCtx.get(), view1, viewOn, groupPipeline, emptyCollation, true));
+    ASSERT_OK(viewCatalog.createView(opCtx.get(), view2, view1, matchPipeline, emptyCollation));
+
+    auto resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(NamespaceString("db.system.materialized.view1"),
+              resolvedView.getValue().getNamespace());
+
+    std::vector<BSONObj> expected = {BSON("$project" << BSON("__mvCount" << 0)),
+                                     BSON("$match" << BSON("total" << BSON("$gt" << 1)))};
+    std::vector<BSONObj> result = resolvedView.getValue().getPipeline();
+
+    ASSERT_EQ(expected.size(), result.size());
+    for (uint32_t i = 0; i < expected.size(); i++) {
+        ASSERT_BSONOBJ_EQ(expected[i], result[i]);
+    }
+}
+
 TEST_F(ViewCatalogFixture, InvalidateThenReload) {
     const NamespaceString viewName("db.view");
     const NamespaceString viewOn("db.coll");
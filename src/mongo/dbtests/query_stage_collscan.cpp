@@ -44,10 +44,12 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageCollectionScan {
 
@@ -78,6 +80,10 @@ public:
         _client.dropCollection(nss.ns());
     }
 
+    void insert(const BSONObj& obj) {
+        _client.insert(nss.ns(), obj);
+    }
+
     void remove(const BSONObj& obj) {
         _client.remove(nss.ns(), obj);
     }
@@ -390,6 +396,67 @@ public:
     }
 };
 
+//
+// Filter in batches over several threads and still return matches in order.
+//
+
+class QueryStageCollscanParallelFilter : public QueryStageCollectionScanBase {
+public:
+    void run() {
+        const int numExtraObj = 1000;
+        {
+            dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+            for (int i = numObj(); i < numObj() + numExtraObj; ++i) {
+                insert(BSON("foo" << i));
+            }
+        }
+
+        const int oldThreads = internalQueryExecCollScanFilterThreads.load();
+        const int oldBatchSize = internalQueryExecCollScanFilterBatchSize.load();
+        internalQueryExecCollScanFilterThreads.store(3);
+        internalQueryExecCollScanFilterBatchSize.store(300);
+        ON_BLOCK_EXIT([&] {
+            internalQueryExecCollScanFilterThreads.store(oldThreads);
+            internalQueryExecCollScanFilterBatchSize.store(oldBatchSize);
+        });
+
+        AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+
+        CollectionScanParams params;
+        params.collection = ctx.getCollection();
+        params.direction = CollectionScanParams::FORWARD;
+        params.tailable = false;
+
+        const boost::intrusive_ptr<ExpressionContext> expCtx(
+            new ExpressionContext(&_opCtx, nullptr));
+        auto statusWithMatcher =
+            MatchExpressionParser::parse(fromjson("{foo: {$mod: [3, 0]}}"), expCtx);
+        ASSERT_OK(statusWithMatcher.getStatus());
+        unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+        WorkingSet ws;
+        CollectionScan scan(&_opCtx, params, &ws, filterExpr.get());
+
+        int expected = 0;
+        while (!scan.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = scan.work(&id);
+            ASSERT_NOT_EQUALS(PlanStage::FAILURE, state);
+            if (PlanStage::ADVANCED == state) {
+                ASSERT_EQUALS(expected, ws.get(id)->obj.value()["foo"].numberInt());
+                expected += 3;
+                ws.free(id);
+            }
+        }
+        ASSERT_EQUALS(numObj() + numExtraObj, expected);
+
+        auto stats = static_cast<const CollectionScanStats*>(scan.getSpecificStats());
+        ASSERT_EQUALS(3U, stats->filterThreads);
+        ASSERT_EQUALS(4U, stats->filterBatches);
+        ASSERT_EQUALS(static_cast<size_t>(numObj() + numExtraObj), stats->docsTested);
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("QueryStageCollectionScan") {}
@@ -404,6 +471,7 @@ public:
         add<QueryStageCollscanObjectsInOrderBackward>();
         add<QueryStageCollscanDeleteUpcomingObject>();
         add<QueryStageCollscanDeleteUpcomingObjectBackward>();
+        add<QueryStageCollscanParallelFilter>();
     }
 };
 
@@ -40,6 +40,7 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
@@ -219,6 +220,76 @@ public:
     }
 };
 
+//
+// Test that a batched fetch reads the records of each batch in RecordId order, and returns them in
+// the order of its child unless told that the order does not matter.
+//
+class FetchStageBatched : public QueryStageFetchBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = db->getCollection(&_opCtx, ns());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(10), recordIds.size());
+
+        // The child returns the records in reverse RecordId order, so in batches of 4 the order of
+        // the results is 9 8 7 6 | 5 4 3 2 | 1 0, and within each batch every record but the first
+        // would be a backward seek.
+        const std::vector<int> childOrder = {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+        ASSERT(runBatched(coll, recordIds, true) == childOrder);
+
+        const std::vector<int> recordIdOrder = {6, 7, 8, 9, 2, 3, 4, 5, 0, 1};
+        ASSERT(runBatched(coll, recordIds, false) == recordIdOrder);
+    }
+
+private:
+    std::vector<int> runBatched(Collection* coll,
+                                const set<RecordId>& recordIds,
+                                bool preserveOrder) {
+        WorkingSet ws;
+        auto mockStage = make_unique<QueuedDataStage>(&_opCtx, &ws);
+        for (auto it = recordIds.rbegin(); it != recordIds.rend(); ++it) {
+            WorkingSetID id = ws.allocate();
+            WorkingSetMember* mockMember = ws.get(id);
+            mockMember->recordId = *it;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        FetchStage fetchStage(&_opCtx, &ws, mockStage.release(), nullptr, coll, 4, preserveOrder);
+
+        std::vector<int> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state;
+        while ((state = fetchStage.work(&id)) != PlanStage::IS_EOF) {
+            ASSERT(state == PlanStage::ADVANCED || state == PlanStage::NEED_TIME);
+            if (state == PlanStage::ADVANCED) {
+                results.push_back(ws.get(id)->obj.value()["foo"].numberInt());
+                ws.free(id);
+            }
+        }
+
+        const FetchStats* stats = static_cast<const FetchStats*>(fetchStage.getSpecificStats());
+        ASSERT_EQUALS(size_t(4), stats->batchSize);
+        ASSERT_EQUALS(size_t(3), stats->batches);
+        ASSERT_EQUALS(size_t(10), stats->docsFetchedInBatches);
+        ASSERT_EQUALS(size_t(7), stats->backwardSeeksAvoided);
+        ASSERT_EQUALS(size_t(10), stats->docsExamined);
+        return results;
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_fetch") {}
@@ -226,6 +297,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageBatched>();
     }
 };
 
@@ -45,6 +45,9 @@
 #include "mongo/db/logical_time.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/find.h"
+#include "mongo/db/query/point_read.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_request.h"
 #include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/util/timer.h"
@@ -906,6 +909,115 @@ public:
     }
 };
 
+/**
+ * Finds for a single key of a unique index can be answered without building a query plan.
+ */
+class PointReadEligibility : public ClientBase {
+public:
+    ~PointReadEligibility() {
+        _client.dropCollection(ns);
+    }
+    void run() {
+        ASSERT_OK(dbtests::createIndex(&_opCtx, ns, BSON("a" << 1), true));
+        ASSERT_OK(dbtests::createIndex(&_opCtx, ns, BSON("b" << 1)));
+        insert(ns, BSON("_id" << 1 << "a" << 1 << "b" << 1));
+
+        ASSERT_TRUE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1))));
+        ASSERT_TRUE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << "x"))));
+        ASSERT_TRUE(isPointRead(BSON("find" << coll << "filter" << BSON("a" << 1))));
+        ASSERT_TRUE(isPointRead(BSON("find" << coll << "filter" << BSON("a" << 1) << "projection"
+                                            << BSON("a" << 1 << "_id" << 0))));
+        ASSERT_TRUE(isPointRead(
+            BSON("find" << coll << "filter" << BSON("_id" << 1) << "singleBatch" << true)));
+
+        // 'b' is indexed, but not uniquely.
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSON("b" << 1))));
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSONObj())));
+        ASSERT_FALSE(
+            isPointRead(BSON("find" << coll << "filter" << BSON("_id" << BSON("$gt" << 1)))));
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << BSONNULL))));
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1 << "a" << 1))));
+        ASSERT_FALSE(isPointRead(
+            BSON("find" << coll << "filter" << BSON("_id" << 1) << "sort" << BSON("a" << 1))));
+        ASSERT_FALSE(
+            isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1) << "skip" << 1)));
+        ASSERT_FALSE(
+            isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1) << "batchSize" << 0)));
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1) << "collation"
+                                             << BSON("locale"
+                                                     << "simple"))));
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1) << "projection"
+                                             << BSON("_id" << 0))));
+        ASSERT_FALSE(isPointRead(BSON("find" << coll << "filter" << BSON("_id" << 1) << "projection"
+                                             << BSON("a.c" << 1))));
+    }
+
+private:
+    bool isPointRead(const BSONObj& cmd) {
+        const bool isExplain = false;
+        auto qr = unittest::assertGet(
+            QueryRequest::makeFromFindCommand(NamespaceString(ns), cmd, isExplain));
+        AutoGetCollectionForReadCommand ctx(&_opCtx, NamespaceString(ns));
+        return static_cast<bool>(PointRead::make(&_opCtx, ctx.getCollection(), *qr));
+    }
+
+    static constexpr const char* ns = "unittests.querytests.PointReadEligibility";
+    static constexpr const char* coll = "querytests.PointReadEligibility";
+};
+
+/**
+ * Point reads return the same documents whether or not they are answered by the fast path.
+ */
+class PointReadResults : public ClientBase {
+public:
+    ~PointReadResults() {
+        internalQueryEnablePointReadFastPath.store(true);
+        _client.dropCollection(ns);
+    }
+    void run() {
+        ASSERT_OK(dbtests::createIndex(&_opCtx, ns, BSON("a" << 1), true));
+        insert(ns, BSON("_id" << 1 << "a" << 10 << "b" << 100));
+        insert(ns, BSON("_id" << 2 << "a" << BSON_ARRAY(20 << 21) << "b" << 200));
+        insert(ns, BSON("_id" << BSON("x" << 1) << "a" << 30 << "b" << 300));
+
+        for (bool fastPath : {true, false}) {
+            internalQueryEnablePointReadFastPath.store(fastPath);
+
+            ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "a" << 10 << "b" << 100),
+                              findOne(BSON("_id" << 1), BSONObj()));
+            ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "a" << 10 << "b" << 100),
+                              findOne(BSON("_id" << 1.0), BSONObj()));
+            ASSERT_BSONOBJ_EQ(BSON("_id" << BSON("x" << 1) << "b" << 300),
+                              findOne(BSON("_id" << BSON("x" << 1)), BSON("b" << 1)));
+            ASSERT_BSONOBJ_EQ(BSON("b" << 200),
+                              findOne(BSON("a" << 21), BSON("b" << 1 << "_id" << 0)));
+            ASSERT_BSONOBJ_EQ(BSONObj(), findOne(BSON("_id" << 3), BSONObj()));
+            ASSERT_BSONOBJ_EQ(BSONObj(), findOne(BSON("a" << 11), BSONObj()));
+        }
+    }
+
+private:
+    /**
+     * Runs a find command for 'filter', and returns the only document in the reply or an empty
+     * object if there is none.
+     */
+    BSONObj findOne(const BSONObj& filter, const BSONObj& projection) {
+        BSONObj res;
+        ASSERT_TRUE(_client.runCommand("unittests",
+                                       BSON("find" << coll << "filter" << filter << "projection"
+                                                   << projection),
+                                       res))
+            << res;
+        ASSERT_EQUALS(0LL, res["cursor"]["id"].numberLong());
+        const auto batch = res["cursor"]["firstBatch"].Array();
+        ASSERT_LTE(batch.size(), 1U);
+        return batch.empty() ? BSONObj() : batch[0].Obj().getOwned();
+    }
+
+    static constexpr const char* ns = "unittests.querytests.PointReadResults";
+    static constexpr const char* coll = "querytests.PointReadResults";
+};
+
 class SubobjectInArray : public ClientBase {
 public:
     ~SubobjectInArray() {
@@ -1839,6 +1951,8 @@ public:
         add<AutoResetIndexCache>();
         add<UniqueIndex>();
         add<UniqueIndexPreexistingData>();
+        add<PointReadEligibility>();
+        add<PointReadResults>();
         add<SubobjectInArray>();
         add<Size>();
         add<FullArray>();
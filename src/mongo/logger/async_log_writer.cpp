@@ -0,0 +1,293 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/logger/async_log_writer.h"
+
+#include <algorithm>
+
+#include "mongo/base/status.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/stdx/chrono.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace logger {
+
+Counter64 asyncLogMessagesWritten;
+Counter64 asyncLogMessagesDropped;
+Counter64 asyncLogMessagesBlocked;
+
+namespace {
+
+/**
+ * All AsyncLogWriters of the process, so that they can be flushed before exiting. Never
+ * destroyed, since the process may exit while static destructors run.
+ */
+struct Registry {
+    stdx::mutex mutex;
+    std::vector<AsyncLogWriter*> writers;
+};
+
+// Set on the background thread of each AsyncLogWriter.
+thread_local bool isWriterThread = false;
+
+Registry& registry() {
+    static auto* const theRegistry = new Registry;
+    return *theRegistry;
+}
+
+size_t roundUpToPowerOfTwo(size_t n) {
+    size_t result = 2;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+const Milliseconds AsyncLogWriter::kCrashFlushTimeout = Seconds(1);
+const Milliseconds AsyncLogWriter::kRotateFlushTimeout = Seconds(10);
+
+StatusWith<AsyncLogWriter::OverflowPolicy> AsyncLogWriter::parseOverflowPolicy(
+    StringData policy) {
+    if (policy == "block"_sd) {
+        return OverflowPolicy::kBlock;
+    }
+    if (policy == "drop"_sd) {
+        return OverflowPolicy::kDrop;
+    }
+    return Status(ErrorCodes::BadValue,
+                  str::stream() << "Unknown log overflow policy '" << policy
+                                << "', expected 'block' or 'drop'");
+}
+
+AsyncLogWriter::AsyncLogWriter(RotatableFileWriter* writer,
+                               size_t capacity,
+                               OverflowPolicy policy)
+    : _writer(writer),
+      _policy(policy),
+      _mask(roundUpToPowerOfTwo(capacity) - 1),
+      _slots(new Slot[_mask + 1]) {
+    for (size_t i = 0; i <= _mask; ++i) {
+        _slots[i].sequence.store(i);
+    }
+    _batch.reserve(_mask + 1);
+
+    _thread = stdx::thread([this] { _run(); });
+
+    stdx::lock_guard<stdx::mutex> lk(registry().mutex);
+    registry().writers.push_back(this);
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(registry().mutex);
+        auto& writers = registry().writers;
+        writers.erase(std::remove(writers.begin(), writers.end(), this), writers.end());
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _shutdown = true;
+    }
+    _messagesAvailable.notify_one();
+    _thread.join();
+}
+
+bool AsyncLogWriter::push(std::string message) {
+    if (!_tryPush(&message)) {
+        if (_policy == OverflowPolicy::kDrop) {
+            asyncLogMessagesDropped.increment();
+            return false;
+        }
+        asyncLogMessagesBlocked.increment();
+        _pushBlocking(&message);
+    }
+
+    // The background thread sets '_writerWaiting' before checking for messages one last time, so
+    // either it sees this message or it is woken up here.
+    if (_writerWaiting.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _writerWaiting.store(false);
+        _messagesAvailable.notify_one();
+    }
+    return true;
+}
+
+bool AsyncLogWriter::flush(Milliseconds timeout) {
+    if (onWriterThread()) {
+        return false;
+    }
+
+    const auto pushed = _pushPos.load();
+    const auto allWritten = [&] { return _writtenCount.load() >= pushed; };
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _flushersWaiting.addAndFetch(1);
+    bool written = true;
+    if (timeout == Milliseconds::max()) {
+        _messagesWritten.wait(lk, allWritten);
+    } else {
+        written = _messagesWritten.wait_for(lk, timeout.toSystemDuration(), allWritten);
+    }
+    _flushersWaiting.subtractAndFetch(1);
+    return written;
+}
+
+bool AsyncLogWriter::flushAll(Milliseconds timeout) {
+    invariant(timeout != Milliseconds::max());
+    const auto deadline = stdx::chrono::steady_clock::now() + timeout.toSystemDuration();
+
+    stdx::lock_guard<stdx::mutex> lk(registry().mutex);
+    bool flushed = true;
+    for (auto* writer : registry().writers) {
+        const auto remaining = std::max(
+            Milliseconds(0),
+            duration_cast<Milliseconds>(deadline - stdx::chrono::steady_clock::now()));
+        flushed = writer->flush(remaining) && flushed;
+    }
+    return flushed;
+}
+
+bool AsyncLogWriter::onWriterThread() {
+    return isWriterThread;
+}
+
+bool AsyncLogWriter::_tryPush(std::string* message) {
+    auto pos = _pushPos.load();
+    while (true) {
+        Slot& slot = _slots[pos & _mask];
+        const auto sequence = slot.sequence.load();
+        if (sequence == pos) {
+            const auto actual = _pushPos.compareAndSwap(pos, pos + 1);
+            if (actual == pos) {
+                slot.message = std::move(*message);
+                slot.sequence.store(pos + 1);
+                return true;
+            }
+            pos = actual;
+        } else if (sequence < pos) {
+            // The slot still holds the message pushed one lap earlier, so the buffer is full.
+            return false;
+        } else {
+            // Another thread pushed into this slot since we read the position.
+            pos = _pushPos.load();
+        }
+    }
+}
+
+void AsyncLogWriter::_pushBlocking(std::string* message) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _pushersWaiting.addAndFetch(1);
+    // The background thread checks '_pushersWaiting' after making room, so either the push
+    // succeeds here or the background thread wakes us up.
+    _spaceAvailable.wait(lk, [&] { return _tryPush(message); });
+    _pushersWaiting.subtractAndFetch(1);
+}
+
+bool AsyncLogWriter::_takeBatch() {
+    // Take at most one buffer's worth, so that the batch is bounded even if producers keep
+    // refilling the slots as they are freed.
+    while (_batch.size() <= _mask) {
+        Slot& slot = _slots[_popPos & _mask];
+        if (slot.sequence.load() != _popPos + 1) {
+            break;
+        }
+        _batch.push_back(std::move(slot.message));
+        slot.message.clear();
+        slot.sequence.store(_popPos + _mask + 1);
+        ++_popPos;
+    }
+    return !_batch.empty();
+}
+
+void AsyncLogWriter::_writeBatch() {
+    {
+        RotatableFileWriter::Use useWriter(_writer);
+        if (useWriter.status().isOK()) {
+            auto& stream = useWriter.stream();
+            for (const auto& message : _batch) {
+                stream.write(message.data(), message.size());
+            }
+            stream.flush();
+        }
+
+        if (useWriter.status().isOK()) {
+            asyncLogMessagesWritten.increment(_batch.size());
+        } else {
+            asyncLogMessagesDropped.increment(_batch.size());
+        }
+    }
+
+    _writtenCount.fetchAndAdd(_batch.size());
+    _batch.clear();
+
+    if (_flushersWaiting.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _messagesWritten.notify_all();
+    }
+}
+
+void AsyncLogWriter::_run() {
+    setThreadName("AsyncLogWriter");
+    isWriterThread = true;
+
+    while (true) {
+        if (!_takeBatch()) {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
+            _writerWaiting.store(true);
+            // Pushers check '_writerWaiting' after publishing a message, so either the message is
+            // taken here or its pusher wakes us up.
+            if (!_takeBatch()) {
+                if (_shutdown) {
+                    _writerWaiting.store(false);
+                    return;
+                }
+                _messagesAvailable.wait(lk, [&] { return !_writerWaiting.load() || _shutdown; });
+                _writerWaiting.store(false);
+                continue;
+            }
+            _writerWaiting.store(false);
+        }
+
+        if (_pushersWaiting.load()) {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _spaceAvailable.notify_all();
+        }
+
+        _writeBatch();
+    }
+}
+
+}  // namespace logger
+}  // namespace mongo
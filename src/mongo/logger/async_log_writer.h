@@ -0,0 +1,199 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/counter.h"
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/new.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+namespace logger {
+
+class RotatableFileWriter;
+
+/**
+ * Process-wide counts of the messages handled by all AsyncLogWriters, reported by serverStatus.
+ */
+extern Counter64 asyncLogMessagesWritten;
+extern Counter64 asyncLogMessagesDropped;
+extern Counter64 asyncLogMessagesBlocked;
+
+/**
+ * Writes formatted log messages to a RotatableFileWriter on a background thread, so that the
+ * threads which log do not wait for disk I/O or for the writer's mutex.
+ *
+ * Messages are handed to the background thread through a bounded ring buffer with one slot per
+ * message. Any number of threads may push messages concurrently without taking a lock, as long as
+ * the buffer has room. The background thread writes all the messages it finds under a single
+ * RotatableFileWriter::Use, so log rotation, which goes through the same writer, keeps working and
+ * only ever happens between whole messages.
+ *
+ * When the buffer is full, push() either waits for the background thread to make room or drops
+ * the message, depending on the OverflowPolicy.
+ */
+class AsyncLogWriter {
+    MONGO_DISALLOW_COPYING(AsyncLogWriter);
+
+public:
+    enum class OverflowPolicy { kBlock, kDrop };
+
+    /**
+     * Parses "block" or "drop" into an OverflowPolicy.
+     */
+    static StatusWith<OverflowPolicy> parseOverflowPolicy(StringData policy);
+
+    /**
+     * Starts the background thread, which writes to 'writer'. The caller must keep 'writer' alive
+     * at least as long as the constructed AsyncLogWriter. 'capacity' is the number of messages
+     * the buffer can hold, and is rounded up to a power of two.
+     */
+    AsyncLogWriter(RotatableFileWriter* writer, size_t capacity, OverflowPolicy policy);
+
+    /**
+     * Writes out all messages still in the buffer and stops the background thread.
+     */
+    ~AsyncLogWriter();
+
+    /**
+     * Queues 'message' for writing. Returns false if the buffer was full and the message was
+     * dropped.
+     */
+    bool push(std::string message);
+
+    /**
+     * How long to wait for the background thread before logging a severe message or exiting. The
+     * process may be crashing because that thread is stuck, so it is not waited for indefinitely.
+     */
+    static const Milliseconds kCrashFlushTimeout;
+
+    /**
+     * How long to wait for the background threads before rotating the logs. Messages which are
+     * not written by then may end up in the new file, which is better than blocking the rotation,
+     * and the threads which wait to log, behind a stuck disk.
+     */
+    static const Milliseconds kRotateFlushTimeout;
+
+    /**
+     * Waits until every message pushed before this call has been written, or until 'timeout' has
+     * passed. Returns true if every such message was written. Returns false straight away when
+     * called on the background thread itself, which cannot wait for its own progress.
+     */
+    bool flush(Milliseconds timeout = Milliseconds::max());
+
+    /**
+     * Flushes all AsyncLogWriters of the process, waiting at most 'timeout' for all of them
+     * together. Called before exiting and before rotating the logs, so that no message that was
+     * logged earlier is lost or ends up in the new file. Returns true if every writer was flushed.
+     *
+     * The wait is always bounded, since it holds the mutex which writers being created or
+     * destroyed must take.
+     */
+    static bool flushAll(Milliseconds timeout);
+
+    /**
+     * Returns true if called on the background thread of any AsyncLogWriter.
+     */
+    static bool onWriterThread();
+
+    RotatableFileWriter* getWriter() const {
+        return _writer;
+    }
+
+private:
+    struct Slot {
+        // Equal to the position of the next push into this slot, or to that position plus one
+        // once the slot has been filled and can be written out.
+        AtomicWord<unsigned long long> sequence;
+        std::string message;
+    };
+
+    bool _tryPush(std::string* message);
+
+    /**
+     * Waits until the message can be pushed, under '_mutex'. Only used by the kBlock policy.
+     */
+    void _pushBlocking(std::string* message);
+
+    /**
+     * Moves the messages which are ready to be written from the buffer to '_batch'. Returns false
+     * if there were none.
+     */
+    bool _takeBatch();
+
+    void _writeBatch();
+
+    void _run();
+
+    RotatableFileWriter* const _writer;
+    const OverflowPolicy _policy;
+    const size_t _mask;
+
+    std::unique_ptr<Slot[]> _slots;
+
+    // Position of the next push. Producers claim positions by incrementing it.
+    alignas(stdx::hardware_destructive_interference_size) AtomicWord<unsigned long long> _pushPos;
+
+    // Position of the next slot the background thread reads. Only accessed by that thread.
+    alignas(stdx::hardware_destructive_interference_size) unsigned long long _popPos = 0;
+
+    // Number of messages which have been written out. Waited upon by flush().
+    AtomicWord<unsigned long long> _writtenCount;
+
+    // Messages taken from the buffer by the background thread, but not yet written.
+    std::vector<std::string> _batch;
+
+    // Set while the background thread waits for messages, and while producers wait for space in
+    // the buffer. Checked after pushing or taking messages, so that the lock-free paths only
+    // take '_mutex' when somebody needs to be woken up.
+    AtomicWord<bool> _writerWaiting;
+    AtomicWord<int> _pushersWaiting;
+    AtomicWord<int> _flushersWaiting;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _messagesAvailable;
+    stdx::condition_variable _spaceAvailable;
+    stdx::condition_variable _messagesWritten;
+    bool _shutdown = false;
+
+    stdx::thread _thread;
+};
+
+}  // namespace logger
+}  // namespace mongo
@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+using namespace mongo;
+using namespace mongo::logger;
+
+const std::string logFileName("LogTest_AsyncLogWriter.txt");
+const std::string logFileNameRotated("LogTest_AsyncLogWriter_Rotated.txt");
+
+class AsyncLogWriterTest : public mongo::unittest::Test {
+public:
+    AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+        unlink(logFileNameRotated.c_str());
+        ASSERT_OK(RotatableFileWriter::Use(&_writer).setFileName(logFileName, false));
+    }
+
+    virtual ~AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+        unlink(logFileNameRotated.c_str());
+    }
+
+    std::vector<std::string> readLines(const std::string& fileName) {
+        std::ifstream ifs(fileName.c_str());
+        ASSERT_TRUE(ifs.is_open());
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(ifs, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+protected:
+    RotatableFileWriter _writer;
+};
+
+TEST_F(AsyncLogWriterTest, FlushWritesMessagesInOrder) {
+    AsyncLogWriter asyncWriter(&_writer, 8, AsyncLogWriter::OverflowPolicy::kBlock);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(asyncWriter.push(std::to_string(i) + "\n"));
+    }
+    asyncWriter.flush();
+
+    auto lines = readLines(logFileName);
+    ASSERT_EQUALS(lines.size(), 1000U);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQUALS(lines[i], std::to_string(i));
+    }
+}
+
+TEST_F(AsyncLogWriterTest, ConcurrentPushersKeepEachThreadsOrder) {
+    const int kThreads = 4;
+    const int kMessagesPerThread = 2000;
+    {
+        AsyncLogWriter asyncWriter(&_writer, 16, AsyncLogWriter::OverflowPolicy::kBlock);
+        std::vector<stdx::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&asyncWriter, t] {
+                for (int i = 0; i < kMessagesPerThread; ++i) {
+                    asyncWriter.push(std::to_string(t) + " " + std::to_string(i) + "\n");
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        // Destroying the writer writes out the remaining messages.
+    }
+
+    auto lines = readLines(logFileName);
+    ASSERT_EQUALS(lines.size(), size_t(kThreads * kMessagesPerThread));
+    std::vector<int> next(kThreads, 0);
+    for (const auto& line : lines) {
+        const auto space = line.find(' ');
+        const int t = std::stoi(line.substr(0, space));
+        ASSERT_EQUALS(std::stoi(line.substr(space + 1)), next[t]);
+        ++next[t];
+    }
+}
+
+TEST_F(AsyncLogWriterTest, DropPolicyCountsDroppedMessages) {
+    const auto droppedBefore = asyncLogMessagesDropped.get();
+    const auto writtenBefore = asyncLogMessagesWritten.get();
+    long long pushed = 0;
+    {
+        AsyncLogWriter asyncWriter(&_writer, 2, AsyncLogWriter::OverflowPolicy::kDrop);
+
+        // Holding the writer keeps the background thread from writing, so the buffer fills up.
+        RotatableFileWriter::Use useWriter(&_writer);
+        for (int i = 0; i < 100; ++i) {
+            if (asyncWriter.push("message\n")) {
+                ++pushed;
+            }
+        }
+    }
+
+    ASSERT_LT(pushed, 100);
+    ASSERT_EQUALS(asyncLogMessagesDropped.get() - droppedBefore, 100LL - pushed);
+    ASSERT_EQUALS(asyncLogMessagesWritten.get() - writtenBefore, pushed);
+    ASSERT_EQUALS(readLines(logFileName).size(), size_t(pushed));
+}
+
+TEST_F(AsyncLogWriterTest, FlushBeforeRotationKeepsMessagesInOldFile) {
+    AsyncLogWriter asyncWriter(&_writer, 8, AsyncLogWriter::OverflowPolicy::kBlock);
+    asyncWriter.push("Level 1 message.\n");
+    asyncWriter.push("Level 2 message.\n");
+    ASSERT_TRUE(AsyncLogWriter::flushAll(AsyncLogWriter::kRotateFlushTimeout));
+    ASSERT_OK(RotatableFileWriter::Use(&_writer).rotate(true, logFileNameRotated));
+    asyncWriter.push("Level 3 message.\n");
+    asyncWriter.flush();
+
+    auto rotated = readLines(logFileNameRotated);
+    ASSERT_EQUALS(rotated.size(), 2U);
+    ASSERT_EQUALS(rotated[0], "Level 1 message.");
+    ASSERT_EQUALS(rotated[1], "Level 2 message.");
+
+    auto current = readLines(logFileName);
+    ASSERT_EQUALS(current.size(), 1U);
+    ASSERT_EQUALS(current[0], "Level 3 message.");
+}
+
+TEST_F(AsyncLogWriterTest, FlushGivesUpOnStuckWriterAfterTimeout) {
+    AsyncLogWriter asyncWriter(&_writer, 8, AsyncLogWriter::OverflowPolicy::kBlock);
+    ASSERT_FALSE(AsyncLogWriter::onWriterThread());
+    {
+        // Holding the writer keeps the background thread from writing.
+        RotatableFileWriter::Use useWriter(&_writer);
+        asyncWriter.push("message\n");
+        ASSERT_FALSE(asyncWriter.flush(Milliseconds(10)));
+    }
+    ASSERT_TRUE(asyncWriter.flush());
+    ASSERT_EQUALS(readLines(logFileName).size(), 1U);
+}
+
+TEST_F(AsyncLogWriterTest, FlushAllGivesUpOnStuckWriterAfterTimeout) {
+    AsyncLogWriter asyncWriter(&_writer, 8, AsyncLogWriter::OverflowPolicy::kBlock);
+    {
+        // Holding the writer keeps the background thread from writing.
+        RotatableFileWriter::Use useWriter(&_writer);
+        asyncWriter.push("message\n");
+        ASSERT_FALSE(AsyncLogWriter::flushAll(Milliseconds(10)));
+    }
+    ASSERT_TRUE(AsyncLogWriter::flushAll(AsyncLogWriter::kRotateFlushTimeout));
+    ASSERT_EQUALS(readLines(logFileName).size(), 1U);
+}
+
+TEST(AsyncLogWriterOverflowPolicy, Parse) {
+    ASSERT(AsyncLogWriter::parseOverflowPolicy("block").getValue() ==
+           AsyncLogWriter::OverflowPolicy::kBlock);
+    ASSERT(AsyncLogWriter::parseOverflowPolicy("drop").getValue() ==
+           AsyncLogWriter::OverflowPolicy::kDrop);
+    ASSERT_EQUALS(AsyncLogWriter::parseOverflowPolicy("wait").getStatus(), ErrorCodes::BadValue);
+}
+
+}  // namespace
@@ -32,6 +32,7 @@
 
 #include "mongo/shell/bench.h"
 
+#include <cmath>
 #include <pcrecpp.h>
 
 #include "mongo/client/dbclient_cursor.h"
@@ -39,6 +40,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_request.h"
+#include "mongo/platform/bits.h"
 #include "mongo/scripting/bson_template_evaluator.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
@@ -321,13 +323,87 @@ Timestamp getAClusterTimeSecondsInThePast(DBClientBase* conn, int numSecondsInTh
     return Timestamp(latestTimestamp.getSecs() - numSecondsInThePast, latestTimestamp.getInc());
 }
 
+// Latency histograms record values below kLatencySubBucketCount exactly, and larger values with
+// the kLatencySubBucketCount / 2 sub-buckets of each power of two above that, up to the power of
+// two kLatencyMaxMagnitude.
+const size_t kLatencySubBucketCount = 256;
+const size_t kLatencySubBucketHalfCount = kLatencySubBucketCount / 2;
+const int kLatencySubBucketMagnitude = 8;
+const int kLatencyMaxMagnitude = 35;
+const size_t kLatencyBucketCount = kLatencySubBucketCount +
+    (kLatencyMaxMagnitude - kLatencySubBucketMagnitude + 1) * kLatencySubBucketHalfCount;
+
 }  // namespace
 
+size_t BenchRunLatencyHistogram::indexForValue(long long micros) {
+    if (micros < static_cast<long long>(kLatencySubBucketCount)) {
+        return std::max(micros, 0LL);
+    }
+    const int magnitude =
+        std::min(63 - countLeadingZeros64(micros), kLatencyMaxMagnitude);
+    const int shift = magnitude - kLatencySubBucketMagnitude + 1;
+    const long long subBucket = std::min(micros >> shift, (1LL << kLatencySubBucketMagnitude) - 1);
+    return kLatencySubBucketCount + (shift - 1) * kLatencySubBucketHalfCount +
+        (subBucket - kLatencySubBucketHalfCount);
+}
+
+long long BenchRunLatencyHistogram::highestValueForIndex(size_t index) {
+    if (index < kLatencySubBucketCount) {
+        return index;
+    }
+    const size_t offset = index - kLatencySubBucketCount;
+    const int shift = offset / kLatencySubBucketHalfCount + 1;
+    const long long subBucket = offset % kLatencySubBucketHalfCount + kLatencySubBucketHalfCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void BenchRunLatencyHistogram::record(long long micros) {
+    if (_counts.empty()) {
+        _counts.resize(kLatencyBucketCount);
+    }
+    ++_counts[indexForValue(micros)];
+    ++_count;
+    _max = std::max(_max, micros);
+}
+
+void BenchRunLatencyHistogram::updateFrom(const BenchRunLatencyHistogram& other) {
+    if (other._counts.empty()) {
+        return;
+    }
+    if (_counts.empty()) {
+        _counts.resize(kLatencyBucketCount);
+    }
+    for (size_t i = 0; i < kLatencyBucketCount; ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _max = std::max(_max, other._max);
+}
+
+long long BenchRunLatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    // The rank of the requested value, counting from 1.
+    const long long rank = std::max(
+        1LL, static_cast<long long>(std::ceil(percentile / 100.0 * static_cast<double>(_count))));
+    long long seen = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        seen += _counts[i];
+        if (seen >= rank) {
+            return std::min(highestValueForIndex(i), _max);
+        }
+    }
+    return _max;
+}
+
 BenchRunEventCounter::BenchRunEventCounter() = default;
 
 void BenchRunEventCounter::updateFrom(const BenchRunEventCounter& other) {
     _numEvents += other._numEvents;
     _totalTimeMicros += other._totalTimeMicros;
+    _latencies.updateFrom(other._latencies);
 }
 
 void BenchRunStats::updateFrom(const BenchRunStats& other) {
@@ -346,6 +422,13 @@ void BenchRunStats::updateFrom(const BenchRunStats& other) {
     for (const auto& trappedError : other.trappedErrors) {
         trappedErrors.push_back(trappedError);
     }
+
+    if (throughputSeries.size() < other.throughputSeries.size()) {
+        throughputSeries.resize(other.throughputSeries.size());
+    }
+    for (size_t i = 0; i < other.throughputSeries.size(); ++i) {
+        throughputSeries[i] += other.throughputSeries[i];
+    }
 }
 
 BenchRunConfig::BenchRunConfig() {
@@ -696,6 +779,16 @@ void BenchRunConfig::initializeFromBson(const BSONObj& args) {
                                   << typeName(arg.type()),
                     arg.isNumber());
             delayMillisOnFailedOperation = Milliseconds(arg.numberInt());
+        } else if (name == "opsPerSecond") {
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Field '" << name << "' should be a non-negative number",
+                    arg.isNumber() && arg.number() >= 0);
+            opsPerSecond = arg.number();
+        } else if (name == "throughputIntervalSeconds") {
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Field '" << name << "' should be a non-negative number",
+                    arg.isNumber() && arg.number() >= 0);
+            throughputIntervalSeconds = arg.number();
         } else if (name == "hideResults") {
             hideResults = arg.trueValue();
         } else if (name == "handleErrors") {
@@ -752,7 +845,8 @@ BenchRunState::BenchRunState(unsigned numWorkers)
       _numUnstartedWorkers(numWorkers),
       _numActiveWorkers(0),
       _isShuttingDown(0),
-      _isCollectingStats(0) {}
+      _isCollectingStats(0),
+      _statsCollectionStartMicros(0) {}
 
 BenchRunState::~BenchRunState() {
     if (_numActiveWorkers != 0)
@@ -787,6 +881,7 @@ void BenchRunState::tellWorkersToFinish() {
 }
 
 void BenchRunState::tellWorkersToCollectStats() {
+    _statsCollectionStartMicros.store(_timer.micros());
     _isCollectingStats.store(1);
 }
 
@@ -800,7 +895,12 @@ bool BenchRunState::shouldWorkerFinish() const {
 }
 
 bool BenchRunState::shouldWorkerCollectStats() const {
-    return (_isCollectingStats.loadRelaxed() == 1);
+    // Not relaxed, so that a worker which collects stats also sees when collection started.
+    return (_isCollectingStats.load() == 1);
+}
+
+long long BenchRunState::microsSinceStatsCollectionStarted() const {
+    return _timer.micros() - _statsCollectionStartMicros.load();
 }
 
 void BenchRunState::onWorkerStarted() {
@@ -888,15 +988,49 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
         }
     });
 
+    // With a fixed arrival rate, each worker starts one operation every 'startIntervalMicros', and
+    // the workers' schedules are staggered so that the starts are spread evenly over time.
+    const bool fixedArrivalRate = _config->opsPerSecond > 0;
+    const double startIntervalMicros =
+        fixedArrivalRate ? 1000000.0 * _config->parallel / _config->opsPerSecond : 0;
+    double nextStartMicros = startIntervalMicros * _id / std::max(_config->parallel, 1U);
+    Timer scheduleTimer;
+
+    const long long throughputIntervalMicros =
+        static_cast<long long>(_config->throughputIntervalSeconds * 1000000);
+
     while (!shouldStop()) {
         for (const auto& op : _config->ops) {
             if (shouldStop())
                 break;
 
+            if (fixedArrivalRate) {
+                long long nowMicros = scheduleTimer.micros();
+                if (nowMicros < nextStartMicros) {
+                    sleepmicros(static_cast<long long>(nextStartMicros) - nowMicros);
+                    nowMicros = scheduleTimer.micros();
+                }
+
+                // The schedule does not slip when operations run late, so a slow server builds up
+                // a backlog whose queueing delay shows up in the measured latencies.
+                opState.scheduleLag = Microseconds(
+                    std::max(0LL, nowMicros - static_cast<long long>(nextStartMicros)));
+                nextStartMicros += startIntervalMicros;
+            }
+
             opState.stats = shouldCollectStats() ? &_stats : &_statsBlackHole;
 
             try {
                 op.executeOnce(conn, lsid, *_config, &opState);
+
+                if (throughputIntervalMicros > 0 && opState.stats == &_stats) {
+                    const size_t interval =
+                        _brState.microsSinceStatsCollectionStarted() / throughputIntervalMicros;
+                    if (_stats.throughputSeries.size() <= interval) {
+                        _stats.throughputSeries.resize(interval + 1);
+                    }
+                    ++_stats.throughputSeries[interval];
+                }
             } catch (const DBException& ex) {
                 if (!_config->hideErrors || op.showError) {
                     bool yesWatch =
@@ -992,7 +1126,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
                 }
                 invariant(qr->validate());
 
-                BenchRunEventTrace _bret(&state->stats->findOneCounter);
+                BenchRunEventTrace _bret(&state->stats->findOneCounter, state);
                 boost::optional<TxnNumber> txnNumberForOp;
                 if (config.useSnapshotReads) {
                     ++state->txnNumber;
@@ -1002,7 +1136,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
                 runQueryWithReadCommands(
                     conn, lsid, txnNumberForOp, std::move(qr), Milliseconds(0), &result);
             } else {
-                BenchRunEventTrace _bret(&state->stats->findOneCounter);
+                BenchRunEventTrace _bret(&state->stats->findOneCounter, state);
                 result = conn->findOne(
                     this->ns, fixedQuery, nullptr, DBClientCursor::QueryOptionLocal_forceOpQuery);
             }
@@ -1014,7 +1148,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
             bool ok;
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->commandCounter);
+                BenchRunEventTrace _bret(&state->stats->commandCounter, state);
                 ok = runCommandWithSession(conn,
                                            this->ns,
                                            fixQuery(this->command, *state->bsonTemplateEvaluator),
@@ -1093,7 +1227,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
 
                 invariant(qr->validate());
 
-                BenchRunEventTrace _bret(&state->stats->queryCounter);
+                BenchRunEventTrace _bret(&state->stats->queryCounter, state);
                 boost::optional<TxnNumber> txnNumberForOp;
                 if (config.useSnapshotReads) {
                     ++state->txnNumber;
@@ -1114,7 +1248,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
             } else {
                 // Use special query function for exhaust query option.
                 if (this->options & QueryOption_Exhaust) {
-                    BenchRunEventTrace _bret(&state->stats->queryCounter);
+                    BenchRunEventTrace _bret(&state->stats->queryCounter, state);
                     stdx::function<void(const BSONObj&)> castedDoNothing(doNothing);
                     count =
                         conn->query(castedDoNothing,
@@ -1123,7 +1257,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
                                     &this->projection,
                                     this->options | DBClientCursor::QueryOptionLocal_forceOpQuery);
                 } else {
-                    BenchRunEventTrace _bret(&state->stats->queryCounter);
+                    BenchRunEventTrace _bret(&state->stats->queryCounter, state);
                     std::unique_ptr<DBClientCursor> cursor(
                         conn->query(NamespaceString(this->ns),
                                     fixedQuery,
@@ -1148,7 +1282,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
         case OpType::UPDATE: {
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->updateCounter);
+                BenchRunEventTrace _bret(&state->stats->updateCounter, state);
                 BSONObj query = fixQuery(this->query, *state->bsonTemplateEvaluator);
                 BSONObj update = fixQuery(this->update, *state->bsonTemplateEvaluator);
 
@@ -1199,7 +1333,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
         case OpType::INSERT: {
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->insertCounter);
+                BenchRunEventTrace _bret(&state->stats->insertCounter, state);
 
                 BSONObj insertDoc;
                 if (this->useWriteCmd) {
@@ -1263,7 +1397,7 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
         case OpType::REMOVE: {
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->deleteCounter);
+                BenchRunEventTrace _bret(&state->stats->deleteCounter, state);
                 BSONObj predicate = fixQuery(this->query, *state->bsonTemplateEvaluator);
                 if (this->useWriteCmd) {
                     BSONObjBuilder builder;
@@ -1470,6 +1604,27 @@ BSONObj BenchRunner::finish(BenchRunner* runner) {
     appendAverageMicrosIfAvailable("queryLatencyAverageMicros", stats.queryCounter);
     appendAverageMicrosIfAvailable("commandsLatencyAverageMicros", stats.commandCounter);
 
+    const auto appendPercentilesIfAvailable = [&buf](StringData name,
+                                                     const BenchRunEventCounter& counter) {
+        const auto& latencies = counter.getLatencies();
+        if (latencies.getCount() > 0) {
+            buf.append(name,
+                       BSON("p50" << latencies.getValueAtPercentile(50) << "p99"
+                                  << latencies.getValueAtPercentile(99)
+                                  << "p999"
+                                  << latencies.getValueAtPercentile(99.9)
+                                  << "max"
+                                  << latencies.getMax()));
+        }
+    };
+
+    appendPercentilesIfAvailable("findOneLatencyPercentilesMicros", stats.findOneCounter);
+    appendPercentilesIfAvailable("insertLatencyPercentilesMicros", stats.insertCounter);
+    appendPercentilesIfAvailable("deleteLatencyPercentilesMicros", stats.deleteCounter);
+    appendPercentilesIfAvailable("updateLatencyPercentilesMicros", stats.updateCounter);
+    appendPercentilesIfAvailable("queryLatencyPercentilesMicros", stats.queryCounter);
+    appendPercentilesIfAvailable("commandsLatencyPercentilesMicros", stats.commandCounter);
+
     buf.append("totalOps", static_cast<long long>(stats.opCount));
 
     const auto appendPerSec = [&buf, runner](StringData name, double total) {
@@ -1492,6 +1647,18 @@ BSONObj BenchRunner::finish(BenchRunner* runner) {
     buf.append("queries", stats.queryCounter.getNumEvents());
     buf.append("commands", stats.commandCounter.getNumEvents());
 
+    const double intervalSeconds = runner->config().throughputIntervalSeconds;
+    if (intervalSeconds > 0) {
+        BSONArrayBuilder series(buf.subarrayStart("throughput"));
+        for (size_t i = 0; i < stats.throughputSeries.size(); ++i) {
+            series.append(BSON("time" << i * intervalSeconds << "totalOps"
+                                      << stats.throughputSeries[i]
+                                      << "totalOps/s"
+                                      << stats.throughputSeries[i] / intervalSeconds));
+        }
+        series.doneFast();
+    }
+
     BSONObj zoo = buf.obj();
 
     delete runner;
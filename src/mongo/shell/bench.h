@@ -30,6 +30,7 @@
 
 #include <boost/optional.hpp>
 #include <string>
+#include <vector>
 
 #include "mongo/base/shim.h"
 #include "mongo/client/dbclient_base.h"
@@ -84,6 +85,10 @@ struct BenchRunOp {
         // Transaction state
         TxnNumber txnNumber = 0;
         bool inProgressMultiStatementTxn = false;
+
+        // How late the next operation is starting relative to its scheduled start time, when the
+        // bench run has a fixed arrival rate. Charged to the first event traced for the operation.
+        Microseconds scheduleLag{0};
     };
 
     void executeOnce(DBClientBase* conn,
@@ -221,6 +226,20 @@ public:
      */
     Milliseconds delayMillisOnFailedOperation{0};
 
+    /**
+     * Total number of operations per second to start across all threads. When non-zero, the
+     * workers start operations on a fixed schedule instead of as soon as the previous operation
+     * completes, and latencies are measured from each operation's scheduled start time. This keeps
+     * a saturated server from hiding its queueing delay (coordinated omission).
+     */
+    double opsPerSecond{0};
+
+    /**
+     * When non-zero, the number of completed operations is also reported for each interval of
+     * this many seconds.
+     */
+    double throughputIntervalSeconds{0};
+
     /// Base random seed for threads
     int64_t randomSeed;
 
@@ -254,6 +273,49 @@ private:
     void initializeToDefaults();
 };
 
+/**
+ * A histogram of latencies in microseconds, in the manner of HdrHistogram. Values are bucketed
+ * log-linearly, so every recorded value is kept to within 1% of its true value. Values of 2^36
+ * microseconds, about 19 hours, or more are clamped.
+ *
+ * Not thread safe. Expected use is one instance per thread during parallel execution.
+ */
+class BenchRunLatencyHistogram {
+public:
+    /**
+     * Count one event which took "micros" microseconds.
+     */
+    void record(long long micros);
+
+    /**
+     * Conceptually the equivalent of "+=". Adds "other" into this.
+     */
+    void updateFrom(const BenchRunLatencyHistogram& other);
+
+    /**
+     * Get the latency which "percentile" percent of the observed events did not exceed, to within
+     * the precision of the histogram. Returns 0 if no events were observed.
+     */
+    long long getValueAtPercentile(double percentile) const;
+
+    long long getCount() const {
+        return _count;
+    }
+
+    long long getMax() const {
+        return _max;
+    }
+
+private:
+    static size_t indexForValue(long long micros);
+    static long long highestValueForIndex(size_t index);
+
+    // Allocated on the first call to record(), as most event types are never observed.
+    std::vector<long long> _counts;
+    long long _count{0};
+    long long _max{0};
+};
+
 /**
  * An event counter for events that have an associated duration.
  *
@@ -278,6 +340,7 @@ public:
         }
         ++_numEvents;
         _totalTimeMicros += timeMicros;
+        _latencies.record(timeMicros);
     }
 
     /**
@@ -294,9 +357,17 @@ public:
         return _numEvents;
     }
 
+    /**
+     * Get the distribution of the durations of the observed events.
+     */
+    const BenchRunLatencyHistogram& getLatencies() const {
+        return _latencies;
+    }
+
 private:
     long long _totalTimeMicros{0};
     long long _numEvents{0};
+    BenchRunLatencyHistogram _latencies;
 };
 
 /**
@@ -311,6 +382,10 @@ private:
  * event, and otherwise, the succes counter will.
  *
  * In all cases, the counter objects must outlive the trace object.
+ *
+ * When constructed with an operation's state, the event is also charged with the time the
+ * operation spent waiting past its scheduled start, and that lag is consumed so that it is only
+ * counted once per operation.
  */
 class BenchRunEventTrace {
     MONGO_DISALLOW_COPYING(BenchRunEventTrace);
@@ -320,6 +395,12 @@ public:
         initialize(eventCounter, eventCounter, false);
     }
 
+    BenchRunEventTrace(BenchRunEventCounter* eventCounter, BenchRunOp::State* state) {
+        initialize(eventCounter, eventCounter, false);
+        _lagMicros = durationCount<Microseconds>(state->scheduleLag);
+        state->scheduleLag = Microseconds(0);
+    }
+
     BenchRunEventTrace(BenchRunEventCounter* successCounter,
                        BenchRunEventCounter* failCounter,
                        bool defaultToFailure = true) {
@@ -327,7 +408,7 @@ public:
     }
 
     ~BenchRunEventTrace() {
-        (_succeeded ? _successCounter : _failCounter)->countOne(_timer.micros());
+        (_succeeded ? _successCounter : _failCounter)->countOne(_lagMicros + _timer.micros());
     }
 
     void succeed() {
@@ -350,6 +431,7 @@ private:
     BenchRunEventCounter* _successCounter;
     BenchRunEventCounter* _failCounter;
     bool _succeeded;
+    long long _lagMicros{0};
 };
 
 /**
@@ -372,6 +454,10 @@ struct BenchRunStats {
 
     std::map<std::string, long long> opcounters;
     std::vector<BSONObj> trappedErrors;
+
+    // Number of operations completed in each interval of the run, when the configuration asks
+    // for a throughput time series. The intervals start when stats collection starts.
+    std::vector<long long> throughputSeries;
 };
 
 /**
@@ -431,6 +517,12 @@ public:
     */
     bool shouldWorkerCollectStats() const;
 
+    /**
+     * Microseconds since the call to tellWorkersToCollectStats(). All workers measure against
+     * the same start, so that their throughput series line up.
+     */
+    long long microsSinceStatsCollectionStarted() const;
+
     /**
      * Called by each BenchRunWorker from within its thread context, immediately before it
      * starts sending requests to the configured mongo instance.
@@ -453,6 +545,11 @@ private:
 
     AtomicUInt32 _isShuttingDown;
     AtomicUInt32 _isCollectingStats;
+
+    // Started on construction. '_statsCollectionStartMicros' is its reading when the workers were
+    // told to collect stats.
+    Timer _timer;
+    AtomicInt64 _statsCollectionStartMicros;
 };
 
 /**
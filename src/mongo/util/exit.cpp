@@ -35,6 +35,7 @@
 #include <boost/optional.hpp>
 #include <stack>
 
+#include "mongo/logger/async_log_writer.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
@@ -72,6 +73,7 @@ void runTasks(decltype(shutdownTasks) tasks) {
 MONGO_COMPILER_NORETURN void logAndQuickExit_inlock() {
     ExitCode code = shutdownExitCode.get();
     log() << "shutting down with code:" << code;
+    logger::AsyncLogWriter::flushAll(logger::AsyncLogWriter::kCrashFlushTimeout);
     quickExit(code);
 }
 
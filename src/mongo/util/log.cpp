@@ -31,6 +31,7 @@
 
 #include "mongo/util/log.h"
 
+#include "mongo/logger/async_log_writer.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/message_event_utf8_encoder.h"
 #include "mongo/logger/ramlog.h"
@@ -65,6 +66,10 @@ bool rotateLogs(bool renameFiles) {
     using logger::RotatableFileManager;
     RotatableFileManager* manager = logger::globalRotatableFileManager();
     log() << "Log rotation initiated";
+    // Messages logged before the rotation belong in the old file.
+    if (!logger::AsyncLogWriter::flushAll(logger::AsyncLogWriter::kRotateFlushTimeout)) {
+        warning() << "Rotating the logs before all earlier messages were written";
+    }
     RotatableFileManager::FileNameStatusPairVector result(
         manager->rotateAll(renameFiles, "." + terseCurrentTime(false)));
     for (RotatableFileManager::FileNameStatusPairVector::iterator it = result.begin();
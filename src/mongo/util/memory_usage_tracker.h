@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+/**
+ * Keeps a running total of the bytes charged against it, along with the highest total it has
+ * reached. A tracker may have a parent to which every charge is forwarded as well, so that the
+ * trackers of individual aggregation stages roll up into an operation-wide total.
+ *
+ * The counters are atomic so that the totals can be read by other threads, e.g. when reporting
+ * $currentOp, while the owning operation keeps charging against them.
+ *
+ * A tracker may also have a limit: a memory budget for everything charged against it and its
+ * descendants. The tracker does not refuse charges beyond its limit. Instead, holders of memory
+ * that can be released, such as aggregation stages that can spill to disk, check
+ * shouldReleaseMemory() before taking on more, in addition to any limits of their own.
+ */
+class MemoryUsageTracker {
+    MemoryUsageTracker(const MemoryUsageTracker&) = delete;
+    MemoryUsageTracker& operator=(const MemoryUsageTracker&) = delete;
+
+public:
+    /**
+     * A tracker charged less than 1/kMinReleaseFraction of an exceeded limit is not asked to
+     * release memory, so that a stage holding little does not spill tiny files to disk for memory
+     * held elsewhere in the operation.
+     */
+    static constexpr long long kMinReleaseFraction = 16;
+
+    /**
+     * Creates a tracker which forwards its charges to 'parent', if any. A positive 'limit' is the
+     * budget for this tracker and its descendants; zero means there is none.
+     */
+    explicit MemoryUsageTracker(std::shared_ptr<MemoryUsageTracker> parent = nullptr,
+                                long long limit = 0)
+        : _parent(std::move(parent)), _limit(limit) {}
+
+    ~MemoryUsageTracker() {
+        // Whatever is still charged here is released from the parent along with this tracker.
+        if (_parent) {
+            _parent->add(-_current.load());
+        }
+    }
+
+    /**
+     * Charges 'diff' bytes against this tracker and its ancestors. A negative 'diff' releases
+     * memory.
+     */
+    void add(long long diff) {
+        const long long current = _current.addAndFetch(diff);
+        long long peak = _peak.load();
+        while (current > peak) {
+            const long long previous = _peak.compareAndSwap(peak, current);
+            if (previous == peak) {
+                break;
+            }
+            peak = previous;
+        }
+
+        if (_parent) {
+            _parent->add(diff);
+        }
+    }
+
+    /**
+     * Adjusts the charge so that exactly 'bytes' bytes are charged against this tracker.
+     */
+    void set(long long bytes) {
+        add(bytes - _current.load());
+    }
+
+    /**
+     * Returns true if this tracker or one of its ancestors is charged more than its limit, and this
+     * tracker's share of that limit is large enough for releasing it to help.
+     */
+    bool shouldReleaseMemory() const {
+        const long long current = _current.load();
+        for (auto tracker = this; tracker; tracker = tracker->_parent.get()) {
+            if (tracker->_limit > 0 && tracker->_current.load() > tracker->_limit &&
+                current >= tracker->_limit / kMinReleaseFraction) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    long long limit() const {
+        return _limit;
+    }
+
+    long long currentMemoryBytes() const {
+        return _current.load();
+    }
+
+    long long peakMemoryBytes() const {
+        return _peak.load();
+    }
+
+private:
+    // Shared so that the parent outlives this tracker even if its owner lets go of it first.
+    const std::shared_ptr<MemoryUsageTracker> _parent;
+    const long long _limit;
+
+    AtomicWord<long long> _current{0};
+    AtomicWord<long long> _peak{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/memory_usage_tracker.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(MemoryUsageTrackerTest, TracksCurrentAndPeakUsage) {
+    MemoryUsageTracker tracker;
+    ASSERT_EQ(tracker.currentMemoryBytes(), 0LL);
+    ASSERT_EQ(tracker.peakMemoryBytes(), 0LL);
+
+    tracker.add(100);
+    tracker.add(50);
+    ASSERT_EQ(tracker.currentMemoryBytes(), 150LL);
+    ASSERT_EQ(tracker.peakMemoryBytes(), 150LL);
+
+    tracker.add(-120);
+    ASSERT_EQ(tracker.currentMemoryBytes(), 30LL);
+    ASSERT_EQ(tracker.peakMemoryBytes(), 150LL);
+
+    tracker.set(80);
+    ASSERT_EQ(tracker.currentMemoryBytes(), 80LL);
+    ASSERT_EQ(tracker.peakMemoryBytes(), 150LL);
+
+    tracker.set(200);
+    ASSERT_EQ(tracker.currentMemoryBytes(), 200LL);
+    ASSERT_EQ(tracker.peakMemoryBytes(), 200LL);
+}
+
+TEST(MemoryUsageTrackerTest, ChildrenRollUpIntoParent) {
+    auto parent = std::make_shared<MemoryUsageTracker>();
+    MemoryUsageTracker first(parent);
+
+    first.add(100);
+    {
+        MemoryUsageTracker second(parent);
+        second.add(300);
+        ASSERT_EQ(parent->currentMemoryBytes(), 400LL);
+
+        second.set(50);
+        ASSERT_EQ(parent->currentMemoryBytes(), 150LL);
+        ASSERT_EQ(second.peakMemoryBytes(), 300LL);
+    }
+
+    // Destroying a child releases whatever it still had charged.
+    ASSERT_EQ(parent->currentMemoryBytes(), 100LL);
+    ASSERT_EQ(parent->peakMemoryBytes(), 400LL);
+    ASSERT_EQ(first.peakMemoryBytes(), 100LL);
+}
+
+TEST(MemoryUsageTrackerTest, ChildKeepsParentAlive) {
+    auto parent = std::make_shared<MemoryUsageTracker>();
+    std::weak_ptr<MemoryUsageTracker> weakParent = parent;
+    {
+        MemoryUsageTracker child(parent);
+        child.add(100);
+
+        // The owner of the parent may replace it while a child still charges against it.
+        parent = std::make_shared<MemoryUsageTracker>();
+        ASSERT_FALSE(weakParent.expired());
+        ASSERT_EQ(weakParent.lock()->currentMemoryBytes(), 100LL);
+    }
+    ASSERT_TRUE(weakParent.expired());
+}
+
+TEST(MemoryUsageTrackerTest, ChildrenAreAskedToReleaseMemoryOverParentLimit) {
+    auto parent = std::make_shared<MemoryUsageTracker>(nullptr, 1600);
+    MemoryUsageTracker large(parent);
+    MemoryUsageTracker small(parent);
+
+    large.add(1550);
+    small.add(50);
+    ASSERT_FALSE(large.shouldReleaseMemory());
+    ASSERT_FALSE(small.shouldReleaseMemory());
+
+    // Only a child holding at least a sixteenth of the limit is asked to release memory.
+    small.add(1);
+    ASSERT_TRUE(parent->shouldReleaseMemory());
+    ASSERT_TRUE(large.shouldReleaseMemory());
+    ASSERT_FALSE(small.shouldReleaseMemory());
+
+    large.set(0);
+    ASSERT_FALSE(parent->shouldReleaseMemory());
+    ASSERT_FALSE(small.shouldReleaseMemory());
+}
+
+TEST(MemoryUsageTrackerTest, TrackerWithoutLimitIsNeverAskedToReleaseMemory) {
+    auto parent = std::make_shared<MemoryUsageTracker>();
+    MemoryUsageTracker child(parent);
+    child.add(1LL << 40);
+    ASSERT_FALSE(child.shouldReleaseMemory());
+}
+
+}  // namespace
+}  // namespace mongo
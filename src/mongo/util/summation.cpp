@@ -32,6 +32,7 @@
 
 #include <cmath>
 
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -44,6 +45,52 @@ void DoubleDoubleSummation::addLong(long long x) {
     addDouble(high);
 }
 
+void DoubleDoubleSummation::addDoubles(const double* values, size_t count) {
+    // Each lane is an independent DoubleDoubleSummation. Keeping them in plain arrays rather than
+    // in separate objects lets the compiler hold all lanes in registers for the whole loop.
+    constexpr size_t kLanes = 4;
+    double sum[kLanes] = {};
+    double addend[kLanes] = {};
+    double special[kLanes] = {};
+
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            double x = values[i + lane];
+            special[lane] += x;
+            std::tie(x, addend[lane]) = _fast2Sum(x, addend[lane]);
+            std::tie(sum[lane], x) = _2Sum(sum[lane], x);
+            addend[lane] += x;
+        }
+    }
+
+    // Fold the lanes into this sum. A lane whose compensated sum became NaN because of infinities
+    // propagates the NaN into '_sum', in which case getDouble() falls back to '_special', exactly
+    // as if the values had been added one at a time.
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        _special += special[lane];
+        _addCompensated(sum[lane]);
+        _addCompensated(addend[lane]);
+    }
+
+    for (; i < count; ++i) {
+        addDouble(values[i]);
+    }
+}
+
+void DoubleDoubleSummation::addLongs(const long long* values, size_t count) {
+    int64_t partial = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t next;
+        if (mongoSignedAddOverflow64(partial, values[i], &next)) {
+            addLong(partial);
+            next = values[i];
+        }
+        partial = next;
+    }
+    addLong(partial);
+}
+
 /**
  * Returns whether the sum is in range of the 64-bit signed integer long long type.
  */
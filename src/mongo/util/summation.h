@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <tuple>
 #include <utility>
 
@@ -51,12 +52,26 @@ public:
      * Adds x to the sum, keeping track of a compensation amount to be subtracted later.
      */
     void addDouble(double x) {
-        _special += x;                                 // Keep a simple sum to use in case of NaN
-        std::tie(x, _addend) = _fast2Sum(x, _addend);  // Compensated add: _addend tinier than _sum
-        std::tie(_sum, x) = _2Sum(_sum, x);            // Compensated add: x maybe larger than _sum
-        _addend += x;                                  // Store away lowest part of sum
+        _special += x;  // Keep a simple sum to use in case of NaN
+        _addCompensated(x);
     }
 
+    /**
+     * Adds 'count' doubles starting at 'values' to the sum. The elements are spread over several
+     * independent compensated sums that are combined at the end, so the loop carries no dependency
+     * from one element to the next and can be pipelined or vectorized by the compiler. Because the
+     * elements are added in a different order, the result may differ in the last bits from calling
+     * addDouble() on each element.
+     */
+    void addDoubles(const double* values, size_t count);
+
+    /**
+     * Adds 'count' 64-bit integers starting at 'values' to the sum. Runs of values are summed
+     * exactly using native integer arithmetic and only folded into the compensated sum when the
+     * partial total would otherwise overflow.
+     */
+    void addLongs(const long long* values, size_t count);
+
     /**
      * Adds x to internal sum. Extra precision guarantees that sum is exact, unless intermediate
      * sums exceed a magnitude of 2**106.
@@ -113,6 +128,15 @@ public:
     long long getLong() const;
 
 private:
+    /**
+     * Adds x to the compensated sum only, leaving the simple '_special' sum untouched.
+     */
+    void _addCompensated(double x) {
+        std::tie(x, _addend) = _fast2Sum(x, _addend);  // Compensated add: _addend tinier than _sum
+        std::tie(_sum, x) = _2Sum(_sum, x);            // Compensated add: x maybe larger than _sum
+        _addend += x;                                  // Store away lowest part of sum
+    }
+
     /**
      * Assuming |b| <= |a|, returns exact unevaluated sum of a and b, where the first member is the
      * double nearest the sum (ties to even) and the second member is the remainder.
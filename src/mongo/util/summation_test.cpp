@@ -203,4 +203,63 @@ TEST(Summation, AddDoubles) {
     ASSERT_EQUALS(sum.getDouble(), doubleValuesSum);
     ASSERT(straightSum != sum.getDouble());
 }
+
+TEST(Summation, AddDoublesBatch) {
+    // Every prefix length exercises a different split between the lanes and the scalar tail. The
+    // compensated sums of these values are exact in either order, so the results match exactly.
+    for (size_t n = 0; n <= doubleValues.size(); n++) {
+        DoubleDoubleSummation expected;
+        for (size_t i = 0; i < n; i++) {
+            expected.addDouble(doubleValues[i]);
+        }
+
+        DoubleDoubleSummation sum;
+        sum.addDoubles(doubleValues.data(), n);
+        ASSERT_EQUALS(sum.getDouble(), expected.getDouble());
+    }
+
+    DoubleDoubleSummation sum;
+    sum.addDoubles(doubleValues.data(), doubleValues.size());
+    ASSERT_EQUALS(sum.getDouble(), doubleValuesSum);
+}
+
+TEST(Summation, AddDoublesBatchSpecial) {
+    for (auto x : specialValues) {
+        std::vector<double> values(doubleValues);
+        values.insert(values.begin() + 7, x);
+
+        DoubleDoubleSummation sum;
+        sum.addDoubles(values.data(), values.size());
+        ASSERT(!sum.fitsLong());
+        if (std::isnan(x)) {
+            ASSERT(std::isnan(sum.getDouble()));
+        } else {
+            ASSERT_EQUALS(sum.getDouble(), x);
+        }
+    }
+
+    DoubleDoubleSummation sum;
+    sum.addDoubles(specialValues.data(), 2);
+    ASSERT(std::isnan(sum.getDouble()));
+}
+
+TEST(Summation, AddLongsBatch) {
+    DoubleDoubleSummation expected;
+    for (auto x : longValues) {
+        expected.addLong(x);
+    }
+
+    DoubleDoubleSummation sum;
+    sum.addLongs(longValues.data(), longValues.size());
+    ASSERT(sum.isInteger());
+    ASSERT_EQUALS(sum.fitsLong(), expected.fitsLong());
+    ASSERT_EQUALS(sum.getDouble(), expected.getDouble());
+
+    // Runs that overflow a 64-bit partial total must still be summed exactly.
+    std::vector<long long> overflowing = {limits::max(), limits::max(), -limits::max(), -1};
+    DoubleDoubleSummation overflowSum;
+    overflowSum.addLongs(overflowing.data(), overflowing.size());
+    ASSERT(overflowSum.fitsLong());
+    ASSERT_EQUALS(overflowSum.getLong(), limits::max() - 1);
+}
 }  // namespace mongo